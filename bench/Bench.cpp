@@ -0,0 +1,523 @@
+/*
+ * CPU-Draw - Benchmark
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 主机基准测试
+ * 在内存缓冲上测量各图元、文字和整帧场景的性能
+ *
+ * 特性：
+ * - 每项输出 ns/op 与 Mpix/s
+ * - 整帧场景分别测立即模式、录制+分块回放、菜单缓存
+ * - 参数：--filter <子串> --time <毫秒> --size <宽>x<高> --threads <线程数> --profile
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "core/Profiler.h"
+#include "graphics/DrawList.h"
+#include "graphics/Gradient.h"
+#include "graphics/PixelFormat.h"
+#include "graphics/Primitives.h"
+#include "graphics/Rasterizer.h"
+#include "graphics/RenderScale.h"
+#include "graphics/Texture.h"
+#include "graphics/TileRenderer.h"
+#include "text/SdfText.h"
+#include "text/TextRenderer.h"
+#include "ui/FloatingMenu.h"
+#include "ui/ProfilerHud.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace Graphics;
+
+namespace
+{
+
+struct BenchConfig
+{
+    std::string filter;
+    int timeMs = 200;
+    int width = 1920;
+    int height = 1080;
+    int threads = 0;
+    bool profile = false; // 开启帧分析，每项结束后输出摘要
+};
+
+BenchConfig g_config;
+std::vector<uint32_t> g_pixels;
+
+// 每帧都会覆盖的背景，避免不同项之间互相影响
+void ResetPixels()
+{
+    for (int y = 0; y < g_config.height; y++)
+    {
+        uint32_t *row = &g_pixels[(size_t)y * g_config.width];
+        for (int x = 0; x < g_config.width; x++)
+        {
+            row[x] = rgba(x * 255 / g_config.width, y * 255 / g_config.height, 96, 255);
+        }
+    }
+}
+
+// 运行一项：先预热，再按批次计时直到达到最短时间
+// pixels 为每次操作覆盖的像素数，用于计算 Mpix/s（0 表示不统计）
+void Run(const char *name, double pixels, const std::function<void()> &op)
+{
+    if (!g_config.filter.empty() && strstr(name, g_config.filter.c_str()) == nullptr) return;
+
+    ResetPixels();
+    for (int i = 0; i < 3; i++)
+    {
+        op();
+    }
+
+    // 每次操作当作一帧，计数按帧平均
+    Core::Profiler &profiler = Core::Profiler::Instance();
+    std::function<void()> frameOp = op;
+    if (g_config.profile)
+    {
+        frameOp = [&]() {
+            profiler.BeginFrame();
+            op();
+            profiler.EndFrame();
+        };
+    }
+
+    typedef std::chrono::steady_clock Clock;
+    const double minSeconds = g_config.timeMs / 1000.0;
+
+    long long iterations = 0;
+    long long batch = 1;
+    double seconds = 0;
+    Clock::time_point start = Clock::now();
+    while (seconds < minSeconds)
+    {
+        for (long long i = 0; i < batch; i++)
+        {
+            frameOp();
+        }
+        iterations += batch;
+        seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (seconds < minSeconds / 10) batch *= 2;
+    }
+
+    double nsPerOp = seconds * 1e9 / iterations;
+    if (pixels > 0)
+    {
+        printf("%-34s %12.1f ns/op %10.1f Mpix/s %10lld ops\n", name, nsPerOp, pixels * iterations / seconds / 1e6, iterations);
+    }
+    else
+    {
+        printf("%-34s %12.1f ns/op %10s        %10lld ops\n", name, nsPerOp, "-", iterations);
+    }
+    if (g_config.profile) profiler.LogSummary((int)std::min<long long>(iterations, 120));
+}
+
+// ==================== 图元 ====================
+
+void BenchPrimitives()
+{
+    uint32_t *px = g_pixels.data();
+    const int w = g_config.width;
+    const int h = g_config.height;
+
+    const uint32_t opaque = rgba(40, 160, 220, 255);
+    const uint32_t translucent = rgba(220, 80, 40, 160);
+
+    Run("clear_screen", (double)w * h, [&]() { clear_screen(px, w, w, h, 0); });
+
+    Run("rect_filled 256 opaque", 256.0 * 256, [&]() { draw_rect_filled(px, w, w, h, 100, 100, 355, 355, opaque); });
+    Run("rect_filled 256 alpha", 256.0 * 256, [&]() { draw_rect_filled(px, w, w, h, 100, 100, 355, 355, translucent); });
+    Run("rect_filled 16 alpha", 16.0 * 16, [&]() { draw_rect_filled(px, w, w, h, 100, 100, 115, 115, translucent); });
+    Run("rect outline 256", 4.0 * 256, [&]() { draw_rect(px, w, w, h, 100, 100, 355, 355, opaque); });
+
+    Run("rect_rounded_filled 256 r16", 256.0 * 256, [&]() { draw_rect_rounded_filled(px, w, w, h, 100, 100, 355, 355, 16, translucent); });
+    Run("rect_rounded_filled_aa 256 r16", 256.0 * 256, [&]() { draw_rect_rounded_filled_aa(px, w, w, h, 100, 100, 355, 355, 16, translucent); });
+    Run("rect_rounded 256 r16", 4.0 * 256, [&]() { draw_rect_rounded(px, w, w, h, 100, 100, 355, 355, 16, opaque); });
+
+    Run("circle_filled r64", 3.14159 * 64 * 64, [&]() { draw_circle_filled(px, w, w, h, 300, 300, 64, translucent); });
+    Run("circle_filled_aa r64", 3.14159 * 64 * 64, [&]() { draw_circle_filled_aa(px, w, w, h, 300.0f, 300.0f, 64.0f, translucent); });
+    Run("circle r64", 2 * 3.14159 * 64, [&]() { draw_circle(px, w, w, h, 300, 300, 64, opaque); });
+    Run("circle_aa r64", 2 * 3.14159 * 64, [&]() { draw_circle_aa(px, w, w, h, 300.0f, 300.0f, 64.0f, opaque); });
+
+    Run("gradient_linear 256", 256.0 * 256, [&]() { fill_gradient_linear(px, w, w, h, 100, 100, 355, 355, opaque, translucent); });
+    Run("gradient_radial r128", 3.14159 * 128 * 128, [&]() { fill_gradient_radial(px, w, w, h, 400, 400, 128, opaque, translucent); });
+
+    // 多色标：色带从缓存取出，逐像素查表
+    Gradient stops = Gradient().AddStop(0.0f, rgba(255, 0, 0, 255)).AddStop(0.3f, rgba(255, 255, 0, 255)).AddStop(0.7f, rgba(0, 255, 0, 255)).AddStop(1.0f, rgba(0, 0, 255, 255));
+    Run("gradient_linear 256 diagonal 4 stops", 256.0 * 256, [&]() { fill_gradient_linear(px, w, w, h, 100, 100, 355, 355, 100.0f, 100.0f, 356.0f, 356.0f, GradientCache::Instance().Get(stops)); });
+    Run("gradient_radial r128 4 stops", 3.14159 * 128 * 128, [&]() { fill_gradient_radial(px, w, w, h, 400, 400, 128, GradientCache::Instance().Get(stops)); });
+
+    // 图标纹理：128x128，圆形不透明区域 + 半透明边缘
+    std::vector<uint8_t> icon(128 * 128 * 4);
+    for (int y = 0; y < 128; y++)
+    {
+        for (int x = 0; x < 128; x++)
+        {
+            uint8_t *p = &icon[(y * 128 + x) * 4];
+            int dx = x - 64, dy = y - 64;
+            p[0] = (uint8_t)(x * 2);
+            p[1] = (uint8_t)(y * 2);
+            p[2] = 128;
+            p[3] = dx * dx + dy * dy < 60 * 60 ? 255 : (dx * dx + dy * dy < 64 * 64 ? 128 : 0);
+        }
+    }
+    Texture texture;
+    texture.Load(icon.data(), 128, 128, 0, true);
+    Run("image 128", 128.0 * 128, [&]() { draw_texture(px, w, w, h, texture, 100, 100); });
+    Run("image 128 tinted", 128.0 * 128, [&]() { draw_texture(px, w, w, h, texture, 100, 100, rgba(255, 128, 0, 200)); });
+    Run("image_scaled 128->256 nearest", 256.0 * 256, [&]() { draw_texture_scaled(px, w, w, h, texture, 100, 100, 355, 355, nullptr, TextureFilter::Nearest); });
+    Run("image_scaled 128->256 bilinear", 256.0 * 256, [&]() { draw_texture_scaled(px, w, w, h, texture, 100, 100, 355, 355); });
+    Run("image_scaled 128->40 bilinear mip", 40.0 * 40, [&]() { draw_texture_scaled(px, w, w, h, texture, 100, 100, 139, 139); });
+
+    // 提交时的整帧格式转换（工作缓冲 -> 窗口缓冲）
+    std::vector<uint32_t> window32((size_t)w * h);
+    std::vector<uint16_t> window16((size_t)w * h);
+    IntRect frame = { 0, 0, w - 1, h - 1 };
+    Run("convert rgba8888 full frame", (double)w * h, [&]() { convert_rect(PixelFormat::RGBA8888, window32.data(), w, px, w, frame); });
+    Run("convert rgb565 dither full frame", (double)w * h, [&]() { convert_rect(PixelFormat::RGB565, window16.data(), w, px, w, frame); });
+
+    // 渲染缩放：低分辨率缓冲放大回整帧
+    int lowW = scaled_size(w, 0.5f), lowH = scaled_size(h, 0.5f);
+    Run("upscale 0.5x full frame", (double)w * h, [&]() { upscale_bilinear(window32.data(), w, w, h, px, w, lowW, lowH, frame); });
+    lowW = scaled_size(w, 0.75f);
+    lowH = scaled_size(h, 0.75f);
+    Run("upscale 0.75x full frame", (double)w * h, [&]() { upscale_bilinear(window32.data(), w, w, h, px, w, lowW, lowH, frame); });
+
+    Run("line 512 diagonal", 512, [&]() { draw_line(px, w, w, h, 100, 100, 462, 462, opaque); });
+    Run("lineF 512 diagonal", 512, [&]() { draw_lineF(px, w, w, h, 100.5f, 100.5f, 462.5f, 462.5f, opaque); });
+    Run("line_aa 512 diagonal", 512, [&]() { draw_line_aa(px, w, w, h, 100.5f, 100.5f, 462.5f, 462.5f, opaque); });
+    Run("line_thick 512 w4", 512.0 * 4, [&]() { draw_line_thick(px, w, w, h, 100, 100, 462, 462, opaque, 4); });
+
+    Run("triangle_filled 256", 256.0 * 256 / 2, [&]() { draw_triangle_filled(px, w, w, h, 100, 100, 356, 100, 100, 356, translucent); });
+    Run("triangle outline 256", 256.0 * 3.4, [&]() { draw_triangle(px, w, w, h, 100, 100, 356, 100, 100, 356, opaque); });
+
+    // 雷达轮廓：64 个顶点，半径起伏
+    std::vector<float> radar(128);
+    std::vector<int> radarInt(128);
+    for (int i = 0; i < 64; i++)
+    {
+        float a = i * 6.2831853f / 64, r = 128.0f * (0.6f + 0.1f * (i * 7 % 5));
+        radar[i * 2] = 300.0f + r * std::cos(a);
+        radar[i * 2 + 1] = 300.0f + r * std::sin(a);
+        radarInt[i * 2] = (int)radar[i * 2];
+        radarInt[i * 2 + 1] = (int)radar[i * 2 + 1];
+    }
+    int radarSize = 64;
+    Run("polygon_filled 64-gon r128", 3.14159 * 100 * 100, [&]() { draw_polygon_filled(px, w, w, h, radarInt.data(), 64, translucent); });
+    Run("path_filled 64-gon r128", 3.14159 * 100 * 100, [&]() { draw_path_filled(px, w, w, h, radar.data(), &radarSize, 1, translucent); });
+    Run("path_filled_aa 64-gon r128", 3.14159 * 100 * 100, [&]() { draw_path_filled_aa(px, w, w, h, radar.data(), &radarSize, 1, translucent); });
+    Run("bezier_cubic adaptive", 0, [&]() { draw_bezier_cubic(px, w, w, h, 100, 400, 200, 100, 400, 700, 500, 400, opaque); });
+}
+
+// ==================== 文字 ====================
+
+void BenchTextCase(const char *name, const std::string &text, int size)
+{
+    uint32_t *px = g_pixels.data();
+    const int w = g_config.width;
+    const int h = g_config.height;
+
+    My_Vector2 extent = Text::CalcTextSize(text, size);
+    Run(name, (double)extent.x * extent.y, [&]() { Text::RenderText(px, w, w, h, 50, 200, text, size, rgba(255, 255, 255, 255)); });
+}
+
+void BenchTextSdfCase(const char *name, const std::string &text, float size, const Text::SdfEffect &effect)
+{
+    uint32_t *px = g_pixels.data();
+    const int w = g_config.width;
+    const int h = g_config.height;
+
+    My_Vector2 extent = Text::CalcTextSizeSdf(text, size);
+    Run(name, (double)extent.x * extent.y, [&]() { Text::RenderTextSdf(px, w, w, h, 50.0f, 200.0f, text, size, rgba(255, 255, 255, 255), effect); });
+}
+
+void BenchText()
+{
+    const std::string latin = "The quick brown fox jumps over 13 lazy dogs";
+    const std::string cjk = "功能控制面板 方框显示 射线连接 名字显示";
+
+    BenchTextCase("text latin 16px", latin, 16);
+    BenchTextCase("text latin 32px", latin, 32);
+    BenchTextCase("text latin 64px", latin, 64);
+    BenchTextCase("text cjk 24px", cjk, 24);
+    BenchTextCase("text cjk 48px", cjk, 48);
+
+    // SDF：所有字号共用一份字形
+    Text::SdfEffect effect;
+    effect.outlineWidth = 2.0f;
+    effect.outlineColor = rgba(0, 0, 0, 255);
+    effect.shadowX = effect.shadowY = 3.0f;
+    effect.shadowSoftness = 2.0f;
+    effect.shadowColor = rgba(0, 0, 0, 128);
+
+    BenchTextSdfCase("text sdf cjk 24px", cjk, 24.0f, Text::SdfEffect());
+    BenchTextSdfCase("text sdf cjk 47.5px", cjk, 47.5f, Text::SdfEffect());
+    BenchTextSdfCase("text sdf cjk 32px outline+shadow", cjk, 32.0f, effect);
+
+    Run("calc_text_size cjk 24px", 0, [&]() { Text::CalcTextSize(cjk, 24); });
+
+    std::string paragraph;
+    for (int i = 0; i < 8; i++) paragraph += latin + " " + cjk + " ";
+    Run("wrap_text paragraph 20px", 0, [&]() { Text::WrapText(paragraph, 20, 400); });
+}
+
+// ==================== 整帧场景 ====================
+
+// 与 main.cpp 的 DrawDemoContent + DrawESPDemo 相同的内容
+void DrawDemoScene(DrawList &dl, int width, int height)
+{
+    dl.AddRect(50, 50, 250, 250, rgba(0, 255, 0, 255));
+    dl.AddLine(0, 0, width - 1, height - 1, rgba(255, 255, 0, 255));
+    dl.AddRectFilled(300, 50, 400, 150, rgba(0, 0, 255, 128));
+    dl.AddCircle(600, 200, 50, rgba(255, 0, 255, 255));
+    dl.AddLineF(100.5f, 300.5f, 500.5f, 350.5f, rgba(0, 255, 255, 255));
+
+    My_Vector2 textSize = dl.CalcTextSize("Hello CPU Render!", 32);
+    dl.AddText((int)(width / 2 - textSize.x / 2), height - 100, "Hello CPU Render!", 32, rgba(255, 255, 255, 255));
+    dl.AddRectRoundedFilled(650, 50, 800, 150, 10, rgba(255, 128, 0, 200));
+    dl.AddGradientLinear(50, 300, 250, 400, rgba(255, 0, 0, 200), rgba(0, 0, 255, 200));
+
+    int centerX = width / 2;
+    int centerY = height / 2;
+    int boxW = 100;
+    int boxH = 180;
+    dl.AddRect(centerX - boxW / 2, centerY - boxH / 2, centerX + boxW / 2, centerY + boxH / 2, rgba(0, 255, 0, 255));
+    Text::SdfEffect labelEffect;
+    labelEffect.outlineWidth = 1.5f;
+    labelEffect.outlineColor = rgba(0, 0, 0, 200);
+    dl.AddTextSdf(centerX - 30, centerY - boxH / 2 - 25, "蔡徐坤", 24.0f, rgba(255, 255, 255, 255), &labelEffect);
+    dl.AddTextSdf(centerX - 20, centerY + boxH / 2 + 5, "120m", 20.0f, rgba(255, 255, 0, 255), &labelEffect);
+    dl.AddRectFilled(centerX - boxW / 2, centerY + boxH / 2 + 25, centerX + boxW / 2, centerY + boxH / 2 + 31, rgba(60, 60, 60, 200));
+    dl.AddRectFilled(centerX - boxW / 2, centerY + boxH / 2 + 25, centerX - boxW / 2 + boxW * 3 / 4, centerY + boxH / 2 + 31, rgba(0, 255, 0, 220));
+}
+
+// 多实体 ESP：大量小方框、射线和文字
+void DrawCrowdScene(DrawList &dl, int width, int height, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        int x = 60 + (i * 157) % (width - 200);
+        int y = 60 + (i * 89) % (height - 300);
+        uint32_t color = rgba(64 + (i * 37) % 192, 255, 64, 255);
+        dl.AddRect(x, y, x + 60, y + 120, color);
+        dl.AddLine(width / 2, height, x + 30, y + 120, rgba(255, 255, 0, 160));
+        dl.AddText(x, y - 22, "敌人", 18, rgba(255, 255, 255, 255));
+        dl.AddRectFilled(x, y + 124, x + 60, y + 128, rgba(60, 60, 60, 200));
+        dl.AddRectFilled(x, y + 124, x + 20 + i % 40, y + 128, rgba(0, 255, 0, 220));
+    }
+}
+
+// 同样的多实体 ESP，通过 EntityBatch 一次提交
+void DrawCrowdBatchScene(DrawList &dl, int width, int height, int count)
+{
+    static EntityBatch batch;
+    batch.Clear();
+    batch.Reserve(count);
+    int name = batch.AddLabel("敌人");
+    for (int i = 0; i < count; i++)
+    {
+        int x = 60 + (i * 157) % (width - 200);
+        int y = 60 + (i * 89) % (height - 300);
+        uint32_t color = rgba(64 + (i * 37) % 192, 255, 64, 255);
+        batch.Add(x, y, x + 60, y + 120, color, (i % 41) / 40.0f, name);
+    }
+
+    EntityStyle style;
+    style.flags = ENTITY_BOX | ENTITY_TRACER | ENTITY_NAME | ENTITY_HEALTH;
+    style.tracerX = width / 2;
+    style.tracerY = height;
+    style.tracerColor = rgba(255, 255, 0, 160);
+    style.nameSize = 18;
+    style.healthHeight = 5;
+    dl.AddEntityBatch(batch, style);
+}
+
+UI::FloatingMenu *CreateMenu(bool cached)
+{
+    UI::FloatingMenu *menu = new UI::FloatingMenu(50, 50, 500, 800);
+    menu->SetTitle("功能控制面板");
+    menu->SetAnimationEnabled(false);
+    menu->SetCacheEnabled(cached);
+
+    UI::FloatingMenu::Style style;
+    style.backgroundColor = rgba(244, 247, 250, 250);
+    style.titleBarColor = rgba(217, 230, 242, 255);
+    style.borderColor = rgba(179, 198, 217, 204);
+    style.textColor = rgba(38, 51, 71, 255);
+    style.titleBarHeight = 70;
+    style.padding = 28;
+    style.itemSpacing = 16;
+    style.cornerRadius = 15;
+    style.showShadow = true;
+    menu->SetStyle(style);
+
+    menu->AddLabel("ESP功能");
+    menu->AddCheckbox("方框显示", true);
+    menu->AddCheckbox("射线连接", false);
+    menu->AddCheckbox("名字显示", true);
+    menu->AddCheckbox("距离显示", true);
+    menu->AddSeparator();
+    menu->AddSlider("字体大小", 12, 48, 24);
+    menu->AddButton("FPS: 60");
+    menu->AddButton("FPS: 120");
+    menu->UpdateLayout();
+    return menu;
+}
+
+void BenchScene(const char *name, const std::function<void(DrawList &, int, int)> &scene, bool antiAliasing)
+{
+    uint32_t *px = g_pixels.data();
+    const int w = g_config.width;
+    const int h = g_config.height;
+    const double frame = (double)w * h;
+
+    std::string label = std::string(name) + (antiAliasing ? " aa" : "");
+
+    Run((label + " immediate").c_str(), frame, [&]() {
+        DrawList dl(px, w, w, h);
+        dl.SetAntiAliasing(antiAliasing);
+        scene(dl, w, h);
+    });
+
+    CommandBuffer commands;
+    Run((label + " record").c_str(), 0, [&]() {
+        commands.Reset();
+        DrawList recorder(&commands, w, h);
+        recorder.SetAntiAliasing(antiAliasing);
+        scene(recorder, w, h);
+    });
+
+    // 回放前重新录制（Render 会剔除/合并命令）
+    Run((label + " record+flush").c_str(), frame, [&]() {
+        commands.Reset();
+        DrawList recorder(&commands, w, h);
+        recorder.SetAntiAliasing(antiAliasing);
+        scene(recorder, w, h);
+        commands.Flush(px, w, w, h);
+    });
+
+    static TileRenderer *tiles = nullptr;
+    if (!tiles) tiles = new TileRenderer(g_config.threads);
+    Run((label + " record+tiled").c_str(), frame, [&]() {
+        commands.Reset();
+        DrawList recorder(&commands, w, h);
+        recorder.SetAntiAliasing(antiAliasing);
+        scene(recorder, w, h);
+        tiles->Render(commands, px, w, w, h);
+    });
+}
+
+void BenchScenes()
+{
+    BenchScene("frame demo", DrawDemoScene, false);
+    BenchScene("frame demo", DrawDemoScene, true);
+    BenchScene("frame crowd", [](DrawList &dl, int w, int h) { DrawCrowdScene(dl, w, h, 64); }, true);
+    BenchScene("frame crowd batched", [](DrawList &dl, int w, int h) { DrawCrowdBatchScene(dl, w, h, 64); }, true);
+    BenchScene("frame crowd 512", [](DrawList &dl, int w, int h) { DrawCrowdScene(dl, w, h, 512); }, true);
+    BenchScene("frame crowd 512 batched", [](DrawList &dl, int w, int h) { DrawCrowdBatchScene(dl, w, h, 512); }, true);
+    BenchScene("frame crowd translated", [](DrawList &dl, int w, int h) {
+        dl.PushTransform(12.0f, -8.0f);
+        DrawCrowdScene(dl, w, h, 64);
+        dl.PopTransform();
+    }, true);
+    BenchScene("frame crowd rotated", [](DrawList &dl, int w, int h) {
+        dl.PushTransform(w * 0.5f, h * 0.5f, 0.9f, 0.1f);
+        dl.PushTransform(-w * 0.5f, -h * 0.5f);
+        DrawCrowdScene(dl, w, h, 64);
+        dl.PopTransform();
+        dl.PopTransform();
+    }, true);
+
+    UI::FloatingMenu *direct = CreateMenu(false);
+    UI::FloatingMenu *cached = CreateMenu(true);
+    BenchScene("frame menu direct", [&](DrawList &dl, int, int) { direct->Draw(dl); }, true);
+    BenchScene("frame menu cached", [&](DrawList &dl, int, int) { cached->Draw(dl); }, true);
+    delete direct;
+    delete cached;
+
+    // 性能面板本身的开销（数据为之前各项留下的历史帧）
+    UI::ProfilerHud hud(20, 20);
+    BenchScene("frame profiler hud", [&](DrawList &dl, int, int) { hud.Draw(dl); }, false);
+}
+
+bool ParseArgs(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (strcmp(arg, "--filter") == 0 && value)
+        {
+            g_config.filter = value;
+            i++;
+        }
+        else if (strcmp(arg, "--time") == 0 && value)
+        {
+            g_config.timeMs = atoi(value);
+            i++;
+        }
+        else if (strcmp(arg, "--size") == 0 && value && sscanf(value, "%dx%d", &g_config.width, &g_config.height) == 2)
+        {
+            i++;
+        }
+        else if (strcmp(arg, "--threads") == 0 && value)
+        {
+            g_config.threads = atoi(value);
+            i++;
+        }
+        else if (strcmp(arg, "--profile") == 0)
+        {
+            g_config.profile = true;
+        }
+        else
+        {
+            printf("用法: %s [--filter 子串] [--time 毫秒] [--size 宽x高] [--threads 线程数] [--profile]\n", argv[0]);
+            return false;
+        }
+    }
+
+    if (g_config.width < 1024 || g_config.height < 768 || g_config.timeMs <= 0)
+    {
+        printf("画布至少 1024x768，时间需大于 0\n");
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (!ParseArgs(argc, argv))
+    {
+        return 1;
+    }
+
+    if (!Text::InitFont())
+    {
+        printf("字体初始化失败\n");
+        return 1;
+    }
+
+    g_pixels.assign((size_t)g_config.width * g_config.height, 0);
+    Core::Profiler::Instance().SetEnabled(g_config.profile);
+    printf("cpudraw_bench %dx%d, %d ms/case\n\n", g_config.width, g_config.height, g_config.timeMs);
+
+    BenchPrimitives();
+    BenchText();
+    BenchScenes();
+
+    Text::ShutdownFont();
+    return 0;
+}
@@ -0,0 +1,665 @@
+/*
+ * CPU-Draw - Regression Test
+ * Created: 2026-10-15
+ * By: MaySnowL
+ *
+ * 主机回归测试
+ * 把演示场景画进离屏缓冲，与基准图逐像素比较，并与计时基线比较
+ *
+ * 特性：
+ * - 场景与 main.cpp 一致：演示内容、ESP、主菜单、迷你菜单、整帧（含 / 不含抗锯齿）
+ * - 每个场景分别走立即模式和录制+分块回放，两条路径都要与基准图一致（容差内）
+ * - 基准图为 PAM（RGBA 原始字节），不一致时在 --dir 下写出 .actual.pam 与 .diff.pam
+ * - 计时取多次运行的中位数，比基线慢超过阈值即失败
+ * - 计时超过阈值时重测，取几轮中最快的中位数，减少机器抖动造成的误报
+ * - 没有基准时记录当前结果并通过，--update 覆盖已有基准
+ * - --require-golden 时缺少基准即失败（ctest 使用），需先用 --update 记录
+ * - 统计全局 operator new：ESP 批量录制（帧内 arena 每帧 Reset）稳定后每帧必须零分配
+ * - 参数：--golden-dir <目录> --dir <目录> --update --require-golden --filter <子串> --tolerance <通道差>
+ *         --max-diff <比例> --perf-threshold <比例> --runs <次数> --threads <线程数> --no-golden --no-perf
+ *
+ * 基准图随仓库提交（tests/golden，使用仓库内的字体），CMake 缓存变量 CPUDRAW_GOLDEN_DIR 指定
+ * 计时基线与机器有关，不进仓库，和比较失败的输出一起放在 CPUDRAW_REGRESS_DIR（默认构建目录）
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "core/FrameArena.h"
+#include "graphics/DrawList.h"
+#include "graphics/EntityBatch.h"
+#include "graphics/Gradient.h"
+#include "graphics/TileRenderer.h"
+#include "text/TextRenderer.h"
+#include "ui/FloatingMenu.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <new>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+using namespace Graphics;
+
+// ==================== 分配计数 ====================
+
+// 替换全局 operator new / delete，只计数，分配仍走 malloc
+static size_t g_allocations = 0;
+
+void *operator new(size_t size)
+{
+    g_allocations++;
+    if (void *p = malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+namespace
+{
+
+struct RegressConfig
+{
+    std::string goldenDir = "golden"; // 基准图
+    std::string dir = "regress";       // 计时基线与比较失败的输出
+    std::string filter;
+    bool update = false;
+    bool requireGolden = false;     // 缺少基准时失败而不是记录
+    bool golden = true;
+    bool perf = true;
+    int tolerance = 2;              // 单通道允许的差值
+    double maxDiff = 0.0005;        // 超出容差的像素占比上限
+    double perfThreshold = 0.25;    // 中位数比基线慢的比例上限
+    int64_t perfSlackNs = 20000;    // 绝对余量，避免很快的场景因抖动失败
+    int runs = 21;
+    int perfRetries = 2;            // 超过阈值时最多重测的轮数
+    int threads = 0;
+    int width = 1080;
+    int height = 960;
+};
+
+RegressConfig g_config;
+int g_failures = 0;
+
+// ==================== 场景（与 main.cpp 保持一致） ====================
+
+void DrawDemoContent(DrawList &dl, int width, int height)
+{
+    dl.AddRect(50, 50, 250, 250, rgba(0, 255, 0, 255));
+    dl.AddLine(0, 0, width - 1, height - 1, rgba(255, 255, 0, 255));
+    dl.AddRectFilled(300, 50, 400, 150, rgba(0, 0, 255, 128));
+    dl.AddCircle(600, 200, 50, rgba(255, 0, 255, 255));
+    dl.AddLineF(100.5f, 300.5f, 500.5f, 350.5f, rgba(0, 255, 255, 255));
+
+    My_Vector2 textSize = dl.CalcTextSize("Hello CPU Render!", 32);
+    dl.AddText((int)(width / 2 - textSize.x / 2), height - 100, "Hello CPU Render!", 32, rgba(255, 255, 255, 255));
+    dl.AddRectRoundedFilled(650, 50, 800, 150, 10, rgba(255, 128, 0, 200));
+    dl.AddGradientLinear(50, 300, 250, 400, rgba(255, 0, 0, 200), rgba(0, 0, 255, 200));
+
+    static const Gradient rainbow = Gradient().AddStop(0.0f, rgba(255, 0, 0, 255)).AddStop(0.5f, rgba(0, 255, 0, 255)).AddStop(1.0f, rgba(0, 0, 255, 255));
+    dl.AddGradientLinear(50, 420, 250, 440, rainbow, true);
+}
+
+void DrawESPDemo(DrawList &dl, int width, int height)
+{
+    int centerX = width / 2;
+    int centerY = height / 2;
+    int boxW = 100;
+    int boxH = 180;
+
+    static EntityBatch batch;
+    batch.Clear();
+    int name = batch.AddLabel("蔡徐坤");
+    int distance = batch.AddLabel("120m");
+    batch.Add(centerX - boxW / 2, centerY - boxH / 2, centerX + boxW / 2, centerY + boxH / 2, rgba(0, 255, 0, 255), 0.75f, name, distance);
+
+    EntityStyle style;
+    style.flags = ENTITY_BOX | ENTITY_NAME | ENTITY_INFO | ENTITY_HEALTH;
+    style.tracerX = width / 2;
+    style.tracerY = height;
+    style.tracerColor = rgba(255, 255, 0, 255);
+    style.nameSize = 24;
+    style.nameColor = rgba(255, 255, 255, 255);
+    style.infoSize = 20;
+
+    dl.AddEntityBatch(batch, style);
+}
+
+UI::FloatingMenu *CreateMainMenu()
+{
+    UI::FloatingMenu *menu = new UI::FloatingMenu(50, 50, 500, 800);
+    menu->SetTitle("功能控制面板");
+    menu->SetAnimationEnabled(false);
+
+    UI::FloatingMenu::Style style;
+    style.backgroundColor = rgba(244, 247, 250, 250);
+    style.titleBarColor = rgba(217, 230, 242, 255);
+    style.borderColor = rgba(179, 198, 217, 204);
+    style.textColor = rgba(38, 51, 71, 255);
+    style.titleBarHeight = 70;
+    style.padding = 28;
+    style.itemSpacing = 16;
+    style.cornerRadius = 15;
+    style.showShadow = true;
+    menu->SetStyle(style);
+
+    UI::Label *headerLabel = menu->AddLabel("控制面板");
+    headerLabel->SetTextColor(rgba(64, 169, 140, 255));
+    headerLabel->SetFontSize(32);
+    headerLabel->SetAlignment(TextAlign::Center);
+    menu->AddSeparator();
+
+    UI::Label *espSection = menu->AddLabel("ESP功能");
+    espSection->SetTextColor(rgba(38, 128, 217, 255));
+    espSection->SetFontSize(24);
+    menu->AddCheckbox("方框显示", false)->SetChecked(true);
+    menu->AddCheckbox("射线连接", false)->SetChecked(false);
+    menu->AddCheckbox("名字显示", false)->SetChecked(true);
+    menu->AddCheckbox("距离显示", false)->SetChecked(true);
+    menu->AddCheckbox("血量显示", false)->SetChecked(true);
+    menu->AddSeparator();
+
+    UI::Label *displaySection = menu->AddLabel("显示设置");
+    displaySection->SetTextColor(rgba(138, 89, 217, 255));
+    displaySection->SetFontSize(24);
+    menu->AddCheckbox("显示演示", false)->SetChecked(true);
+    menu->AddCheckbox("性能面板", false)->SetChecked(false);
+    menu->AddSeparator();
+
+    UI::Label *fpsSection = menu->AddLabel("帧率控制");
+    fpsSection->SetTextColor(rgba(217, 140, 89, 255));
+    fpsSection->SetFontSize(24);
+    menu->AddButton("FPS: 60");
+    menu->AddButton("FPS: 120");
+    menu->AddCheckbox("自适应画质", false)->SetChecked(true);
+    menu->AddSeparator();
+
+    UI::Button *miniBtn = menu->AddButton("收缩到迷你窗");
+    miniBtn->SetColors(rgba(191, 64, 89, 230), rgba(217, 89, 112, 230), rgba(166, 39, 64, 230));
+    miniBtn->SetTextColor(rgba(255, 255, 255, 255));
+
+    menu->UpdateLayout();
+    return menu;
+}
+
+UI::FloatingMenu *CreateMiniMenu()
+{
+    UI::FloatingMenu *menu = new UI::FloatingMenu(50, 50, 180, 140);
+    menu->SetTitle("迷你");
+
+    UI::FloatingMenu::Style style;
+    style.backgroundColor = rgba(230, 230, 235, 230);
+    style.titleBarColor = rgba(204, 204, 214, 255);
+    style.textColor = rgba(26, 26, 38, 255);
+    style.titleBarHeight = 45;
+    style.padding = 12;
+    style.itemSpacing = 10;
+    style.cornerRadius = 10;
+    menu->SetStyle(style);
+
+    UI::Button *expandBtn = menu->AddButton("展开主菜单");
+    expandBtn->SetColors(rgba(38, 128, 217, 220), rgba(58, 148, 237, 220), rgba(18, 108, 197, 220));
+    expandBtn->SetTextColor(rgba(255, 255, 255, 255));
+    expandBtn->SetFontSize(20);
+
+    UI::Label *fpsLabel = menu->AddLabel("FPS: --");
+    fpsLabel->SetTextColor(rgba(100, 100, 100, 255));
+    fpsLabel->SetFontSize(18);
+    return menu;
+}
+
+struct Scene
+{
+    const char *name;
+    std::function<void(DrawList &, int, int)> draw;
+};
+
+// ==================== 基准图 ====================
+
+// 逐级创建目录（已存在的忽略）
+void MakeDirs(const std::string &path)
+{
+    for (size_t pos = path.find('/', 1); pos != std::string::npos; pos = path.find('/', pos + 1))
+    {
+        mkdir(path.substr(0, pos).c_str(), 0755);
+    }
+    mkdir(path.c_str(), 0755);
+}
+
+// PAM：RGBA 原始字节（像素在内存中即为 R, G, B, A）
+bool WritePam(const std::string &path, const std::vector<uint32_t> &pixels, int width, int height)
+{
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+    fprintf(file, "P7\nWIDTH %d\nHEIGHT %d\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n", width, height);
+    bool ok = fwrite(pixels.data(), sizeof(uint32_t), pixels.size(), file) == pixels.size();
+    return fclose(file) == 0 && ok;
+}
+
+bool ReadPam(const std::string &path, std::vector<uint32_t> &pixels, int &width, int &height)
+{
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    int depth = 0, maxval = 0;
+    bool ok = fscanf(file, "P7 WIDTH %d HEIGHT %d DEPTH %d MAXVAL %d TUPLTYPE RGB_ALPHA ENDHDR", &width, &height, &depth, &maxval) == 4 && fgetc(file) == '\n';
+    ok = ok && width > 0 && height > 0 && depth == 4 && maxval == 255;
+    if (ok)
+    {
+        pixels.resize((size_t)width * height);
+        ok = fread(pixels.data(), sizeof(uint32_t), pixels.size(), file) == pixels.size();
+    }
+    fclose(file);
+    return ok;
+}
+
+// 超出容差的像素数，diff 中超差像素标红，其余为变暗的基准图
+int ComparePixels(const std::vector<uint32_t> &actual, const std::vector<uint32_t> &expected, std::vector<uint32_t> *diff, int &maxDelta)
+{
+    int bad = 0;
+    maxDelta = 0;
+    if (diff) diff->resize(actual.size());
+
+    for (size_t i = 0; i < actual.size(); i++)
+    {
+        int delta = 0;
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            delta = std::max(delta, std::abs((int)((actual[i] >> shift) & 0xFF) - (int)((expected[i] >> shift) & 0xFF)));
+        }
+        maxDelta = std::max(maxDelta, delta);
+
+        bool over = delta > g_config.tolerance;
+        if (over) bad++;
+        if (diff)
+        {
+            uint32_t e = expected[i];
+            int gray = (get_red(e) + get_green(e) + get_blue(e)) / 12;
+            (*diff)[i] = over ? rgba(255, 0, 0, 255) : rgba(gray, gray, gray, 255);
+        }
+    }
+    return bad;
+}
+
+// 一条渲染路径的结果与基准图比较；没有基准或 --update 时写入基准（--require-golden 时没有基准即失败）
+void CheckGolden(const char *scene, const char *path, const std::vector<uint32_t> &pixels)
+{
+    const int w = g_config.width;
+    const int h = g_config.height;
+    std::string base = g_config.dir + "/" + scene;
+    std::string goldenPath = g_config.goldenDir + "/" + scene + ".pam";
+
+    std::vector<uint32_t> expected;
+    int gw = 0, gh = 0;
+    bool have = !g_config.update && ReadPam(goldenPath, expected, gw, gh);
+    if (!have && !g_config.update && g_config.requireGolden)
+    {
+        printf("  %-26s %-9s FAIL no golden %s (record with --update)\n", scene, path, goldenPath.c_str());
+        g_failures++;
+        return;
+    }
+    if (!have)
+    {
+        // 同一场景的两条路径只记录一次（先跑的立即模式），后一条与之比较
+        if (WritePam(goldenPath, pixels, w, h))
+        {
+            printf("  %-26s %-9s recorded %s\n", scene, path, goldenPath.c_str());
+        }
+        else
+        {
+            printf("  %-26s %-9s FAIL cannot write %s\n", scene, path, goldenPath.c_str());
+            g_failures++;
+        }
+        return;
+    }
+
+    if (gw != w || gh != h)
+    {
+        printf("  %-26s %-9s FAIL golden is %dx%d, canvas is %dx%d\n", scene, path, gw, gh, w, h);
+        g_failures++;
+        return;
+    }
+
+    std::vector<uint32_t> diff;
+    int maxDelta = 0;
+    int bad = ComparePixels(pixels, expected, &diff, maxDelta);
+    double ratio = (double)bad / pixels.size();
+    if (ratio > g_config.maxDiff)
+    {
+        std::string suffix = std::string(".") + path;
+        WritePam(base + suffix + ".actual.pam", pixels, w, h);
+        WritePam(base + suffix + ".diff.pam", diff, w, h);
+        printf("  %-26s %-9s FAIL %d pixels differ (%.3f%%), max delta %d -> %s%s.diff.pam\n", scene, path, bad, ratio * 100, maxDelta, base.c_str(), suffix.c_str());
+        g_failures++;
+        return;
+    }
+    printf("  %-26s %-9s ok   %d pixels within tolerance, max delta %d\n", scene, path, bad, maxDelta);
+}
+
+// ==================== 计时基线 ====================
+
+std::map<std::string, int64_t> LoadTimings(const std::string &path)
+{
+    std::map<std::string, int64_t> timings;
+    FILE *file = fopen(path.c_str(), "r");
+    if (!file) return timings;
+
+    char name[256];
+    long long ns;
+    while (fscanf(file, "%255s %lld", name, &ns) == 2)
+    {
+        timings[name] = ns;
+    }
+    fclose(file);
+    return timings;
+}
+
+bool SaveTimings(const std::string &path, const std::map<std::string, int64_t> &timings)
+{
+    FILE *file = fopen(path.c_str(), "w");
+    if (!file) return false;
+    for (const auto &entry : timings)
+    {
+        fprintf(file, "%s %lld\n", entry.first.c_str(), (long long)entry.second);
+    }
+    return fclose(file) == 0;
+}
+
+// 预热后跑 runs 次，取中位数（纳秒）
+int64_t MeasureMedian(const std::function<void()> &op)
+{
+    typedef std::chrono::steady_clock Clock;
+    for (int i = 0; i < 3; i++)
+    {
+        op();
+    }
+
+    std::vector<int64_t> samples(g_config.runs);
+    for (int64_t &sample : samples)
+    {
+        Clock::time_point start = Clock::now();
+        op();
+        sample = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    }
+    std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+    return samples[samples.size() / 2];
+}
+
+void CheckTiming(std::map<std::string, int64_t> &timings, bool &dirty, const std::string &key, const std::function<void()> &op)
+{
+    auto it = timings.find(key);
+    if (it == timings.end() && !g_config.update && g_config.requireGolden)
+    {
+        printf("  %-36s FAIL no baseline (record with --update)\n", key.c_str());
+        g_failures++;
+        return;
+    }
+
+    int64_t median = MeasureMedian(op);
+    if (it == timings.end() || g_config.update)
+    {
+        timings[key] = median;
+        dirty = true;
+        printf("  %-36s %10.1f us  recorded\n", key.c_str(), median / 1000.0);
+        return;
+    }
+
+    int64_t baseline = it->second;
+    int64_t limit = (int64_t)(baseline * (1.0 + g_config.perfThreshold)) + g_config.perfSlackNs;
+
+    // 偶发的调度抖动会让整轮变慢：超过阈值时重测，取最快的一轮
+    for (int retry = 0; retry < g_config.perfRetries && median > limit; retry++)
+    {
+        median = std::min(median, MeasureMedian(op));
+    }
+
+    double change = baseline > 0 ? (double)median / baseline - 1.0 : 0.0;
+    bool slow = median > limit;
+    printf("  %-36s %10.1f us  baseline %10.1f us  %+6.1f%%  %s\n", key.c_str(), median / 1000.0, baseline / 1000.0, change * 100, slow ? "FAIL" : "ok");
+    if (slow) g_failures++;
+}
+
+// ==================== 运行 ====================
+
+void RunScenes(const std::vector<Scene> &scenes)
+{
+    const int w = g_config.width;
+    const int h = g_config.height;
+    std::vector<uint32_t> pixels((size_t)w * h);
+    CommandBuffer commands;
+    TileRenderer tiles(g_config.threads);
+
+    // 两条渲染路径：立即模式 / 录制 + 分块回放（与 RenderThread 相同）
+    auto immediate = [&](const Scene &scene) {
+        std::fill(pixels.begin(), pixels.end(), 0);
+        DrawList dl(pixels.data(), w, w, h);
+        scene.draw(dl, w, h);
+    };
+    auto tiled = [&](const Scene &scene) {
+        std::fill(pixels.begin(), pixels.end(), 0);
+        commands.Reset();
+        DrawList recorder(&commands, w, h);
+        scene.draw(recorder, w, h);
+        tiles.Render(commands, pixels.data(), w, w, h);
+    };
+
+    if (g_config.golden)
+    {
+        printf("golden images (%s, tolerance %d, max %.3f%%)\n", g_config.goldenDir.c_str(), g_config.tolerance, g_config.maxDiff * 100);
+        for (const Scene &scene : scenes)
+        {
+            if (!g_config.filter.empty() && strstr(scene.name, g_config.filter.c_str()) == nullptr) continue;
+
+            immediate(scene);
+            CheckGolden(scene.name, "immediate", pixels);
+            // 基准图由立即模式写入后，分块回放始终与之比较
+            bool update = g_config.update;
+            g_config.update = false;
+            tiled(scene);
+            CheckGolden(scene.name, "tiled", pixels);
+            g_config.update = update;
+        }
+        printf("\n");
+    }
+
+    if (g_config.perf)
+    {
+        std::string path = g_config.dir + "/timings.txt";
+        std::map<std::string, int64_t> timings = LoadTimings(path);
+        bool dirty = false;
+
+        printf("timings (median of %d, threshold +%.0f%%)\n", g_config.runs, g_config.perfThreshold * 100);
+        for (const Scene &scene : scenes)
+        {
+            if (!g_config.filter.empty() && strstr(scene.name, g_config.filter.c_str()) == nullptr) continue;
+
+            CheckTiming(timings, dirty, std::string(scene.name) + "/immediate", [&]() { immediate(scene); });
+            CheckTiming(timings, dirty, std::string(scene.name) + "/tiled", [&]() { tiled(scene); });
+        }
+        if (dirty && !SaveTimings(path, timings))
+        {
+            printf("  FAIL cannot write %s\n", path.c_str());
+            g_failures++;
+        }
+        printf("\n");
+    }
+}
+
+// 与 DrawESPDemo 的每帧流程相同：arena 与命令缓冲每帧重置，录制一次 AddEntityBatch
+void CheckAllocations()
+{
+    if (!g_config.filter.empty() && strstr("esp", g_config.filter.c_str()) == nullptr) return;
+
+    const int w = g_config.width;
+    const int h = g_config.height;
+    const int warmup = 4;
+    const int frames = 16;
+    CommandBuffer commands;
+    Core::FrameArena arena;
+
+    auto frame = [&]() {
+        arena.Reset();
+        commands.Reset();
+        DrawList recorder(&commands, w, h, &arena);
+        recorder.SetAntiAliasing(true);
+        DrawESPDemo(recorder, w, h);
+    };
+
+    printf("allocations (esp, %d frames after %d warm-up)\n", frames, warmup);
+    for (int i = 0; i < warmup; i++) frame();
+    size_t before = g_allocations;
+    for (int i = 0; i < frames; i++) frame();
+    size_t count = g_allocations - before;
+
+    if (count > 0)
+    {
+        printf("  %-26s %-9s FAIL %zu allocation(s) in %d frames\n", "esp", "record", count, frames);
+        g_failures++;
+    }
+    else
+    {
+        printf("  %-26s %-9s ok   0 allocations\n", "esp", "record");
+    }
+    printf("\n");
+}
+
+bool ParseArgs(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (strcmp(arg, "--golden-dir") == 0 && value)
+        {
+            g_config.goldenDir = value;
+            i++;
+        }
+        else if (strcmp(arg, "--dir") == 0 && value)
+        {
+            g_config.dir = value;
+            i++;
+        }
+        else if (strcmp(arg, "--filter") == 0 && value)
+        {
+            g_config.filter = value;
+            i++;
+        }
+        else if (strcmp(arg, "--tolerance") == 0 && value)
+        {
+            g_config.tolerance = atoi(value);
+            i++;
+        }
+        else if (strcmp(arg, "--max-diff") == 0 && value)
+        {
+            g_config.maxDiff = atof(value);
+            i++;
+        }
+        else if (strcmp(arg, "--perf-threshold") == 0 && value)
+        {
+            g_config.perfThreshold = atof(value);
+            i++;
+        }
+        else if (strcmp(arg, "--runs") == 0 && value)
+        {
+            g_config.runs = std::max(1, atoi(value));
+            i++;
+        }
+        else if (strcmp(arg, "--threads") == 0 && value)
+        {
+            g_config.threads = atoi(value);
+            i++;
+        }
+        else if (strcmp(arg, "--update") == 0)
+        {
+            g_config.update = true;
+        }
+        else if (strcmp(arg, "--require-golden") == 0)
+        {
+            g_config.requireGolden = true;
+        }
+        else if (strcmp(arg, "--no-golden") == 0)
+        {
+            g_config.golden = false;
+        }
+        else if (strcmp(arg, "--no-perf") == 0)
+        {
+            g_config.perf = false;
+        }
+        else
+        {
+            printf("用法: %s [--golden-dir 目录] [--dir 目录] [--update] [--require-golden] [--filter 子串] [--tolerance 通道差] [--max-diff 比例] [--perf-threshold 比例] [--runs 次数] [--threads 线程数] [--no-golden] [--no-perf]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (!ParseArgs(argc, argv))
+    {
+        return 1;
+    }
+
+    if (!Text::InitFont())
+    {
+        printf("字体初始化失败\n");
+        return 1;
+    }
+
+    MakeDirs(g_config.dir);
+    if (g_config.update) MakeDirs(g_config.goldenDir);
+    printf("cpudraw_regress %dx%d%s\n\n", g_config.width, g_config.height, g_config.update ? " (update)" : "");
+
+    UI::FloatingMenu *mainMenu = CreateMainMenu();
+    UI::FloatingMenu *miniMenu = CreateMiniMenu();
+
+    std::vector<Scene> scenes = {
+        { "demo", [](DrawList &dl, int w, int h) { dl.SetAntiAliasing(true); DrawDemoContent(dl, w, h); } },
+        { "esp", [](DrawList &dl, int w, int h) { dl.SetAntiAliasing(true); DrawESPDemo(dl, w, h); } },
+        { "menu_main", [&](DrawList &dl, int, int) { dl.SetAntiAliasing(true); mainMenu->Draw(dl); } },
+        { "menu_mini", [&](DrawList &dl, int, int) { dl.SetAntiAliasing(true); miniMenu->Draw(dl); } },
+        // 完整一帧（DrawScene + DrawOverlay），以及自适应画质关闭抗锯齿后的同一帧
+        { "frame", [&](DrawList &dl, int w, int h) {
+             dl.SetAntiAliasing(true);
+             DrawDemoContent(dl, w, h);
+             DrawESPDemo(dl, w, h);
+             mainMenu->Draw(dl);
+         } },
+        { "frame_noaa", [&](DrawList &dl, int w, int h) {
+             DrawDemoContent(dl, w, h);
+             DrawESPDemo(dl, w, h);
+             mainMenu->Draw(dl);
+         } },
+    };
+
+    RunScenes(scenes);
+    CheckAllocations();
+
+    delete mainMenu;
+    delete miniMenu;
+    Text::ShutdownFont();
+
+    if (g_failures > 0)
+    {
+        printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -45,7 +45,8 @@ cmake .. \
     -DANDROID_ABI=arm64-v8a \
     -DANDROID_PLATFORM=android-30 \
     -DCMAKE_BUILD_TYPE=Release \
-    -DANDROID_NDK=$NDK_PATH
+    -DANDROID_NDK=$NDK_PATH \
+    -DNDK_PATH=$NDK_PATH
 
 [ $? -ne 0 ] && print_error "CMake 配置失败" && exit 1
 
@@ -0,0 +1,138 @@
+/*
+ * CPU-Draw - Frame Arena Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 帧内临时内存
+ * 一帧内的临时数组（裁剪 / 变换栈、顶点、触摸快照）从块里顺序切分，帧末整体释放
+ *
+ * 特性：
+ * - 分配只移动指针，单独释放是空操作
+ * - Reset 时把多个块合并成一个，容量稳定后每帧不再向系统申请内存
+ * - ArenaVector：接口与 std::vector 相同，没有绑定 arena 时退回堆分配
+ * - 非线程安全：每个 arena 只在一个线程上使用
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef CORE_FRAMEARENA_H
+#define CORE_FRAMEARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace Core
+{
+
+class FrameArena
+{
+  public:
+    static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit FrameArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~FrameArena();
+
+    // 按 align（2 的幂）对齐分配，size 为 0 时也返回有效指针
+    void *Allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+    template <typename T>
+    T *AllocateArray(size_t count)
+    {
+        return static_cast<T *>(Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // 释放本帧全部分配，之前返回的指针全部失效
+    void Reset();
+
+    // 本帧已分配的字节数 / 峰值 / 当前持有的块容量
+    size_t GetUsed() const
+    {
+        return used;
+    }
+    size_t GetPeak() const
+    {
+        return peak;
+    }
+    size_t GetCapacity() const;
+
+  private:
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    struct Block
+    {
+        uint8_t *memory;
+        size_t size;
+    };
+
+    void *AllocateSlow(size_t size, size_t align);
+
+    std::vector<Block> blocks; // 最后一块为当前块
+    uint8_t *cursor;
+    uint8_t *limit;
+    size_t blockSize;
+    size_t used;
+    size_t peak;
+};
+
+// 绑定 arena 的 STL 分配器，arena 为空时使用堆
+template <typename T>
+class ArenaAllocator
+{
+  public:
+    typedef T value_type;
+    // 容器整体赋值 / 交换时分配器跟着走（用于把成员容器重新绑定到 arena）
+    typedef std::true_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    ArenaAllocator() noexcept : arena(nullptr)
+    {
+    }
+    explicit ArenaAllocator(FrameArena *arena) noexcept : arena(arena)
+    {
+    }
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) noexcept : arena(other.GetArena())
+    {
+    }
+
+    T *allocate(size_t count)
+    {
+        if (arena) return arena->AllocateArray<T>(count);
+        return static_cast<T *>(::operator new(count * sizeof(T)));
+    }
+    void deallocate(T *pointer, size_t) noexcept
+    {
+        if (!arena) ::operator delete(pointer);
+    }
+
+    FrameArena *GetArena() const noexcept
+    {
+        return arena;
+    }
+
+  private:
+    FrameArena *arena;
+};
+
+template <typename T, typename U>
+inline bool operator==(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b)
+{
+    return a.GetArena() == b.GetArena();
+}
+template <typename T, typename U>
+inline bool operator!=(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b)
+{
+    return a.GetArena() != b.GetArena();
+}
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace Core
+
+#endif // CORE_FRAMEARENA_H
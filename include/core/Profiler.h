@@ -0,0 +1,186 @@
+/*
+ * CPU-Draw - Profiler Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 帧性能分析
+ * 分段计时与计数，最近若干帧保存在无锁环形缓冲
+ *
+ * 特性：
+ * - CPUDRAW_PROFILE_SCOPE / CPUDRAW_PROFILE_COUNT 宏，编译期可整体去掉
+ * - 运行时开关，关闭时每个埋点只有一次原子读
+ * - 计时与计数可在任意线程（分块线程）累加
+ * - 百分位统计与 CSV 导出，便于离线分析
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef CORE_PROFILER_H
+#define CORE_PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+// 编译开关：0 时所有埋点为空
+#ifndef CPUDRAW_PROFILER
+#define CPUDRAW_PROFILER 1
+#endif
+
+namespace Core
+{
+
+// 计时分段
+enum class ProfileZone : uint8_t
+{
+    Input,   // 触摸派发
+    Update,  // 动画更新
+    Record,  // 录制绘制命令
+    Lock,    // 锁定窗口缓冲
+    Clear,   // 清空脏矩形
+    Render,  // 光栅化
+    Present, // 解锁并提交
+    Menu,    // 菜单绘制（录制模式下为录制耗时）
+    Text,    // 文字光栅化
+    Count
+};
+
+// 计数项
+enum class ProfileCounter : uint8_t
+{
+    Commands,         // 绘制命令数
+    PixelsCovered,    // 命令范围面积（裁剪后）
+    GlyphsDrawn,      // 绘制的字形数
+    GlyphsRasterized, // 新光栅化进图集的字形数
+    Count
+};
+
+static const int PROFILE_ZONE_COUNT = (int)ProfileZone::Count;
+static const int PROFILE_COUNTER_COUNT = (int)ProfileCounter::Count;
+
+// 单帧统计
+struct FrameStats
+{
+    uint64_t frameIndex;
+    int64_t startNs;                              // 帧开始（单调时钟）
+    uint32_t frameNs;                             // 帧开始到结束
+    uint32_t zoneNs[PROFILE_ZONE_COUNT];          // 各分段累计耗时
+    uint32_t counters[PROFILE_COUNTER_COUNT];     // 各计数项
+};
+
+// 最近帧的统计摘要
+struct ProfileSummary
+{
+    int frames;
+    float fps;                    // 按帧开始时间间隔计算
+    float frameMs[4];             // p50 / p95 / p99 / max
+    float zoneMs[PROFILE_ZONE_COUNT];           // 各分段平均
+    float counters[PROFILE_COUNTER_COUNT];      // 各计数项平均
+};
+
+class Profiler
+{
+  public:
+    static const int HISTORY = 256; // 保存的帧数（2 的幂）
+
+    static Profiler &Instance();
+
+    // 运行时开关
+    static bool IsEnabled()
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+    void SetEnabled(bool enable);
+
+    // 帧边界（渲染线程）
+    void BeginFrame();
+    void EndFrame();
+
+    // 累加（任意线程）
+    void AddTime(ProfileZone zone, int64_t ns)
+    {
+        zoneNs[(int)zone].fetch_add((uint64_t)ns, std::memory_order_relaxed);
+    }
+    void AddCount(ProfileCounter counter, uint64_t value)
+    {
+        counters[(int)counter].fetch_add(value, std::memory_order_relaxed);
+    }
+
+    // 复制最近 max 帧（旧到新），返回实际帧数
+    int CopyFrames(FrameStats *out, int max) const;
+
+    // 最近 frames 帧的摘要
+    ProfileSummary Summarize(int frames = 120) const;
+
+    // 导出最近帧为 CSV
+    void DumpCsv(FILE *file) const;
+    // 摘要输出到日志（Android logcat / 标准输出）
+    void LogSummary(int frames = 120) const;
+
+    static const char *GetZoneName(ProfileZone zone);
+    static const char *GetCounterName(ProfileCounter counter);
+
+    static int64_t NowNs();
+
+  private:
+    Profiler();
+    Profiler(const Profiler &) = delete;
+    Profiler &operator=(const Profiler &) = delete;
+
+    static std::atomic<bool> enabled;
+
+    // 当前帧累加器
+    std::atomic<uint64_t> zoneNs[PROFILE_ZONE_COUNT];
+    std::atomic<uint64_t> counters[PROFILE_COUNTER_COUNT];
+    int64_t frameStartNs;
+    bool inFrame;
+
+    // 环形缓冲：单写者，读者复制后用写序号校验是否被覆盖
+    FrameStats history[HISTORY];
+    std::atomic<uint64_t> written;
+};
+
+// 作用域计时
+class ProfileScope
+{
+  public:
+    explicit ProfileScope(ProfileZone zone) : zone(zone), start(Profiler::IsEnabled() ? Profiler::NowNs() : 0)
+    {
+    }
+    ~ProfileScope()
+    {
+        if (start) Profiler::Instance().AddTime(zone, Profiler::NowNs() - start);
+    }
+
+  private:
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+    ProfileZone zone;
+    int64_t start;
+};
+
+} // namespace Core
+
+#if CPUDRAW_PROFILER
+#define CPUDRAW_PROFILE_CONCAT_(a, b) a##b
+#define CPUDRAW_PROFILE_CONCAT(a, b) CPUDRAW_PROFILE_CONCAT_(a, b)
+#define CPUDRAW_PROFILE_SCOPE(zone) ::Core::ProfileScope CPUDRAW_PROFILE_CONCAT(profileScope_, __LINE__)(::Core::ProfileZone::zone)
+#define CPUDRAW_PROFILE_COUNT(counter, value)                                                              \
+    do                                                                                                     \
+    {                                                                                                      \
+        if (::Core::Profiler::IsEnabled())                                                                 \
+            ::Core::Profiler::Instance().AddCount(::Core::ProfileCounter::counter, (uint64_t)(value));     \
+    } while (0)
+#else
+#define CPUDRAW_PROFILE_SCOPE(zone) \
+    do                              \
+    {                               \
+    } while (0)
+#define CPUDRAW_PROFILE_COUNT(counter, value) \
+    do                                        \
+    {                                         \
+    } while (0)
+#endif
+
+#endif // CORE_PROFILER_H
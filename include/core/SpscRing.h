@@ -0,0 +1,108 @@
+/*
+ * CPU-Draw - SPSC Ring Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 单生产者单消费者无锁环形队列
+ * 用于输入线程向渲染线程投递数据
+ *
+ * 特性：
+ * - 定长、无分配，容量为 2 的幂
+ * - 生产者与消费者各自缓存对方的下标，减少跨核读取
+ * - 两端下标分处不同缓存行，避免伪共享
+ * - 满时 Push 失败，由生产者决定丢弃或稍后重试
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef CORE_SPSCRING_H
+#define CORE_SPSCRING_H
+
+#include <atomic>
+#include <cstddef>
+
+template <typename T, size_t Capacity>
+class SpscRing
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscRing capacity must be a power of two");
+
+  public:
+    SpscRing() : head(0), tailCache(0), tail(0), headCache(0)
+    {
+    }
+
+    // 生产者：写入一项，队列满时返回 false
+    bool Push(const T &value)
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - headCache == Capacity)
+        {
+            headCache = head.load(std::memory_order_acquire);
+            if (t - headCache == Capacity) return false;
+        }
+
+        slots[t & (Capacity - 1)] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者：取出一项，队列空时返回 false
+    bool Pop(T &out)
+    {
+        const T *front = Front();
+        if (!front) return false;
+
+        out = *front;
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者：查看队首，队列空时返回空指针
+    const T *Front()
+    {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tailCache)
+        {
+            tailCache = tail.load(std::memory_order_acquire);
+            if (h == tailCache) return nullptr;
+        }
+        return &slots[h & (Capacity - 1)];
+    }
+
+    // 消费者：丢弃队首（配合 Front 原地读取）
+    void Discard()
+    {
+        if (Front()) head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // 近似数量（两端都可调用）
+    size_t Size() const
+    {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    bool Empty() const
+    {
+        return Size() == 0;
+    }
+
+  private:
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    static const size_t CACHE_LINE = 64;
+
+    // 消费者侧
+    std::atomic<size_t> head;
+    size_t tailCache;
+    char padHead[CACHE_LINE - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+    // 生产者侧
+    std::atomic<size_t> tail;
+    size_t headCache;
+    char padTail[CACHE_LINE - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+    T slots[Capacity];
+};
+
+#endif // CORE_SPSCRING_H
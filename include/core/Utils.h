@@ -6,11 +6,14 @@
 #include <cstring>
 #include <ctime>
 #include <fcntl.h>
-#include <jni.h>
 #include <random>
 #include <string>
-#include <sys/system_properties.h>
 #include <unistd.h>
+#include <vector>
+#ifdef __ANDROID__
+#include <jni.h>
+#include <sys/system_properties.h>
+#endif
 // #include "Log.h"
 
 inline bool isStartWith(const std::string &str, const char *check)
@@ -47,9 +50,13 @@ inline void trimStr(std::string &str)
 
 inline std::string getSystemProperty(const char *name)
 {
+#ifdef __ANDROID__
     char tmp[PROP_VALUE_MAX]{ 0 };
     __system_property_get(name, tmp);
     return tmp;
+#else
+    return {};
+#endif
 }
 
 inline bool getLocalLanguageIsCN()
@@ -236,6 +243,7 @@ inline bool isAlphaNumericString(const char *str)
     return true;
 }
 
+#ifdef __ANDROID__
 inline std::string getJString(JNIEnv *env, jstring jstr)
 {
     if (jstr == nullptr || env == nullptr)
@@ -247,6 +255,7 @@ inline std::string getJString(JNIEnv *env, jstring jstr)
     env->ReleaseStringUTFChars(jstr, cstr);
     return str;
 }
+#endif
 
 inline int getRandomNumber(int minNumber, int maxNumber)
 {
@@ -0,0 +1,110 @@
+/*
+ * CPU-Draw - Affine Transform Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 2x3 仿射矩阵
+ * x' = a * x + c * y + tx
+ * y' = b * x + d * y + ty
+ *
+ * 特性：
+ * - 压栈时一次性合成，逐点变换只剩乘加，不再调用三角函数
+ * - 按形状分类（平移 / 轴对齐缩放 / 一般），绘制时走对应的快速路径
+ * - 批量变换顶点数组
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef GRAPHICS_AFFINE_H
+#define GRAPHICS_AFFINE_H
+
+#include <cmath>
+
+namespace Graphics
+{
+
+// 变换形状
+enum class AffineKind
+{
+    Translate, // 只有平移
+    Scale,     // 轴对齐缩放 + 平移（可以是非等比、负数）
+    General    // 含旋转或错切
+};
+
+struct Affine
+{
+    float a, b, c, d, tx, ty;
+
+    static Affine Identity()
+    {
+        return { 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f };
+    }
+
+    // 先缩放、再旋转（弧度）、最后平移
+    static Affine Make(float tx, float ty, float scale, float rotation)
+    {
+        if (rotation == 0.0f) return { scale, 0.0f, 0.0f, scale, tx, ty };
+
+        float cos_r = std::cos(rotation) * scale;
+        float sin_r = std::sin(rotation) * scale;
+        return { cos_r, sin_r, -sin_r, cos_r, tx, ty };
+    }
+
+    // this * m：先应用 m，再应用 this
+    Affine operator*(const Affine &m) const
+    {
+        return { a * m.a + c * m.b, b * m.a + d * m.b, a * m.c + c * m.d, b * m.c + d * m.d, a * m.tx + c * m.ty + tx, b * m.tx + d * m.ty + ty };
+    }
+
+    AffineKind GetKind() const
+    {
+        if (b != 0.0f || c != 0.0f) return AffineKind::General;
+        if (a != 1.0f || d != 1.0f) return AffineKind::Scale;
+        return AffineKind::Translate;
+    }
+
+    // 等比（缩放 + 旋转，不含非等比与错切）时圆仍是圆
+    bool IsSimilarity() const
+    {
+        return std::fabs(a - d) < 1e-5f && std::fabs(b + c) < 1e-5f;
+    }
+
+    // 线性部分的平均缩放（面积缩放的平方根），用于线宽、半径、字号
+    float GetScale() const
+    {
+        return std::sqrt(std::fabs(a * d - b * c));
+    }
+
+    void Apply(float &x, float &y) const
+    {
+        float nx = a * x + c * y + tx;
+        y = b * x + d * y + ty;
+        x = nx;
+    }
+
+    // 批量变换 (x0, y0, x1, y1, ...)，结果四舍五入并加上整数偏移
+    void ApplyRounded(const int *src, int *dst, int point_count, int offset_x, int offset_y) const
+    {
+        for (int i = 0; i < point_count * 2; i += 2)
+        {
+            float x = (float)src[i];
+            float y = (float)src[i + 1];
+            dst[i] = (int)std::floor(a * x + c * y + tx + 0.5f) + offset_x;
+            dst[i + 1] = (int)std::floor(b * x + d * y + ty + 0.5f) + offset_y;
+        }
+    }
+    void ApplyRounded(const float *src, int *dst, int point_count, int offset_x, int offset_y) const
+    {
+        for (int i = 0; i < point_count * 2; i += 2)
+        {
+            float x = src[i];
+            float y = src[i + 1];
+            dst[i] = (int)std::floor(a * x + c * y + tx + 0.5f) + offset_x;
+            dst[i + 1] = (int)std::floor(b * x + d * y + ty + 0.5f) + offset_y;
+        }
+    }
+};
+
+} // namespace Graphics
+
+#endif // GRAPHICS_AFFINE_H
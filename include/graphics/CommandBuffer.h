@@ -0,0 +1,308 @@
+/*
+ * CPU-Draw - Command Buffer Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 延迟绘制命令缓冲
+ * DrawList 录制模式下的命令存储与回放
+ *
+ * 特性：
+ * - 定长 POD 命令，字符串/顶点存放在数据区（按偏移引用）
+ * - 录制时即确定范围与裁剪区，缓冲可独立于 DrawList 存在
+ * - 回放前剔除、消除被不透明矩形覆盖的命令
+ * - 同色相邻矩形合并、文本命令归并
+ * - 命令级抗锯齿标志
+ * - 可直接回放外部内存（共享内存）中的命令与数据，不复制
+ *
+ * 录制与回放可以在不同线程，但同一缓冲不能同时进行
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef GRAPHICS_COMMANDBUFFER_H
+#define GRAPHICS_COMMANDBUFFER_H
+
+#include "graphics/Primitives.h"
+#include "graphics/Surface.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Text
+{
+struct SdfEffect;
+}
+
+namespace Graphics
+{
+
+struct GradientRamp;
+struct TextureSampling;
+class Texture;
+
+// 绘制命令类型
+enum class DrawOp : uint8_t
+{
+    Pixel,
+    Line,
+    LineF,
+    LineThick,
+    Rect,
+    RectF,
+    RectFilled,
+    RectRounded,
+    RectRoundedFilled,
+    Circle,
+    CircleF,
+    CircleFilled,
+    Triangle,
+    TriangleFilled,
+    Polygon,
+    PolygonFilled,
+    BezierCubic,
+    BezierQuadratic,
+    GradientLinear,
+    GradientRadial,
+    Text,
+    Clear,
+    Surface,
+    TextSdf,
+    EntityBatch,
+    PolygonF,
+    PathFilled,
+    Image,
+    ImageScaled
+};
+
+static const int DRAW_OP_COUNT = (int)DrawOp::ImageScaled + 1;
+
+// 外部命令（CommandBuffer::Validate）接受的数值范围：坐标决定逐像素走线的步数，尺寸与分段数决定循环次数和字形大小
+static const int EXTERNAL_COORD_LIMIT = 1 << 16;  // 坐标绝对值
+static const int EXTERNAL_SIZE_LIMIT = 4096;      // 半径、线宽、SDF 字号
+static const int EXTERNAL_FONT_SIZE_LIMIT = 512;  // 位图文字字号（字形须放得进图集页）
+static const int EXTERNAL_SEGMENT_LIMIT = 1024;   // 贝塞尔分段数
+
+// 支持抗锯齿的命令
+inline bool SupportsAntiAliasing(DrawOp op)
+{
+    switch (op)
+    {
+    case DrawOp::Line:
+    case DrawOp::LineF:
+    case DrawOp::LineThick:
+    case DrawOp::RectF:
+    case DrawOp::RectRounded:
+    case DrawOp::RectRoundedFilled:
+    case DrawOp::Circle:
+    case DrawOp::CircleF:
+    case DrawOp::CircleFilled:
+    case DrawOp::PathFilled: return true;
+    default: return false;
+    }
+}
+
+// 顶点数组参数（x0, y0, x1, y1, ...）
+struct PointList
+{
+    const int *points;
+    int count;
+};
+
+// 浮点顶点数组
+struct PointListF
+{
+    const float *points;
+    int count;
+};
+
+// 原样存入数据区的字节块（如打包好的实体批次）
+struct DataBlock
+{
+    const void *data;
+    uint32_t size;
+};
+
+// 命令参数（32 位）
+union CommandArg
+{
+    int32_t i;
+    uint32_t u;
+    float f;
+};
+
+// 绘制命令
+struct DrawCommand
+{
+    static const int MAX_ARGS = 10;
+
+    // 标志位（高位保留给回放内部使用）
+    static const uint16_t FLAG_ANTIALIAS = 1 << 0; // 线条、圆、圆角矩形走覆盖率光栅化
+
+    DrawOp op;
+    uint8_t argCount;
+    uint16_t flags;
+    IntRect bounds; // 绘制范围（已裁剪到缓冲区和裁剪区）
+    IntRect clip;   // 录制时的裁剪区
+    CommandArg args[MAX_ARGS];
+};
+
+// 回放统计
+struct FlushStats
+{
+    int recorded; // 录制的命令数
+    int culled;   // 剔除（不可见或被覆盖）
+    int merged;   // 合并掉的矩形
+    int batched;  // 归并时移动的命令
+    int executed; // 实际光栅化
+};
+
+// 回放用的临时数据（每个光栅化线程一份）
+struct RasterScratch
+{
+    std::string text;
+    std::vector<int> points;
+};
+
+// 命令缓冲
+class CommandBuffer
+{
+  public:
+    CommandBuffer();
+
+    // 清空命令（保留内存），同时解除 Attach
+    void Reset();
+
+    // 改为回放外部内存中的命令与数据（不复制），外部内存在下一次 Reset / Attach 之前须保持有效
+    // Attach 之后不能再录制
+    void Attach(const DrawCommand *commands, size_t count, const uint8_t *data, size_t size);
+
+    // 检查来自其他进程的命令：操作码、参数个数、范围非空、数据区引用不越界，坐标与尺寸在 EXTERNAL_*_LIMIT 内
+    // 引用本进程指针的命令（Surface、Image、ImageScaled）一律拒绝
+    static bool Validate(const DrawCommand *commands, size_t count, const uint8_t *data, size_t size);
+
+    // 把外部命令的范围限制在 width x height 内（Validate 之后、回放之前调用）
+    static void ClampBounds(DrawCommand *commands, size_t count, int width, int height);
+
+    // 录制一条命令
+    template <typename... Args>
+    void Record(DrawOp op, uint16_t flags, const IntRect &bounds, const IntRect &clip, const Args &...args)
+    {
+        commands.emplace_back();
+        DrawCommand &cmd = commands.back();
+        cmd.op = op;
+        cmd.argCount = 0;
+        cmd.flags = flags;
+        cmd.bounds = bounds;
+        cmd.clip = clip;
+        PackArgs(cmd, args...);
+    }
+
+    // 剔除、合并、归并后光栅化
+    void Flush(uint32_t *pixels, int stride, int width, int height);
+
+    // 只做剔除、合并、归并，结果见 GetPrepared
+    void Prepare(int width, int height);
+    const std::vector<DrawCommand> &GetPrepared() const
+    {
+        return work;
+    }
+
+    // 光栅化单条命令，clip 不为空时只写入该区域
+    // 只读访问缓冲，可在多个线程同时调用（各自的 scratch）
+    void Execute(const DrawCommand &cmd, uint32_t *pixels, int stride, int width, int height, const IntRect *clip, RasterScratch &scratch) const;
+
+    // 命令访问（录制的命令，或 Attach 的外部命令）
+    size_t GetCommandCount() const
+    {
+        return external ? externalCount : commands.size();
+    }
+    const DrawCommand *GetCommands() const
+    {
+        return external ? external : commands.data();
+    }
+    const uint8_t *GetData() const
+    {
+        return external ? externalData : data.data();
+    }
+    size_t GetDataSize() const
+    {
+        return external ? externalSize : data.size();
+    }
+
+    // 上一次回放的统计
+    const FlushStats &GetLastStats() const
+    {
+        return stats;
+    }
+
+  private:
+    static const int OCCLUDER_LIMIT = 32;
+    static const int BATCH_WINDOW = 32;
+
+    std::vector<DrawCommand> commands;
+    std::vector<uint8_t> data;
+
+    // Attach 的外部命令，为空时回放录制的命令
+    const DrawCommand *external;
+    size_t externalCount;
+    const uint8_t *externalData;
+    size_t externalSize;
+
+    // 回放用的临时数据
+    std::vector<DrawCommand> work;
+    std::vector<IntRect> occluders;
+    RasterScratch scratch;
+    FlushStats stats;
+
+    void PackArgs(DrawCommand &)
+    {
+    }
+    template <typename T, typename... Rest>
+    void PackArgs(DrawCommand &cmd, const T &value, const Rest &...rest)
+    {
+        Pack(cmd, value);
+        PackArgs(cmd, rest...);
+    }
+
+    void Pack(DrawCommand &cmd, int32_t value)
+    {
+        cmd.args[cmd.argCount++].i = value;
+    }
+    void Pack(DrawCommand &cmd, uint32_t value)
+    {
+        cmd.args[cmd.argCount++].u = value;
+    }
+    void Pack(DrawCommand &cmd, float value)
+    {
+        cmd.args[cmd.argCount++].f = value;
+    }
+    void Pack(DrawCommand &cmd, const std::string &value);
+    void Pack(DrawCommand &cmd, const PointList &value);
+    void Pack(DrawCommand &cmd, const PointListF &value);
+    void Pack(DrawCommand &cmd, const Surface *value);
+    void Pack(DrawCommand &cmd, const Text::SdfEffect &value);
+    void Pack(DrawCommand &cmd, const DataBlock &value);
+    void Pack(DrawCommand &cmd, const GradientRamp &value);
+    void Pack(DrawCommand &cmd, const Texture *value);
+    void Pack(DrawCommand &cmd, const TextureSampling &value);
+
+    // 数据区追加（4 字节对齐），返回偏移
+    uint32_t AppendData(const void *src, size_t size);
+    template <typename T>
+    const T *DataAt(uint32_t offset) const
+    {
+        return reinterpret_cast<const T *>(GetData() + offset);
+    }
+
+    // 抗锯齿版本，不支持的命令返回 false
+    bool ExecuteAntiAliased(const DrawCommand &cmd, uint32_t *pixels, int stride, int width, int height, const IntRect &cr) const;
+
+    void Cull(int width, int height);
+    void Batch();
+    void Merge();
+};
+
+} // namespace Graphics
+
+#endif // GRAPHICS_COMMANDBUFFER_H
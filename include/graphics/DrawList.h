@@ -8,8 +8,11 @@
  * 
  * 特性：
  * - 裁剪区域
- * - 几何变换
+ * - 几何变换（压栈时合成仿射矩阵，所有图元都跟随变换）
  * - 文本渲染
+ * - 录制模式（写入 CommandBuffer，稍后回放）
+ * - 可选抗锯齿（线条、圆、圆角矩形）
+ * - 坐标原点偏移、离屏缓存贴图
  * 
  * 仅供学习和研究使用
  */
@@ -17,11 +20,26 @@
 #ifndef GRAPHICS_DRAWLIST_H
 #define GRAPHICS_DRAWLIST_H
 
+#include "core/FrameArena.h"
+#include "core/Profiler.h"
 #include "core/VectorStruct.h"
+#include "graphics/Affine.h"
+#include "graphics/CommandBuffer.h"
+#include "graphics/EntityBatch.h"
+#include "graphics/Gradient.h"
+#include "graphics/Path.h"
 #include "graphics/Primitives.h"
+#include "graphics/Surface.h"
+#include "graphics/Texture.h"
 #include <string>
 #include <vector>
 
+namespace Text
+{
+struct TextLayout;
+struct SdfEffect;
+}
+
 namespace Graphics
 {
 
@@ -33,11 +51,24 @@ enum class TextAlign
     Right
 };
 
+// 绘制层：渲染缩放时几何画进低分辨率缓冲，文字另起一遍按屏幕分辨率绘制
+enum class DrawLayer : uint8_t
+{
+    All,
+    Geometry, // 跳过 AddText / AddTextSdf
+    Text      // 只保留 AddText / AddTextSdf
+};
+
 // 绘制命令列表
 class DrawList
 {
   public:
-    DrawList(uint32_t *buffer, int stride, int width, int height);
+    // arena 不为空时内部临时数组（裁剪 / 变换栈、顶点）从 arena 分配，DrawList 不能活过 arena 的 Reset
+    DrawList(uint32_t *buffer, int stride, int width, int height, Core::FrameArena *arena = nullptr);
+    // 仅统计绘制范围与内容签名，不写像素
+    DrawList(int width, int height, Core::FrameArena *arena = nullptr);
+    // 录制模式：命令写入 buffer，由 CommandBuffer::Flush 光栅化
+    DrawList(CommandBuffer *buffer, int width, int height, Core::FrameArena *arena = nullptr);
     ~DrawList();
 
     // 获取缓冲区信息
@@ -58,6 +89,53 @@ class DrawList
         return pixels;
     }
 
+    // 本帧绘制范围（已裁剪到缓冲区和裁剪区）
+    const IntRect &GetDrawnBounds() const
+    {
+        return drawnBounds;
+    }
+
+    // 本帧内容签名，绘制调用及参数完全相同时不变
+    uint64_t GetSignature() const
+    {
+        return signature;
+    }
+
+    // 抗锯齿开关，影响之后的线条、圆、圆角矩形
+    void SetAntiAliasing(bool enabled)
+    {
+        antiAliasing = enabled;
+    }
+    bool GetAntiAliasing() const
+    {
+        return antiAliasing;
+    }
+
+    // 坐标原点，之后所有绘制坐标（含裁剪区）都加上 (x, y)
+    void SetOrigin(int x, int y)
+    {
+        originX = x;
+        originY = y;
+    }
+    int GetOriginX() const
+    {
+        return originX;
+    }
+    int GetOriginY() const
+    {
+        return originY;
+    }
+
+    // 只接受某一层的绘制调用，其余调用不绘制、不计入范围与签名
+    void SetLayer(DrawLayer value)
+    {
+        layer = value;
+    }
+    DrawLayer GetLayer() const
+    {
+        return layer;
+    }
+
     // 基础绘制
     void AddPixel(int x, int y, uint32_t color);
     void AddPixelF(float x, float y, uint32_t color);
@@ -86,22 +164,53 @@ class DrawList
     // 多边形
     void AddPolygon(const int *points, int point_count, uint32_t color);
     void AddPolygonFilled(const int *points, int point_count, uint32_t color);
+    // 浮点顶点（几何坐标，填充采样像素中心），抗锯齿开启时填充走覆盖率光栅化
+    void AddPolygon(const float *points, int point_count, uint32_t color);
+    void AddPolygonFilled(const float *points, int point_count, uint32_t color, FillRule rule = FillRule::EvenOdd);
+
+    // 路径：曲线变换到设备坐标后自适应展开，多条轮廓按填充规则挖空
+    void AddPathFilled(const Path &path, uint32_t color, FillRule rule = FillRule::NonZero);
 
-    // 贝塞尔曲线
-    void AddBezierCubic(float x0, float y0, float x1, float y1, float x2, float y2, float x3, float y3, uint32_t color, int segments = 20);
-    void AddBezierQuadratic(float x0, float y0, float x1, float y1, float x2, float y2, uint32_t color, int segments = 15);
+    // 贝塞尔曲线（segments 为 0 时按设备坐标下的曲率自适应分段）
+    void AddBezierCubic(float x0, float y0, float x1, float y1, float x2, float y2, float x3, float y3, uint32_t color, int segments = 0);
+    void AddBezierQuadratic(float x0, float y0, float x1, float y1, float x2, float y2, uint32_t color, int segments = 0);
 
-    // 渐变
+    // 渐变（两色线性渐变为竖直方向）
     void AddGradientLinear(int x0, int y0, int x1, int y1, uint32_t color_start, uint32_t color_end);
     void AddGradientRadial(int cx, int cy, int radius, uint32_t color_center, uint32_t color_edge);
+    // 多色标渐变：色带按定义烘焙后缓存（GradientCache），录制模式复制进命令
+    // from / to 为色带两端（几何坐标），矩形内在两端之外的部分取端点颜色；旋转时填充外接矩形
+    void AddGradientLinear(int x0, int y0, int x1, int y1, float from_x, float from_y, float to_x, float to_y, const Gradient &gradient);
+    // 色带铺满矩形：horizontal 为 true 时从左到右，否则从上到下
+    void AddGradientLinear(int x0, int y0, int x1, int y1, const Gradient &gradient, bool horizontal = false);
+    void AddGradientRadial(int cx, int cy, int radius, const Gradient &gradient);
+
+    // 离屏缓存（预乘 alpha），录制模式只保存指针，回放前 surface 不能改动
+    void AddSurface(const Surface &surface, int x, int y);
+
+    // 图片（预乘纹理），录制模式只保存指针，回放前纹理不能改动
+    // 含缩放变换时按变换后的外接矩形缩放绘制，不支持旋转采样
+    void AddImage(const Texture &texture, int x, int y);
+    void AddImageScaled(const Texture &texture, int x0, int y0, int x1, int y1, TextureFilter filter = TextureFilter::Bilinear);
+    // tint 为直通 alpha 颜色，与纹理逐通道相乘（图标换色、淡入淡出）
+    void AddImageTinted(const Texture &texture, int x0, int y0, int x1, int y1, uint32_t tint, TextureFilter filter = TextureFilter::Bilinear);
+    // 图集中的子图，source 为纹理像素坐标（包含边界）
+    void AddImageRegion(const Texture &texture, const IntRect &source, int x0, int y0, int x1, int y1, uint32_t tint = 0xFFFFFFFF, TextureFilter filter = TextureFilter::Bilinear);
 
     // 文本
     void AddText(int x, int y, const std::string &text, int font_size, uint32_t color);
     void AddText(float x, float y, const std::string &text, int font_size, uint32_t color);
     void AddTextAligned(int x, int y, const std::string &text, int font_size, uint32_t color, TextAlign align);
+    // SDF 文本：浮点字号，随变换缩放，可带描边 / 阴影（effect 为空时无效果）
+    void AddTextSdf(float x, float y, const std::string &text, float font_size, uint32_t color, const Text::SdfEffect *effect = nullptr);
+
+    // 批量实体（方框 / 射线 / 名字 / 信息 / 血条），整批剔除后只生成一条命令
+    // 方框跟随完整变换（含旋转时取外接矩形），标签字号只随缩放变化
+    void AddEntityBatch(const EntityBatch &batch, const EntityStyle &style);
 
     // 文本工具
     My_Vector2 CalcTextSize(const std::string &text, int font_size);
+    My_Vector2 CalcTextSizeSdf(const std::string &text, float font_size);
 
     // 清屏
     void Clear(uint32_t color = rgba(0, 0, 0, 255));
@@ -111,32 +220,178 @@ class DrawList
     void PopClipRect();
     void ClearClipRect();
 
-    // 变换
+    // 变换：新压入的变换作用在当前变换之内（先应用新变换，再应用外层）
+    // 平移 / 轴对齐缩放时矩形、圆仍按原图元绘制；含旋转、非等比缩放时矩形、圆、圆角矩形转为多边形
+    // 文字只跟随位置与缩放，离屏贴图只跟随位置
     void PushTransform(float tx, float ty, float scale = 1.0f, float rotation = 0.0f);
+    void PushTransform(const Affine &matrix);
     void PopTransform();
+    const Affine &GetTransform() const
+    {
+        return transform;
+    }
 
   private:
     uint32_t *pixels;
     int stride;
     int width;
     int height;
+    CommandBuffer *recorder;
+    bool antiAliasing;
+    int originX, originY;
+    DrawLayer layer;
+
+    // 已排版文本（设备坐标）
+    void AddTextLayout(int x, int y, const std::string &text, const Text::TextLayout &layout, uint32_t color);
+
+    // 损伤统计
+    IntRect drawnBounds;
+    uint64_t signature;
 
     // 裁剪区域栈
-    struct ClipRect
+    Core::ArenaVector<IntRect> clipRectStack;
+
+    // 变换栈（每层保存合成后的矩阵）
+    Core::ArenaVector<Affine> transformStack;
+    Affine transform;
+    AffineKind transformKind;
+    float transformScale;      // 线性部分的平均缩放
+    int transformX, transformY; // 纯平移时取整后的平移量
+    void UpdateTransform();
+    void BindArena(Core::FrameArena *arena);
+
+    bool IsPointInClipRect(int x, int y) const;
+    IntRect GetClipRect() const;
+
+    // 当前裁剪区，没有时为空指针
+    const IntRect *Clip() const
     {
-        int x0, y0, x1, y1;
-    };
-    std::vector<ClipRect> clipRectStack;
+        return clipRectStack.empty() ? nullptr : &clipRectStack.back();
+    }
 
-    // 变换栈
-    struct Transform
+    // 整数坐标变换后加原点（纯平移时只做整数加法）
+    void Translate(int &x, int &y) const
     {
-        float tx, ty, scale, rotation;
-    };
-    std::vector<Transform> transformStack;
+        if (transformKind == AffineKind::Translate)
+        {
+            x += originX + transformX;
+            y += originY + transformY;
+            return;
+        }
+        float fx = (float)x, fy = (float)y;
+        transform.Apply(fx, fy);
+        x = (int)std::floor(fx + 0.5f) + originX;
+        y = (int)std::floor(fy + 0.5f) + originY;
+    }
+    // 变换后再加原点（浮点接口）
+    void TransformPoint(float &x, float &y) const
+    {
+        transform.Apply(x, y);
+        x += originX;
+        y += originY;
+    }
+    // 像素矩形 [x0, x1] × [y0, y1] 变换后的范围，含旋转时取外接矩形
+    void TransformRect(int &x0, int &y0, int &x1, int &y1) const;
+    // 长度（线宽、半径、字号）按变换缩放，非零长度至少保留 1
+    int TransformLength(int length) const;
+    // 多边形顶点变换，无变换无偏移时直接返回原数组
+    const int *TranslatePoints(const int *points, int point_count);
+    Core::ArenaVector<int> translatedPoints;
 
-    bool IsPointInClipRect(int x, int y) const;
-    void ApplyTransform(float &x, float &y) const;
+    // 批量实体的设备坐标方框与打包数据
+    Core::ArenaVector<int> entityRects;
+    Core::ArenaVector<uint8_t> entityData;
+
+    // 含旋转 / 非等比缩放时，矩形、圆转成的路径（局部坐标）
+    Core::ArenaVector<float> pathPoints;
+    void PathRect(float x0, float y0, float x1, float y1);
+    void PathRoundedRect(float x0, float y0, float x1, float y1, float radius);
+    void PathEllipse(float cx, float cy, float rx, float ry);
+    void AddPath(bool filled, uint32_t color);
+    void AddPolygonPoints(const int *points, int point_count, uint32_t color, bool filled);
+
+    // 浮点顶点变换到设备坐标
+    const float *TransformPoints(const float *points, int point_count);
+    Core::ArenaVector<float> devicePoints;
+    Core::ArenaVector<int> deviceContours;
+    // 已是设备坐标的多轮廓填充
+    void AddContoursFilled(const float *points, const int *contour_sizes, int contour_count, uint32_t color, FillRule rule);
+    // 已是设备坐标的渐变
+    void AddGradientLinearDevice(int x0, int y0, int x1, int y1, float from_x, float from_y, float to_x, float to_y, const GradientRamp &ramp);
+    void AddGradientRadialDevice(int cx, int cy, int radius, const GradientRamp &ramp);
+
+    // 当前命令是否走抗锯齿
+    bool UseAntiAliasing(DrawOp op) const
+    {
+        return antiAliasing && SupportsAntiAliasing(op);
+    }
+
+    // 记录绘制范围与签名，返回是否需要立即光栅化
+    template <typename... Args>
+    bool Track(DrawOp op, int x0, int y0, int x1, int y1, const Args &...args)
+    {
+        if (layer != DrawLayer::All)
+        {
+            bool text = op == DrawOp::Text || op == DrawOp::TextSdf;
+            if (text != (layer == DrawLayer::Text)) return false;
+        }
+
+        uint16_t flags = UseAntiAliasing(op) ? DrawCommand::FLAG_ANTIALIAS : 0;
+
+        // 抗锯齿边缘最多向外多覆盖一个像素
+        int pad = flags ? 1 : 0;
+        IntRect clip = GetClipRect();
+        IntRect r = MarkBounds(IntRect{ x0 - pad, y0 - pad, x1 + pad, y1 + pad }.Intersect(clip));
+        HashValue((uint32_t)op | ((uint32_t)flags << 8));
+        HashArgs(clip.x0, clip.y0, clip.x1, clip.y1, args...);
+
+        // 完全在裁剪区外
+        if (r.IsEmpty()) return false;
+
+        // 仅统计真正落盘或录制的命令（只算范围的模式不计）
+#if CPUDRAW_PROFILER
+        if ((recorder || pixels) && Core::Profiler::IsEnabled())
+        {
+            Core::Profiler &profiler = Core::Profiler::Instance();
+            profiler.AddCount(Core::ProfileCounter::Commands, 1);
+            profiler.AddCount(Core::ProfileCounter::PixelsCovered, (uint64_t)r.Width() * r.Height());
+        }
+#endif
+        if (recorder)
+        {
+            recorder->Record(op, flags, r, clip, args...);
+            return false;
+        }
+        return pixels != nullptr;
+    }
+
+    IntRect MarkBounds(const IntRect &rect);
+
+    void HashArgs()
+    {
+    }
+    template <typename T, typename... Rest>
+    void HashArgs(const T &value, const Rest &...rest)
+    {
+        HashValue(value);
+        HashArgs(rest...);
+    }
+
+    void HashValue(uint32_t value);
+    void HashValue(int value)
+    {
+        HashValue((uint32_t)value);
+    }
+    void HashValue(float value);
+    void HashValue(const std::string &value);
+    void HashValue(const PointList &value);
+    void HashValue(const PointListF &value);
+    void HashValue(const Surface *value);
+    void HashValue(const Text::SdfEffect &value);
+    void HashValue(const DataBlock &value);
+    void HashValue(const GradientRamp &value);
+    void HashValue(const Texture *value);
+    void HashValue(const TextureSampling &value);
 };
 
 } // namespace Graphics
@@ -0,0 +1,116 @@
+/*
+ * CPU-Draw - Entity Batch Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 批量实体覆盖层
+ * 一次提交成百上千个实体的方框、射线、名字、信息标签和血条
+ *
+ * 特性：
+ * - 结构数组输入，标签按编号引用标签表，同一文本只排版一次
+ * - 整批剔除屏幕外的实体，可见实体打包成一块数据、一条命令
+ * - 按图元类型分遍光栅化：射线 -> 方框 -> 血条 -> 标签
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef GRAPHICS_ENTITYBATCH_H
+#define GRAPHICS_ENTITYBATCH_H
+
+#include "core/FrameArena.h"
+#include "graphics/Primitives.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Graphics
+{
+
+// 绘制内容
+enum EntityFlags : uint32_t
+{
+    ENTITY_BOX = 1 << 0,
+    ENTITY_TRACER = 1 << 1,
+    ENTITY_NAME = 1 << 2,
+    ENTITY_INFO = 1 << 3,
+    ENTITY_HEALTH = 1 << 4,
+    ENTITY_ALL = 0x1F
+};
+
+// 整批共用的样式（颜色为直通 alpha）
+struct EntityStyle
+{
+    uint32_t flags;
+    int tracerX, tracerY; // 射线起点
+    uint32_t tracerColor;
+    int nameSize;         // 名字（方框上方）
+    uint32_t nameColor;
+    int infoSize;         // 信息（方框下方，如距离）
+    uint32_t infoColor;
+    int healthHeight;     // 血条（信息下方）
+    uint32_t healthBackColor;
+    uint32_t healthLowColor, healthHighColor; // 血量 0 与 1 时的颜色，中间线性插值
+    int gap;              // 各部分间距
+
+    EntityStyle()
+        : flags(ENTITY_ALL), tracerX(0), tracerY(0), tracerColor(rgba(255, 255, 0, 255)), nameSize(24), nameColor(rgba(255, 255, 255, 255)), infoSize(20), infoColor(rgba(255, 255, 0, 255)), healthHeight(6), healthBackColor(rgba(60, 60, 60, 200)),
+          healthLowColor(rgba(255, 0, 0, 220)), healthHighColor(rgba(0, 255, 0, 220)), gap(4)
+    {
+    }
+};
+
+// 实体数组，每帧 Clear 后重新填充（也可以直接写各数组，长度需一致）
+struct EntityBatch
+{
+    std::vector<int> x0, y0, x1, y1; // 方框
+    std::vector<uint32_t> color;     // 方框颜色
+    std::vector<float> health;       // 0..1，小于 0 不画血条
+    std::vector<int> name, info;     // 标签编号（labels 下标），-1 表示无
+    std::vector<std::string> labels;
+
+    void Clear();
+    void Reserve(size_t count);
+    // 标签文本加入标签表，返回编号
+    int AddLabel(const std::string &text);
+    void Add(int bx0, int by0, int bx1, int by1, uint32_t box_color, float health_value = -1.0f, int name_label = -1, int info_label = -1);
+
+    size_t Size() const
+    {
+        return x0.size();
+    }
+};
+
+// 打包后的可见实体（设备坐标），DrawList 生成，录制模式原样存进命令数据区
+// 布局：EntityBatchHeader | 实体数组 | 标签绘制（按标签排序）| 标签表 | 标签文本，数组均 4 字节对齐
+struct EntityBatchHeader
+{
+    uint32_t count;      // 可见实体数
+    uint32_t drawCount;  // 标签绘制数
+    uint32_t labelCount; // 用到的 (文本, 字号) 组合数
+    uint32_t nameSlots;  // 其中前 nameSlots 个是名字
+    uint32_t textSize;
+    uint32_t flags;
+    uint32_t antiAliasing;
+    int32_t tracerX, tracerY;
+    uint32_t tracerColor;
+    int32_t healthHeight;
+    uint32_t healthBackColor;
+    uint32_t nameColor, infoColor;
+};
+
+// 剔除并打包，rects 为变换后的方框（x0, y0, x1, y1 交错），返回可见部分的范围
+// 样式中的坐标、尺寸也需是设备坐标；arena 不为空时内部临时数组从 arena 分配
+IntRect pack_entity_batch(Core::ArenaVector<uint8_t> &out, const EntityBatch &batch, const int *rects, const EntityStyle &style, bool anti_aliasing, const IntRect &clip, Core::FrameArena *arena = nullptr);
+
+// 光栅化打包数据，clip 为空时写满缓冲区
+void draw_entity_batch(uint32_t *pixels, int stride, int width, int height, const uint8_t *data, const IntRect *clip = nullptr);
+
+// 检查外部提供的打包数据：各数组与标签文本都在 size 字节内，下标不越界
+bool validate_entity_batch(const uint8_t *data, uint32_t size);
+
+// 把打包数据用到的标签放进排版缓存（分块并行回放前在主线程调用）
+void prewarm_entity_batch(const uint8_t *data);
+
+} // namespace Graphics
+
+#endif // GRAPHICS_ENTITYBATCH_H
@@ -0,0 +1,129 @@
+/*
+ * CPU-Draw - Gradient Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 渐变色带
+ * 渐变定义（多个色标）烘焙成 256 项的像素色带，光栅化只做整数下标查表
+ *
+ * 特性：
+ * - 任意多个色标，在缓冲区像素格式下插值（预乘管线下透明端不会带出颜色）
+ * - 色带按定义缓存，同一渐变每帧只查一次哈希表
+ * - 线性渐变沿任意方向，下标按定点数逐像素累加
+ * - 径向渐变按距离平方查表，逐像素没有开方
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef GRAPHICS_GRADIENT_H
+#define GRAPHICS_GRADIENT_H
+
+#include "graphics/Primitives.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Graphics
+{
+
+static const int GRADIENT_RAMP_SIZE = 256;
+
+// 色标（位置 0..1，直通 alpha 颜色）
+struct GradientStop
+{
+    float offset;
+    uint32_t color;
+};
+
+// 渐变定义
+class Gradient
+{
+  public:
+    Gradient()
+    {
+    }
+    Gradient(uint32_t color_start, uint32_t color_end);
+
+    // 按位置插入（同一位置的色标按添加顺序排列，形成硬边）
+    Gradient &AddStop(float offset, uint32_t color);
+    void Clear()
+    {
+        stops.clear();
+    }
+
+    const std::vector<GradientStop> &GetStops() const
+    {
+        return stops;
+    }
+    bool IsEmpty() const
+    {
+        return stops.empty();
+    }
+
+  private:
+    std::vector<GradientStop> stops;
+};
+
+// 烘焙好的色带（缓冲区像素格式），录制模式整体复制进命令数据区
+struct GradientRamp
+{
+    uint32_t colors[GRADIENT_RAMP_SIZE];
+    uint32_t key[2]; // 色标哈希（DrawList 帧签名用，不逐项哈希）
+    uint32_t opaque; // 所有项 alpha 为 255，可直接写入
+};
+
+// 烘焙色带，没有色标时全透明
+void bake_gradient_ramp(GradientRamp &ramp, const GradientStop *stops, int count);
+
+// 色带缓存（只在录制 / 立即绘制的线程使用，回放读取命令里的副本）
+class GradientCache
+{
+  public:
+    static GradientCache &Instance()
+    {
+        static GradientCache instance;
+        return instance;
+    }
+
+    // 返回的引用在下一次 Get / Clear 之前有效
+    const GradientRamp &Get(const Gradient &gradient);
+    const GradientRamp &Get(uint32_t color_start, uint32_t color_end);
+
+    size_t GetCount() const
+    {
+        return current.size() + previous.size();
+    }
+
+    void Clear();
+
+  private:
+    GradientCache()
+    {
+    }
+    GradientCache(const GradientCache &) = delete;
+    GradientCache &operator=(const GradientCache &) = delete;
+
+    static const size_t GENERATION_CAPACITY = 64;
+
+    struct Entry
+    {
+        std::vector<GradientStop> stops;
+        GradientRamp ramp;
+    };
+
+    const GradientRamp &Get(const GradientStop *stops, int count);
+
+    std::unordered_map<uint64_t, Entry> current;
+    std::unordered_map<uint64_t, Entry> previous;
+};
+
+// 线性渐变：填充矩形 (x0, y0) - (x1, y1)，颜色沿 from -> to 方向（几何坐标，采样像素中心），两端之外取端点颜色
+void fill_gradient_linear(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, float from_x, float from_y, float to_x, float to_y, const GradientRamp &ramp, const IntRect *clip = nullptr);
+
+// 径向渐变：圆心为色带起点，半径处为终点
+void fill_gradient_radial(uint32_t *pixels, int stride, int width, int height, int cx, int cy, int radius, const GradientRamp &ramp, const IntRect *clip = nullptr);
+
+} // namespace Graphics
+
+#endif // GRAPHICS_GRADIENT_H
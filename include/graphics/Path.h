@@ -0,0 +1,79 @@
+/*
+ * CPU-Draw - Path Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 矢量路径（雷达轮廓、箭头、图标）
+ * 只保存命令与控制点，绘制时先变换到设备坐标再展开曲线，缩放后精度不变
+ *
+ * 特性：
+ * - 直线、二次 / 三次贝塞尔、多条轮廓
+ * - 曲线按 Wang 公式自适应分段：平直的曲线几段，弯曲的按需细分
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef GRAPHICS_PATH_H
+#define GRAPHICS_PATH_H
+
+#include "core/FrameArena.h"
+#include "graphics/Affine.h"
+#include <cstdint>
+#include <vector>
+
+namespace Graphics
+{
+
+// 曲线展开的最大误差（像素）
+static const float BEZIER_TOLERANCE = 0.25f;
+static const int BEZIER_MAX_SEGMENTS = 256;
+
+// 展开误差不超过 BEZIER_TOLERANCE 的分段数
+int bezier_segments_quadratic(float x0, float y0, float x1, float y1, float x2, float y2);
+int bezier_segments_cubic(float x0, float y0, float x1, float y1, float x2, float y2, float x3, float y3);
+
+class Path
+{
+  public:
+    Path()
+    {
+    }
+    // 每帧重建的路径：verb 与坐标从帧内 arena 分配，不能活过 arena 的 Reset
+    explicit Path(Core::FrameArena *arena) : verbs(Core::ArenaAllocator<uint8_t>(arena)), coords(Core::ArenaAllocator<float>(arena))
+    {
+    }
+
+    void Clear();
+
+    void MoveTo(float x, float y);
+    void LineTo(float x, float y);
+    void QuadTo(float cx, float cy, float x, float y);
+    void CubicTo(float c0x, float c0y, float c1x, float c1y, float x, float y);
+    // 闭合当前轮廓（填充时未闭合的轮廓也按闭合处理）
+    void Close();
+
+    bool IsEmpty() const
+    {
+        return verbs.empty();
+    }
+
+    // 变换后加偏移，展开成折线轮廓：points 为 (x, y) 交错，contours 为每条轮廓的顶点数
+    void Flatten(const Affine &matrix, float offset_x, float offset_y, Core::ArenaVector<float> &points, Core::ArenaVector<int> &contours) const;
+
+  private:
+    enum Verb : uint8_t
+    {
+        VerbMove,
+        VerbLine,
+        VerbQuad,
+        VerbCubic,
+        VerbClose
+    };
+
+    Core::ArenaVector<uint8_t> verbs;
+    Core::ArenaVector<float> coords;
+};
+
+} // namespace Graphics
+
+#endif // GRAPHICS_PATH_H
@@ -0,0 +1,100 @@
+/*
+ * CPU-Draw - Pixel Format Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 目标缓冲像素格式
+ * 绘制统一在 32 位工作缓冲（后台缓冲）中进行，提交时按目标格式转换写出
+ *
+ * 特性：
+ * - 格式特性在编译期展开（PixelTraits），每种格式一份转换循环
+ * - RGBA8888：整行拷贝
+ * - RGB565：每像素 2 字节，窗口缓冲与合成器读取带宽减半
+ *   4x4 有序抖动，渐变不出现色带；抖动只取决于屏幕坐标，帧间、分块间稳定
+ *
+ * RGB565 没有 alpha 通道，窗口按不透明合成（预乘像素相当于叠在黑底上），
+ * 只适合全屏不透明的界面；透明覆盖层需保持 RGBA8888
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef GRAPHICS_PIXELFORMAT_H
+#define GRAPHICS_PIXELFORMAT_H
+
+#include "graphics/Primitives.h"
+#include "graphics/SpanKernels.h"
+#include <cstdint>
+#include <cstring>
+
+namespace Graphics
+{
+
+enum class PixelFormat : uint8_t
+{
+    RGBA8888,
+    RGB565
+};
+
+template <PixelFormat F>
+struct PixelTraits;
+
+template <>
+struct PixelTraits<PixelFormat::RGBA8888>
+{
+    typedef uint32_t Pixel;
+    static const bool HAS_ALPHA = true;
+
+    // 工作缓冲一段像素写入目标，(x, y) 为该段起点的屏幕坐标
+    static void Convert(Pixel *dst, const uint32_t *src, int count, int, int)
+    {
+        memcpy(dst, src, (size_t)count * sizeof(Pixel));
+    }
+};
+
+template <>
+struct PixelTraits<PixelFormat::RGB565>
+{
+    typedef uint16_t Pixel;
+    static const bool HAS_ALPHA = false;
+
+    static void Convert(Pixel *dst, const uint32_t *src, int count, int x, int y)
+    {
+        span_convert_rgb565(dst, src, count, x, y);
+    }
+};
+
+inline int bytes_per_pixel(PixelFormat format)
+{
+    return format == PixelFormat::RGB565 ? 2 : 4;
+}
+
+inline const char *pixel_format_name(PixelFormat format)
+{
+    return format == PixelFormat::RGB565 ? "RGB565" : "RGBA8888";
+}
+
+// 工作缓冲的 rect 区域转换写入目标，dst_stride 以目标像素计
+template <PixelFormat F>
+void convert_rect(void *dst, int dst_stride, const uint32_t *src, int src_stride, const IntRect &rect)
+{
+    typedef typename PixelTraits<F>::Pixel Pixel;
+    Pixel *out = static_cast<Pixel *>(dst);
+    int count = rect.Width();
+    for (int y = rect.y0; y <= rect.y1; y++)
+    {
+        PixelTraits<F>::Convert(out + (size_t)y * dst_stride + rect.x0, src + (size_t)y * src_stride + rect.x0, count, rect.x0, y);
+    }
+}
+
+inline void convert_rect(PixelFormat format, void *dst, int dst_stride, const uint32_t *src, int src_stride, const IntRect &rect)
+{
+    switch (format)
+    {
+    case PixelFormat::RGBA8888: convert_rect<PixelFormat::RGBA8888>(dst, dst_stride, src, src_stride, rect); break;
+    case PixelFormat::RGB565: convert_rect<PixelFormat::RGB565>(dst, dst_stride, src, src_stride, rect); break;
+    }
+}
+
+} // namespace Graphics
+
+#endif // GRAPHICS_PIXELFORMAT_H
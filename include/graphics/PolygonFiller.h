@@ -0,0 +1,82 @@
+/*
+ * CPU-Draw - Polygon Filler Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 扫描线多边形填充（非抗锯齿）
+ * 边表按起始行分桶，逐行维护活动边表，相邻交点之间的区间直接交给 span_blend
+ *
+ * 特性：
+ * - 浮点顶点，可以有多条轮廓（挖空的图标路径）
+ * - 非零 / 奇偶填充规则
+ * - 只处理裁剪区内的行，屏幕右侧之外的边直接丢弃
+ * - 每行交点由边方程直接求出（不逐行累加），分块回放与整屏结果完全一致
+ *
+ * 坐标为几何坐标，采样像素中心：(x + 0.5, y + 0.5) 落在多边形内的像素被填充
+ * 左闭右开，相邻多边形的公共边不会重复混合
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef GRAPHICS_POLYGONFILLER_H
+#define GRAPHICS_POLYGONFILLER_H
+
+#include "graphics/Primitives.h"
+#include <cstdint>
+#include <vector>
+
+namespace Graphics
+{
+
+class PolygonFiller
+{
+  public:
+    PolygonFiller();
+
+    // 开始新路径，clip 为输出范围（需已与缓冲区求交）
+    void Reset(const IntRect &clip);
+
+    // 路径
+    void MoveTo(float x, float y);
+    void LineTo(float x, float y);
+    void Close();
+
+    // 闭合多边形
+    void AddPolygon(const float *points, int point_count);
+    void AddPolygon(const int *points, int point_count);
+
+    // 输出到缓冲区
+    void Fill(uint32_t *pixels, int stride, uint32_t color, FillRule rule = FillRule::NonZero);
+
+    bool IsEmpty() const
+    {
+        return edges.empty();
+    }
+
+  private:
+    // 边：覆盖扫描线 [row0, row1]，x = x0 + (y - y0) * dxdy
+    struct Edge
+    {
+        float x0, y0, dxdy;
+        int row0, row1;
+        int winding; // 向下为 +1
+        float x;     // 当前扫描线的交点
+    };
+
+    IntRect clip;
+    std::vector<Edge> edges;
+    std::vector<int> bucket; // 按起始行计数排序后的边下标
+    std::vector<int> rowStart;
+    std::vector<Edge *> active;
+    int minRow, maxRow;
+
+    float startX, startY;
+    float lastX, lastY;
+    bool hasPath;
+
+    void AddEdge(float x0, float y0, float x1, float y1);
+};
+
+} // namespace Graphics
+
+#endif // GRAPHICS_POLYGONFILLER_H
@@ -10,6 +10,10 @@
  * - Alpha 混合支持
  * - 多种图形绘制算法
  * - 渐变填充
+ * - 预乘 alpha 管线（CPUDRAW_PREMULTIPLIED，默认开启）
+ * 
+ * 接口颜色始终为直通 alpha，缓冲区像素格式由管线决定：
+ * 预乘管线输出正确的 alpha，交给合成器混合；直通管线绘制过的像素 alpha 为 255
  * 
  * 仅供学习和研究使用
  */
@@ -19,6 +23,11 @@
 
 #include <cstdint>
 
+// 像素管线：1 为预乘 alpha，0 为直通 alpha
+#ifndef CPUDRAW_PREMULTIPLIED
+#define CPUDRAW_PREMULTIPLIED 1
+#endif
+
 namespace Graphics
 {
 
@@ -46,46 +55,135 @@ inline uint8_t get_alpha(uint32_t color)
     return (color >> 24) & 0xFF;
 }
 
+// 四个通道同乘 s / 255（四舍五入），两两通道合并计算
+inline uint32_t scale_pixel(uint32_t color, uint32_t s)
+{
+    uint32_t rb = (color & 0x00FF00FF) * s + 0x00800080;
+    rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+
+    uint32_t ag = ((color >> 8) & 0x00FF00FF) * s + 0x00800080;
+    ag = (ag + ((ag >> 8) & 0x00FF00FF)) & 0xFF00FF00;
+
+    return rb | ag;
+}
+
+// 直通颜色转预乘
+inline uint32_t premultiply(uint32_t color)
+{
+    uint32_t a = color >> 24;
+    if (a == 255) return color;
+    return scale_pixel(color | 0xFF000000, a);
+}
+
+// 接口颜色转缓冲区像素格式
+inline uint32_t to_pixel(uint32_t color)
+{
+#if CPUDRAW_PREMULTIPLIED
+    return premultiply(color);
+#else
+    return color;
+#endif
+}
+
+// 整数矩形（包含边界）
+struct IntRect
+{
+    int x0, y0, x1, y1;
+
+    static IntRect Empty()
+    {
+        return { 0, 0, -1, -1 };
+    }
+
+    bool IsEmpty() const
+    {
+        return x1 < x0 || y1 < y0;
+    }
+
+    int Width() const
+    {
+        return x1 - x0 + 1;
+    }
+    int Height() const
+    {
+        return y1 - y0 + 1;
+    }
+
+    IntRect Union(const IntRect &o) const
+    {
+        if (IsEmpty()) return o;
+        if (o.IsEmpty()) return *this;
+        return { x0 < o.x0 ? x0 : o.x0, y0 < o.y0 ? y0 : o.y0, x1 > o.x1 ? x1 : o.x1, y1 > o.y1 ? y1 : o.y1 };
+    }
+
+    IntRect Intersect(const IntRect &o) const
+    {
+        return { x0 > o.x0 ? x0 : o.x0, y0 > o.y0 ? y0 : o.y0, x1 < o.x1 ? x1 : o.x1, y1 < o.y1 ? y1 : o.y1 };
+    }
+
+    bool operator==(const IntRect &o) const
+    {
+        return (IsEmpty() && o.IsEmpty()) || (x0 == o.x0 && y0 == o.y0 && x1 == o.x1 && y1 == o.y1);
+    }
+    bool operator!=(const IntRect &o) const
+    {
+        return !(*this == o);
+    }
+};
+
+// 以下函数的 clip 为附加裁剪区（包含边界），会再与缓冲区求交；为空时只按缓冲区裁剪
+
 // 像素操作
-void put_pixel(uint32_t *pixels, int stride, int width, int height, int x, int y, uint32_t color);
-void put_pixel_fast(uint32_t *pixels, int stride, int width, int height, int x, int y, uint32_t color);
-void put_pixelF(uint32_t *pixels, int stride, int width, int height, float x, float y, uint32_t color);
+void put_pixel(uint32_t *pixels, int stride, int width, int height, int x, int y, uint32_t color, const IntRect *clip = nullptr);
+void put_pixel_fast(uint32_t *pixels, int stride, int width, int height, int x, int y, uint32_t color, const IntRect *clip = nullptr);
+void put_pixelF(uint32_t *pixels, int stride, int width, int height, float x, float y, uint32_t color, const IntRect *clip = nullptr);
 
 // 线条
-void draw_line(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color);
-void draw_lineF(uint32_t *pixels, int stride, int width, int height, float x0, float y0, float x1, float y1, uint32_t color);
-void draw_line_thick(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color, int thickness);
+void draw_line(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color, const IntRect *clip = nullptr);
+void draw_lineF(uint32_t *pixels, int stride, int width, int height, float x0, float y0, float x1, float y1, uint32_t color, const IntRect *clip = nullptr);
+void draw_line_thick(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color, int thickness, const IntRect *clip = nullptr);
 
 // 矩形
-void draw_rect(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color);
-void draw_rectF(uint32_t *pixels, int stride, int width, int height, float x0, float y0, float x1, float y1, uint32_t color);
-void draw_rect_filled(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color);
-void draw_rect_rounded(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, int radius, uint32_t color);
-void draw_rect_rounded_filled(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, int radius, uint32_t color);
+void draw_rect(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color, const IntRect *clip = nullptr);
+void draw_rectF(uint32_t *pixels, int stride, int width, int height, float x0, float y0, float x1, float y1, uint32_t color, const IntRect *clip = nullptr);
+void draw_rect_filled(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color, const IntRect *clip = nullptr);
+void draw_rect_rounded(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, int radius, uint32_t color, const IntRect *clip = nullptr);
+void draw_rect_rounded_filled(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, int radius, uint32_t color, const IntRect *clip = nullptr);
 
 // 圆形
-void draw_circle(uint32_t *pixels, int stride, int width, int height, int cx, int cy, int radius, uint32_t color);
-void draw_circle_filled(uint32_t *pixels, int stride, int width, int height, int cx, int cy, int radius, uint32_t color);
-void draw_circleF(uint32_t *pixels, int stride, int width, int height, float cx, float cy, float radius, uint32_t color);
+void draw_circle(uint32_t *pixels, int stride, int width, int height, int cx, int cy, int radius, uint32_t color, const IntRect *clip = nullptr);
+void draw_circle_filled(uint32_t *pixels, int stride, int width, int height, int cx, int cy, int radius, uint32_t color, const IntRect *clip = nullptr);
+void draw_circleF(uint32_t *pixels, int stride, int width, int height, float cx, float cy, float radius, uint32_t color, const IntRect *clip = nullptr);
 
 // 三角形
-void draw_triangle(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, int x2, int y2, uint32_t color);
-void draw_triangle_filled(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, int x2, int y2, uint32_t color);
+void draw_triangle(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, int x2, int y2, uint32_t color, const IntRect *clip = nullptr);
+void draw_triangle_filled(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, int x2, int y2, uint32_t color, const IntRect *clip = nullptr);
+
+// 填充规则
+enum class FillRule
+{
+    NonZero,
+    EvenOdd
+};
 
-// 多边形
-void draw_polygon(uint32_t *pixels, int stride, int width, int height, const int *points, int point_count, uint32_t color);
-void draw_polygon_filled(uint32_t *pixels, int stride, int width, int height, const int *points, int point_count, uint32_t color);
+// 多边形（填充采样像素中心，顶点为几何坐标：像素 (x, y) 覆盖 [x, x + 1) x [y, y + 1)）
+void draw_polygon(uint32_t *pixels, int stride, int width, int height, const int *points, int point_count, uint32_t color, const IntRect *clip = nullptr);
+void draw_polygon_filled(uint32_t *pixels, int stride, int width, int height, const int *points, int point_count, uint32_t color, const IntRect *clip = nullptr);
+void draw_polygonF(uint32_t *pixels, int stride, int width, int height, const float *points, int point_count, uint32_t color, const IntRect *clip = nullptr);
+// 多条轮廓（contour_sizes 为每条轮廓的顶点数），用于挖空的图标路径
+void draw_path_filled(uint32_t *pixels, int stride, int width, int height, const float *points, const int *contour_sizes, int contour_count, uint32_t color, FillRule rule = FillRule::NonZero, const IntRect *clip = nullptr);
 
-// 贝塞尔曲线
-void draw_bezier_cubic(uint32_t *pixels, int stride, int width, int height, float x0, float y0, float x1, float y1, float x2, float y2, float x3, float y3, uint32_t color, int segments = 20);
-void draw_bezier_quadratic(uint32_t *pixels, int stride, int width, int height, float x0, float y0, float x1, float y1, float x2, float y2, uint32_t color, int segments = 15);
+// 贝塞尔曲线（segments 为 0 时按曲率自适应分段）
+void draw_bezier_cubic(uint32_t *pixels, int stride, int width, int height, float x0, float y0, float x1, float y1, float x2, float y2, float x3, float y3, uint32_t color, int segments = 0, const IntRect *clip = nullptr);
+void draw_bezier_quadratic(uint32_t *pixels, int stride, int width, int height, float x0, float y0, float x1, float y1, float x2, float y2, uint32_t color, int segments = 0, const IntRect *clip = nullptr);
 
 // 渐变填充
-void fill_gradient_linear(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color_start, uint32_t color_end);
-void fill_gradient_radial(uint32_t *pixels, int stride, int width, int height, int cx, int cy, int radius, uint32_t color_center, uint32_t color_edge);
+void fill_gradient_linear(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color_start, uint32_t color_end, const IntRect *clip = nullptr);
+void fill_gradient_radial(uint32_t *pixels, int stride, int width, int height, int cx, int cy, int radius, uint32_t color_center, uint32_t color_edge, const IntRect *clip = nullptr);
 
 // 清屏
-void clear_screen(uint32_t *pixels, int stride, int width, int height, uint32_t color);
+void clear_screen(uint32_t *pixels, int stride, int width, int height, uint32_t color, const IntRect *clip = nullptr);
+void clear_rect(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color, const IntRect *clip = nullptr);
 
 } // namespace Graphics
 
@@ -0,0 +1,95 @@
+/*
+ * CPU-Draw - Rasterizer Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 抗锯齿覆盖率光栅化
+ * 路径按扫描线累积有向面积，输出水平覆盖率扫描线
+ *
+ * 特性：
+ * - 稀疏单元格（只记录边经过的像素），按行计数排序、行内按 x 排序后扫描
+ * - 非零 / 奇偶填充规则
+ * - 内部恒定覆盖率的区间整段交给 span_blend，边缘交给 span_blend_mask
+ * - 线段描边、圆、圆环、圆角矩形
+ *
+ * 坐标为几何坐标：像素 (x, y) 覆盖 [x, x + 1) x [y, y + 1)
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef GRAPHICS_RASTERIZER_H
+#define GRAPHICS_RASTERIZER_H
+
+#include "graphics/Primitives.h"
+#include <cstdint>
+#include <vector>
+
+namespace Graphics
+{
+
+// 覆盖率光栅化器
+class Rasterizer
+{
+  public:
+    Rasterizer();
+
+    // 开始新路径，clip 为输出范围（需已与缓冲区求交）
+    void Reset(const IntRect &clip);
+
+    // 路径
+    void MoveTo(float x, float y);
+    void LineTo(float x, float y);
+    void Close();
+
+    // 形状（reverse 为反向绕行，用于挖空）
+    void AddPolygon(const float *points, int point_count);
+    void AddCircle(float cx, float cy, float radius, bool reverse = false);
+    void AddRoundedRect(float x0, float y0, float x1, float y1, float radius, bool reverse = false);
+    // 线段描边，两端各延长半个像素
+    void AddStrokeLine(float x0, float y0, float x1, float y1, float width);
+
+    // 输出到缓冲区
+    void Fill(uint32_t *pixels, int stride, uint32_t color, FillRule rule = FillRule::NonZero);
+
+    bool IsEmpty() const
+    {
+        return cells.empty();
+    }
+
+  private:
+    // 单元格：cover 为穿过的纵向面积，area 为本像素内的覆盖
+    struct Cell
+    {
+        int x, y;
+        float cover, area;
+    };
+
+    IntRect clip;
+    std::vector<Cell> cells;
+    std::vector<Cell> sorted; // 按 (y, x) 排好的单元格
+    std::vector<int> rowStart;
+    std::vector<uint8_t> rowMask;
+
+    float startX, startY;
+    float lastX, lastY;
+    bool hasPath;
+
+    void AddEdge(float x0, float y0, float x1, float y1);
+    void AddRowSegment(int row, float xa, float xb, float dy);
+    void AddCell(int x, int y, float cover, float area);
+    void AddArc(float cx, float cy, float radius, float a0, float a1, bool first);
+    void SortCells();
+};
+
+// 抗锯齿图形（整数参数与非抗锯齿版本一致，按像素中心对齐）
+void draw_line_aa(uint32_t *pixels, int stride, int width, int height, float x0, float y0, float x1, float y1, uint32_t color, float thickness = 1.0f, const IntRect *clip = nullptr);
+void draw_rectF_aa(uint32_t *pixels, int stride, int width, int height, float x0, float y0, float x1, float y1, uint32_t color, const IntRect *clip = nullptr);
+void draw_circle_aa(uint32_t *pixels, int stride, int width, int height, float cx, float cy, float radius, uint32_t color, float thickness = 1.0f, const IntRect *clip = nullptr);
+void draw_circle_filled_aa(uint32_t *pixels, int stride, int width, int height, float cx, float cy, float radius, uint32_t color, const IntRect *clip = nullptr);
+void draw_rect_rounded_aa(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, int radius, uint32_t color, const IntRect *clip = nullptr);
+void draw_rect_rounded_filled_aa(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, int radius, uint32_t color, const IntRect *clip = nullptr);
+void draw_path_filled_aa(uint32_t *pixels, int stride, int width, int height, const float *points, const int *contour_sizes, int contour_count, uint32_t color, FillRule rule = FillRule::NonZero, const IntRect *clip = nullptr);
+
+} // namespace Graphics
+
+#endif // GRAPHICS_RASTERIZER_H
@@ -0,0 +1,42 @@
+/*
+ * CPU-Draw - Render Scale Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 渲染缩放
+ * 几何在缩小的缓冲中光栅化（面积按缩放比例的平方减少），再放大到屏幕分辨率
+ *
+ * 特性：
+ * - 坐标照常按屏幕分辨率给出，DrawList 压入缩放变换即可，触摸坐标不用换算
+ * - 双线性放大复用纹理纵向插值（NEON）与横向定点采样
+ * - 低分辨率范围换算成屏幕范围，只放大变化区域
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef GRAPHICS_RENDERSCALE_H
+#define GRAPHICS_RENDERSCALE_H
+
+#include "graphics/Primitives.h"
+#include <cmath>
+#include <cstdint>
+
+namespace Graphics
+{
+
+// 缩放后的尺寸（至少 1 像素）
+inline int scaled_size(int size, float scale)
+{
+    int scaled = (int)std::lround(size * (double)scale);
+    return scaled < 1 ? 1 : scaled;
+}
+
+// 低分辨率缓冲 src_w x src_h 中的 rect 放大后影响的屏幕范围（双线性向外多一个源像素）
+IntRect upscale_bounds(const IntRect &rect, int src_w, int src_h, int dst_w, int dst_h);
+
+// 低分辨率缓冲双线性放大到 dst_w x dst_h，只写 rect 区域（直接覆盖，不混合）
+void upscale_bilinear(uint32_t *dst, int dst_stride, int dst_w, int dst_h, const uint32_t *src, int src_stride, int src_w, int src_h, const IntRect &rect);
+
+} // namespace Graphics
+
+#endif // GRAPHICS_RENDERSCALE_H
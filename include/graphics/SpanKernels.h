@@ -0,0 +1,133 @@
+/*
+ * CPU-Draw - Span Kernels Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 水平扫描线内核
+ * 填充图形的底层像素写入
+ *
+ * 特性：
+ * - 不透明填充 / 常量颜色混合
+ * - 逐像素颜色混合（渐变、贴图）
+ * - 覆盖率遮罩混合（字形、抗锯齿）
+ * - ARM NEON 加速，除法改为乘法+移位
+ * - 预乘管线下 dst = src + dst * (1 - a)，四通道同一公式，输出 alpha 正确
+ * - SDF 采样：纵向插值与距离转覆盖率按整行向量化
+ *
+ * 调用方负责裁剪，内核不做边界检查
+ * color 参数为直通颜色；src 像素与 dst 一样为缓冲区像素格式（见 Primitives.h）
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef GRAPHICS_SPANKERNELS_H
+#define GRAPHICS_SPANKERNELS_H
+
+#include "graphics/Primitives.h"
+#include <cstdint>
+
+namespace Graphics
+{
+
+// x / 255 (四舍五入)，x <= 255 * 255
+inline uint32_t div255(uint32_t x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+// 直通混合：(color * a + dst * (255 - a)) / 255，结果 alpha 固定为 255
+inline uint32_t blend_pixel_straight(uint32_t dst, uint32_t color, uint32_t a)
+{
+    uint32_t ia = 255 - a;
+
+    uint32_t rb = (color & 0x00FF00FF) * a + (dst & 0x00FF00FF) * ia + 0x00800080;
+    rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+
+    uint32_t g = ((color >> 8) & 0xFF) * a + ((dst >> 8) & 0xFF) * ia + 0x80;
+    g = ((g + (g >> 8)) >> 8) & 0xFF;
+
+    return rb | (g << 8) | 0xFF000000;
+}
+
+// 四通道插值：(c * a + dst * (255 - a)) / 255
+inline uint32_t lerp_pixel(uint32_t dst, uint32_t c, uint32_t a)
+{
+    uint32_t ia = 255 - a;
+
+    uint32_t rb = (c & 0x00FF00FF) * a + (dst & 0x00FF00FF) * ia + 0x00800080;
+    rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+
+    uint32_t ag = ((c >> 8) & 0x00FF00FF) * a + ((dst >> 8) & 0x00FF00FF) * ia + 0x00800080;
+    ag = (ag + ((ag >> 8) & 0x00FF00FF)) & 0xFF00FF00;
+
+    return rb | ag;
+}
+
+// 预乘源混合：src + dst * ia / 255，ia = 255 - src.a
+inline uint32_t blend_pixel_premul(uint32_t dst, uint32_t src, uint32_t ia)
+{
+#if CPUDRAW_PREMULTIPLIED
+    // 预乘分量不大于 alpha，相加不会进位
+    return src + scale_pixel(dst, ia);
+#else
+    // 直通管线的目标 alpha 恒为 255
+    return ((src & 0x00FFFFFF) + (scale_pixel(dst, ia) & 0x00FFFFFF)) | 0xFF000000;
+#endif
+}
+
+// 单像素混合直通颜色
+inline uint32_t blend_color(uint32_t dst, uint32_t color)
+{
+    uint32_t a = color >> 24;
+    if (a == 255) return color;
+    if (a == 0) return dst;
+#if CPUDRAW_PREMULTIPLIED
+    // 预乘后再混合与把不透明颜色按 a 插值等价，只舍入一次
+    return lerp_pixel(dst, color | 0xFF000000, a);
+#else
+    return blend_pixel_straight(dst, color, a);
+#endif
+}
+
+// 不透明填充
+void span_fill(uint32_t *dst, int count, uint32_t color);
+
+// 常量颜色混合
+void span_blend(uint32_t *dst, int count, uint32_t color);
+
+// 逐像素颜色混合（预乘管线下 src 为预乘颜色，与 span_blend_premul 相同）
+void span_blend_colors(uint32_t *dst, const uint32_t *src, int count);
+
+// 覆盖率遮罩混合，实际 alpha = mask * color.a / 255
+void span_blend_mask(uint32_t *dst, const uint8_t *mask, int count, uint32_t color);
+
+// 预乘 alpha 源混合，dst = src + dst * (255 - src.a) / 255
+void span_blend_premul(uint32_t *dst, const uint32_t *src, int count);
+
+// 逐通道调制：dst = src * color / 255（color 为缓冲区像素格式，预乘纹理着色）
+void span_modulate(uint32_t *dst, const uint32_t *src, int count, uint32_t color);
+
+// 纹理纵向插值：dst = (row0 * (256 - fy) + row1 * fy) / 256，fy 取 0..255
+void span_image_lerp_rows(uint32_t *dst, const uint32_t *row0, const uint32_t *row1, int count, int fy);
+
+// 纹理横向采样：u、du 为 16.16 定点纹素坐标，超出 [0, width - 1] 的取边缘值
+void span_image_sample_nearest(uint32_t *dst, const uint32_t *row, int width, int32_t u, int32_t du, int count);
+void span_image_sample_bilinear(uint32_t *dst, const uint32_t *row, int width, int32_t u, int32_t du, int count);
+
+// 转 RGB565（R 在高位），(x, y) 为起点屏幕坐标，用于 4x4 有序抖动
+void span_convert_rgb565(uint16_t *dst, const uint32_t *src, int count, int x, int y);
+
+// SDF 纵向插值：dst = row0 * (128 - fy) + row1 * fy，fy 取 0..128，结果为距离 × 128
+void span_sdf_lerp_rows(uint16_t *dst, const uint8_t *row0, const uint8_t *row1, int count, int fy);
+
+// SDF 横向采样：u、du 为 16.16 定点纹素坐标，超出 [0, width - 1] 的取边缘值
+void span_sdf_sample(uint16_t *dst, const uint16_t *row, int width, int32_t u, int32_t du, int count);
+
+// SDF 距离转覆盖率：mask = clamp((dist - edge) * gain / 4096 + 127.5)
+// dist / edge 为距离 × 128，gain 不超过 65535
+void span_sdf_coverage(uint8_t *mask, const uint16_t *dist, int count, int edge, int gain);
+
+} // namespace Graphics
+
+#endif // GRAPHICS_SPANKERNELS_H
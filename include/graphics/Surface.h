@@ -0,0 +1,83 @@
+/*
+ * CPU-Draw - Surface Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 离屏像素缓冲
+ * 缓存静态内容，之后每帧只需一次贴图
+ *
+ * 特性：
+ * - 像素为预乘 alpha（透明区域为 0）
+ * - 版本号随内容更新递增，用于帧签名
+ * - 预乘管线直接绘制即可；直通管线用黑白两次绘制提取 alpha
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef GRAPHICS_SURFACE_H
+#define GRAPHICS_SURFACE_H
+
+#include "graphics/Primitives.h"
+#include <cstdint>
+#include <vector>
+
+namespace Graphics
+{
+
+// 离屏缓冲
+class Surface
+{
+  public:
+    Surface();
+
+    // 调整尺寸，尺寸变化时内容清空并返回 true
+    bool Resize(int width, int height);
+
+    // 由同一内容分别画在黑底、白底上的结果生成预乘像素
+    // on_black 可以就是 GetPixels()，结果原地写回
+    void ResolveBlackWhite(const uint32_t *on_black, const uint32_t *on_white);
+
+    // 内容已更新
+    void MarkUpdated()
+    {
+        version++;
+    }
+
+    int GetWidth() const
+    {
+        return width;
+    }
+    int GetHeight() const
+    {
+        return height;
+    }
+    int GetStride() const
+    {
+        return width;
+    }
+    uint32_t *GetPixels()
+    {
+        return pixels.data();
+    }
+    const uint32_t *GetPixels() const
+    {
+        return pixels.data();
+    }
+    uint32_t GetVersion() const
+    {
+        return version;
+    }
+
+  private:
+    int width;
+    int height;
+    uint32_t version;
+    std::vector<uint32_t> pixels;
+};
+
+// 预乘贴图，(x, y) 为左上角，clip 为空时只裁剪到缓冲区
+void draw_surface(uint32_t *pixels, int stride, int width, int height, const Surface &surface, int x, int y, const IntRect *clip = nullptr);
+
+} // namespace Graphics
+
+#endif // GRAPHICS_SURFACE_H
@@ -0,0 +1,162 @@
+/*
+ * CPU-Draw - Texture Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 图片 / 图标纹理
+ * 载入时一次性转成预乘像素（与 Surface 相同），绘制时整行拷贝或混合
+ *
+ * 特性：
+ * - RGBA 字节输入（直通 alpha），可选 mipmap（2x2 盒式滤波）
+ * - 原尺寸、缩放、着色三种绘制，缩放支持最近邻 / 双线性
+ * - 双线性先纵向插值整行（NEON），再横向定点步进采样
+ * - 缩小超过一半时自动选 mip 层，不会闪烁走样
+ * - 按名字缓存的纹理表，启动时载入，每帧只取指针
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef GRAPHICS_TEXTURE_H
+#define GRAPHICS_TEXTURE_H
+
+#include "graphics/Primitives.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Graphics
+{
+
+// 缩放采样方式
+enum class TextureFilter : uint32_t
+{
+    Nearest,
+    Bilinear
+};
+
+// 缩放贴图参数（录制模式整体存入数据区）
+struct TextureSampling
+{
+    IntRect source; // 纹理像素坐标，包含边界
+    TextureFilter filter;
+    uint32_t tint;
+};
+
+// 纹理（预乘 alpha）
+class Texture
+{
+  public:
+    Texture();
+
+    // 由 RGBA 字节（直通 alpha）载入，stride 为每行字节数（0 表示紧密排列）
+    bool Load(const uint8_t *rgba, int width, int height, int stride = 0, bool mipmaps = false);
+    // 由已预乘的像素载入（如 Surface 内容），stride 以像素计
+    bool LoadPremultiplied(const uint32_t *pixels, int width, int height, int stride = 0, bool mipmaps = false);
+
+    // 由第 0 层重新生成各级 mipmap
+    void GenerateMipmaps();
+
+    int GetWidth() const
+    {
+        return levels.empty() ? 0 : levels[0].width;
+    }
+    int GetHeight() const
+    {
+        return levels.empty() ? 0 : levels[0].height;
+    }
+    int GetLevelCount() const
+    {
+        return (int)levels.size();
+    }
+    int GetLevelWidth(int level) const
+    {
+        return levels[level].width;
+    }
+    int GetLevelHeight(int level) const
+    {
+        return levels[level].height;
+    }
+    // 各层紧密排列，行跨度等于该层宽度
+    const uint32_t *GetLevelPixels(int level) const
+    {
+        return pixels.data() + levels[level].offset;
+    }
+    const uint32_t *GetPixels() const
+    {
+        return pixels.data();
+    }
+    uint32_t GetVersion() const
+    {
+        return version;
+    }
+    bool IsEmpty() const
+    {
+        return levels.empty();
+    }
+    size_t GetMemoryUsage() const
+    {
+        return pixels.size() * sizeof(uint32_t);
+    }
+
+    // 缩放到 dst_w x dst_h 时使用的 mip 层（缩小比例 >= 2 时下降）
+    int SelectLevel(float src_w, float src_h, int dst_w, int dst_h) const;
+
+  private:
+    struct Level
+    {
+        int width, height;
+        size_t offset;
+    };
+
+    std::vector<Level> levels;
+    std::vector<uint32_t> pixels;
+    uint32_t version;
+
+    bool Allocate(int width, int height);
+};
+
+// 纹理表：按名字保存，指针在 Remove / Clear 之前一直有效（同名重新载入时原地更新）
+class TextureCache
+{
+  public:
+    static TextureCache &Instance()
+    {
+        static TextureCache instance;
+        return instance;
+    }
+
+    // 载入并转换，失败返回空指针
+    const Texture *Load(const std::string &name, const uint8_t *rgba, int width, int height, int stride = 0, bool mipmaps = true);
+    const Texture *Find(const std::string &name) const;
+
+    void Remove(const std::string &name);
+    void Clear();
+
+    size_t GetCount() const
+    {
+        return textures.size();
+    }
+    size_t GetMemoryUsage() const;
+
+  private:
+    TextureCache()
+    {
+    }
+    TextureCache(const TextureCache &) = delete;
+    TextureCache &operator=(const TextureCache &) = delete;
+
+    std::unordered_map<std::string, std::unique_ptr<Texture>> textures;
+};
+
+// 原尺寸贴图，(x, y) 为左上角；tint 为直通 alpha 颜色，白色不透明时不着色
+void draw_texture(uint32_t *pixels, int stride, int width, int height, const Texture &texture, int x, int y, uint32_t tint = 0xFFFFFFFF, const IntRect *clip = nullptr);
+
+// 缩放贴图：source（纹理像素坐标，包含边界，为空时取整张）映射到 (x0, y0) - (x1, y1)
+void draw_texture_scaled(uint32_t *pixels, int stride, int width, int height, const Texture &texture, int x0, int y0, int x1, int y1, const IntRect *source = nullptr, TextureFilter filter = TextureFilter::Bilinear, uint32_t tint = 0xFFFFFFFF, const IntRect *clip = nullptr);
+
+} // namespace Graphics
+
+#endif // GRAPHICS_TEXTURE_H
@@ -0,0 +1,86 @@
+/*
+ * CPU-Draw - Tile Renderer Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 分块多线程光栅化
+ * 回放 CommandBuffer，按 64x64 分块并行绘制
+ *
+ * 特性：
+ * - 命令按范围分箱到分块
+ * - 固定线程池，原子计数领取分块
+ * - 每个分块以自身为裁剪区，只写自己的像素，帧缓冲无需加锁
+ * - 并行前预热字形缓存（缓存只允许单线程写）
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef GRAPHICS_TILERENDERER_H
+#define GRAPHICS_TILERENDERER_H
+
+#include "graphics/CommandBuffer.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Graphics
+{
+
+// 分块渲染器
+class TileRenderer
+{
+  public:
+    static const int TILE_SIZE = 64;
+
+    // thread_count <= 0 时使用全部核心
+    explicit TileRenderer(int thread_count = 0);
+    ~TileRenderer();
+
+    // 剔除/合并后分块并行光栅化，结果与 CommandBuffer::Flush 一致
+    void Render(CommandBuffer &commands, uint32_t *pixels, int stride, int width, int height);
+
+    int GetThreadCount() const
+    {
+        return (int)workers.size() + 1;
+    }
+
+  private:
+    TileRenderer(const TileRenderer &) = delete;
+    TileRenderer &operator=(const TileRenderer &) = delete;
+
+    // 命令数少于此值时直接单线程回放
+    static const int PARALLEL_MIN_COMMANDS = 16;
+
+    std::vector<std::thread> workers;
+    std::vector<RasterScratch> scratches;
+
+    // 分箱结果
+    int tilesX, tilesY;
+    std::vector<std::vector<uint32_t>> bins;
+
+    // 当前任务
+    const CommandBuffer *job;
+    uint32_t *jobPixels;
+    int jobStride, jobWidth, jobHeight;
+    std::atomic<int> nextTile;
+
+    std::mutex mutex;
+    std::condition_variable startCond;
+    std::condition_variable doneCond;
+    uint64_t jobId;
+    int pending;
+    bool quit;
+
+    void Bin(const CommandBuffer &commands, int width, int height);
+    bool PrewarmText(const CommandBuffer &commands);
+    void RunTiles(RasterScratch &scratch);
+    void RenderTile(int tile, RasterScratch &scratch);
+    void WorkerLoop(int index);
+};
+
+} // namespace Graphics
+
+#endif // GRAPHICS_TILERENDERER_H
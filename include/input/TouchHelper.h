@@ -17,7 +17,9 @@
 #ifndef INPUT_TOUCHHELPER_H
 #define INPUT_TOUCHHELPER_H
 
+#include "core/FrameArena.h"
 #include "core/VectorStruct.h"
+#include <cstring>
 #include <functional>
 #include <linux/input.h>
 #include <vector>
@@ -101,6 +103,7 @@ struct GestureData
 // 触摸回调函数类型
 using TouchCallback = std::function<void(std::vector<TouchDevice> *)>;
 using GestureCallback = std::function<void(const GestureData &)>;
+using EventNotifyCallback = std::function<void()>;
 
 // 初始化触摸系统
 bool Init(const My_Vector2 &screenSize, bool readOnly = false);
@@ -124,10 +127,17 @@ void MultiTouch(const std::vector<My_Vector2> &positions);
 // 上传触摸事件到系统
 void Upload();
 
+// 派发读取线程投递的触摸快照（渲染线程每帧调用一次）
+// 手势识别与触摸回调都在调用线程上执行
+void DispatchEvents();
+
 // 设置回调
 void SetTouchCallback(const TouchCallback &callback);
 void SetGestureCallback(const GestureCallback &callback);
 
+// 有新快照入队时在读取线程调用（用于唤醒渲染循环，须线程安全且不阻塞）
+void SetEventNotify(const EventNotifyCallback &callback);
+
 // 坐标转换
 My_Vector2 TouchToScreen(const My_Vector2 &touchCoord);
 My_Vector2 ScreenToTouch(const My_Vector2 &screenCoord);
@@ -135,12 +145,17 @@ My_Vector2 ScreenToTouch(const My_Vector2 &screenCoord);
 // 获取缩放比例
 My_Vector2 GetScale();
 
+// 屏幕尺寸或方向变化时原地更新换算参数，不重新打开设备（在渲染线程调用）
+void SetScreenSize(const My_Vector2 &screenSize);
+
 // 设置屏幕方向
 void SetOrientation(int orientation);
 
 // 获取当前触摸点
 const std::vector<TouchDevice> &GetDevices();
 std::vector<TouchPoint> GetActiveTouches();
+// 写入 out（先清空），out 可绑定帧内 arena，每帧查询不分配堆内存
+void GetActiveTouches(Core::ArenaVector<TouchPoint> &out);
 int GetTouchCount();
 
 // 触摸点查询
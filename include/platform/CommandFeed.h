@@ -0,0 +1,146 @@
+/*
+ * CPU-Draw - Command Feed Module
+ * Created: 2026-10-15
+ * By: MaySnowL
+ *
+ * 跨进程绘制命令输入
+ * 数据生产者（实体位置、名字、血量）在另一个进程用 DrawList 录制，命令写入共享内存，渲染进程直接回放
+ *
+ * 特性：
+ * - 帧格式即录制模式的 POD 命令（DrawCommand + 数据区），带版本号，渲染端不解析文本、不复制
+ * - memfd 共享内存三缓冲：生产者写空闲槽后原子发布，渲染端每帧取最新的完整帧，双方都不等待
+ * - 渲染端通过抽象 unix socket 把 memfd / eventfd 交给生产者，新帧由 eventfd 通知（唤醒帧调度器）
+ * - 同一时间只接受一个生产者（同 uid 或 root），断开后它的帧不再显示
+ * - 新帧只做一次越界检查（CommandBuffer::Validate），引用进程内指针的命令被拒绝，命令范围限制在帧尺寸内
+ *
+ * 生产者视为可信：检查防的是版本不一致和程序错误，不防止发布后继续改写已发布的槽
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef PLATFORM_COMMANDFEED_H
+#define PLATFORM_COMMANDFEED_H
+
+#include "graphics/CommandBuffer.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Platform
+{
+
+// 共享内存布局版本：DrawCommand、DrawOp 或下列结构变化时递增
+static const uint32_t COMMAND_FEED_VERSION = 1;
+
+// 一帧：位于槽的开头，后接 DrawCommand 数组与数据区
+struct FeedFrame
+{
+    uint32_t sequence;        // 生产者递增的帧序号
+    int32_t width, height;    // 录制时的目标尺寸
+    uint32_t commandCount;
+    uint32_t dataSize;
+    uint32_t reserved;
+    Graphics::IntRect bounds; // 所有命令范围的并集
+
+    const Graphics::DrawCommand *GetCommands() const
+    {
+        return reinterpret_cast<const Graphics::DrawCommand *>(this + 1);
+    }
+    const uint8_t *GetData() const
+    {
+        return reinterpret_cast<const uint8_t *>(GetCommands() + commandCount);
+    }
+};
+
+struct FeedHeader;
+
+// 渲染端：创建共享内存，等待生产者连接，每帧取最新的完整帧
+class CommandFeedServer
+{
+  public:
+    static const size_t DEFAULT_SLOT_SIZE = 2 * 1024 * 1024;
+
+    // 新帧到达或生产者断开时在监听线程调用，须线程安全且不阻塞
+    typedef std::function<void()> ChangeCallback;
+
+    CommandFeedServer();
+    ~CommandFeedServer();
+
+    // 在抽象 unix socket name 上监听，slotSize 为每帧（帧头 + 命令 + 数据）的容量
+    bool Start(const char *name, size_t slotSize = DEFAULT_SLOT_SIZE);
+    void Stop();
+
+    void SetChangeNotify(const ChangeCallback &callback);
+
+    // 渲染端期望的录制尺寸（写进共享内存，生产者据此录制）
+    void SetTargetSize(int width, int height);
+
+    // 渲染线程：有新帧时切换到新帧，返回当前帧
+    // 返回的帧在下一次 Acquire 之前有效，没有生产者、尚无帧或帧未通过检查时返回 nullptr
+    const FeedFrame *Acquire();
+
+  private:
+    CommandFeedServer(const CommandFeedServer &) = delete;
+    CommandFeedServer &operator=(const CommandFeedServer &) = delete;
+
+    void ListenThread();
+    bool SendHandles(int client);
+
+    FeedHeader *header;
+    size_t mapSize;
+    int memFd;
+    int eventFd;
+    int listenFd;
+    int stopFd;
+
+    std::mutex notifyMutex;
+    ChangeCallback notify;
+    std::thread thread;
+
+    std::atomic<bool> connected;
+    std::atomic<uint32_t> generation; // 每次有新生产者连接时递增
+
+    // 仅渲染线程访问
+    const FeedFrame *current;
+    uint32_t acquiredGeneration;
+};
+
+// 生产者：连接渲染端，把录制好的命令发布到共享内存
+class CommandFeedClient
+{
+  public:
+    CommandFeedClient();
+    ~CommandFeedClient();
+
+    // 连接并映射共享内存，版本不一致或已有生产者时返回 false
+    bool Connect(const char *name);
+    void Disconnect();
+    bool IsConnected() const
+    {
+        return header != nullptr;
+    }
+
+    // 渲染端期望的录制尺寸，渲染端尚未设置时为 0
+    void GetTargetSize(int &width, int &height) const;
+
+    // 复制进空闲槽后原子发布，width / height 为录制时的目标尺寸
+    // 超出槽容量或含有不能跨进程的命令时返回 false
+    bool Publish(const Graphics::CommandBuffer &buffer, int width, int height);
+
+  private:
+    CommandFeedClient(const CommandFeedClient &) = delete;
+    CommandFeedClient &operator=(const CommandFeedClient &) = delete;
+
+    FeedHeader *header;
+    size_t mapSize;
+    int socketFd;
+    int eventFd;
+    uint32_t sequence;
+};
+
+} // namespace Platform
+
+#endif // PLATFORM_COMMANDFEED_H
@@ -0,0 +1,95 @@
+/*
+ * CPU-Draw - Display Monitor Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 屏幕状态监视
+ * 后台线程低频查询屏幕尺寸与方向（binder 调用不进渲染循环），渲染线程每帧只读缓存
+ *
+ * 特性：
+ * - 查询函数由调用方提供（Android 上为 ANativeWindowCreator::GetDisplayInfo）
+ * - 变化时递增版本号并回调通知（用于唤醒帧调度器）
+ * - 渲染线程 Poll() 只比较版本号，无变化时不加锁
+ * - Refresh() 立即重新查询，不用等下一个轮询周期
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef PLATFORM_DISPLAYMONITOR_H
+#define PLATFORM_DISPLAYMONITOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Platform
+{
+
+// 屏幕状态（当前方向下的宽高）
+struct DisplayState
+{
+    int width;
+    int height;
+    int orientation; // 0..3，顺时针 90° 为一档
+    uint64_t version;
+
+    bool IsLandscape() const
+    {
+        return width > height;
+    }
+};
+
+class DisplayMonitor
+{
+  public:
+    // 查询屏幕状态，失败返回 false（在轮询线程调用）
+    typedef std::function<bool(DisplayState &)> QueryFunction;
+    // 状态变化时在轮询线程调用，须线程安全且不阻塞
+    typedef std::function<void()> ChangeCallback;
+
+    static DisplayMonitor &Instance();
+
+    // 先同步查询一次再启动轮询线程，首次查询失败返回 false
+    bool Start(const QueryFunction &query, int intervalMs = 500);
+    void Stop();
+
+    void SetChangeNotify(const ChangeCallback &callback);
+
+    // 唤醒轮询线程立即查询（任意线程可调用）
+    void Refresh();
+
+    // 最近一次查询结果
+    DisplayState Get() const;
+
+    // 渲染线程：自上次 Poll 之后有变化时返回 true 并取出最新状态
+    bool Poll(DisplayState &state);
+
+  private:
+    DisplayMonitor();
+    DisplayMonitor(const DisplayMonitor &) = delete;
+    DisplayMonitor &operator=(const DisplayMonitor &) = delete;
+
+    void PollThread();
+    void Update(const DisplayState &queried);
+
+    QueryFunction query;
+    ChangeCallback notify;
+    int intervalMs;
+
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+    std::thread thread;
+    bool running;
+    bool refreshRequested;
+
+    DisplayState state;
+    std::atomic<uint64_t> version;
+    uint64_t polledVersion; // 仅渲染线程访问
+};
+
+} // namespace Platform
+
+#endif // PLATFORM_DISPLAYMONITOR_H
@@ -0,0 +1,138 @@
+/*
+ * CPU-Draw - Frame Scheduler Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 帧调度器
+ * 按显示刷新节奏驱动渲染循环，给出真实的帧间隔
+ *
+ * 特性：
+ * - AChoreographer 垂直同步回调驱动（运行时解析，不可用时自动降级）
+ * - 降级为 CLOCK_MONOTONIC 绝对时间休眠，纳秒精度、不累积误差
+ * - 帧率策略：跟随刷新率 / 每 N 个垂直同步一帧 / 固定帧率
+ * - 无事可做时挂起，由 Wake() 唤醒，空闲不占 CPU
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef PLATFORM_FRAMESCHEDULER_H
+#define PLATFORM_FRAMESCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace Platform
+{
+
+// 帧率策略
+struct PacingPolicy
+{
+    int targetFps;     // 目标帧率，0 表示跟随显示刷新率
+    bool idleSkip;     // 没有 Wake() 请求时跳过渲染
+    int idleTimeoutMs; // 空闲挂起的最长时间，到时仍会跑一帧（兜底，屏幕变化由 DisplayMonitor 唤醒）
+
+    PacingPolicy() : targetFps(0), idleSkip(true), idleTimeoutMs(500)
+    {
+    }
+};
+
+class FrameScheduler
+{
+  public:
+    static FrameScheduler &Instance();
+
+    // 在渲染线程调用，绑定当前线程的 Looper 与 Choreographer
+    void Init();
+    void Shutdown();
+
+    // 帧率策略
+    void SetPolicy(const PacingPolicy &policy);
+    const PacingPolicy &GetPolicy() const
+    {
+        return policy;
+    }
+    void SetTargetFps(int fps);
+    int GetTargetFps() const
+    {
+        return policy.targetFps;
+    }
+
+    // 等待下一帧开始，返回与上一帧的真实间隔（秒）
+    // 空闲跳过开启时，没有 Wake() 请求会一直挂起到 idleTimeoutMs
+    float WaitFrame();
+
+    // 请求渲染下一帧（任意线程可调用）
+    void Wake();
+
+    // 本帧是否由 Wake() 请求（否则为空闲超时帧）
+    bool IsRequestedFrame() const
+    {
+        return requestedFrame;
+    }
+
+    // 帧信息
+    int64_t GetFrameTimeNs() const
+    {
+        return frameTimeNs;
+    }
+    float GetDeltaTime() const
+    {
+        return deltaTime;
+    }
+    float GetRefreshRate() const;
+    bool IsVsyncDriven() const
+    {
+        return choreographer != nullptr;
+    }
+
+    // 单调时钟（纳秒）
+    static int64_t NowNs();
+
+  private:
+    FrameScheduler();
+    FrameScheduler(const FrameScheduler &) = delete;
+    FrameScheduler &operator=(const FrameScheduler &) = delete;
+
+    static const int64_t DEFAULT_PERIOD_NS = 16666667; // 无法测量时按 60Hz
+    static const int64_t MAX_DELTA_NS = 100000000;     // 帧间隔上限，避免动画跳变
+    static const int VSYNC_TIMEOUT_MS = 100;           // 超时未收到回调则降级
+
+    static void OnVsync(int64_t frameTimeNanos, void *data);
+    void PostVsync();
+
+    bool WaitWake(int timeoutMs);
+    int64_t WaitVsync(int interval);
+    int64_t WaitDeadline(int64_t periodNs);
+    void DisableVsync();
+
+    PacingPolicy policy;
+
+    // Choreographer（仅 Android）
+    void *looper;
+    void *choreographer;
+    bool vsyncPosted;
+    int64_t vsyncTimeNs;
+    uint64_t vsyncCount;
+    int64_t vsyncPeriodNs;
+    bool periodMeasured;
+
+    // 降级路径
+    int64_t nextDeadlineNs;
+
+    // 空闲唤醒
+    std::atomic<bool> wakeRequested;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCond;
+
+    // 帧信息
+    int64_t frameTimeNs;
+    float deltaTime;
+    bool requestedFrame;
+    bool resumed; // 上一次等待经历了空闲挂起
+};
+
+} // namespace Platform
+
+#endif // PLATFORM_FRAMESCHEDULER_H
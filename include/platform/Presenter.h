@@ -0,0 +1,159 @@
+/*
+ * CPU-Draw - Presenter Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 帧提交
+ * 绘制写入自有后台缓冲，提交阶段只把变化区域拷进窗口缓冲并投递
+ *
+ * 特性：
+ * - 两个 64 字节对齐的后台缓冲，行跨度按缓存行取整
+ * - 每个后台缓冲记录自身内容范围，只修补与本帧绘制范围的并集
+ * - 流水线模式：提交线程阻塞在 lock 等合成器时，渲染线程继续画下一帧
+ * - 串行模式：在渲染线程直接提交（调试 / 单核设备）
+ * - 尺寸真正变化时才重新设置窗口缓冲几何
+ * - 窗口缓冲可以是 RGBA8888 或 RGB565，提交拷贝时转换（后台缓冲始终 32 位）
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef PLATFORM_PRESENTER_H
+#define PLATFORM_PRESENTER_H
+
+#include "graphics/PixelFormat.h"
+#include "graphics/Primitives.h"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#ifdef __ANDROID__
+#include <android/native_window.h>
+#endif
+
+namespace Platform
+{
+
+// 锁定后的目标缓冲
+struct LockedBuffer
+{
+    void *bits;
+    int stride; // 像素
+    Graphics::PixelFormat format;
+    int width;
+    int height;
+    Graphics::IntRect dirty; // 传入请求的脏矩形，返回系统实际要求填充的范围
+};
+
+// 提交目标（窗口缓冲）
+class PresentTarget
+{
+  public:
+    virtual ~PresentTarget()
+    {
+    }
+
+    // 尺寸变化时调用
+    virtual bool SetGeometry(int width, int height) = 0;
+    virtual bool Lock(LockedBuffer &buffer) = 0;
+    virtual void Post() = 0;
+};
+
+#ifdef __ANDROID__
+// ANativeWindow（RGBA_8888 / RGB_565）
+class NativeWindowTarget : public PresentTarget
+{
+  public:
+    explicit NativeWindowTarget(ANativeWindow *window, Graphics::PixelFormat format = Graphics::PixelFormat::RGBA8888) : window(window), format(format)
+    {
+    }
+
+    bool SetGeometry(int width, int height) override;
+    bool Lock(LockedBuffer &buffer) override;
+    void Post() override;
+
+  private:
+    ANativeWindow *window;
+    Graphics::PixelFormat format;
+};
+#endif
+
+// 后台缓冲
+struct BackBuffer
+{
+    uint32_t *pixels;
+    int stride; // 像素，按 16 像素（64 字节）对齐
+    int width;
+    int height;
+    Graphics::IntRect content; // 当前保存的绘制范围，其余区域为 0
+};
+
+class Presenter
+{
+  public:
+    static const int BUFFER_COUNT = 2;
+
+    Presenter();
+    ~Presenter();
+
+    // pipelined 为 true 时启动提交线程
+    void Start(PresentTarget *target, bool pipelined);
+    // 提交完已排队的帧后退出
+    void Stop();
+
+    // 取一个空闲后台缓冲（必要时等待提交完成），尺寸变化时重新分配并清零
+    // 返回的缓冲保留上次的内容：调用方需清空 content ∪ 本帧范围 再绘制
+    // 提交失败后返回 nullptr
+    BackBuffer *Acquire(int width, int height);
+
+    // 提交已绘制的缓冲，drawn 为本帧绘制范围
+    void Submit(BackBuffer *buffer, const Graphics::IntRect &drawn);
+
+    bool IsPipelined() const
+    {
+        return pipelined;
+    }
+    bool HasFailed() const;
+
+  private:
+    enum class BufferState : uint8_t
+    {
+        Free,
+        Rendering,
+        Queued,
+        Presenting
+    };
+
+    struct Slot
+    {
+        BackBuffer buffer;
+        BufferState state;
+        uint64_t sequence;        // 提交序号，越大越新
+        Graphics::IntRect damage; // 相对上一帧已投递内容的变化范围
+    };
+
+    Presenter(const Presenter &) = delete;
+    Presenter &operator=(const Presenter &) = delete;
+
+    void PresentThread();
+    bool PresentSlot(Slot &slot);
+    static bool Allocate(BackBuffer &buffer, int width, int height);
+    static void Release(BackBuffer &buffer);
+
+    PresentTarget *target;
+    bool pipelined;
+    Slot slots[BUFFER_COUNT];
+    uint64_t submitted;                  // 已提交帧数
+    Graphics::IntRect lastSubmittedBounds;
+    int presentedWidth, presentedHeight; // 目标缓冲当前几何
+
+    std::thread thread;
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+    bool running;
+    bool failed;
+};
+
+} // namespace Platform
+
+#endif // PLATFORM_PRESENTER_H
@@ -0,0 +1,131 @@
+/*
+ * CPU-Draw - Quality Governor Module
+ * Created: 2026-10-15
+ * By: MaySnowL
+ *
+ * 自适应画质
+ * 按实测的渲染耗时与温控状态逐档降低画质，目标是在给定 CPU 预算内保持稳定帧率，
+ * 而不是先跑满帧率、等 SoC 发热降频后帧率崩掉
+ *
+ * 特性：
+ * - 档位依次叠加：关阴影 → 关抗锯齿 → 降低文字刷新频率 → 渲染缩放 0.75 / 0.5 → 帧率减半
+ * - 预算按帧间隔的比例给出，降帧率后每帧预算随之变大
+ * - 迟滞：超预算持续若干帧才降档，低于上一档预算的一定比例且持续更久才升档，切档后先冷却
+ * - 升档后很快又降回来时，该档的升档等待时间加倍，避免来回振荡
+ * - 温控状态给出最低档位，发热时直接跳到对应档位
+ *
+ * 只在渲染线程使用
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef PLATFORM_QUALITYGOVERNOR_H
+#define PLATFORM_QUALITYGOVERNOR_H
+
+#include "platform/ThermalMonitor.h"
+#include <cstdint>
+
+namespace Platform
+{
+
+// 画质档位，数值越大越省（包含前面各档的降级）
+enum class QualityLevel : uint8_t
+{
+    Full,
+    NoShadow,       // 关闭菜单阴影
+    NoAntiAliasing, // 关闭覆盖率抗锯齿
+    SlowRefresh,    // 帧率等文字标签降低刷新频率（减少菜单缓存与排版缓存失效）
+    Scale75,        // 渲染缩放 0.75
+    Scale50,        // 渲染缩放 0.5
+    ReducedFps,     // 目标帧率减半
+    Count
+};
+
+// 档位对应的设置
+struct QualitySettings
+{
+    bool shadows;
+    bool antiAliasing;
+    int labelRefreshMs; // 文字标签刷新间隔
+    float renderScale;  // 渲染缩放上限
+    float fpsScale;     // 目标帧率倍数
+};
+
+struct GovernorConfig
+{
+    float cpuBudget;       // 每帧渲染耗时占帧间隔的比例上限
+    float upgradeRatio;    // 耗时低于上一档预算的该比例才考虑升档
+    int downgradeFrames;   // 超预算持续帧数
+    int upgradeFrames;     // 低负载持续帧数（基础值，振荡时按档位加倍）
+    int cooldownFrames;    // 切档后不采样的帧数
+    QualityLevel maxLevel; // 最多降到的档位
+
+    GovernorConfig() : cpuBudget(0.6f), upgradeRatio(0.7f), downgradeFrames(20), upgradeFrames(180), cooldownFrames(30), maxLevel(QualityLevel::ReducedFps)
+    {
+    }
+};
+
+class QualityGovernor
+{
+  public:
+    explicit QualityGovernor(const GovernorConfig &config = GovernorConfig());
+
+    void SetConfig(const GovernorConfig &config);
+    const GovernorConfig &GetConfig() const
+    {
+        return config;
+    }
+
+    // 每帧实际渲染之后调用：workNs 为本帧渲染线程耗时，baseFps 为不降帧率时的目标帧率
+    // 档位变化时返回 true
+    bool Update(int64_t workNs, float baseFps);
+
+    // 温控状态与余量（负数为未知），需要时立即降档；档位变化时返回 true
+    bool SetThermal(ThermalStatus status, float headroom);
+
+    // 回到最高画质并清空统计（如关闭自适应时）
+    void Reset();
+
+    QualityLevel GetLevel() const
+    {
+        return level;
+    }
+    QualitySettings GetSettings() const
+    {
+        return SettingsFor(level);
+    }
+    static QualitySettings SettingsFor(QualityLevel level);
+    static const char *GetLevelName(QualityLevel level);
+
+    // 该档位的每帧预算（纳秒）
+    int64_t GetBudgetNs(QualityLevel level, float baseFps) const;
+    // 平滑后的渲染耗时（纳秒）
+    int64_t GetAverageNs() const
+    {
+        return (int64_t)averageNs;
+    }
+
+  private:
+    static const int LEVEL_COUNT = (int)QualityLevel::Count;
+    static const int MAX_HOLD_SHIFT = 3; // 升档等待最多加倍到 8 倍
+
+    void SetLevel(QualityLevel next);
+
+    GovernorConfig config;
+    QualityLevel level;
+    QualityLevel thermalFloor;
+
+    float averageNs; // 指数平均，0 表示切档后尚无样本
+    int cooldown;
+    int overFrames;
+    int underFrames;
+
+    // 振荡检测：最近一次升档离开的档位，以及之后经过的帧数
+    int upgradedFrom;
+    int framesSinceUpgrade;
+    int holdShift[LEVEL_COUNT];
+};
+
+} // namespace Platform
+
+#endif // PLATFORM_QUALITYGOVERNOR_H
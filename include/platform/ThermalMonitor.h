@@ -0,0 +1,89 @@
+/*
+ * CPU-Draw - Thermal Monitor Module
+ * Created: 2026-10-15
+ * By: MaySnowL
+ *
+ * 温控状态监视
+ * 后台线程低频查询设备温控状态，渲染线程每帧只读原子变量
+ *
+ * 特性：
+ * - Android 11+：AThermal 温控状态，Android 12+ 额外读取温控余量（headroom，1.0 为开始重度降频）
+ * - 不可用时读取 /sys/class/thermal 各温区的最高温度，按温度估算状态
+ * - 状态变化时回调通知（用于唤醒帧调度器）
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef PLATFORM_THERMALMONITOR_H
+#define PLATFORM_THERMALMONITOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Platform
+{
+
+// 与 AThermalStatus 的取值一致
+enum class ThermalStatus : int
+{
+    None,
+    Light,
+    Moderate,
+    Severe,
+    Critical,
+    Emergency,
+    Shutdown
+};
+
+class ThermalMonitor
+{
+  public:
+    // 状态变化时在轮询线程调用，须线程安全且不阻塞
+    typedef std::function<void()> ChangeCallback;
+
+    static ThermalMonitor &Instance();
+
+    // 先同步查询一次再启动轮询线程，没有任何温控来源时返回 false
+    bool Start(int intervalMs = 2000);
+    void Stop();
+
+    void SetChangeNotify(const ChangeCallback &callback);
+
+    ThermalStatus GetStatus() const
+    {
+        return (ThermalStatus)status.load(std::memory_order_relaxed);
+    }
+    // 温控余量，未知时为负数
+    float GetHeadroom() const
+    {
+        return headroom.load(std::memory_order_relaxed);
+    }
+
+  private:
+    ThermalMonitor();
+    ~ThermalMonitor();
+    ThermalMonitor(const ThermalMonitor &) = delete;
+    ThermalMonitor &operator=(const ThermalMonitor &) = delete;
+
+    void PollThread();
+    bool Query(ThermalStatus &queried, float &queriedHeadroom);
+
+    ChangeCallback notify;
+    int intervalMs;
+    void *manager; // AThermalManager
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::thread thread;
+    bool running;
+
+    std::atomic<int> status;
+    std::atomic<float> headroom;
+};
+
+} // namespace Platform
+
+#endif // PLATFORM_THERMALMONITOR_H
@@ -0,0 +1,39 @@
+/*
+ * CPU-Draw - Embedded Font Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 内嵌字体（可选）
+ * CPUDRAW_EMBED_FONT 打开时把 Font.h（或构建时生成的子集）编译进程序，
+ * 作为找不到字体文件时的兜底
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef TEXT_EMBEDDEDFONT_H
+#define TEXT_EMBEDDEDFONT_H
+
+#include <cstddef>
+
+#ifndef CPUDRAW_EMBED_FONT
+#define CPUDRAW_EMBED_FONT 0
+#endif
+
+namespace Text
+{
+
+#if CPUDRAW_EMBED_FONT
+// 获取内嵌字体数据
+bool GetEmbeddedFont(const unsigned char *&data, size_t &size);
+#else
+inline bool GetEmbeddedFont(const unsigned char *&data, size_t &size)
+{
+    data = nullptr;
+    size = 0;
+    return false;
+}
+#endif
+
+} // namespace Text
+
+#endif // TEXT_EMBEDDEDFONT_H
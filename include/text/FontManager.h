@@ -0,0 +1,106 @@
+/*
+ * CPU-Draw - Font Manager Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 字体管理模块
+ * 从磁盘映射字体文件，多字体按回退链查找字形
+ *
+ * 特性：
+ * - mmap 只读映射 TTF / OTF / TTC，只有用到的页才会常驻内存
+ * - 回退链：按顺序查找第一个包含该字符的字体
+ * - 默认查找顺序：CPUDRAW_FONT 环境变量 -> 程序目录 fonts/ -> 内嵌字体（可选编译）-> 系统字体
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef TEXT_FONTMANAGER_H
+#define TEXT_FONTMANAGER_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "stb/stb_truetype.h"
+
+namespace Text
+{
+
+// 已加载的字体
+struct FontFace
+{
+    stbtt_fontinfo info;
+    const unsigned char *data;
+    size_t size;
+    bool mapped; // 由 mmap 映射，释放时 munmap
+    std::string name;
+};
+
+// 字体管理
+class FontManager
+{
+  public:
+    static FontManager &Instance()
+    {
+        static FontManager instance;
+        return instance;
+    }
+
+    ~FontManager();
+
+    // 映射字体文件，index 为 TTC 内的字体序号；返回字体编号，失败返回 -1
+    // 新字体追加到回退链末尾
+    int LoadFile(const char *path, int index = 0);
+
+    // 从内存加载（不复制，调用方保证数据有效）
+    int LoadMemory(const unsigned char *data, size_t size, int index = 0, const char *name = "memory");
+
+    // 按默认顺序加载主字体和系统回退字体，至少加载一个时返回 true
+    bool LoadDefaults();
+
+    // 设置回退链（字体编号，第一个为主字体，行高等度量取自主字体）
+    void SetFallbackChain(const std::vector<int> &faces);
+    const std::vector<int> &GetFallbackChain() const
+    {
+        return chain;
+    }
+
+    // 查找包含该字符的字体，都不包含时返回主字体和 glyph 0（缺字框）
+    // 没有字体时返回 nullptr
+    const FontFace *FindGlyph(int codepoint, int &glyph) const;
+
+    // 主字体
+    const FontFace *GetPrimary() const
+    {
+        return chain.empty() ? nullptr : faces[chain[0]].get();
+    }
+
+    const FontFace *GetFace(int id) const
+    {
+        return id >= 0 && id < (int)faces.size() ? faces[id].get() : nullptr;
+    }
+    int GetFaceCount() const
+    {
+        return (int)faces.size();
+    }
+
+    // 卸载全部字体
+    void Clear();
+
+  private:
+    FontManager() = default;
+    FontManager(const FontManager &) = delete;
+    FontManager &operator=(const FontManager &) = delete;
+
+    int AddFace(const unsigned char *data, size_t size, int index, bool mapped, const char *name);
+    bool LoadFirstExisting(const char *const *paths, int count);
+    void Unload();
+
+    std::vector<std::unique_ptr<FontFace>> faces;
+    std::vector<int> chain;
+};
+
+} // namespace Text
+
+#endif // TEXT_FONTMANAGER_H
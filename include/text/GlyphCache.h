@@ -0,0 +1,144 @@
+/*
+ * CPU-Draw - Glyph Cache Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 字形缓存模块
+ * 按 (codepoint, font_size) 缓存光栅化结果
+ *
+ * 特性：
+ * - 8 位覆盖率图集（货架式打包）
+ * - 缓存步进与偏移量
+ * - 缓存命中后不再调用 stb
+ * - 字形来自 FontManager 回退链，度量取自主字体
+ * - SDF 字形与覆盖率字形共用图集，每个字符只生成一次，可绘制为任意字号
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef TEXT_GLYPHCACHE_H
+#define TEXT_GLYPHCACHE_H
+
+#include "text/TextRenderer.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Text
+{
+
+// 缓存的字形
+struct GlyphInfo
+{
+    int page;             // 图集页
+    int atlasX, atlasY;   // 图集内位置
+    int width, height;    // 位图尺寸
+    int offsetX, offsetY; // 相对基线的偏移
+    float advance;        // 步进宽度（像素）
+};
+
+// 字号相关的字体信息
+struct SizeMetrics
+{
+    FontMetrics font;
+    float lineHeight;
+};
+
+// 字形缓存
+class GlyphCache
+{
+  public:
+    static GlyphCache &Instance()
+    {
+        static GlyphCache instance;
+        return instance;
+    }
+
+    // 获取字形，未命中时光栅化进图集
+    const GlyphInfo *GetGlyph(int codepoint, int font_size);
+
+    // SDF 字形参数：按 SDF_BASE_SIZE 生成，四周留 SDF_PADDING 像素
+    // 纹素值 = 128 + 距离（基准像素）× SDF_DIST_SCALE，字形内部为正
+    static const int SDF_BASE_SIZE = 48;
+    static const int SDF_PADDING = 8;
+    static const int SDF_ONEDGE = 128;
+    static const int SDF_DIST_SCALE = SDF_ONEDGE / SDF_PADDING;
+
+    // 获取 SDF 字形（尺寸、偏移、步进为基准字号下的值），未命中时生成进图集
+    const GlyphInfo *GetSdfGlyph(int codepoint);
+
+    // 获取字号信息
+    const SizeMetrics &GetMetrics(int font_size);
+
+    // 图集访问
+    const uint8_t *GetPagePixels(int page) const
+    {
+        return pages[page].pixels.data();
+    }
+    int GetPageSize() const
+    {
+        return PAGE_SIZE;
+    }
+    int GetPageCount() const
+    {
+        return (int)pages.size();
+    }
+    size_t GetGlyphCount() const
+    {
+        return glyphs.size();
+    }
+
+    // 每次清空加一，用于判断之前取得的字形是否仍然有效
+    uint32_t GetGeneration() const
+    {
+        return generation;
+    }
+
+    // 清空缓存（FontManager 的字体或回退链变化时自动调用）
+    void Clear();
+
+  private:
+    GlyphCache() : generation(0)
+    {
+    }
+    GlyphCache(const GlyphCache &) = delete;
+    GlyphCache &operator=(const GlyphCache &) = delete;
+
+    static const int PAGE_SIZE = 1024;
+    static const int MAX_PAGES = 8;
+    static const int GLYPH_PADDING = 1;
+    static const int SDF_KEY_SIZE = -1; // SDF 字形的缓存键字号
+
+    // 货架
+    struct Shelf
+    {
+        int y, height, x;
+    };
+
+    // 图集页
+    struct Page
+    {
+        std::vector<uint8_t> pixels;
+        std::vector<Shelf> shelves;
+        int nextY;
+    };
+
+    uint32_t generation;
+    std::vector<Page> pages;
+    std::unordered_map<uint64_t, GlyphInfo> glyphs;
+    std::unordered_map<int, SizeMetrics> metrics;
+
+    static uint64_t MakeKey(int codepoint, int font_size)
+    {
+        return ((uint64_t)(uint32_t)font_size << 32) | (uint32_t)codepoint;
+    }
+
+    bool Allocate(int w, int h, int &page, int &x, int &y);
+    // 分配图集空间，图集已满时整体清空后重试
+    bool AllocateOrReset(int w, int h, int &page, int &x, int &y);
+    bool AllocateInPage(Page &p, int w, int h, int &x, int &y);
+};
+
+} // namespace Text
+
+#endif // TEXT_GLYPHCACHE_H
@@ -0,0 +1,65 @@
+/*
+ * CPU-Draw - SDF Text Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 有向距离场文字
+ * 每个字符只生成一次 SDF（GlyphCache::SDF_BASE_SIZE），按任意浮点字号缩放绘制
+ *
+ * 特性：
+ * - 所有字号共用同一份字形，字号可以连续变化（缩放动画、PushTransform）
+ * - 描边、阴影只是换一个距离阈值 / 偏移再采样一遍，不需要额外字形
+ * - 小字号（约 16px 以下）边缘比覆盖率字形略软，清晰度优先时仍用 RenderText
+ *
+ * 描边宽度与阴影柔化范围受 SDF_PADDING 限制，最大约 SDF_PADDING × 字号 / SDF_BASE_SIZE 像素
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef TEXT_SDFTEXT_H
+#define TEXT_SDFTEXT_H
+
+#include "core/VectorStruct.h"
+#include "graphics/Primitives.h"
+#include "text/TextRenderer.h"
+#include <cstdint>
+#include <string>
+
+namespace Text
+{
+
+// SDF 文字效果（颜色为直通 alpha，alpha 为 0 表示关闭）
+struct SdfEffect
+{
+    float outlineWidth;    // 描边宽度（像素）
+    uint32_t outlineColor;
+    float shadowX, shadowY; // 阴影偏移（像素）
+    float shadowSoftness;   // 阴影柔化半径（像素）
+    uint32_t shadowColor;
+
+    SdfEffect() : outlineWidth(0.0f), outlineColor(0), shadowX(0.0f), shadowY(0.0f), shadowSoftness(0.0f), shadowColor(0)
+    {
+    }
+
+    bool HasOutline() const
+    {
+        return outlineWidth > 0.0f && (outlineColor >> 24) != 0;
+    }
+    bool HasShadow() const
+    {
+        return (shadowColor >> 24) != 0;
+    }
+};
+
+// 绘制 SDF 文本，(x, y) 与 RenderText 相同为首行基线起点
+void RenderTextSdf(uint32_t *pixels, int stride, int width, int height, float x, float y, const std::string &text, float font_size, uint32_t color, const SdfEffect &effect = SdfEffect(), const Graphics::IntRect *clip = nullptr);
+
+// 尺寸（步进宽度 × 行高 × 行数）
+My_Vector2 CalcTextSizeSdf(const std::string &text, float font_size);
+
+// 绘制范围（含描边与阴影）
+TextBounds CalcTextBoundsSdf(float x, float y, const std::string &text, float font_size, const SdfEffect &effect = SdfEffect());
+
+} // namespace Text
+
+#endif // TEXT_SDFTEXT_H
@@ -0,0 +1,156 @@
+/*
+ * CPU-Draw - Text Layout Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 文本排版缓存
+ * 按 (文本, 字号, 字距, 行距, 换行宽度) 缓存解码与排版结果
+ *
+ * 特性：
+ * - 保存解码后的字符、落笔位置、行信息、尺寸与墨迹范围
+ * - 静态文本每帧只需一次哈希查找，测量与绘制共用同一份排版
+ * - 换行单次线性扫描：空格处、中日韩字符前后可断行，行首标点不断开
+ * - 双代淘汰：当前代满后整体降为上一代，上一代命中的条目提回当前代
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef TEXT_TEXTLAYOUT_H
+#define TEXT_TEXTLAYOUT_H
+
+#include "core/VectorStruct.h"
+#include "text/GlyphCache.h"
+#include "text/TextRenderer.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Text
+{
+
+// 解码一个 UTF-8 字符，返回占用字节数（0 表示无效字节）
+inline int DecodeUTF8(const std::string &text, size_t i, int &codepoint)
+{
+    unsigned char c = text[i];
+    size_t remaining = text.size() - i;
+
+    if (c < 0x80)
+    {
+        // ASCII (1 byte)
+        codepoint = c;
+        return 1;
+    }
+    else if ((c & 0xE0) == 0xC0 && remaining >= 2)
+    {
+        // 2 bytes
+        codepoint = ((c & 0x1F) << 6) | (text[i + 1] & 0x3F);
+        return 2;
+    }
+    else if ((c & 0xF0) == 0xE0 && remaining >= 3)
+    {
+        // 3 bytes (中文通常在这里)
+        codepoint = ((c & 0x0F) << 12) | ((text[i + 1] & 0x3F) << 6) | (text[i + 2] & 0x3F);
+        return 3;
+    }
+    else if ((c & 0xF8) == 0xF0 && remaining >= 4)
+    {
+        // 4 bytes
+        codepoint = ((c & 0x07) << 18) | ((text[i + 1] & 0x3F) << 12) | ((text[i + 2] & 0x3F) << 6) | (text[i + 3] & 0x3F);
+        return 4;
+    }
+
+    // 无效字符
+    return 0;
+}
+
+// 排版后的字形
+struct LayoutGlyph
+{
+    const GlyphInfo *glyph; // 排版时的缓存项，GlyphCache 代数变化后失效
+    int codepoint;
+    int x, y;               // 相对文本原点的落笔位置
+    uint32_t offset;        // 在原文中的字节偏移
+};
+
+// 一行
+struct LayoutLine
+{
+    int first, count; // glyphs 中的范围
+    float width;      // 步进宽度之和
+};
+
+// 排版结果
+struct TextLayout
+{
+    std::vector<LayoutGlyph> glyphs;
+    std::vector<LayoutLine> lines;
+    My_Vector2 size;          // 与 CalcTextSize 相同：最宽一行 × 行高 × 行数
+    TextBounds ink;           // 墨迹范围（相对文本原点，x0 > x1 表示为空）
+    int fontSize;
+    uint32_t glyphGeneration; // 排版时的 GlyphCache 代数
+
+    // 字形指针是否仍然有效
+    bool IsGlyphCacheValid() const
+    {
+        return glyphGeneration == GlyphCache::Instance().GetGeneration();
+    }
+};
+
+// 排版缓存
+// 命中且字形缓存未变化时只读，TileRenderer 预热后可在工作线程并发查找
+class TextLayoutCache
+{
+  public:
+    static TextLayoutCache &Instance()
+    {
+        static TextLayoutCache instance;
+        return instance;
+    }
+
+    // 获取排版，wrap_width <= 0 表示只在 '\n' 处换行
+    // 返回的引用在下一次 Get / Clear 之前有效
+    const TextLayout &Get(const std::string &text, int font_size, float letter_spacing = 0.0f, float line_spacing = 1.0f, int wrap_width = -1);
+
+    // 每次淘汰或清空加一，之前取得的引用可能失效
+    uint32_t GetGeneration() const
+    {
+        return generation;
+    }
+    size_t GetCount() const
+    {
+        return current.size() + previous.size();
+    }
+
+    void Clear();
+
+  private:
+    TextLayoutCache() : generation(0)
+    {
+    }
+    TextLayoutCache(const TextLayoutCache &) = delete;
+    TextLayoutCache &operator=(const TextLayoutCache &) = delete;
+
+    static const size_t GENERATION_CAPACITY = 512;
+
+    struct Entry
+    {
+        std::string text;
+        float letterSpacing;
+        float lineSpacing;
+        int wrapWidth;
+        TextLayout layout;
+    };
+
+    static uint64_t MakeKey(const std::string &text, int font_size, float letter_spacing, float line_spacing, int wrap_width);
+    static bool Matches(const Entry &entry, const std::string &text, int font_size, float letter_spacing, float line_spacing, int wrap_width);
+    static void Build(TextLayout &layout, const std::string &text, int font_size, float letter_spacing, float line_spacing, int wrap_width);
+
+    uint32_t generation;
+    std::unordered_map<uint64_t, Entry> current;
+    std::unordered_map<uint64_t, Entry> previous;
+};
+
+} // namespace Text
+
+#endif // TEXT_TEXTLAYOUT_H
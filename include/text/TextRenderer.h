@@ -10,6 +10,7 @@
  * - UTF-8 中文支持
  * - 多行文本
  * - 文本对齐
+ * - 排版结果按文本缓存（TextLayout.h），测量与绘制不重复解码
  * 
  * 仅供学习和研究使用
  */
@@ -17,13 +18,18 @@
 #ifndef TEXT_TEXTRENDERER_H
 #define TEXT_TEXTRENDERER_H
 
+#include "core/FrameArena.h"
 #include "core/VectorStruct.h"
+#include "graphics/Primitives.h"
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace Text
 {
 
+struct TextLayout;
+
 // 文本对齐方式
 enum class Alignment
 {
@@ -56,56 +62,80 @@ struct FontMetrics
     float scale;
 };
 
-// 初始化
+// 文本墨迹范围（像素，包含边界；x0 > x1 表示为空）
+struct TextBounds
+{
+    int x0, y0, x1, y1;
+};
+
+// 初始化（尚未加载字体时按 FontManager 默认顺序查找）
 bool InitFont();
 
-// 释放
+// 释放（卸载全部字体）
 void ShutdownFont();
 
 // 检查是否已初始化
 bool IsFontInitialized();
 
+// 渲染函数的 clip 为附加裁剪区，与缓冲区求交
+
 // 普通文本
-void RenderText(uint32_t *pixels, int stride, int width, int height, int x, int y, const std::string &text, int font_size, uint32_t color);
+void RenderText(uint32_t *pixels, int stride, int width, int height, int x, int y, const std::string &text, int font_size, uint32_t color, const Graphics::IntRect *clip = nullptr);
 
-void RenderTextF(uint32_t *pixels, int stride, int width, int height, float x, float y, const std::string &text, int font_size, uint32_t color);
+void RenderTextF(uint32_t *pixels, int stride, int width, int height, float x, float y, const std::string &text, int font_size, uint32_t color, const Graphics::IntRect *clip = nullptr);
 
 // 格式文本
-void RenderTextStyled(uint32_t *pixels, int stride, int width, int height, int x, int y, const std::string &text, const TextStyle &style);
+void RenderTextStyled(uint32_t *pixels, int stride, int width, int height, int x, int y, const std::string &text, const TextStyle &style, const Graphics::IntRect *clip = nullptr);
+
+// 已排版文本（见 TextLayout.h）
+void RenderTextLayout(uint32_t *pixels, int stride, int width, int height, int x, int y, const TextLayout &layout, uint32_t color, const Graphics::IntRect *clip = nullptr);
 
 // 多行文本
-void RenderTextMultiline(uint32_t *pixels, int stride, int width, int height, int x, int y, const std::string &text, int font_size, uint32_t color, int maxWidth = -1);
+void RenderTextMultiline(uint32_t *pixels, int stride, int width, int height, int x, int y, const std::string &text, int font_size, uint32_t color, int maxWidth = -1, const Graphics::IntRect *clip = nullptr);
 
 // 对齐文本
-void RenderTextAligned(uint32_t *pixels, int stride, int width, int height, int x, int y, int box_width, const std::string &text, int font_size, uint32_t color, Alignment align);
+void RenderTextAligned(uint32_t *pixels, int stride, int width, int height, int x, int y, int box_width, const std::string &text, int font_size, uint32_t color, Alignment align, const Graphics::IntRect *clip = nullptr);
 
 // 字符渲染
-void RenderChar(uint32_t *pixels, int stride, int width, int height, int codepoint, int x, int y, int font_size, uint32_t color); // 改为 int
+void RenderChar(uint32_t *pixels, int stride, int width, int height, int codepoint, int x, int y, int font_size, uint32_t color, const Graphics::IntRect *clip = nullptr); // 改为 int
 
 // 尺寸计算
 My_Vector2 CalcTextSize(const std::string &text, int font_size);
 My_Vector2 CalcTextSizeStyled(const std::string &text, const TextStyle &style);
 My_Vector2 CalcTextSizeMultiline(const std::string &text, int font_size, int maxWidth = -1);
 
+// 墨迹范围（与 RenderText 的落笔位置一致）
+TextBounds CalcTextBounds(int x, int y, const std::string &text, int font_size);
+
 // 字符尺寸
-My_Vector2 CalcCharSize(unsigned char c, int font_size);
+My_Vector2 CalcCharSize(int codepoint, int font_size);
 
 // 字符宽度
-float GetCharAdvance(unsigned char c, int font_size);
+float GetCharAdvance(int codepoint, int font_size);
 
-// 文本换行
+// 文本换行（空格处、中日韩字符前后断行，保留 '\n'）
 std::vector<std::string> WrapText(const std::string &text, int font_size, int maxWidth);
 
+// 换行结果中的一行：原文中的字节范围
+struct TextLine
+{
+    int offset;
+    int length;
+};
+
+// 不复制字符串的换行，lines 可绑定帧内 arena（先清空再写入）
+void WrapText(const std::string &text, int font_size, int maxWidth, Core::ArenaVector<TextLine> &lines);
+
 // 获取字体信息
 FontMetrics GetFontMetrics(int font_size);
 
 // 文本截断
 std::string TruncateText(const std::string &text, int font_size, int maxWidth);
 
-// 获取字符索引
+// 获取字符索引（字节偏移，落在字符边界上）
 int GetCharIndexFromPos(const std::string &text, int font_size, int pixel_x);
 
-// 获取像素位置
+// 获取像素位置（char_index 为字节偏移）
 int GetPosFromCharIndex(const std::string &text, int font_size, int char_index);
 
 // UTF-8
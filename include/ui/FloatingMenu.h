@@ -10,6 +10,7 @@
  * - 拖拽支持
  * - 自动布局
  * - 样式定制
+ * - 离屏缓存（内容不变时每帧只贴一次图，拖拽不重绘）
  * 
  * 仅供学习和研究使用
  */
@@ -18,8 +19,10 @@
 #define UI_FLOATINGMENU_H
 
 #include "graphics/DrawList.h"
+#include "graphics/Surface.h"
 #include "input/TouchHelper.h"
 #include "ui/UIWidget.h"
+#include <cmath>
 #include <memory>
 #include <vector>
 
@@ -96,6 +99,7 @@ class FloatingMenu
     // 标题栏
     void SetTitle(const std::string &title)
     {
+        if (this->title != title) Invalidate();
         this->title = title;
     }
     std::string GetTitle() const
@@ -125,6 +129,7 @@ class FloatingMenu
     void SetStyle(const Style &style)
     {
         this->style = style;
+        Invalidate();
     }
     const Style &GetStyle() const
     {
@@ -144,6 +149,7 @@ class FloatingMenu
     // 可调整大小
     void SetResizable(bool resizable)
     {
+        if (isResizable != resizable) Invalidate();
         isResizable = resizable;
     }
     bool IsResizable() const
@@ -167,6 +173,28 @@ class FloatingMenu
     {
         return animationEnabled;
     }
+    // 动画进行中（需要继续出帧）
+    bool IsAnimating() const
+    {
+        return isVisible && animationEnabled && std::abs(currentHeight - targetHeight) > 1.0f;
+    }
+
+    // 离屏缓存：关闭后每帧直接绘制
+    void SetCacheEnabled(bool enabled)
+    {
+        cacheEnabled = enabled;
+        Invalidate();
+    }
+    bool IsCacheEnabled() const
+    {
+        return cacheEnabled;
+    }
+
+    // 强制下一帧重建缓存（外部直接修改了组件状态时调用）
+    void Invalidate()
+    {
+        cacheDirty = true;
+    }
 
   private:
     // 菜单属性
@@ -199,7 +227,23 @@ class FloatingMenu
     float targetHeight;
     float currentHeight;
 
+    // 离屏缓存，覆盖菜单实际绘制范围，左上角在 menuPos + (cacheX, cacheY)
+    static const int CACHE_SLACK = 64; // 统计范围时允许超出菜单矩形的距离
+    static const int SHADOW_OFFSET = 4;
+    bool cacheEnabled;
+    bool cacheDirty;
+    bool cacheAntiAliasing;
+    My_Vector2 cacheMenuSize;
+    float cacheMenuHeight;
+    int cacheX, cacheY;
+    Graphics::Surface cache;
+    std::vector<uint32_t> cacheWhite; // 直通管线的白底副本
+
     // 方法
+    void DrawMenu(Graphics::DrawList &dl);
+    bool CacheValid(bool antiAliasing) const;
+    void RebuildCache(bool antiAliasing);
+
     void DrawTitleBar(Graphics::DrawList &dl);
     void DrawContent(Graphics::DrawList &dl);
     void DrawShadow(Graphics::DrawList &dl);
@@ -0,0 +1,58 @@
+/*
+ * CPU-Draw - Profiler HUD Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 性能面板
+ * 用 DrawList 绘制最近帧的耗时柱状图与统计
+ *
+ * 特性：
+ * - 帧耗时柱状图（按帧预算着色，带预算参考线）
+ * - p50 / p95 / p99 / max 与平均帧率
+ * - 各分段平均耗时与计数
+ *
+ * 仅供学习和研究使用
+ */
+
+#ifndef UI_PROFILERHUD_H
+#define UI_PROFILERHUD_H
+
+#include "core/Profiler.h"
+#include "graphics/DrawList.h"
+
+namespace UI
+{
+
+class ProfilerHud
+{
+  public:
+    static const int GRAPH_FRAMES = 120; // 柱状图显示的帧数
+
+    ProfilerHud(int x, int y);
+
+    void Draw(Graphics::DrawList &dl);
+
+    void SetPosition(int x, int y)
+    {
+        posX = x;
+        posY = y;
+    }
+
+    // 帧预算（毫秒），决定柱子颜色与参考线
+    void SetFrameBudget(float ms)
+    {
+        budgetMs = ms > 0.0f ? ms : 16.6667f;
+    }
+
+  private:
+    void DrawGraph(Graphics::DrawList &dl, int x, int y, int count);
+    void DrawStats(Graphics::DrawList &dl, int x, int y, const Core::ProfileSummary &summary);
+
+    int posX, posY;
+    float budgetMs;
+    Core::FrameStats frames[GRAPH_FRAMES];
+};
+
+} // namespace UI
+
+#endif // UI_PROFILERHUD_H
@@ -10,6 +10,7 @@
  * - 触摸 ID 追踪
  * - 状态管理
  * - 回调机制
+ * - 外观变化标记（供菜单缓存判断是否重绘）
  * 
  * 仅供学习和研究使用
  */
@@ -30,7 +31,7 @@ namespace UI
 class Widget
 {
   public:
-    Widget() : pos(0, 0), size(100, 40), visible(true), enabled(true), id(0)
+    Widget() : pos(0, 0), size(100, 40), visible(true), enabled(true), id(0), activeTouchId(-1), dirty(true)
     {
     }
     virtual ~Widget()
@@ -44,14 +45,15 @@ class Widget
     {
     }
 
-    // 位置和尺寸
+    // 位置和尺寸（位置由菜单布局管理，整体平移不算外观变化）
     void SetPosition(const My_Vector2 &p)
     {
         pos = p;
     }
     void SetSize(const My_Vector2 &s)
     {
-        size = s;
+        SetState(size.x, s.x);
+        SetState(size.y, s.y);
     }
     My_Vector2 GetPosition() const
     {
@@ -71,11 +73,11 @@ class Widget
     // 可见性和启用状态
     void SetVisible(bool v)
     {
-        visible = v;
+        SetState(visible, v);
     }
     void SetEnabled(bool e)
     {
-        enabled = e;
+        SetState(enabled, e);
     }
     bool IsVisible() const
     {
@@ -96,6 +98,20 @@ class Widget
         return id;
     }
 
+    // 外观变化标记
+    void MarkDirty()
+    {
+        dirty = true;
+    }
+    bool IsDirty() const
+    {
+        return dirty;
+    }
+    void ClearDirty()
+    {
+        dirty = false;
+    }
+
   protected:
     My_Vector2 pos;
     My_Vector2 size;
@@ -103,6 +119,18 @@ class Widget
     bool enabled;
     int id;
     int activeTouchId;
+    bool dirty;
+
+    // 赋值，值变化时标记重绘
+    template <typename T>
+    void SetState(T &field, const T &value)
+    {
+        if (field != value)
+        {
+            field = value;
+            dirty = true;
+        }
+    }
 };
 
 // 按钮组件
@@ -118,7 +146,7 @@ class Button : public Widget
 
     void SetText(const std::string &text)
     {
-        this->text = text;
+        SetState(this->text, text);
     }
     std::string GetText() const
     {
@@ -132,22 +160,22 @@ class Button : public Widget
 
     void SetColors(uint32_t normal, uint32_t hover, uint32_t press)
     {
-        normalColor = normal;
-        hoverColor = hover;
-        pressColor = press;
+        SetState(normalColor, normal);
+        SetState(hoverColor, hover);
+        SetState(pressColor, press);
     }
 
     void SetTextColor(uint32_t color)
     {
-        textColor = color;
+        SetState(textColor, color);
     }
     void SetFontSize(int size)
     {
-        fontSize = size;
+        SetState(fontSize, size);
     }
     void SetRounded(bool rounded)
     {
-        isRounded = rounded;
+        SetState(isRounded, rounded);
     }
 
   private:
@@ -182,18 +210,18 @@ class Slider : public Widget
 
     void SetRange(float min, float max)
     {
-        minValue = min;
-        maxValue = max;
+        SetState(minValue, min);
+        SetState(maxValue, max);
         SetValue(value);
     }
 
     void SetLabel(const std::string &label)
     {
-        this->label = label;
+        SetState(this->label, label);
     }
     void SetShowValue(bool show)
     {
-        showValue = show;
+        SetState(showValue, show);
     }
     void SetOnValueChange(const ValueChangeCallback &callback)
     {
@@ -236,7 +264,7 @@ class Checkbox : public Widget
 
     void SetLabel(const std::string &label)
     {
-        this->label = label;
+        SetState(this->label, label);
     }
     void SetOnValueChange(const ValueChangeCallback &callback)
     {
@@ -264,7 +292,7 @@ class Label : public Widget
 
     void SetText(const std::string &text)
     {
-        this->text = text;
+        SetState(this->text, text);
     }
     std::string GetText() const
     {
@@ -273,15 +301,15 @@ class Label : public Widget
 
     void SetTextColor(uint32_t color)
     {
-        textColor = color;
+        SetState(textColor, color);
     }
     void SetFontSize(int size)
     {
-        fontSize = size;
+        SetState(fontSize, size);
     }
     void SetAlignment(Graphics::TextAlign align)
     {
-        alignment = align;
+        SetState(alignment, align);
     }
 
   private:
@@ -304,7 +332,7 @@ class TextInput : public Widget
 
     void SetText(const std::string &text)
     {
-        this->text = text;
+        SetState(this->text, text);
     }
     std::string GetText() const
     {
@@ -313,7 +341,7 @@ class TextInput : public Widget
 
     void SetPlaceholder(const std::string &ph)
     {
-        placeholder = ph;
+        SetState(placeholder, ph);
     }
     void SetOnTextChange(const TextChangeCallback &callback)
     {
@@ -322,7 +350,7 @@ class TextInput : public Widget
 
     void SetFocused(bool focused)
     {
-        isFocused = focused;
+        SetState(isFocused, focused);
     }
     bool IsFocused() const
     {
@@ -351,11 +379,11 @@ class Separator : public Widget
 
     void SetColor(uint32_t color)
     {
-        this->color = color;
+        SetState(this->color, color);
     }
     void SetThickness(int thickness)
     {
-        this->thickness = thickness;
+        SetState(this->thickness, thickness);
     }
 
   private:
@@ -0,0 +1,89 @@
+/*
+ * CPU-Draw - Frame Arena Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 帧内临时内存
+ * 当前块用完时追加一块（至少为上一块的两倍），Reset 时合并为一块
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "core/FrameArena.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace Core
+{
+
+FrameArena::FrameArena(size_t size) : cursor(nullptr), limit(nullptr), blockSize(size > 0 ? size : DEFAULT_BLOCK_SIZE), used(0), peak(0)
+{
+}
+
+FrameArena::~FrameArena()
+{
+    for (Block &block : blocks)
+    {
+        free(block.memory);
+    }
+}
+
+size_t FrameArena::GetCapacity() const
+{
+    size_t total = 0;
+    for (const Block &block : blocks)
+    {
+        total += block.size;
+    }
+    return total;
+}
+
+void *FrameArena::Allocate(size_t size, size_t align)
+{
+    uintptr_t p = ((uintptr_t)cursor + (align - 1)) & ~(uintptr_t)(align - 1);
+    if (cursor && p + size <= (uintptr_t)limit)
+    {
+        used += p + size - (uintptr_t)cursor;
+        cursor = (uint8_t *)(p + size);
+        return (void *)p;
+    }
+    return AllocateSlow(size, align);
+}
+
+void *FrameArena::AllocateSlow(size_t size, size_t align)
+{
+    size_t last = blocks.empty() ? 0 : blocks.back().size;
+    size_t bytes = std::max(std::max(blockSize, last * 2), size + align);
+    uint8_t *memory = static_cast<uint8_t *>(malloc(bytes));
+    if (!memory) throw std::bad_alloc();
+
+    blocks.push_back(Block{ memory, bytes });
+    cursor = memory;
+    limit = memory + bytes;
+    return Allocate(size, align);
+}
+
+void FrameArena::Reset()
+{
+    peak = std::max(peak, used);
+    used = 0;
+
+    // 本帧用到多个块：合并成一块，下一帧同样的用量只需一块
+    if (blocks.size() > 1)
+    {
+        size_t total = GetCapacity();
+        for (Block &block : blocks)
+        {
+            free(block.memory);
+        }
+        blocks.clear();
+
+        uint8_t *memory = static_cast<uint8_t *>(malloc(total));
+        if (memory) blocks.push_back(Block{ memory, total });
+    }
+
+    cursor = blocks.empty() ? nullptr : blocks[0].memory;
+    limit = blocks.empty() ? nullptr : blocks[0].memory + blocks[0].size;
+}
+
+} // namespace Core
@@ -0,0 +1,257 @@
+/*
+ * CPU-Draw - Profiler Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 帧性能分析
+ * EndFrame 把当前帧累加器写入环形缓冲并清零
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "core/Profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <time.h>
+#include <vector>
+
+#ifdef __ANDROID__
+#include <android/log.h>
+#endif
+
+namespace Core
+{
+
+std::atomic<bool> Profiler::enabled(false);
+
+Profiler &Profiler::Instance()
+{
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler() : frameStartNs(0), inFrame(false), written(0)
+{
+    for (int i = 0; i < PROFILE_ZONE_COUNT; i++)
+    {
+        zoneNs[i] = 0;
+    }
+    for (int i = 0; i < PROFILE_COUNTER_COUNT; i++)
+    {
+        counters[i] = 0;
+    }
+    memset(history, 0, sizeof(history));
+}
+
+int64_t Profiler::NowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+void Profiler::SetEnabled(bool enable)
+{
+    enabled.store(enable, std::memory_order_relaxed);
+    inFrame = false;
+}
+
+void Profiler::BeginFrame()
+{
+    if (!IsEnabled()) return;
+
+    // 丢弃帧外（或关闭期间）残留的累加
+    for (int i = 0; i < PROFILE_ZONE_COUNT; i++)
+    {
+        zoneNs[i].store(0, std::memory_order_relaxed);
+    }
+    for (int i = 0; i < PROFILE_COUNTER_COUNT; i++)
+    {
+        counters[i].store(0, std::memory_order_relaxed);
+    }
+
+    frameStartNs = NowNs();
+    inFrame = true;
+}
+
+void Profiler::EndFrame()
+{
+    if (!IsEnabled() || !inFrame) return;
+    inFrame = false;
+
+    uint64_t index = written.load(std::memory_order_relaxed);
+    FrameStats &frame = history[index & (HISTORY - 1)];
+
+    frame.frameIndex = index;
+    frame.startNs = frameStartNs;
+    frame.frameNs = (uint32_t)std::min<int64_t>(NowNs() - frameStartNs, UINT32_MAX);
+    for (int i = 0; i < PROFILE_ZONE_COUNT; i++)
+    {
+        frame.zoneNs[i] = (uint32_t)std::min<uint64_t>(zoneNs[i].load(std::memory_order_relaxed), UINT32_MAX);
+    }
+    for (int i = 0; i < PROFILE_COUNTER_COUNT; i++)
+    {
+        frame.counters[i] = (uint32_t)std::min<uint64_t>(counters[i].load(std::memory_order_relaxed), UINT32_MAX);
+    }
+
+    written.store(index + 1, std::memory_order_release);
+}
+
+int Profiler::CopyFrames(FrameStats *out, int max) const
+{
+    uint64_t end = written.load(std::memory_order_acquire);
+    uint64_t count = std::min<uint64_t>(end, (uint64_t)std::min(max, HISTORY - 1));
+    uint64_t begin = end - count;
+
+    for (uint64_t i = 0; i < count; i++)
+    {
+        out[i] = history[(begin + i) & (HISTORY - 1)];
+    }
+
+    // 复制期间写者追上来的帧可能不完整，丢弃最旧的部分
+    uint64_t now = written.load(std::memory_order_acquire);
+    uint64_t overwritten = now > begin + (HISTORY - 1) ? now - (begin + (HISTORY - 1)) : 0;
+    if (overwritten >= count) return 0;
+    if (overwritten > 0)
+    {
+        memmove(out, out + overwritten, (size_t)(count - overwritten) * sizeof(FrameStats));
+    }
+    return (int)(count - overwritten);
+}
+
+ProfileSummary Profiler::Summarize(int frames) const
+{
+    ProfileSummary summary;
+    memset(&summary, 0, sizeof(summary));
+
+    std::vector<FrameStats> recent(std::max(1, std::min(frames, HISTORY)));
+    int n = CopyFrames(recent.data(), (int)recent.size());
+    summary.frames = n;
+    if (n == 0) return summary;
+
+    std::vector<uint32_t> times(n);
+    for (int i = 0; i < n; i++)
+    {
+        times[i] = recent[i].frameNs;
+        for (int z = 0; z < PROFILE_ZONE_COUNT; z++)
+        {
+            summary.zoneMs[z] += recent[i].zoneNs[z] * 1e-6f;
+        }
+        for (int c = 0; c < PROFILE_COUNTER_COUNT; c++)
+        {
+            summary.counters[c] += (float)recent[i].counters[c];
+        }
+    }
+    for (int z = 0; z < PROFILE_ZONE_COUNT; z++)
+    {
+        summary.zoneMs[z] /= n;
+    }
+    for (int c = 0; c < PROFILE_COUNTER_COUNT; c++)
+    {
+        summary.counters[c] /= n;
+    }
+
+    std::sort(times.begin(), times.end());
+    const float percentiles[3] = { 0.50f, 0.95f, 0.99f };
+    for (int p = 0; p < 3; p++)
+    {
+        int k = std::min(n - 1, (int)(percentiles[p] * n));
+        summary.frameMs[p] = times[k] * 1e-6f;
+    }
+    summary.frameMs[3] = times[n - 1] * 1e-6f;
+
+    if (n > 1)
+    {
+        int64_t span = recent[n - 1].startNs - recent[0].startNs;
+        if (span > 0) summary.fps = (float)(n - 1) * 1e9f / (float)span;
+    }
+
+    return summary;
+}
+
+void Profiler::DumpCsv(FILE *file) const
+{
+    if (!file) return;
+
+    std::vector<FrameStats> frames(HISTORY);
+    int n = CopyFrames(frames.data(), HISTORY);
+
+    fprintf(file, "frame,start_ns,frame_ns");
+    for (int z = 0; z < PROFILE_ZONE_COUNT; z++)
+    {
+        fprintf(file, ",%s_ns", GetZoneName((ProfileZone)z));
+    }
+    for (int c = 0; c < PROFILE_COUNTER_COUNT; c++)
+    {
+        fprintf(file, ",%s", GetCounterName((ProfileCounter)c));
+    }
+    fprintf(file, "\n");
+
+    for (int i = 0; i < n; i++)
+    {
+        const FrameStats &f = frames[i];
+        fprintf(file, "%llu,%lld,%u", (unsigned long long)f.frameIndex, (long long)f.startNs, f.frameNs);
+        for (int z = 0; z < PROFILE_ZONE_COUNT; z++)
+        {
+            fprintf(file, ",%u", f.zoneNs[z]);
+        }
+        for (int c = 0; c < PROFILE_COUNTER_COUNT; c++)
+        {
+            fprintf(file, ",%u", f.counters[c]);
+        }
+        fprintf(file, "\n");
+    }
+}
+
+void Profiler::LogSummary(int frames) const
+{
+    ProfileSummary s = Summarize(frames);
+
+    char line[512];
+    int len = snprintf(line, sizeof(line), "frames=%d fps=%.1f p50=%.2fms p95=%.2fms p99=%.2fms max=%.2fms", s.frames, s.fps, s.frameMs[0], s.frameMs[1], s.frameMs[2], s.frameMs[3]);
+    for (int z = 0; z < PROFILE_ZONE_COUNT && len < (int)sizeof(line); z++)
+    {
+        len += snprintf(line + len, sizeof(line) - len, " %s=%.2f", GetZoneName((ProfileZone)z), s.zoneMs[z]);
+    }
+    for (int c = 0; c < PROFILE_COUNTER_COUNT && len < (int)sizeof(line); c++)
+    {
+        len += snprintf(line + len, sizeof(line) - len, " %s=%.0f", GetCounterName((ProfileCounter)c), s.counters[c]);
+    }
+
+#ifdef __ANDROID__
+    __android_log_print(ANDROID_LOG_INFO, "CPUDraw", "%s", line);
+#else
+    printf("%s\n", line);
+#endif
+}
+
+const char *Profiler::GetZoneName(ProfileZone zone)
+{
+    switch (zone)
+    {
+    case ProfileZone::Input: return "input";
+    case ProfileZone::Update: return "update";
+    case ProfileZone::Record: return "record";
+    case ProfileZone::Lock: return "lock";
+    case ProfileZone::Clear: return "clear";
+    case ProfileZone::Render: return "render";
+    case ProfileZone::Present: return "present";
+    case ProfileZone::Menu: return "menu";
+    case ProfileZone::Text: return "text";
+    default: return "?";
+    }
+}
+
+const char *Profiler::GetCounterName(ProfileCounter counter)
+{
+    switch (counter)
+    {
+    case ProfileCounter::Commands: return "commands";
+    case ProfileCounter::PixelsCovered: return "pixels";
+    case ProfileCounter::GlyphsDrawn: return "glyphs";
+    case ProfileCounter::GlyphsRasterized: return "glyphs_new";
+    default: return "?";
+    }
+}
+
+} // namespace Core
@@ -0,0 +1,597 @@
+/*
+ * CPU-Draw - Command Buffer Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 延迟绘制命令缓冲
+ * DrawList 录制模式下的命令存储与回放
+ *
+ * 特性：
+ * - 定长 POD 命令，字符串/顶点存放在数据区（按偏移引用）
+ * - 录制时即确定范围与裁剪区，缓冲可独立于 DrawList 存在
+ * - 回放前剔除、消除被不透明矩形覆盖的命令
+ * - 同色相邻矩形合并、文本命令归并
+ * - 命令级抗锯齿标志
+ * - 外部命令（共享内存）回放前的越界检查
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "graphics/CommandBuffer.h"
+#include "graphics/EntityBatch.h"
+#include "graphics/Gradient.h"
+#include "graphics/Rasterizer.h"
+#include "graphics/Texture.h"
+#include "text/SdfText.h"
+#include "text/TextRenderer.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Graphics
+{
+
+static const uint16_t FLAG_CULLED = 1 << 15;
+
+static bool Overlaps(const IntRect &a, const IntRect &b)
+{
+    return !a.Intersect(b).IsEmpty();
+}
+
+static bool Contains(const IntRect &outer, const IntRect &inner)
+{
+    return inner.x0 >= outer.x0 && inner.y0 >= outer.y0 && inner.x1 <= outer.x1 && inner.y1 <= outer.y1;
+}
+
+// 实心矩形的规范化坐标
+static IntRect RectArgs(const DrawCommand &cmd)
+{
+    return { std::min(cmd.args[0].i, cmd.args[2].i), std::min(cmd.args[1].i, cmd.args[3].i), std::max(cmd.args[0].i, cmd.args[2].i), std::max(cmd.args[1].i, cmd.args[3].i) };
+}
+
+// 是否不透明地覆盖自身范围
+static bool IsOccluder(const DrawCommand &cmd)
+{
+    if (cmd.op == DrawOp::Clear) return true;
+    return cmd.op == DrawOp::RectFilled && (cmd.args[4].u >> 24) == 255;
+}
+
+// 可归并的命令：文本归为一组，实心矩形按颜色分组
+static bool SameBatch(const DrawCommand &a, const DrawCommand &b)
+{
+    if (a.op != b.op) return false;
+    if (a.op == DrawOp::Text || a.op == DrawOp::TextSdf) return true;
+    if (a.op == DrawOp::RectFilled) return a.args[4].u == b.args[4].u;
+    return false;
+}
+
+CommandBuffer::CommandBuffer() : external(nullptr), externalCount(0), externalData(nullptr), externalSize(0), stats()
+{
+}
+
+void CommandBuffer::Reset()
+{
+    commands.clear();
+    data.clear();
+    external = nullptr;
+    externalCount = 0;
+    externalData = nullptr;
+    externalSize = 0;
+}
+
+void CommandBuffer::Attach(const DrawCommand *source, size_t count, const uint8_t *sourceData, size_t size)
+{
+    Reset();
+    external = source;
+    externalCount = source ? count : 0;
+    externalData = sourceData;
+    externalSize = size;
+}
+
+// 各命令至少需要的参数个数（按 Execute 的取参方式），0 表示不接受外部命令
+static const uint8_t MIN_ARGS[DRAW_OP_COUNT] = {
+    3,  // Pixel
+    5,  // Line
+    5,  // LineF
+    6,  // LineThick
+    5,  // Rect
+    5,  // RectF
+    5,  // RectFilled
+    6,  // RectRounded
+    6,  // RectRoundedFilled
+    4,  // Circle
+    4,  // CircleF
+    4,  // CircleFilled
+    7,  // Triangle
+    7,  // TriangleFilled
+    3,  // Polygon
+    3,  // PolygonFilled
+    10, // BezierCubic
+    8,  // BezierQuadratic
+    9,  // GradientLinear
+    4,  // GradientRadial
+    6,  // Text
+    1,  // Clear
+    0,  // Surface（本进程指针）
+    7,  // TextSdf
+    2,  // EntityBatch
+    3,  // PolygonF
+    6,  // PathFilled
+    0,  // Image（本进程指针）
+    0,  // ImageScaled（本进程指针）
+};
+
+// 数据区引用：4 字节对齐且 [offset, offset + bytes) 在数据区内
+static bool InData(uint32_t offset, uint64_t bytes, size_t size)
+{
+    return (offset & 3) == 0 && offset <= size && bytes <= size - offset;
+}
+
+// 整数坐标参数 a[first, first + count)
+static bool CoordsInRange(const CommandArg *a, int first, int count)
+{
+    for (int i = first; i < first + count; i++)
+    {
+        if (a[i].i < -EXTERNAL_COORD_LIMIT || a[i].i > EXTERNAL_COORD_LIMIT) return false;
+    }
+    return true;
+}
+
+// 浮点值有限且在 [lo, hi] 内（NaN 不通过）
+static bool FloatInRange(float value, float lo, float hi)
+{
+    return value >= lo && value <= hi;
+}
+
+static bool FloatCoordsInRange(const float *values, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!FloatInRange(values[i], -(float)EXTERNAL_COORD_LIMIT, (float)EXTERNAL_COORD_LIMIT)) return false;
+    }
+    return true;
+}
+
+static bool FloatArgsInRange(const CommandArg *a, int first, int count)
+{
+    for (int i = first; i < first + count; i++)
+    {
+        if (!FloatInRange(a[i].f, -(float)EXTERNAL_COORD_LIMIT, (float)EXTERNAL_COORD_LIMIT)) return false;
+    }
+    return true;
+}
+
+static bool SizeInRange(int value, int lo, int hi)
+{
+    return value >= lo && value <= hi;
+}
+
+bool CommandBuffer::Validate(const DrawCommand *source, size_t count, const uint8_t *sourceData, size_t size)
+{
+    if (count > 0 && !source) return false;
+
+    const IntRect limit = { -EXTERNAL_COORD_LIMIT, -EXTERNAL_COORD_LIMIT, EXTERNAL_COORD_LIMIT, EXTERNAL_COORD_LIMIT };
+    for (size_t i = 0; i < count; i++)
+    {
+        const DrawCommand &cmd = source[i];
+        if ((int)cmd.op >= DRAW_OP_COUNT) return false;
+        if (cmd.argCount > DrawCommand::MAX_ARGS || cmd.argCount < MIN_ARGS[(int)cmd.op] || MIN_ARGS[(int)cmd.op] == 0) return false;
+
+        // 录制的命令范围总是非空且已裁剪，分块按范围算下标
+        if (cmd.bounds.IsEmpty() || !Contains(limit, cmd.bounds)) return false;
+
+        const CommandArg *a = cmd.args;
+        switch (cmd.op)
+        {
+        case DrawOp::Pixel:
+            if (!CoordsInRange(a, 0, 2)) return false;
+            break;
+        case DrawOp::Line:
+        case DrawOp::Rect:
+        case DrawOp::RectFilled:
+            if (!CoordsInRange(a, 0, 4)) return false;
+            break;
+        case DrawOp::LineF:
+        case DrawOp::RectF:
+            if (!FloatArgsInRange(a, 0, 4)) return false;
+            break;
+        case DrawOp::LineThick:
+            if (!CoordsInRange(a, 0, 4) || !SizeInRange(a[5].i, 0, EXTERNAL_SIZE_LIMIT)) return false;
+            break;
+        case DrawOp::RectRounded:
+        case DrawOp::RectRoundedFilled:
+            if (!CoordsInRange(a, 0, 4) || !SizeInRange(a[4].i, 0, EXTERNAL_SIZE_LIMIT)) return false;
+            break;
+        case DrawOp::Circle:
+        case DrawOp::CircleFilled:
+            if (!CoordsInRange(a, 0, 2) || !SizeInRange(a[2].i, 0, EXTERNAL_SIZE_LIMIT)) return false;
+            break;
+        case DrawOp::CircleF:
+            if (!FloatArgsInRange(a, 0, 2) || !FloatInRange(a[2].f, 0.0f, (float)EXTERNAL_SIZE_LIMIT)) return false;
+            break;
+        case DrawOp::Triangle:
+        case DrawOp::TriangleFilled:
+            if (!CoordsInRange(a, 0, 6)) return false;
+            break;
+        case DrawOp::Polygon:
+        case DrawOp::PolygonFilled:
+        {
+            if (a[1].i < 0 || !InData(a[0].u, (uint64_t)a[1].i * 2 * sizeof(int), size)) return false;
+            const int32_t *points = reinterpret_cast<const int32_t *>(sourceData + a[0].u);
+            for (int p = 0; p < a[1].i * 2; p++)
+            {
+                if (points[p] < -EXTERNAL_COORD_LIMIT || points[p] > EXTERNAL_COORD_LIMIT) return false;
+            }
+            break;
+        }
+        case DrawOp::PolygonF:
+            if (a[1].i < 0 || !InData(a[0].u, (uint64_t)a[1].i * 2 * sizeof(float), size)) return false;
+            if (!FloatCoordsInRange(reinterpret_cast<const float *>(sourceData + a[0].u), (size_t)a[1].i * 2)) return false;
+            break;
+        case DrawOp::PathFilled:
+        {
+            if (a[1].i < 0 || !InData(a[0].u, (uint64_t)a[1].i * 2 * sizeof(float), size)) return false;
+            if (!FloatCoordsInRange(reinterpret_cast<const float *>(sourceData + a[0].u), (size_t)a[1].i * 2)) return false;
+            // 轮廓表按 int32_t 读取，偏移与长度都须按 4 字节对齐
+            if (a[2].u % sizeof(int32_t) != 0 || a[3].u % sizeof(int32_t) != 0 || !InData(a[2].u, a[3].u, size)) return false;
+            if (a[5].i != (int)FillRule::NonZero && a[5].i != (int)FillRule::EvenOdd) return false;
+
+            // 各轮廓顶点数之和不能超过顶点数组
+            const int32_t *contours = reinterpret_cast<const int32_t *>(sourceData + a[2].u);
+            int64_t total = 0;
+            for (uint32_t c = 0; c < a[3].u / sizeof(int32_t); c++)
+            {
+                if (contours[c] < 0) return false;
+                total += contours[c];
+            }
+            if (total > a[1].i) return false;
+            break;
+        }
+        case DrawOp::BezierCubic:
+            // 分段数 0 为按长度自动计算
+            if (!FloatArgsInRange(a, 0, 8) || !SizeInRange(a[9].i, 0, EXTERNAL_SEGMENT_LIMIT)) return false;
+            break;
+        case DrawOp::BezierQuadratic:
+            if (!FloatArgsInRange(a, 0, 6) || !SizeInRange(a[7].i, 0, EXTERNAL_SEGMENT_LIMIT)) return false;
+            break;
+        case DrawOp::GradientLinear:
+            if (!CoordsInRange(a, 0, 4) || !FloatArgsInRange(a, 4, 4) || !InData(a[8].u, sizeof(GradientRamp), size)) return false;
+            break;
+        case DrawOp::GradientRadial:
+            if (!CoordsInRange(a, 0, 2) || !SizeInRange(a[2].i, 0, EXTERNAL_SIZE_LIMIT) || !InData(a[3].u, sizeof(GradientRamp), size)) return false;
+            break;
+        case DrawOp::Text:
+            if (!CoordsInRange(a, 0, 2) || !InData(a[2].u, a[3].u, size) || !SizeInRange(a[4].i, 1, EXTERNAL_FONT_SIZE_LIMIT)) return false;
+            break;
+        case DrawOp::TextSdf:
+        {
+            if (!FloatArgsInRange(a, 0, 2) || !InData(a[2].u, a[3].u, size) || !InData(a[6].u, sizeof(Text::SdfEffect), size)) return false;
+            if (!(a[4].f > 0.0f) || a[4].f > (float)EXTERNAL_SIZE_LIMIT) return false;
+
+            const Text::SdfEffect *effect = reinterpret_cast<const Text::SdfEffect *>(sourceData + a[6].u);
+            const float sizeLimit = (float)EXTERNAL_SIZE_LIMIT;
+            if (!FloatInRange(effect->outlineWidth, -sizeLimit, sizeLimit) || !FloatInRange(effect->shadowSoftness, -sizeLimit, sizeLimit)) return false;
+            if (!FloatInRange(effect->shadowX, -sizeLimit, sizeLimit) || !FloatInRange(effect->shadowY, -sizeLimit, sizeLimit)) return false;
+            break;
+        }
+        case DrawOp::EntityBatch:
+            if (!InData(a[0].u, a[1].u, size) || !validate_entity_batch(sourceData + a[0].u, a[1].u)) return false;
+            break;
+        default: break;
+        }
+    }
+    return true;
+}
+
+void CommandBuffer::ClampBounds(DrawCommand *target, size_t count, int width, int height)
+{
+    // 完全在屏幕外的命令范围变为空，Cull 时丢弃
+    IntRect screen = { 0, 0, width - 1, height - 1 };
+    for (size_t i = 0; i < count; i++)
+    {
+        target[i].bounds = target[i].bounds.Intersect(screen);
+    }
+}
+
+uint32_t CommandBuffer::AppendData(const void *src, size_t size)
+{
+    uint32_t offset = (uint32_t)data.size();
+    size_t padded = (size + 3) & ~(size_t)3;
+    data.resize(offset + padded);
+    if (size > 0)
+    {
+        memcpy(data.data() + offset, src, size);
+    }
+    return offset;
+}
+
+void CommandBuffer::Pack(DrawCommand &cmd, const std::string &value)
+{
+    Pack(cmd, AppendData(value.data(), value.size()));
+    Pack(cmd, (uint32_t)value.size());
+}
+
+void CommandBuffer::Pack(DrawCommand &cmd, const PointList &value)
+{
+    Pack(cmd, AppendData(value.points, value.count * 2 * sizeof(int)));
+    Pack(cmd, (int32_t)value.count);
+}
+
+void CommandBuffer::Pack(DrawCommand &cmd, const PointListF &value)
+{
+    Pack(cmd, AppendData(value.points, value.count * 2 * sizeof(float)));
+    Pack(cmd, (int32_t)value.count);
+}
+
+void CommandBuffer::Pack(DrawCommand &cmd, const Surface *value)
+{
+    // 指针按两个 32 位参数保存
+    uint64_t bits = (uint64_t)(uintptr_t)value;
+    Pack(cmd, (uint32_t)bits);
+    Pack(cmd, (uint32_t)(bits >> 32));
+}
+
+void CommandBuffer::Pack(DrawCommand &cmd, const Texture *value)
+{
+    uint64_t bits = (uint64_t)(uintptr_t)value;
+    Pack(cmd, (uint32_t)bits);
+    Pack(cmd, (uint32_t)(bits >> 32));
+}
+
+void CommandBuffer::Pack(DrawCommand &cmd, const TextureSampling &value)
+{
+    Pack(cmd, AppendData(&value, sizeof(value)));
+}
+
+void CommandBuffer::Pack(DrawCommand &cmd, const Text::SdfEffect &value)
+{
+    // 效果参数整体存入数据区
+    Pack(cmd, AppendData(&value, sizeof(value)));
+}
+
+void CommandBuffer::Pack(DrawCommand &cmd, const DataBlock &value)
+{
+    Pack(cmd, AppendData(value.data, value.size));
+    Pack(cmd, value.size);
+}
+
+void CommandBuffer::Pack(DrawCommand &cmd, const GradientRamp &value)
+{
+    // 色带整体复制，回放时不访问 GradientCache
+    Pack(cmd, AppendData(&value, sizeof(value)));
+}
+
+void CommandBuffer::Prepare(int width, int height)
+{
+    stats = FlushStats();
+    stats.recorded = (int)GetCommandCount();
+
+    Cull(width, height);
+    Batch();
+    Merge();
+
+    stats.executed = (int)work.size();
+}
+
+void CommandBuffer::Flush(uint32_t *pixels, int stride, int width, int height)
+{
+    Prepare(width, height);
+
+    for (const DrawCommand &cmd : work)
+    {
+        Execute(cmd, pixels, stride, width, height, nullptr, scratch);
+    }
+}
+
+void CommandBuffer::Cull(int width, int height)
+{
+    IntRect screen = { 0, 0, width - 1, height - 1 };
+    work.clear();
+
+    // 不可见的命令直接丢弃；清屏之前的命令全部作废
+    const DrawCommand *source = GetCommands();
+    for (size_t i = 0; i < GetCommandCount(); i++)
+    {
+        const DrawCommand &cmd = source[i];
+        if (cmd.bounds.Intersect(cmd.clip).Intersect(screen).IsEmpty())
+        {
+            stats.culled++;
+            continue;
+        }
+
+        if (cmd.op == DrawOp::Clear && Contains(cmd.clip, screen))
+        {
+            stats.culled += (int)work.size();
+            work.clear();
+        }
+
+        work.push_back(cmd);
+        work.back().flags &= ~FLAG_CULLED;
+    }
+
+    // 从后往前：完全落在后续不透明矩形内的命令不必绘制
+    occluders.clear();
+    for (size_t i = work.size(); i-- > 0;)
+    {
+        DrawCommand &cmd = work[i];
+
+        for (const IntRect &o : occluders)
+        {
+            if (Contains(o, cmd.bounds))
+            {
+                cmd.flags |= FLAG_CULLED;
+                break;
+            }
+        }
+        if (cmd.flags & FLAG_CULLED)
+        {
+            stats.culled++;
+            continue;
+        }
+
+        if (IsOccluder(cmd) && (int)occluders.size() < OCCLUDER_LIMIT)
+        {
+            occluders.push_back(cmd.bounds.Intersect(cmd.clip).Intersect(screen));
+        }
+    }
+
+    work.erase(std::remove_if(work.begin(), work.end(), [](const DrawCommand &cmd) { return (cmd.flags & FLAG_CULLED) != 0; }), work.end());
+}
+
+void CommandBuffer::Batch()
+{
+    // 把命令前移到同组命令之后，中间的命令不能与它重叠
+    for (size_t i = 1; i < work.size(); i++)
+    {
+        const DrawCommand &cmd = work[i];
+        if (cmd.op != DrawOp::Text && cmd.op != DrawOp::TextSdf && cmd.op != DrawOp::RectFilled) continue;
+        if (SameBatch(work[i - 1], cmd)) continue;
+
+        int limit = std::max(0, (int)i - BATCH_WINDOW);
+        size_t target = i;
+        for (int j = (int)i - 1; j >= limit; j--)
+        {
+            if (SameBatch(work[j], cmd))
+            {
+                target = j + 1;
+                break;
+            }
+            if (Overlaps(work[j].bounds, cmd.bounds)) break;
+        }
+
+        if (target < i)
+        {
+            std::rotate(work.begin() + target, work.begin() + i, work.begin() + i + 1);
+            stats.batched++;
+        }
+    }
+}
+
+void CommandBuffer::Merge()
+{
+    if (work.empty()) return;
+
+    size_t out = 0;
+    for (size_t i = 1; i < work.size(); i++)
+    {
+        DrawCommand &prev = work[out];
+        const DrawCommand &cmd = work[i];
+
+        if (prev.op == DrawOp::RectFilled && cmd.op == DrawOp::RectFilled && prev.args[4].u == cmd.args[4].u && prev.clip == cmd.clip && prev.flags == cmd.flags)
+        {
+            IntRect a = RectArgs(prev);
+            IntRect b = RectArgs(cmd);
+            bool opaque = (cmd.args[4].u >> 24) == 255;
+
+            // 并集仍是矩形；半透明时不能重叠，否则重叠处会少混合一次
+            bool rows = a.y0 == b.y0 && a.y1 == b.y1 && (opaque ? (a.x1 + 1 >= b.x0 && b.x1 + 1 >= a.x0) : (a.x1 + 1 == b.x0 || b.x1 + 1 == a.x0));
+            bool cols = a.x0 == b.x0 && a.x1 == b.x1 && (opaque ? (a.y1 + 1 >= b.y0 && b.y1 + 1 >= a.y0) : (a.y1 + 1 == b.y0 || b.y1 + 1 == a.y0));
+
+            if (rows || cols)
+            {
+                IntRect u = a.Union(b);
+                prev.args[0].i = u.x0;
+                prev.args[1].i = u.y0;
+                prev.args[2].i = u.x1;
+                prev.args[3].i = u.y1;
+                prev.bounds = prev.bounds.Union(cmd.bounds);
+                stats.merged++;
+                continue;
+            }
+        }
+
+        work[++out] = cmd;
+    }
+    work.resize(out + 1);
+}
+
+bool CommandBuffer::ExecuteAntiAliased(const DrawCommand &cmd, uint32_t *pixels, int stride, int width, int height, const IntRect &cr) const
+{
+    const CommandArg *a = cmd.args;
+
+    switch (cmd.op)
+    {
+    case DrawOp::Line: draw_line_aa(pixels, stride, width, height, (float)a[0].i, (float)a[1].i, (float)a[2].i, (float)a[3].i, a[4].u, 1.0f, &cr); return true;
+    case DrawOp::LineF: draw_line_aa(pixels, stride, width, height, a[0].f, a[1].f, a[2].f, a[3].f, a[4].u, 1.0f, &cr); return true;
+    case DrawOp::LineThick: draw_line_aa(pixels, stride, width, height, (float)a[0].i, (float)a[1].i, (float)a[2].i, (float)a[3].i, a[4].u, (float)a[5].i, &cr); return true;
+    case DrawOp::RectF: draw_rectF_aa(pixels, stride, width, height, a[0].f, a[1].f, a[2].f, a[3].f, a[4].u, &cr); return true;
+    case DrawOp::RectRounded: draw_rect_rounded_aa(pixels, stride, width, height, a[0].i, a[1].i, a[2].i, a[3].i, a[4].i, a[5].u, &cr); return true;
+    case DrawOp::RectRoundedFilled: draw_rect_rounded_filled_aa(pixels, stride, width, height, a[0].i, a[1].i, a[2].i, a[3].i, a[4].i, a[5].u, &cr); return true;
+    case DrawOp::Circle: draw_circle_aa(pixels, stride, width, height, (float)a[0].i, (float)a[1].i, (float)a[2].i, a[3].u, 1.0f, &cr); return true;
+    case DrawOp::CircleF: draw_circle_aa(pixels, stride, width, height, a[0].f, a[1].f, a[2].f, a[3].u, 1.0f, &cr); return true;
+    case DrawOp::CircleFilled: draw_circle_filled_aa(pixels, stride, width, height, (float)a[0].i, (float)a[1].i, (float)a[2].i, a[3].u, &cr); return true;
+    case DrawOp::PathFilled: draw_path_filled_aa(pixels, stride, width, height, DataAt<float>(a[0].u), DataAt<int>(a[2].u), (int)(a[3].u / sizeof(int)), a[4].u, (FillRule)a[5].i, &cr); return true;
+    default: return false;
+    }
+}
+
+void CommandBuffer::Execute(const DrawCommand &cmd, uint32_t *pixels, int stride, int width, int height, const IntRect *clip, RasterScratch &scratch) const
+{
+    const CommandArg *a = cmd.args;
+    const int *points = (cmd.op == DrawOp::Polygon || cmd.op == DrawOp::PolygonFilled) ? DataAt<int>(a[0].u) : nullptr;
+
+    // 录制时的裁剪区，再与调用方的裁剪区（分块）求交
+    IntRect cr = clip ? cmd.clip.Intersect(*clip) : cmd.clip;
+    if (cr.IsEmpty()) return;
+
+    if ((cmd.flags & DrawCommand::FLAG_ANTIALIAS) && ExecuteAntiAliased(cmd, pixels, stride, width, height, cr)) return;
+
+    switch (cmd.op)
+    {
+    case DrawOp::Pixel: put_pixel(pixels, stride, width, height, a[0].i, a[1].i, a[2].u, &cr); break;
+    case DrawOp::Line: draw_line(pixels, stride, width, height, a[0].i, a[1].i, a[2].i, a[3].i, a[4].u, &cr); break;
+    case DrawOp::LineF: draw_lineF(pixels, stride, width, height, a[0].f, a[1].f, a[2].f, a[3].f, a[4].u, &cr); break;
+    case DrawOp::LineThick: draw_line_thick(pixels, stride, width, height, a[0].i, a[1].i, a[2].i, a[3].i, a[4].u, a[5].i, &cr); break;
+    case DrawOp::Rect: draw_rect(pixels, stride, width, height, a[0].i, a[1].i, a[2].i, a[3].i, a[4].u, &cr); break;
+    case DrawOp::RectF: draw_rectF(pixels, stride, width, height, a[0].f, a[1].f, a[2].f, a[3].f, a[4].u, &cr); break;
+    case DrawOp::RectFilled: draw_rect_filled(pixels, stride, width, height, a[0].i, a[1].i, a[2].i, a[3].i, a[4].u, &cr); break;
+    case DrawOp::RectRounded: draw_rect_rounded(pixels, stride, width, height, a[0].i, a[1].i, a[2].i, a[3].i, a[4].i, a[5].u, &cr); break;
+    case DrawOp::RectRoundedFilled: draw_rect_rounded_filled(pixels, stride, width, height, a[0].i, a[1].i, a[2].i, a[3].i, a[4].i, a[5].u, &cr); break;
+    case DrawOp::Circle: draw_circle(pixels, stride, width, height, a[0].i, a[1].i, a[2].i, a[3].u, &cr); break;
+    case DrawOp::CircleF: draw_circleF(pixels, stride, width, height, a[0].f, a[1].f, a[2].f, a[3].u, &cr); break;
+    case DrawOp::CircleFilled: draw_circle_filled(pixels, stride, width, height, a[0].i, a[1].i, a[2].i, a[3].u, &cr); break;
+    case DrawOp::Triangle: draw_triangle(pixels, stride, width, height, a[0].i, a[1].i, a[2].i, a[3].i, a[4].i, a[5].i, a[6].u, &cr); break;
+    case DrawOp::TriangleFilled: draw_triangle_filled(pixels, stride, width, height, a[0].i, a[1].i, a[2].i, a[3].i, a[4].i, a[5].i, a[6].u, &cr); break;
+    case DrawOp::Polygon: draw_polygon(pixels, stride, width, height, points, a[1].i, a[2].u, &cr); break;
+    case DrawOp::PolygonFilled: draw_polygon_filled(pixels, stride, width, height, points, a[1].i, a[2].u, &cr); break;
+    case DrawOp::BezierCubic: draw_bezier_cubic(pixels, stride, width, height, a[0].f, a[1].f, a[2].f, a[3].f, a[4].f, a[5].f, a[6].f, a[7].f, a[8].u, a[9].i, &cr); break;
+    case DrawOp::BezierQuadratic: draw_bezier_quadratic(pixels, stride, width, height, a[0].f, a[1].f, a[2].f, a[3].f, a[4].f, a[5].f, a[6].u, a[7].i, &cr); break;
+    case DrawOp::GradientLinear: fill_gradient_linear(pixels, stride, width, height, a[0].i, a[1].i, a[2].i, a[3].i, a[4].f, a[5].f, a[6].f, a[7].f, *DataAt<GradientRamp>(a[8].u), &cr); break;
+    case DrawOp::GradientRadial: fill_gradient_radial(pixels, stride, width, height, a[0].i, a[1].i, a[2].i, *DataAt<GradientRamp>(a[3].u), &cr); break;
+    case DrawOp::Text:
+        scratch.text.assign(DataAt<char>(a[2].u), a[3].u);
+        Text::RenderText(pixels, stride, width, height, a[0].i, a[1].i, scratch.text, a[4].i, a[5].u, &cr);
+        break;
+    case DrawOp::Clear: clear_screen(pixels, stride, width, height, a[0].u, &cr); break;
+    case DrawOp::Surface:
+    {
+        const Surface *surface = reinterpret_cast<const Surface *>((uintptr_t)((uint64_t)a[2].u | ((uint64_t)a[3].u << 32)));
+        draw_surface(pixels, stride, width, height, *surface, a[0].i, a[1].i, &cr);
+        break;
+    }
+    case DrawOp::Image:
+    {
+        const Texture *texture = reinterpret_cast<const Texture *>((uintptr_t)((uint64_t)a[2].u | ((uint64_t)a[3].u << 32)));
+        draw_texture(pixels, stride, width, height, *texture, a[0].i, a[1].i, a[4].u, &cr);
+        break;
+    }
+    case DrawOp::ImageScaled:
+    {
+        const Texture *texture = reinterpret_cast<const Texture *>((uintptr_t)((uint64_t)a[4].u | ((uint64_t)a[5].u << 32)));
+        const TextureSampling *sampling = DataAt<TextureSampling>(a[6].u);
+        draw_texture_scaled(pixels, stride, width, height, *texture, a[0].i, a[1].i, a[2].i, a[3].i, &sampling->source, sampling->filter, sampling->tint, &cr);
+        break;
+    }
+    case DrawOp::TextSdf:
+    {
+        scratch.text.assign(DataAt<char>(a[2].u), a[3].u);
+        const Text::SdfEffect *effect = DataAt<Text::SdfEffect>(a[6].u);
+        Text::RenderTextSdf(pixels, stride, width, height, a[0].f, a[1].f, scratch.text, a[4].f, a[5].u, *effect, &cr);
+        break;
+    }
+    case DrawOp::EntityBatch: draw_entity_batch(pixels, stride, width, height, GetData() + a[0].u, &cr); break;
+    case DrawOp::PolygonF: draw_polygonF(pixels, stride, width, height, DataAt<float>(a[0].u), a[1].i, a[2].u, &cr); break;
+    case DrawOp::PathFilled: draw_path_filled(pixels, stride, width, height, DataAt<float>(a[0].u), DataAt<int>(a[2].u), (int)(a[3].u / sizeof(int)), a[4].u, (FillRule)a[5].i, &cr); break;
+    }
+}
+
+} // namespace Graphics
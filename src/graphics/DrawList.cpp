@@ -8,161 +8,558 @@
  * 
  * 特性：
  * - 裁剪区域
- * - 几何变换
+ * - 几何变换（2x3 仿射矩阵，纯平移走整数快速路径）
  * - 文本渲染
+ * - 可选抗锯齿（线条、圆、圆角矩形）
+ * - 坐标原点偏移、离屏缓存贴图
  * 
  * 仅供学习和研究使用
  */
 
 #include "graphics/DrawList.h"
+#include "graphics/Rasterizer.h"
+#include "text/SdfText.h"
+#include "text/TextLayout.h"
 #include "text/TextRenderer.h"
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 namespace Graphics
 {
 
-DrawList::DrawList(uint32_t *buffer, int stride, int width, int height) : pixels(buffer), stride(stride), width(width), height(height)
+static const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+DrawList::DrawList(uint32_t *buffer, int stride, int width, int height, Core::FrameArena *arena) : pixels(buffer), stride(stride), width(width), height(height), recorder(nullptr), antiAliasing(false), originX(0), originY(0), layer(DrawLayer::All), drawnBounds(IntRect::Empty()), signature(FNV_OFFSET), transform(Affine::Identity()), transformKind(AffineKind::Translate), transformScale(1.0f), transformX(0), transformY(0)
 {
+    BindArena(arena);
+}
+
+DrawList::DrawList(int width, int height, Core::FrameArena *arena) : pixels(nullptr), stride(width), width(width), height(height), recorder(nullptr), antiAliasing(false), originX(0), originY(0), layer(DrawLayer::All), drawnBounds(IntRect::Empty()), signature(FNV_OFFSET), transform(Affine::Identity()), transformKind(AffineKind::Translate), transformScale(1.0f), transformX(0), transformY(0)
+{
+    BindArena(arena);
+}
+
+DrawList::DrawList(CommandBuffer *buffer, int width, int height, Core::FrameArena *arena) : pixels(nullptr), stride(width), width(width), height(height), recorder(buffer), antiAliasing(false), originX(0), originY(0), layer(DrawLayer::All), drawnBounds(IntRect::Empty()), signature(FNV_OFFSET), transform(Affine::Identity()), transformKind(AffineKind::Translate), transformScale(1.0f), transformX(0), transformY(0)
+{
+    BindArena(arena);
 }
 
 DrawList::~DrawList()
 {
 }
 
+void DrawList::BindArena(Core::FrameArena *arena)
+{
+    if (!arena) return;
+
+    // 成员容器整体换成 arena 分配（分配器随赋值传递），栈预留常见深度
+    clipRectStack = Core::ArenaVector<IntRect>(Core::ArenaAllocator<IntRect>(arena));
+    transformStack = Core::ArenaVector<Affine>(Core::ArenaAllocator<Affine>(arena));
+    translatedPoints = Core::ArenaVector<int>(Core::ArenaAllocator<int>(arena));
+    entityRects = Core::ArenaVector<int>(Core::ArenaAllocator<int>(arena));
+    entityData = Core::ArenaVector<uint8_t>(Core::ArenaAllocator<uint8_t>(arena));
+    pathPoints = Core::ArenaVector<float>(Core::ArenaAllocator<float>(arena));
+    devicePoints = Core::ArenaVector<float>(Core::ArenaAllocator<float>(arena));
+    deviceContours = Core::ArenaVector<int>(Core::ArenaAllocator<int>(arena));
+    clipRectStack.reserve(8);
+    transformStack.reserve(8);
+}
+
 void DrawList::AddPixel(int x, int y, uint32_t color)
 {
+    Translate(x, y);
     if (!IsPointInClipRect(x, y)) return;
-    put_pixel(pixels, stride, width, height, x, y, color);
+    if (!Track(DrawOp::Pixel, x, y, x, y, x, y, color)) return;
+    put_pixel(pixels, stride, width, height, x, y, color, Clip());
 }
 
 void DrawList::AddPixelF(float x, float y, uint32_t color)
 {
-    ApplyTransform(x, y);
-    AddPixel((int)x, (int)y, color);
+    TransformPoint(x, y);
+    int ix = (int)x, iy = (int)y;
+    if (!IsPointInClipRect(ix, iy)) return;
+    if (!Track(DrawOp::Pixel, ix, iy, ix, iy, ix, iy, color)) return;
+    put_pixel(pixels, stride, width, height, ix, iy, color, Clip());
 }
 
 void DrawList::AddLine(int x0, int y0, int x1, int y1, uint32_t color)
 {
-    draw_line(pixels, stride, width, height, x0, y0, x1, y1, color);
+    Translate(x0, y0);
+    Translate(x1, y1);
+    if (!Track(DrawOp::Line, std::min(x0, x1), std::min(y0, y1), std::max(x0, x1), std::max(y0, y1), x0, y0, x1, y1, color)) return;
+    if (antiAliasing)
+    {
+        draw_line_aa(pixels, stride, width, height, (float)x0, (float)y0, (float)x1, (float)y1, color, 1.0f, Clip());
+        return;
+    }
+    draw_line(pixels, stride, width, height, x0, y0, x1, y1, color, Clip());
 }
 
 void DrawList::AddLineF(float x0, float y0, float x1, float y1, uint32_t color)
 {
-    ApplyTransform(x0, y0);
-    ApplyTransform(x1, y1);
-    draw_lineF(pixels, stride, width, height, x0, y0, x1, y1, color);
+    TransformPoint(x0, y0);
+    TransformPoint(x1, y1);
+    if (!Track(DrawOp::LineF, (int)std::min(x0, x1) - 1, (int)std::min(y0, y1) - 1, (int)std::max(x0, x1) + 1, (int)std::max(y0, y1) + 1, x0, y0, x1, y1, color)) return;
+    if (antiAliasing)
+    {
+        draw_line_aa(pixels, stride, width, height, x0, y0, x1, y1, color, 1.0f, Clip());
+        return;
+    }
+    draw_lineF(pixels, stride, width, height, x0, y0, x1, y1, color, Clip());
 }
 
 void DrawList::AddLineThick(int x0, int y0, int x1, int y1, uint32_t color, int thickness)
 {
-    draw_line_thick(pixels, stride, width, height, x0, y0, x1, y1, color, thickness);
+    Translate(x0, y0);
+    Translate(x1, y1);
+    thickness = TransformLength(thickness);
+    int pad = thickness / 2 + 1;
+    if (!Track(DrawOp::LineThick, std::min(x0, x1) - pad, std::min(y0, y1) - pad, std::max(x0, x1) + pad, std::max(y0, y1) + pad, x0, y0, x1, y1, color, thickness)) return;
+    if (antiAliasing)
+    {
+        draw_line_aa(pixels, stride, width, height, (float)x0, (float)y0, (float)x1, (float)y1, color, (float)thickness, Clip());
+        return;
+    }
+    draw_line_thick(pixels, stride, width, height, x0, y0, x1, y1, color, thickness, Clip());
 }
 
 void DrawList::AddRect(int x0, int y0, int x1, int y1, uint32_t color)
 {
-    draw_rect(pixels, stride, width, height, x0, y0, x1, y1, color);
+    if (transformKind == AffineKind::General)
+    {
+        // 边框经过像素中心
+        PathRect((float)x0, (float)y0, (float)x1, (float)y1);
+        AddPath(false, color);
+        return;
+    }
+
+    TransformRect(x0, y0, x1, y1);
+    if (!Track(DrawOp::Rect, std::min(x0, x1), std::min(y0, y1), std::max(x0, x1), std::max(y0, y1), x0, y0, x1, y1, color)) return;
+    draw_rect(pixels, stride, width, height, x0, y0, x1, y1, color, Clip());
 }
 
 void DrawList::AddRectF(float x0, float y0, float x1, float y1, uint32_t color)
 {
-    ApplyTransform(x0, y0);
-    ApplyTransform(x1, y1);
-    draw_rectF(pixels, stride, width, height, x0, y0, x1, y1, color);
+    if (transformKind == AffineKind::General)
+    {
+        PathRect(x0, y0, x1, y1);
+        AddPath(false, color);
+        return;
+    }
+
+    TransformPoint(x0, y0);
+    TransformPoint(x1, y1);
+    if (!Track(DrawOp::RectF, (int)std::min(x0, x1) - 1, (int)std::min(y0, y1) - 1, (int)std::max(x0, x1) + 1, (int)std::max(y0, y1) + 1, x0, y0, x1, y1, color)) return;
+    if (antiAliasing)
+    {
+        draw_rectF_aa(pixels, stride, width, height, x0, y0, x1, y1, color, Clip());
+        return;
+    }
+    draw_rectF(pixels, stride, width, height, x0, y0, x1, y1, color, Clip());
 }
 
 void DrawList::AddRectFilled(int x0, int y0, int x1, int y1, uint32_t color)
 {
-    draw_rect_filled(pixels, stride, width, height, x0, y0, x1, y1, color);
+    if (transformKind == AffineKind::General)
+    {
+        // 填充覆盖整个像素：[x0, x1 + 1) × [y0, y1 + 1)
+        PathRect((float)std::min(x0, x1), (float)std::min(y0, y1), (float)std::max(x0, x1) + 1.0f, (float)std::max(y0, y1) + 1.0f);
+        AddPath(true, color);
+        return;
+    }
+
+    TransformRect(x0, y0, x1, y1);
+    if (!Track(DrawOp::RectFilled, std::min(x0, x1), std::min(y0, y1), std::max(x0, x1), std::max(y0, y1), x0, y0, x1, y1, color)) return;
+    draw_rect_filled(pixels, stride, width, height, x0, y0, x1, y1, color, Clip());
 }
 
 void DrawList::AddRectRounded(int x0, int y0, int x1, int y1, int radius, uint32_t color)
 {
-    draw_rect_rounded(pixels, stride, width, height, x0, y0, x1, y1, radius, color);
+    if (transformKind == AffineKind::General || !transform.IsSimilarity())
+    {
+        PathRoundedRect((float)x0, (float)y0, (float)x1, (float)y1, (float)radius);
+        AddPath(false, color);
+        return;
+    }
+
+    TransformRect(x0, y0, x1, y1);
+    radius = TransformLength(radius);
+    if (!Track(DrawOp::RectRounded, std::min(x0, x1), std::min(y0, y1), std::max(x0, x1), std::max(y0, y1), x0, y0, x1, y1, radius, color)) return;
+    if (antiAliasing)
+    {
+        draw_rect_rounded_aa(pixels, stride, width, height, x0, y0, x1, y1, radius, color, Clip());
+        return;
+    }
+    draw_rect_rounded(pixels, stride, width, height, x0, y0, x1, y1, radius, color, Clip());
 }
 
 void DrawList::AddRectRoundedFilled(int x0, int y0, int x1, int y1, int radius, uint32_t color)
 {
-    draw_rect_rounded_filled(pixels, stride, width, height, x0, y0, x1, y1, radius, color);
+    if (transformKind == AffineKind::General || !transform.IsSimilarity())
+    {
+        PathRoundedRect((float)std::min(x0, x1), (float)std::min(y0, y1), (float)std::max(x0, x1) + 1.0f, (float)std::max(y0, y1) + 1.0f, (float)radius);
+        AddPath(true, color);
+        return;
+    }
+
+    TransformRect(x0, y0, x1, y1);
+    radius = TransformLength(radius);
+    if (!Track(DrawOp::RectRoundedFilled, std::min(x0, x1), std::min(y0, y1), std::max(x0, x1), std::max(y0, y1), x0, y0, x1, y1, radius, color)) return;
+    if (antiAliasing)
+    {
+        draw_rect_rounded_filled_aa(pixels, stride, width, height, x0, y0, x1, y1, radius, color, Clip());
+        return;
+    }
+    draw_rect_rounded_filled(pixels, stride, width, height, x0, y0, x1, y1, radius, color, Clip());
 }
 
 void DrawList::AddCircle(int cx, int cy, int radius, uint32_t color)
 {
-    draw_circle(pixels, stride, width, height, cx, cy, radius, color);
+    if (!transform.IsSimilarity())
+    {
+        PathEllipse((float)cx, (float)cy, (float)radius, (float)radius);
+        AddPath(false, color);
+        return;
+    }
+
+    Translate(cx, cy);
+    radius = TransformLength(radius);
+    if (!Track(DrawOp::Circle, cx - radius, cy - radius, cx + radius, cy + radius, cx, cy, radius, color)) return;
+    if (antiAliasing)
+    {
+        draw_circle_aa(pixels, stride, width, height, (float)cx, (float)cy, (float)radius, color, 1.0f, Clip());
+        return;
+    }
+    draw_circle(pixels, stride, width, height, cx, cy, radius, color, Clip());
 }
 
 void DrawList::AddCircleF(float cx, float cy, float radius, uint32_t color)
 {
-    ApplyTransform(cx, cy);
-    draw_circleF(pixels, stride, width, height, cx, cy, radius, color);
+    if (!transform.IsSimilarity())
+    {
+        PathEllipse(cx, cy, radius, radius);
+        AddPath(false, color);
+        return;
+    }
+
+    TransformPoint(cx, cy);
+    radius *= transformScale;
+    if (!Track(DrawOp::CircleF, (int)std::floor(cx - radius), (int)std::floor(cy - radius), (int)std::ceil(cx + radius), (int)std::ceil(cy + radius), cx, cy, radius, color)) return;
+    if (antiAliasing)
+    {
+        draw_circle_aa(pixels, stride, width, height, cx, cy, radius, color, 1.0f, Clip());
+        return;
+    }
+    draw_circleF(pixels, stride, width, height, cx, cy, radius, color, Clip());
 }
 
 void DrawList::AddCircleFilled(int cx, int cy, int radius, uint32_t color)
 {
-    draw_circle_filled(pixels, stride, width, height, cx, cy, radius, color);
+    if (!transform.IsSimilarity())
+    {
+        // 覆盖像素中心落在圆内的像素，与 draw_circle_filled 一致
+        PathEllipse(cx + 0.5f, cy + 0.5f, radius + 0.5f, radius + 0.5f);
+        AddPath(true, color);
+        return;
+    }
+
+    Translate(cx, cy);
+    radius = TransformLength(radius);
+    if (!Track(DrawOp::CircleFilled, cx - radius, cy - radius, cx + radius, cy + radius, cx, cy, radius, color)) return;
+    if (antiAliasing)
+    {
+        draw_circle_filled_aa(pixels, stride, width, height, (float)cx, (float)cy, (float)radius, color, Clip());
+        return;
+    }
+    draw_circle_filled(pixels, stride, width, height, cx, cy, radius, color, Clip());
 }
 
 void DrawList::AddTriangle(int x0, int y0, int x1, int y1, int x2, int y2, uint32_t color)
 {
-    draw_triangle(pixels, stride, width, height, x0, y0, x1, y1, x2, y2, color);
+    Translate(x0, y0);
+    Translate(x1, y1);
+    Translate(x2, y2);
+    if (!Track(DrawOp::Triangle, std::min({ x0, x1, x2 }), std::min({ y0, y1, y2 }), std::max({ x0, x1, x2 }), std::max({ y0, y1, y2 }), x0, y0, x1, y1, x2, y2, color)) return;
+    draw_triangle(pixels, stride, width, height, x0, y0, x1, y1, x2, y2, color, Clip());
 }
 
 void DrawList::AddTriangleFilled(int x0, int y0, int x1, int y1, int x2, int y2, uint32_t color)
 {
-    draw_triangle_filled(pixels, stride, width, height, x0, y0, x1, y1, x2, y2, color);
+    Translate(x0, y0);
+    Translate(x1, y1);
+    Translate(x2, y2);
+    if (!Track(DrawOp::TriangleFilled, std::min({ x0, x1, x2 }), std::min({ y0, y1, y2 }), std::max({ x0, x1, x2 }), std::max({ y0, y1, y2 }), x0, y0, x1, y1, x2, y2, color)) return;
+    draw_triangle_filled(pixels, stride, width, height, x0, y0, x1, y1, x2, y2, color, Clip());
+}
+
+// 多边形范围
+static IntRect PolygonBounds(const int *points, int point_count)
+{
+    IntRect r = IntRect::Empty();
+    for (int i = 0; i < point_count; i++)
+    {
+        r = r.Union({ points[i * 2], points[i * 2 + 1], points[i * 2], points[i * 2 + 1] });
+    }
+    return r;
 }
 
 void DrawList::AddPolygon(const int *points, int point_count, uint32_t color)
 {
-    draw_polygon(pixels, stride, width, height, points, point_count, color);
+    AddPolygonPoints(TranslatePoints(points, point_count), point_count, color, false);
 }
 
 void DrawList::AddPolygonFilled(const int *points, int point_count, uint32_t color)
 {
-    draw_polygon_filled(pixels, stride, width, height, points, point_count, color);
+    AddPolygonPoints(TranslatePoints(points, point_count), point_count, color, true);
+}
+
+void DrawList::AddPolygonPoints(const int *points, int point_count, uint32_t color, bool filled)
+{
+    IntRect r = PolygonBounds(points, point_count);
+    DrawOp op = filled ? DrawOp::PolygonFilled : DrawOp::Polygon;
+    if (!Track(op, r.x0, r.y0, r.x1, r.y1, PointList{ points, point_count }, color)) return;
+    if (filled)
+    {
+        draw_polygon_filled(pixels, stride, width, height, points, point_count, color, Clip());
+    }
+    else
+    {
+        draw_polygon(pixels, stride, width, height, points, point_count, color, Clip());
+    }
+}
+// 浮点多边形范围（含边上的像素）
+static IntRect PolygonBoundsF(const float *points, int point_count)
+{
+    if (point_count <= 0) return IntRect::Empty();
+
+    float x0 = points[0], y0 = points[1], x1 = points[0], y1 = points[1];
+    for (int i = 1; i < point_count; i++)
+    {
+        x0 = std::min(x0, points[i * 2]);
+        y0 = std::min(y0, points[i * 2 + 1]);
+        x1 = std::max(x1, points[i * 2]);
+        y1 = std::max(y1, points[i * 2 + 1]);
+    }
+    return { (int)std::floor(x0), (int)std::floor(y0), (int)std::ceil(x1), (int)std::ceil(y1) };
+}
+
+const float *DrawList::TransformPoints(const float *points, int point_count)
+{
+    devicePoints.resize(point_count * 2);
+    for (int i = 0; i < point_count * 2; i += 2)
+    {
+        float x = points[i], y = points[i + 1];
+        TransformPoint(x, y);
+        devicePoints[i] = x;
+        devicePoints[i + 1] = y;
+    }
+    return devicePoints.data();
+}
+
+void DrawList::AddPolygon(const float *points, int point_count, uint32_t color)
+{
+    if (point_count < 2) return;
+
+    const float *device = TransformPoints(points, point_count);
+    IntRect r = PolygonBoundsF(device, point_count);
+    if (!Track(DrawOp::PolygonF, r.x0, r.y0, r.x1, r.y1, PointListF{ device, point_count }, color)) return;
+    draw_polygonF(pixels, stride, width, height, device, point_count, color, Clip());
+}
+
+void DrawList::AddPolygonFilled(const float *points, int point_count, uint32_t color, FillRule rule)
+{
+    if (point_count < 3) return;
+
+    AddContoursFilled(TransformPoints(points, point_count), &point_count, 1, color, rule);
+}
+
+void DrawList::AddPathFilled(const Path &path, uint32_t color, FillRule rule)
+{
+    path.Flatten(transform, (float)originX, (float)originY, devicePoints, deviceContours);
+    if (deviceContours.empty()) return;
+
+    AddContoursFilled(devicePoints.data(), deviceContours.data(), (int)deviceContours.size(), color, rule);
+}
+
+void DrawList::AddContoursFilled(const float *points, const int *contour_sizes, int contour_count, uint32_t color, FillRule rule)
+{
+    int total = 0;
+    for (int i = 0; i < contour_count; i++)
+    {
+        total += contour_sizes[i];
+    }
+
+    IntRect r = PolygonBoundsF(points, total);
+    DataBlock contours = { contour_sizes, (uint32_t)(contour_count * sizeof(int)) };
+    if (!Track(DrawOp::PathFilled, r.x0, r.y0, r.x1, r.y1, PointListF{ points, total }, contours, color, (int)rule)) return;
+
+    if (UseAntiAliasing(DrawOp::PathFilled))
+    {
+        draw_path_filled_aa(pixels, stride, width, height, points, contour_sizes, contour_count, color, rule, Clip());
+        return;
+    }
+    draw_path_filled(pixels, stride, width, height, points, contour_sizes, contour_count, color, rule, Clip());
 }
 
 void DrawList::AddBezierCubic(float x0, float y0, float x1, float y1, float x2, float y2, float x3, float y3, uint32_t color, int segments)
 {
-    ApplyTransform(x0, y0);
-    ApplyTransform(x1, y1);
-    ApplyTransform(x2, y2);
-    ApplyTransform(x3, y3);
-    draw_bezier_cubic(pixels, stride, width, height, x0, y0, x1, y1, x2, y2, x3, y3, color, segments);
+    TransformPoint(x0, y0);
+    TransformPoint(x1, y1);
+    TransformPoint(x2, y2);
+    TransformPoint(x3, y3);
+    if (!Track(DrawOp::BezierCubic, (int)std::min({ x0, x1, x2, x3 }) - 1, (int)std::min({ y0, y1, y2, y3 }) - 1, (int)std::max({ x0, x1, x2, x3 }) + 1, (int)std::max({ y0, y1, y2, y3 }) + 1, x0, y0, x1, y1, x2, y2, x3, y3, color, segments)) return;
+    draw_bezier_cubic(pixels, stride, width, height, x0, y0, x1, y1, x2, y2, x3, y3, color, segments, Clip());
 }
 
 void DrawList::AddBezierQuadratic(float x0, float y0, float x1, float y1, float x2, float y2, uint32_t color, int segments)
 {
-    ApplyTransform(x0, y0);
-    ApplyTransform(x1, y1);
-    ApplyTransform(x2, y2);
-    draw_bezier_quadratic(pixels, stride, width, height, x0, y0, x1, y1, x2, y2, color, segments);
+    TransformPoint(x0, y0);
+    TransformPoint(x1, y1);
+    TransformPoint(x2, y2);
+    if (!Track(DrawOp::BezierQuadratic, (int)std::min({ x0, x1, x2 }) - 1, (int)std::min({ y0, y1, y2 }) - 1, (int)std::max({ x0, x1, x2 }) + 1, (int)std::max({ y0, y1, y2 }) + 1, x0, y0, x1, y1, x2, y2, color, segments)) return;
+    draw_bezier_quadratic(pixels, stride, width, height, x0, y0, x1, y1, x2, y2, color, segments, Clip());
 }
 
 void DrawList::AddGradientLinear(int x0, int y0, int x1, int y1, uint32_t color_start, uint32_t color_end)
 {
-    fill_gradient_linear(pixels, stride, width, height, x0, y0, x1, y1, color_start, color_end);
+    TransformRect(x0, y0, x1, y1);
+    if (y0 > y1) std::swap(y0, y1);
+    AddGradientLinearDevice(x0, y0, x1, y1, 0.0f, (float)y0, 0.0f, (float)(y1 + 1), GradientCache::Instance().Get(color_start, color_end));
+}
+
+void DrawList::AddGradientLinear(int x0, int y0, int x1, int y1, float from_x, float from_y, float to_x, float to_y, const Gradient &gradient)
+{
+    TransformRect(x0, y0, x1, y1);
+    TransformPoint(from_x, from_y);
+    TransformPoint(to_x, to_y);
+    AddGradientLinearDevice(x0, y0, x1, y1, from_x, from_y, to_x, to_y, GradientCache::Instance().Get(gradient));
+}
+
+void DrawList::AddGradientLinear(int x0, int y0, int x1, int y1, const Gradient &gradient, bool horizontal)
+{
+    if (x0 > x1) std::swap(x0, x1);
+    if (y0 > y1) std::swap(y0, y1);
+    if (horizontal)
+    {
+        AddGradientLinear(x0, y0, x1, y1, (float)x0, (float)y0, (float)(x1 + 1), (float)y0, gradient);
+    }
+    else
+    {
+        AddGradientLinear(x0, y0, x1, y1, (float)x0, (float)y0, (float)x0, (float)(y1 + 1), gradient);
+    }
+}
+
+void DrawList::AddGradientLinearDevice(int x0, int y0, int x1, int y1, float from_x, float from_y, float to_x, float to_y, const GradientRamp &ramp)
+{
+    if (!Track(DrawOp::GradientLinear, std::min(x0, x1), std::min(y0, y1), std::max(x0, x1), std::max(y0, y1), x0, y0, x1, y1, from_x, from_y, to_x, to_y, ramp)) return;
+    fill_gradient_linear(pixels, stride, width, height, x0, y0, x1, y1, from_x, from_y, to_x, to_y, ramp, Clip());
 }
 
 void DrawList::AddGradientRadial(int cx, int cy, int radius, uint32_t color_center, uint32_t color_edge)
 {
-    fill_gradient_radial(pixels, stride, width, height, cx, cy, radius, color_center, color_edge);
+    Translate(cx, cy);
+    AddGradientRadialDevice(cx, cy, TransformLength(radius), GradientCache::Instance().Get(color_center, color_edge));
+}
+
+void DrawList::AddGradientRadial(int cx, int cy, int radius, const Gradient &gradient)
+{
+    Translate(cx, cy);
+    AddGradientRadialDevice(cx, cy, TransformLength(radius), GradientCache::Instance().Get(gradient));
+}
+
+void DrawList::AddGradientRadialDevice(int cx, int cy, int radius, const GradientRamp &ramp)
+{
+    if (!Track(DrawOp::GradientRadial, cx - radius, cy - radius, cx + radius, cy + radius, cx, cy, radius, ramp)) return;
+    fill_gradient_radial(pixels, stride, width, height, cx, cy, radius, ramp, Clip());
+}
+
+void DrawList::AddSurface(const Surface &surface, int x, int y)
+{
+    Translate(x, y);
+    if (!Track(DrawOp::Surface, x, y, x + surface.GetWidth() - 1, y + surface.GetHeight() - 1, x, y, &surface)) return;
+    draw_surface(pixels, stride, width, height, surface, x, y, Clip());
+}
+
+void DrawList::AddImage(const Texture &texture, int x, int y)
+{
+    if (transformKind != AffineKind::Translate)
+    {
+        AddImageScaled(texture, x, y, x + texture.GetWidth() - 1, y + texture.GetHeight() - 1);
+        return;
+    }
+
+    Translate(x, y);
+    uint32_t tint = 0xFFFFFFFF;
+    if (!Track(DrawOp::Image, x, y, x + texture.GetWidth() - 1, y + texture.GetHeight() - 1, x, y, &texture, tint)) return;
+    draw_texture(pixels, stride, width, height, texture, x, y, tint, Clip());
+}
+
+void DrawList::AddImageScaled(const Texture &texture, int x0, int y0, int x1, int y1, TextureFilter filter)
+{
+    AddImageRegion(texture, IntRect{ 0, 0, texture.GetWidth() - 1, texture.GetHeight() - 1 }, x0, y0, x1, y1, 0xFFFFFFFF, filter);
+}
+
+void DrawList::AddImageTinted(const Texture &texture, int x0, int y0, int x1, int y1, uint32_t tint, TextureFilter filter)
+{
+    AddImageRegion(texture, IntRect{ 0, 0, texture.GetWidth() - 1, texture.GetHeight() - 1 }, x0, y0, x1, y1, tint, filter);
+}
+
+void DrawList::AddImageRegion(const Texture &texture, const IntRect &source, int x0, int y0, int x1, int y1, uint32_t tint, TextureFilter filter)
+{
+    if (texture.IsEmpty() || (tint >> 24) == 0) return;
+
+    TransformRect(x0, y0, x1, y1);
+    if (x0 > x1) std::swap(x0, x1);
+    if (y0 > y1) std::swap(y0, y1);
+
+    TextureSampling sampling = { source, filter, tint };
+    if (!Track(DrawOp::ImageScaled, x0, y0, x1, y1, x0, y0, x1, y1, &texture, sampling)) return;
+    draw_texture_scaled(pixels, stride, width, height, texture, x0, y0, x1, y1, &source, filter, tint, Clip());
+}
+
+// 字号按变换缩放
+static int ScaleFontSize(int font_size, float scale)
+{
+    if (scale == 1.0f) return font_size;
+    return std::max(1, (int)std::lround(font_size * scale));
 }
 
 void DrawList::AddText(int x, int y, const std::string &text, int font_size, uint32_t color)
 {
-    Text::RenderText(pixels, stride, width, height, x, y, text, font_size, color);
+    if (!Text::InitFont()) return;
+
+    Translate(x, y);
+    font_size = ScaleFontSize(font_size, transformScale);
+    AddTextLayout(x, y, text, Text::TextLayoutCache::Instance().Get(text, font_size), color);
+}
+
+void DrawList::AddTextLayout(int x, int y, const std::string &text, const Text::TextLayout &layout, uint32_t color)
+{
+    const Text::TextBounds &b = layout.ink;
+    if (!Track(DrawOp::Text, b.x0 + x, b.y0 + y, b.x1 + x, b.y1 + y, x, y, text, layout.fontSize, color)) return;
+    Text::RenderTextLayout(pixels, stride, width, height, x, y, layout, color, Clip());
 }
 
 void DrawList::AddText(float x, float y, const std::string &text, int font_size, uint32_t color)
 {
-    ApplyTransform(x, y);
-    AddText((int)x, (int)y, text, font_size, color);
+    if (!Text::InitFont()) return;
+
+    TransformPoint(x, y);
+    font_size = ScaleFontSize(font_size, transformScale);
+    AddTextLayout((int)x, (int)y, text, Text::TextLayoutCache::Instance().Get(text, font_size), color);
 }
 
 void DrawList::AddTextAligned(int x, int y, const std::string &text, int font_size, uint32_t color, TextAlign align)
 {
-    My_Vector2 size = CalcTextSize(text, font_size);
+    if (!Text::InitFont()) return;
+
+    // 测量与绘制共用一份排版（设备字号，对齐偏移也按设备像素）
+    Translate(x, y);
+    font_size = ScaleFontSize(font_size, transformScale);
+    const Text::TextLayout &layout = Text::TextLayoutCache::Instance().Get(text, font_size);
+    const My_Vector2 &size = layout.size;
 
     int offset_x = 0;
     switch (align)
@@ -173,7 +570,72 @@ void DrawList::AddTextAligned(int x, int y, const std::string &text, int font_si
     default: offset_x = 0; break;
     }
 
-    AddText(x + offset_x, y, text, font_size, color);
+    AddTextLayout(x + offset_x, y, text, layout, color);
+}
+
+void DrawList::AddTextSdf(float x, float y, const std::string &text, float font_size, uint32_t color, const Text::SdfEffect *effect)
+{
+    if (!Text::InitFont()) return;
+
+    // 位置走完整变换，字号与效果只随缩放变化（旋转不影响字形朝向）
+    TransformPoint(x, y);
+    float scale = transformScale;
+    Text::SdfEffect fx = effect ? *effect : Text::SdfEffect();
+    fx.outlineWidth *= scale;
+    fx.shadowX *= scale;
+    fx.shadowY *= scale;
+    fx.shadowSoftness *= scale;
+    font_size *= scale;
+
+    Text::TextBounds b = Text::CalcTextBoundsSdf(x, y, text, font_size, fx);
+    if (!Track(DrawOp::TextSdf, b.x0, b.y0, b.x1, b.y1, x, y, text, font_size, color, fx)) return;
+    Text::RenderTextSdf(pixels, stride, width, height, x, y, text, font_size, color, fx, Clip());
+}
+
+void DrawList::AddEntityBatch(const EntityBatch &batch, const EntityStyle &style)
+{
+    const int n = (int)batch.Size();
+    if (n == 0) return;
+
+    // 方框转设备坐标，纯平移时是一个整数加法循环
+    entityRects.resize((size_t)n * 4);
+    int *r = entityRects.data();
+    if (transformKind == AffineKind::Translate)
+    {
+        int dx = originX + transformX, dy = originY + transformY;
+        for (int i = 0; i < n; i++)
+        {
+            r[i * 4] = batch.x0[i] + dx;
+            r[i * 4 + 1] = batch.y0[i] + dy;
+            r[i * 4 + 2] = batch.x1[i] + dx;
+            r[i * 4 + 3] = batch.y1[i] + dy;
+        }
+    }
+    else
+    {
+        for (int i = 0; i < n; i++)
+        {
+            int x0 = batch.x0[i], y0 = batch.y0[i], x1 = batch.x1[i], y1 = batch.y1[i];
+            TransformRect(x0, y0, x1, y1);
+            r[i * 4] = x0, r[i * 4 + 1] = y0, r[i * 4 + 2] = x1, r[i * 4 + 3] = y1;
+        }
+    }
+
+    EntityStyle device = style;
+    Translate(device.tracerX, device.tracerY);
+    device.nameSize = ScaleFontSize(style.nameSize, transformScale);
+    device.infoSize = ScaleFontSize(style.infoSize, transformScale);
+    device.healthHeight = TransformLength(style.healthHeight);
+    device.gap = TransformLength(style.gap);
+
+    IntRect b = pack_entity_batch(entityData, batch, r, device, antiAliasing, GetClipRect(), entityData.get_allocator().GetArena());
+    if (b.IsEmpty()) return;
+
+    // 抗锯齿射线边缘多覆盖一个像素
+    int pad = antiAliasing ? 1 : 0;
+    DataBlock block = { entityData.data(), (uint32_t)entityData.size() };
+    if (!Track(DrawOp::EntityBatch, b.x0 - pad, b.y0 - pad, b.x1 + pad, b.y1 + pad, block)) return;
+    draw_entity_batch(pixels, stride, width, height, entityData.data(), Clip());
 }
 
 My_Vector2 DrawList::CalcTextSize(const std::string &text, int font_size)
@@ -181,22 +643,25 @@ My_Vector2 DrawList::CalcTextSize(const std::string &text, int font_size)
     return Text::CalcTextSize(text, font_size);
 }
 
+My_Vector2 DrawList::CalcTextSizeSdf(const std::string &text, float font_size)
+{
+    return Text::CalcTextSizeSdf(text, font_size);
+}
+
 void DrawList::Clear(uint32_t color)
 {
-    clear_screen(pixels, stride, width, height, color);
+    if (!Track(DrawOp::Clear, 0, 0, width - 1, height - 1, color)) return;
+    clear_screen(pixels, stride, width, height, color, Clip());
 }
 
 void DrawList::PushClipRect(int x0, int y0, int x1, int y1)
 {
+    TransformRect(x0, y0, x1, y1);
     if (x0 > x1) std::swap(x0, x1);
     if (y0 > y1) std::swap(y0, y1);
 
-    x0 = std::max(0, x0);
-    y0 = std::max(0, y0);
-    x1 = std::min(width - 1, x1);
-    y1 = std::min(height - 1, y1);
-
-    clipRectStack.push_back({ x0, y0, x1, y1 });
+    // 嵌套时与上一层求交
+    clipRectStack.push_back(IntRect{ x0, y0, x1, y1 }.Intersect(GetClipRect()));
 }
 
 void DrawList::PopClipRect()
@@ -214,7 +679,14 @@ void DrawList::ClearClipRect()
 
 void DrawList::PushTransform(float tx, float ty, float scale, float rotation)
 {
-    transformStack.push_back({ tx, ty, scale, rotation });
+    PushTransform(Affine::Make(tx, ty, scale, rotation));
+}
+
+void DrawList::PushTransform(const Affine &matrix)
+{
+    // 与当前矩阵合成一次，之后每个点只做一次乘加
+    transformStack.push_back(transform * matrix);
+    UpdateTransform();
 }
 
 void DrawList::PopTransform()
@@ -222,42 +694,265 @@ void DrawList::PopTransform()
     if (!transformStack.empty())
     {
         transformStack.pop_back();
+        UpdateTransform();
+    }
+}
+
+void DrawList::UpdateTransform()
+{
+    transform = transformStack.empty() ? Affine::Identity() : transformStack.back();
+    transformKind = transform.GetKind();
+    transformScale = transform.GetScale();
+    transformX = (int)std::floor(transform.tx + 0.5f);
+    transformY = (int)std::floor(transform.ty + 0.5f);
+}
+
+IntRect DrawList::MarkBounds(const IntRect &rect)
+{
+    IntRect r = rect.Intersect({ 0, 0, width - 1, height - 1 });
+    if (!r.IsEmpty())
+    {
+        drawnBounds = drawnBounds.Union(r);
+    }
+    return r;
+}
+
+void DrawList::HashValue(uint32_t value)
+{
+    // FNV-1a，按字节混合
+    for (int i = 0; i < 4; i++)
+    {
+        signature ^= (value >> (i * 8)) & 0xFF;
+        signature *= FNV_PRIME;
+    }
+}
+
+void DrawList::HashValue(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    HashValue(bits);
+}
+
+void DrawList::HashValue(const std::string &value)
+{
+    HashValue((uint32_t)value.size());
+    for (unsigned char c : value)
+    {
+        signature ^= c;
+        signature *= FNV_PRIME;
+    }
+}
+
+void DrawList::HashValue(const Surface *value)
+{
+    // 内容由版本号代表，不逐像素哈希
+    HashValue((uint32_t)(uintptr_t)value);
+    HashValue(value->GetVersion());
+}
+
+void DrawList::HashValue(const Text::SdfEffect &value)
+{
+    HashValue(value.outlineWidth);
+    HashValue(value.outlineColor);
+    HashValue(value.shadowX);
+    HashValue(value.shadowY);
+    HashValue(value.shadowSoftness);
+    HashValue(value.shadowColor);
+}
+
+void DrawList::HashValue(const DataBlock &value)
+{
+    HashValue(value.size);
+    const uint8_t *bytes = static_cast<const uint8_t *>(value.data);
+    for (uint32_t i = 0; i < value.size; i++)
+    {
+        signature ^= bytes[i];
+        signature *= FNV_PRIME;
+    }
+}
+
+void DrawList::HashValue(const Texture *value)
+{
+    // 与 Surface 相同，内容由版本号代表
+    HashValue((uint32_t)(uintptr_t)value);
+    HashValue(value->GetVersion());
+}
+
+void DrawList::HashValue(const TextureSampling &value)
+{
+    HashValue(value.source.x0);
+    HashValue(value.source.y0);
+    HashValue(value.source.x1);
+    HashValue(value.source.y1);
+    HashValue((uint32_t)value.filter);
+    HashValue(value.tint);
+}
+
+void DrawList::HashValue(const GradientRamp &value)
+{
+    // 色带由色标哈希代表，不逐项哈希
+    HashValue(value.key[0]);
+    HashValue(value.key[1]);
+}
+
+void DrawList::HashValue(const PointListF &value)
+{
+    HashValue(value.count);
+    for (int i = 0; i < value.count * 2; i++)
+    {
+        HashValue(value.points[i]);
     }
 }
 
+void DrawList::HashValue(const PointList &value)
+{
+    HashValue(value.count);
+    for (int i = 0; i < value.count * 2; i++)
+    {
+        HashValue(value.points[i]);
+    }
+}
+
+IntRect DrawList::GetClipRect() const
+{
+    if (clipRectStack.empty()) return { 0, 0, width - 1, height - 1 };
+    return clipRectStack.back();
+}
+
 bool DrawList::IsPointInClipRect(int x, int y) const
 {
     if (clipRectStack.empty()) return true;
 
-    const ClipRect &rect = clipRectStack.back();
+    const IntRect &rect = clipRectStack.back();
     return x >= rect.x0 && x <= rect.x1 && y >= rect.y0 && y <= rect.y1;
 }
 
-void DrawList::ApplyTransform(float &x, float &y) const
+void DrawList::TransformRect(int &x0, int &y0, int &x1, int &y1) const
 {
-    if (transformStack.empty()) return;
+    if (transformKind == AffineKind::Translate)
+    {
+        Translate(x0, y0);
+        Translate(x1, y1);
+        return;
+    }
 
-    for (const auto &t : transformStack)
+    // 按像素边界 [x0, x1 + 1) 变换，缩放后宽高按比例变化
+    float ex0 = (float)std::min(x0, x1), ey0 = (float)std::min(y0, y1);
+    float ex1 = (float)std::max(x0, x1) + 1.0f, ey1 = (float)std::max(y0, y1) + 1.0f;
+    float cx[4] = { ex0, ex1, ex1, ex0 };
+    float cy[4] = { ey0, ey0, ey1, ey1 };
+    float fx0 = 0, fy0 = 0, fx1 = 0, fy1 = 0;
+    for (int i = 0; i < 4; i++)
     {
-        // 缩放
-        x *= t.scale;
-        y *= t.scale;
+        transform.Apply(cx[i], cy[i]);
+        fx0 = i ? std::min(fx0, cx[i]) : cx[i];
+        fy0 = i ? std::min(fy0, cy[i]) : cy[i];
+        fx1 = i ? std::max(fx1, cx[i]) : cx[i];
+        fy1 = i ? std::max(fy1, cy[i]) : cy[i];
+    }
+
+    x0 = (int)std::floor(fx0 + 0.5f) + originX;
+    y0 = (int)std::floor(fy0 + 0.5f) + originY;
+    x1 = std::max(x0, (int)std::floor(fx1 + 0.5f) - 1 + originX);
+    y1 = std::max(y0, (int)std::floor(fy1 + 0.5f) - 1 + originY);
+}
 
-        // 旋转
-        if (t.rotation != 0.0f)
+int DrawList::TransformLength(int length) const
+{
+    if (transformScale == 1.0f || length == 0) return length;
+    return std::max(1, (int)std::floor(length * transformScale + 0.5f));
+}
+
+const int *DrawList::TranslatePoints(const int *points, int point_count)
+{
+    if (transformKind == AffineKind::Translate)
+    {
+        int dx = originX + transformX, dy = originY + transformY;
+        if (dx == 0 && dy == 0) return points;
+
+        translatedPoints.resize(point_count * 2);
+        for (int i = 0; i < point_count; i++)
         {
-            float cos_r = std::cos(t.rotation);
-            float sin_r = std::sin(t.rotation);
-            float nx = x * cos_r - y * sin_r;
-            float ny = x * sin_r + y * cos_r;
-            x = nx;
-            y = ny;
+            translatedPoints[i * 2] = points[i * 2] + dx;
+            translatedPoints[i * 2 + 1] = points[i * 2 + 1] + dy;
         }
+        return translatedPoints.data();
+    }
+
+    translatedPoints.resize(point_count * 2);
+    transform.ApplyRounded(points, translatedPoints.data(), point_count, originX, originY);
+    return translatedPoints.data();
+}
 
-        // 平移
-        x += t.tx;
-        y += t.ty;
+void DrawList::PathRect(float x0, float y0, float x1, float y1)
+{
+    pathPoints.assign({ x0, y0, x1, y0, x1, y1, x0, y1 });
+}
+
+// 圆弧分段数：弦高误差约 0.25 设备像素
+static int ArcSegments(float radius)
+{
+    if (radius <= 0.5f) return 4;
+    float step = 2.0f * std::acos(std::max(-1.0f, 1.0f - 0.25f / radius));
+    return std::max(8, std::min(256, (int)std::ceil(6.2831853f / step)));
+}
+
+void DrawList::PathRoundedRect(float x0, float y0, float x1, float y1, float radius)
+{
+    if (x0 > x1) std::swap(x0, x1);
+    if (y0 > y1) std::swap(y0, y1);
+    radius = std::max(0.0f, std::min(radius, std::min(x1 - x0, y1 - y0) * 0.5f));
+
+    // 四个角各一段四分之一圆弧，顺时针
+    int quarter = std::max(1, ArcSegments(radius * transformScale) / 4);
+    float cx[4] = { x1 - radius, x1 - radius, x0 + radius, x0 + radius };
+    float cy[4] = { y0 + radius, y1 - radius, y1 - radius, y0 + radius };
+
+    pathPoints.clear();
+    for (int corner = 0; corner < 4; corner++)
+    {
+        float start = -1.5707963f + corner * 1.5707963f;
+        for (int i = 0; i <= quarter; i++)
+        {
+            float t = start + 1.5707963f * i / quarter;
+            pathPoints.push_back(cx[corner] + std::cos(t) * radius);
+            pathPoints.push_back(cy[corner] + std::sin(t) * radius);
+        }
+    }
+}
+
+void DrawList::PathEllipse(float cx, float cy, float rx, float ry)
+{
+    // 变换后的外接半径决定分段数，一次 sincos 之后用旋转递推
+    int segments = ArcSegments(std::max(rx, ry) * std::max(std::fabs(transform.a) + std::fabs(transform.c), std::fabs(transform.b) + std::fabs(transform.d)));
+    float step = 6.2831853f / segments;
+    float cs = std::cos(step), sn = std::sin(step);
+    float ux = 1.0f, uy = 0.0f;
+
+    pathPoints.resize(segments * 2);
+    for (int i = 0; i < segments; i++)
+    {
+        pathPoints[i * 2] = cx + ux * rx;
+        pathPoints[i * 2 + 1] = cy + uy * ry;
+        float nx = ux * cs - uy * sn;
+        uy = ux * sn + uy * cs;
+        ux = nx;
+    }
+}
+
+void DrawList::AddPath(bool filled, uint32_t color)
+{
+    int count = (int)pathPoints.size() / 2;
+    if (filled)
+    {
+        // 填充直接用浮点顶点，不取整
+        AddContoursFilled(TransformPoints(pathPoints.data(), count), &count, 1, color, FillRule::NonZero);
+        return;
     }
+    translatedPoints.resize(count * 2);
+    transform.ApplyRounded(pathPoints.data(), translatedPoints.data(), count, originX, originY);
+    AddPolygonPoints(translatedPoints.data(), count, color, filled);
 }
 
-} // namespace Graphics
\ No newline at end of file
+} // namespace Graphics
@@ -0,0 +1,459 @@
+/*
+ * CPU-Draw - Entity Batch Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 批量实体覆盖层
+ * 打包：逐实体计算整体范围后整批剔除，标签绘制按 (文本, 字号) 计数排序
+ * 回放：每种图元一遍循环，同一标签连续绘制，只查一次排版
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "graphics/EntityBatch.h"
+#include "graphics/CommandBuffer.h"
+#include "graphics/Rasterizer.h"
+#include "graphics/SpanKernels.h"
+#include "text/TextLayout.h"
+#include "text/TextRenderer.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Graphics
+{
+
+void EntityBatch::Clear()
+{
+    x0.clear();
+    y0.clear();
+    x1.clear();
+    y1.clear();
+    color.clear();
+    health.clear();
+    name.clear();
+    info.clear();
+    labels.clear();
+}
+
+void EntityBatch::Reserve(size_t count)
+{
+    x0.reserve(count);
+    y0.reserve(count);
+    x1.reserve(count);
+    y1.reserve(count);
+    color.reserve(count);
+    health.reserve(count);
+    name.reserve(count);
+    info.reserve(count);
+}
+
+int EntityBatch::AddLabel(const std::string &text)
+{
+    labels.push_back(text);
+    return (int)labels.size() - 1;
+}
+
+void EntityBatch::Add(int bx0, int by0, int bx1, int by1, uint32_t box_color, float health_value, int name_label, int info_label)
+{
+    x0.push_back(bx0);
+    y0.push_back(by0);
+    x1.push_back(bx1);
+    y1.push_back(by1);
+    color.push_back(box_color);
+    health.push_back(health_value);
+    name.push_back(name_label);
+    info.push_back(info_label);
+}
+
+// 打包数据的视图（打包时也通过它写入）
+struct EntityBatchView
+{
+    EntityBatchHeader *header;
+    int32_t *rects;      // 方框 x0, y0, x1, y1
+    uint32_t *colors;    // 方框颜色
+    int32_t *barY;       // 血条顶部
+    int32_t *barFill;    // 血量像素宽度，-1 表示无血条
+    uint32_t *barColors;
+    int32_t *drawLabel;  // 标签绘制：标签表下标（已排序）
+    int32_t *drawPos;    // 标签绘制：基线起点 x, y
+    int32_t *labelSize;
+    uint32_t *labelOffset;
+    uint32_t *labelLength;
+    char *text;
+};
+
+static size_t PackedSize(uint32_t count, uint32_t draws, uint32_t labels, uint32_t text)
+{
+    return sizeof(EntityBatchHeader) + count * 8 * sizeof(int32_t) + draws * 3 * sizeof(int32_t) + labels * 3 * sizeof(int32_t) + ((text + 3) & ~3u);
+}
+
+static EntityBatchView ParseEntityBatch(const uint8_t *data)
+{
+    uint8_t *base = const_cast<uint8_t *>(data);
+    EntityBatchView v;
+    v.header = reinterpret_cast<EntityBatchHeader *>(base);
+    uint32_t n = v.header->count;
+    uint32_t k = v.header->drawCount;
+    uint32_t m = v.header->labelCount;
+
+    int32_t *p = reinterpret_cast<int32_t *>(base + sizeof(EntityBatchHeader));
+    v.rects = p, p += n * 4;
+    v.colors = reinterpret_cast<uint32_t *>(p), p += n;
+    v.barY = p, p += n;
+    v.barFill = p, p += n;
+    v.barColors = reinterpret_cast<uint32_t *>(p), p += n;
+    v.drawLabel = p, p += k;
+    v.drawPos = p, p += k * 2;
+    v.labelSize = p, p += m;
+    v.labelOffset = reinterpret_cast<uint32_t *>(p), p += m;
+    v.labelLength = reinterpret_cast<uint32_t *>(p), p += m;
+    v.text = reinterpret_cast<char *>(p);
+    return v;
+}
+
+// 标签表中的一项：批内标签编号 + 字号
+struct LabelSlot
+{
+    int slot;            // 打包后的下标，-1 表示这一帧还没用到
+    Text::TextBounds ink; // 相对基线起点
+};
+
+static void ResolveLabel(Core::ArenaVector<LabelSlot> &slots, const EntityBatch &batch, int id, int size)
+{
+    LabelSlot &s = slots[id];
+    if (s.slot != -2) return;
+
+    s.slot = -1;
+    s.ink = { 0, 0, -1, -1 };
+    if (size > 0 && !batch.labels[id].empty() && Text::InitFont())
+    {
+        s.ink = Text::TextLayoutCache::Instance().Get(batch.labels[id], size).ink;
+    }
+}
+
+IntRect pack_entity_batch(Core::ArenaVector<uint8_t> &out, const EntityBatch &batch, const int *rects, const EntityStyle &style, bool anti_aliasing, const IntRect &clip, Core::FrameArena *arena)
+{
+    const int n = (int)batch.Size();
+    const int labelCount = (int)batch.labels.size();
+    const bool drawName = (style.flags & ENTITY_NAME) != 0;
+    const bool drawInfo = (style.flags & ENTITY_INFO) != 0;
+    const bool drawHealth = (style.flags & ENTITY_HEALTH) != 0 && style.healthHeight > 0;
+    const bool drawTracer = (style.flags & ENTITY_TRACER) != 0;
+    const int gap = style.gap;
+
+    // 名字与信息字号不同，各自一张表（-2 表示未排版）
+    // 临时数组都从 arena 分配，容量稳定后每帧不再向系统申请内存
+    const LabelSlot unresolved = { -2, { 0, 0, -1, -1 } };
+    Core::ArenaVector<LabelSlot> names(drawName ? labelCount : 0, unresolved, Core::ArenaAllocator<LabelSlot>(arena));
+    Core::ArenaVector<LabelSlot> infos(drawInfo ? labelCount : 0, unresolved, Core::ArenaAllocator<LabelSlot>(arena));
+
+    // 第一遍：计算每个实体的整体范围，剔除不可见的
+    struct Visible
+    {
+        int index;
+        int nameX, nameY, infoX, infoY;
+        int barY;
+    };
+    Core::ArenaVector<Visible> visible{ Core::ArenaAllocator<Visible>(arena) };
+    visible.reserve(n);
+    IntRect bounds = IntRect::Empty();
+
+    for (int i = 0; i < n; i++)
+    {
+        const int *r = rects + i * 4;
+        int bx0 = std::min(r[0], r[2]), by0 = std::min(r[1], r[3]);
+        int bx1 = std::max(r[0], r[2]), by1 = std::max(r[1], r[3]);
+        int cx = (bx0 + bx1) / 2;
+        IntRect region = { bx0, by0, bx1, by1 };
+
+        Visible v = { i, 0, 0, 0, 0, by1 };
+
+        int nameId = drawName ? batch.name[i] : -1;
+        if (nameId >= 0 && nameId < labelCount)
+        {
+            ResolveLabel(names, batch, nameId, style.nameSize);
+            const Text::TextBounds &ink = names[nameId].ink;
+            v.nameX = cx - (ink.x0 + ink.x1 + 1) / 2;
+            v.nameY = by0 - gap - 1 - ink.y1;
+            region = region.Union({ v.nameX + ink.x0, v.nameY + ink.y0, v.nameX + ink.x1, v.nameY + ink.y1 });
+        }
+
+        int infoId = drawInfo ? batch.info[i] : -1;
+        if (infoId >= 0 && infoId < labelCount)
+        {
+            ResolveLabel(infos, batch, infoId, style.infoSize);
+            const Text::TextBounds &ink = infos[infoId].ink;
+            if (ink.x0 <= ink.x1)
+            {
+                v.infoX = cx - (ink.x0 + ink.x1 + 1) / 2;
+                v.infoY = by1 + gap + 1 - ink.y0;
+                v.barY = v.infoY + ink.y1;
+                region = region.Union({ v.infoX + ink.x0, v.infoY + ink.y0, v.infoX + ink.x1, v.infoY + ink.y1 });
+            }
+        }
+
+        v.barY += gap + 1;
+        if (drawHealth && batch.health[i] >= 0.0f)
+        {
+            region = region.Union({ bx0, v.barY, bx1, v.barY + style.healthHeight - 1 });
+        }
+
+        bool hit = !region.Intersect(clip).IsEmpty();
+        if (drawTracer)
+        {
+            IntRect line = { std::min(style.tracerX, cx), std::min(style.tracerY, by1), std::max(style.tracerX, cx), std::max(style.tracerY, by1) };
+            if (!line.Intersect(clip).IsEmpty())
+            {
+                hit = true;
+                region = region.Union(line);
+            }
+        }
+        if (!hit) continue;
+
+        visible.push_back(v);
+        bounds = bounds.Union(region);
+    }
+
+    // 第二遍：给可见实体用到的标签分配下标（名字在前、信息在后），统计标签文本长度
+    uint32_t slotCount = 0, drawCount = 0, textSize = 0;
+    auto useSlot = [&](LabelSlot &s, int id) {
+        if (s.ink.x0 > s.ink.x1) return;
+        if (s.slot < 0)
+        {
+            s.slot = (int)slotCount++;
+            textSize += (uint32_t)batch.labels[id].size();
+        }
+        drawCount++;
+    };
+    for (const Visible &v : visible)
+    {
+        int nameId = drawName ? batch.name[v.index] : -1;
+        if (nameId >= 0 && nameId < labelCount) useSlot(names[nameId], nameId);
+    }
+    uint32_t nameSlots = slotCount;
+    for (const Visible &v : visible)
+    {
+        int infoId = drawInfo ? batch.info[v.index] : -1;
+        if (infoId >= 0 && infoId < labelCount) useSlot(infos[infoId], infoId);
+    }
+
+    uint32_t count = (uint32_t)visible.size();
+    out.assign(PackedSize(count, drawCount, slotCount, textSize), 0);
+
+    EntityBatchHeader *header = reinterpret_cast<EntityBatchHeader *>(out.data());
+    header->count = count;
+    header->drawCount = drawCount;
+    header->labelCount = slotCount;
+    header->nameSlots = nameSlots;
+    header->textSize = textSize;
+    header->flags = style.flags;
+    header->antiAliasing = anti_aliasing ? 1 : 0;
+    header->tracerX = style.tracerX;
+    header->tracerY = style.tracerY;
+    header->tracerColor = style.tracerColor;
+    header->healthHeight = style.healthHeight;
+    header->healthBackColor = style.healthBackColor;
+    header->nameColor = style.nameColor;
+    header->infoColor = style.infoColor;
+
+    EntityBatchView view = ParseEntityBatch(out.data());
+
+    // 标签表
+    uint32_t textPos = 0;
+    auto emitSlots = [&](const Core::ArenaVector<LabelSlot> &table, int size) {
+        for (size_t id = 0; id < table.size(); id++)
+        {
+            int slot = table[id].slot;
+            if (slot < 0) continue;
+            const std::string &text = batch.labels[id];
+            view.labelSize[slot] = size;
+            view.labelOffset[slot] = textPos;
+            view.labelLength[slot] = (uint32_t)text.size();
+            memcpy(view.text + textPos, text.data(), text.size());
+            textPos += (uint32_t)text.size();
+        }
+    };
+    emitSlots(names, style.nameSize);
+    emitSlots(infos, style.infoSize);
+
+    // 标签绘制按下标计数排序：先统计每个标签的次数，前缀和得到起点
+    Core::ArenaVector<uint32_t> start(slotCount + 1, 0, Core::ArenaAllocator<uint32_t>(arena));
+    for (const Visible &v : visible)
+    {
+        int nameId = drawName ? batch.name[v.index] : -1;
+        int infoId = drawInfo ? batch.info[v.index] : -1;
+        if (nameId >= 0 && nameId < labelCount && names[nameId].slot >= 0) start[names[nameId].slot + 1]++;
+        if (infoId >= 0 && infoId < labelCount && infos[infoId].slot >= 0) start[infos[infoId].slot + 1]++;
+    }
+    for (uint32_t s = 0; s < slotCount; s++) start[s + 1] += start[s];
+
+    auto emitDraw = [&](int slot, int x, int y) {
+        uint32_t d = start[slot]++;
+        view.drawLabel[d] = slot;
+        view.drawPos[d * 2] = x;
+        view.drawPos[d * 2 + 1] = y;
+    };
+
+    // 实体数组
+    for (uint32_t j = 0; j < count; j++)
+    {
+        const Visible &v = visible[j];
+        int i = v.index;
+        const int *r = rects + i * 4;
+        int bx0 = std::min(r[0], r[2]), by0 = std::min(r[1], r[3]);
+        int bx1 = std::max(r[0], r[2]), by1 = std::max(r[1], r[3]);
+
+        view.rects[j * 4] = bx0;
+        view.rects[j * 4 + 1] = by0;
+        view.rects[j * 4 + 2] = bx1;
+        view.rects[j * 4 + 3] = by1;
+        view.colors[j] = batch.color[i];
+
+        float h = batch.health[i];
+        view.barY[j] = v.barY;
+        view.barFill[j] = -1;
+        if (drawHealth && h >= 0.0f)
+        {
+            h = std::min(h, 1.0f);
+            view.barFill[j] = (int)((bx1 - bx0 + 1) * h + 0.5f);
+            view.barColors[j] = lerp_pixel(style.healthLowColor, style.healthHighColor, (uint32_t)(h * 255.0f + 0.5f));
+        }
+
+        int nameId = drawName ? batch.name[i] : -1;
+        int infoId = drawInfo ? batch.info[i] : -1;
+        if (nameId >= 0 && nameId < labelCount && names[nameId].slot >= 0) emitDraw(names[nameId].slot, v.nameX, v.nameY);
+        if (infoId >= 0 && infoId < labelCount && infos[infoId].slot >= 0) emitDraw(infos[infoId].slot, v.infoX, v.infoY);
+    }
+
+    return bounds;
+}
+
+void draw_entity_batch(uint32_t *pixels, int stride, int width, int height, const uint8_t *data, const IntRect *clip)
+{
+    EntityBatchView v = ParseEntityBatch(data);
+    const EntityBatchHeader &h = *v.header;
+    const int n = (int)h.count;
+
+    IntRect cr = { 0, 0, width - 1, height - 1 };
+    if (clip) cr = cr.Intersect(*clip);
+    if (cr.IsEmpty()) return;
+
+    // 射线（最底层）
+    if (h.flags & ENTITY_TRACER)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            const int32_t *r = v.rects + i * 4;
+            int ex = (r[0] + r[2]) / 2;
+            int ey = r[3];
+            if (std::max(h.tracerX, ex) < cr.x0 || std::min(h.tracerX, ex) > cr.x1 || std::max(h.tracerY, ey) < cr.y0 || std::min(h.tracerY, ey) > cr.y1) continue;
+
+            if (h.antiAliasing)
+            {
+                draw_line_aa(pixels, stride, width, height, (float)h.tracerX, (float)h.tracerY, (float)ex, (float)ey, h.tracerColor, 1.0f, &cr);
+            }
+            else
+            {
+                draw_line(pixels, stride, width, height, h.tracerX, h.tracerY, ex, ey, h.tracerColor, &cr);
+            }
+        }
+    }
+
+    // 方框
+    if (h.flags & ENTITY_BOX)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            const int32_t *r = v.rects + i * 4;
+            if (r[2] < cr.x0 || r[0] > cr.x1 || r[3] < cr.y0 || r[1] > cr.y1) continue;
+            draw_rect(pixels, stride, width, height, r[0], r[1], r[2], r[3], v.colors[i], &cr);
+        }
+    }
+
+    // 血条：背景 + 当前血量
+    if (h.flags & ENTITY_HEALTH)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            if (v.barFill[i] < 0) continue;
+
+            const int32_t *r = v.rects + i * 4;
+            int y0 = v.barY[i];
+            int y1 = y0 + h.healthHeight - 1;
+            if (r[2] < cr.x0 || r[0] > cr.x1 || y1 < cr.y0 || y0 > cr.y1) continue;
+
+            draw_rect_filled(pixels, stride, width, height, r[0], y0, r[2], y1, h.healthBackColor, &cr);
+            if (v.barFill[i] > 0) draw_rect_filled(pixels, stride, width, height, r[0], y0, r[0] + v.barFill[i] - 1, y1, v.barColors[i], &cr);
+        }
+    }
+
+    // 标签：同一标签的绘制连续排列，每段只查一次排版
+    if (h.drawCount == 0 || !Text::InitFont()) return;
+
+    uint32_t d = 0;
+    std::string text;
+    while (d < h.drawCount)
+    {
+        int slot = v.drawLabel[d];
+        uint32_t end = d;
+        while (end < h.drawCount && v.drawLabel[end] == slot) end++;
+
+        text.assign(v.text + v.labelOffset[slot], v.labelLength[slot]);
+        const Text::TextLayout &layout = Text::TextLayoutCache::Instance().Get(text, v.labelSize[slot]);
+        const Text::TextBounds &ink = layout.ink;
+        uint32_t color = (uint32_t)slot < h.nameSlots ? h.nameColor : h.infoColor; // 名字的下标在前
+
+        for (; d < end; d++)
+        {
+            int x = v.drawPos[d * 2];
+            int y = v.drawPos[d * 2 + 1];
+            if (x + ink.x1 < cr.x0 || x + ink.x0 > cr.x1 || y + ink.y1 < cr.y0 || y + ink.y0 > cr.y1) continue;
+            Text::RenderTextLayout(pixels, stride, width, height, x, y, layout, color, &cr);
+        }
+    }
+}
+
+bool validate_entity_batch(const uint8_t *data, uint32_t size)
+{
+    if (size < sizeof(EntityBatchHeader) || ((uintptr_t)data & 3) != 0) return false;
+
+    // 先用 64 位算总长，计数字段过大时不会回绕
+    const EntityBatchHeader &h = *reinterpret_cast<const EntityBatchHeader *>(data);
+    uint64_t total = sizeof(EntityBatchHeader) + (uint64_t)h.count * 8 * sizeof(int32_t) + (uint64_t)h.drawCount * 3 * sizeof(int32_t) + (uint64_t)h.labelCount * 3 * sizeof(int32_t) + (((uint64_t)h.textSize + 3) & ~3ull);
+    if (total > size || h.nameSlots > h.labelCount) return false;
+
+    // 坐标与尺寸同 CommandBuffer::Validate 的上限
+    auto inRange = [](int32_t value) { return value >= -EXTERNAL_COORD_LIMIT && value <= EXTERNAL_COORD_LIMIT; };
+    if (!inRange(h.tracerX) || !inRange(h.tracerY) || h.healthHeight < 0 || h.healthHeight > EXTERNAL_SIZE_LIMIT) return false;
+
+    EntityBatchView v = ParseEntityBatch(data);
+    for (uint32_t i = 0; i < h.count; i++)
+    {
+        const int32_t *r = v.rects + i * 4;
+        if (!inRange(r[0]) || !inRange(r[1]) || !inRange(r[2]) || !inRange(r[3]) || !inRange(v.barY[i]) || !inRange(v.barFill[i])) return false;
+    }
+    for (uint32_t d = 0; d < h.drawCount; d++)
+    {
+        if (v.drawLabel[d] < 0 || (uint32_t)v.drawLabel[d] >= h.labelCount) return false;
+        if (!inRange(v.drawPos[d * 2]) || !inRange(v.drawPos[d * 2 + 1])) return false;
+    }
+    for (uint32_t s = 0; s < h.labelCount; s++)
+    {
+        if (v.labelOffset[s] > h.textSize || v.labelLength[s] > h.textSize - v.labelOffset[s]) return false;
+        if (v.labelSize[s] <= 0 || v.labelSize[s] > EXTERNAL_FONT_SIZE_LIMIT) return false;
+    }
+    return true;
+}
+
+void prewarm_entity_batch(const uint8_t *data)
+{
+    EntityBatchView v = ParseEntityBatch(data);
+    std::string text;
+    for (uint32_t s = 0; s < v.header->labelCount; s++)
+    {
+        text.assign(v.text + v.labelOffset[s], v.labelLength[s]);
+        Text::TextLayoutCache::Instance().Get(text, v.labelSize[s]);
+    }
+}
+
+} // namespace Graphics
@@ -0,0 +1,322 @@
+/*
+ * CPU-Draw - Gradient Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 渐变色带烘焙、缓存与查表填充
+ * 线性：下标 = t * 255，16.16 定点数，每像素加一次步长
+ * 径向：t² = d² / r²，d² 逐像素二阶差分递推，t² 经开方表换成色带下标
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "graphics/Gradient.h"
+#include "graphics/SpanKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Graphics
+{
+
+// 径向开方表的精度（t² 分成的份数）
+static const int RADIAL_STEPS = 4096;
+
+static inline IntRect clip_bounds(int width, int height, const IntRect *clip)
+{
+    IntRect r = { 0, 0, width - 1, height - 1 };
+    return clip ? r.Intersect(*clip) : r;
+}
+
+Gradient::Gradient(uint32_t color_start, uint32_t color_end)
+{
+    AddStop(0.0f, color_start);
+    AddStop(1.0f, color_end);
+}
+
+Gradient &Gradient::AddStop(float offset, uint32_t color)
+{
+    offset = std::min(1.0f, std::max(0.0f, offset));
+    auto it = std::upper_bound(stops.begin(), stops.end(), offset, [](float o, const GradientStop &s) { return o < s.offset; });
+    stops.insert(it, GradientStop{ offset, color });
+    return *this;
+}
+
+static uint64_t stops_key(const GradientStop *stops, int count)
+{
+    // FNV-1a
+    uint64_t h = 1469598103934665603ULL;
+    for (int i = 0; i < count; i++)
+    {
+        uint32_t o;
+        memcpy(&o, &stops[i].offset, sizeof(o));
+        uint64_t p = ((uint64_t)o << 32) | stops[i].color;
+        h = (h ^ p) * 1099511628211ULL;
+        h ^= h >> 29;
+    }
+    return h;
+}
+
+static bool stops_equal(const std::vector<GradientStop> &a, const GradientStop *b, int count)
+{
+    if ((int)a.size() != count) return false;
+    for (int i = 0; i < count; i++)
+    {
+        if (a[i].offset != b[i].offset || a[i].color != b[i].color) return false;
+    }
+    return true;
+}
+
+void bake_gradient_ramp(GradientRamp &ramp, const GradientStop *stops, int count)
+{
+    uint64_t key = stops_key(stops, count);
+    ramp.key[0] = (uint32_t)key;
+    ramp.key[1] = (uint32_t)(key >> 32);
+
+    if (count <= 0)
+    {
+        std::fill(ramp.colors, ramp.colors + GRADIENT_RAMP_SIZE, 0u);
+        ramp.opaque = 0;
+        return;
+    }
+
+    // 在缓冲区像素格式下插值（与原先逐像素插值一致）
+    uint32_t alphaAnd = 0xFF;
+    int k = 0;
+    for (int i = 0; i < GRADIENT_RAMP_SIZE; i++)
+    {
+        float t = i / (float)(GRADIENT_RAMP_SIZE - 1);
+        while (k + 1 < count && stops[k + 1].offset <= t) k++;
+
+        uint32_t color;
+        if (k + 1 >= count || t <= stops[k].offset)
+        {
+            color = to_pixel(stops[k].color);
+        }
+        else
+        {
+            uint32_t c0 = to_pixel(stops[k].color);
+            uint32_t c1 = to_pixel(stops[k + 1].color);
+            float f = (t - stops[k].offset) / (stops[k + 1].offset - stops[k].offset);
+            color = 0;
+            for (int shift = 0; shift < 32; shift += 8)
+            {
+                int v0 = (c0 >> shift) & 0xFF;
+                int v1 = (c1 >> shift) & 0xFF;
+                color |= (uint32_t)(int)(v0 + f * (v1 - v0) + 0.5f) << shift;
+            }
+        }
+        ramp.colors[i] = color;
+        alphaAnd &= color >> 24;
+    }
+    ramp.opaque = alphaAnd == 0xFF;
+}
+
+const GradientRamp &GradientCache::Get(const Gradient &gradient)
+{
+    const std::vector<GradientStop> &stops = gradient.GetStops();
+    return Get(stops.data(), (int)stops.size());
+}
+
+const GradientRamp &GradientCache::Get(uint32_t color_start, uint32_t color_end)
+{
+    GradientStop stops[2] = { { 0.0f, color_start }, { 1.0f, color_end } };
+    return Get(stops, 2);
+}
+
+const GradientRamp &GradientCache::Get(const GradientStop *stops, int count)
+{
+    uint64_t key = stops_key(stops, count);
+
+    auto it = current.find(key);
+    if (it != current.end())
+    {
+        Entry &entry = it->second;
+        if (!stops_equal(entry.stops, stops, count))
+        {
+            // 哈希冲突：覆盖旧条目
+            entry.stops.assign(stops, stops + count);
+            bake_gradient_ramp(entry.ramp, stops, count);
+        }
+        return entry.ramp;
+    }
+
+    // 上一代命中的条目提回当前代，否则新建
+    Entry entry;
+    auto old = previous.find(key);
+    if (old != previous.end() && stops_equal(old->second.stops, stops, count))
+    {
+        entry = std::move(old->second);
+        previous.erase(old);
+    }
+    else
+    {
+        entry.stops.assign(stops, stops + count);
+        bake_gradient_ramp(entry.ramp, stops, count);
+    }
+
+    if (current.size() >= GENERATION_CAPACITY)
+    {
+        previous = std::move(current);
+        current.clear();
+    }
+
+    return current.emplace(key, std::move(entry)).first->second.ramp;
+}
+
+void GradientCache::Clear()
+{
+    current.clear();
+    previous.clear();
+}
+
+// 整行同色
+static void fill_row_solid(uint32_t *dst, int count, uint32_t color)
+{
+    uint32_t a = color >> 24;
+    if (a == 0) return;
+    if (a == 255)
+    {
+        span_fill(dst, count, color);
+        return;
+    }
+
+    uint32_t row[256];
+    std::fill(row, row + std::min(256, count), color);
+    for (int x = 0; x < count; x += 256)
+    {
+        span_blend_colors(dst + x, row, std::min(256, count - x));
+    }
+}
+
+void fill_gradient_linear(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, float from_x, float from_y, float to_x, float to_y, const GradientRamp &ramp, const IntRect *clip)
+{
+    if (x0 > x1) std::swap(x0, x1);
+    if (y0 > y1) std::swap(y0, y1);
+
+    IntRect cr = clip_bounds(width, height, clip).Intersect(IntRect{ x0, y0, x1, y1 });
+    if (cr.IsEmpty()) return;
+
+    const int last = GRADIENT_RAMP_SIZE - 1;
+    double dx = to_x - from_x, dy = to_y - from_y;
+    double len2 = dx * dx + dy * dy;
+    if (len2 < 1e-12)
+    {
+        for (int y = cr.y0; y <= cr.y1; y++)
+        {
+            fill_row_solid(pixels + (size_t)y * stride + cr.x0, cr.Width(), ramp.colors[last]);
+        }
+        return;
+    }
+
+    // 下标（16.16，加 0.5 四舍五入）= ((p - from) · axis) / |axis|² * 255
+    double scale = last * 65536.0 / len2;
+    int64_t step = (int64_t)std::llround(dx * scale);
+    int n = cr.Width();
+    uint32_t row[256];
+
+    for (int y = cr.y0; y <= cr.y1; y++)
+    {
+        uint32_t *dst = pixels + (size_t)y * stride + cr.x0;
+        // 从矩形左边界（不是裁剪后的）按步长推进，分块回放与整屏结果一致
+        double t = ((x0 + 0.5 - from_x) * dx + (y + 0.5 - from_y) * dy) * scale + 32768.0;
+        int64_t pos = (int64_t)std::floor(t) + (int64_t)(cr.x0 - x0) * step;
+
+        // 竖直方向：整行同色
+        if (step == 0)
+        {
+            int index = pos < 0 ? 0 : (int)std::min<int64_t>(last, pos >> 16);
+            fill_row_solid(dst, n, ramp.colors[index]);
+            continue;
+        }
+
+        // 水平方向的不透明渐变每行相同，复制第一行
+        if (dy == 0 && ramp.opaque && y > cr.y0)
+        {
+            memcpy(dst, pixels + (size_t)cr.y0 * stride + cr.x0, n * sizeof(uint32_t));
+            continue;
+        }
+
+        for (int x = 0; x < n; x += 256)
+        {
+            int count = std::min(256, n - x);
+            uint32_t *out = ramp.opaque ? dst + x : row;
+            for (int i = 0; i < count; i++)
+            {
+                int index = pos < 0 ? 0 : (int)std::min<int64_t>(last, pos >> 16);
+                out[i] = ramp.colors[index];
+                pos += step;
+            }
+            if (!ramp.opaque) span_blend_colors(dst + x, row, count);
+        }
+    }
+}
+
+// t² 的份数 -> 色带下标，取每份中点
+static const uint8_t *radial_index_table()
+{
+    static const struct Table
+    {
+        uint8_t index[RADIAL_STEPS + 1];
+        Table()
+        {
+            for (int i = 0; i < RADIAL_STEPS; i++)
+            {
+                index[i] = (uint8_t)std::min(255, (int)(std::sqrt((i + 0.5) / RADIAL_STEPS) * (GRADIENT_RAMP_SIZE - 1) + 0.5));
+            }
+            index[RADIAL_STEPS] = GRADIENT_RAMP_SIZE - 1;
+        }
+    } table;
+    return table.index;
+}
+
+void fill_gradient_radial(uint32_t *pixels, int stride, int width, int height, int cx, int cy, int radius, const GradientRamp &ramp, const IntRect *clip)
+{
+    if (radius <= 0) return;
+
+    IntRect cr = clip_bounds(width, height, clip).Intersect(IntRect{ cx - radius, cy - radius, cx + radius, cy + radius });
+    if (cr.IsEmpty()) return;
+
+    const uint8_t *table = radial_index_table();
+    int rr = radius * radius;
+
+    // t² 的份数（32.32）= d² * inv，圆内 d² <= r² 保证不超过 RADIAL_STEPS
+    const int64_t inv = (int64_t)(((uint64_t)RADIAL_STEPS << 32) / (uint64_t)rr);
+    uint32_t row[256];
+
+    for (int y = cr.y0; y <= cr.y1; y++)
+    {
+        int dy = y - cy;
+
+        // 本行在圆内的横向范围
+        int half = (int)std::sqrt((float)(rr - dy * dy));
+        while ((half + 1) * (half + 1) + dy * dy <= rr) half++;
+        while (half > 0 && half * half + dy * dy > rr) half--;
+
+        int xs = std::max(cr.x0, cx - half);
+        int xe = std::min(cr.x1, cx + half);
+        if (xs > xe) continue;
+
+        // d²(x + 1) - d²(x) = 2dx + 1
+        int dx = xs - cx;
+        int64_t q = (int64_t)(dx * dx + dy * dy) * inv;
+        int64_t dq = (int64_t)(2 * dx + 1) * inv;
+        const int64_t ddq = 2 * inv;
+
+        uint32_t *dst = pixels + (size_t)y * stride;
+        for (int x = xs; x <= xe; x += 256)
+        {
+            int count = std::min(256, xe - x + 1);
+            uint32_t *out = ramp.opaque ? dst + x : row;
+            for (int i = 0; i < count; i++)
+            {
+                out[i] = ramp.colors[table[q >> 32]];
+                q += dq;
+                dq += ddq;
+            }
+            if (!ramp.opaque) span_blend_colors(dst + x, row, count);
+        }
+    }
+}
+
+} // namespace Graphics
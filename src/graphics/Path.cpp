@@ -0,0 +1,183 @@
+/*
+ * CPU-Draw - Path Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 矢量路径展开
+ * Wang 公式：n 段均匀参数展开的误差不超过 d(d-1)/8 · max|P[i] - 2P[i+1] + P[i+2]| / n²
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "graphics/Path.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Graphics
+{
+
+static int segments_for(float k, float dd)
+{
+    // k = d(d-1)/8，dd 为控制点二阶差分的最大长度
+    float n = std::sqrt(k * dd / BEZIER_TOLERANCE);
+    return std::max(1, std::min(BEZIER_MAX_SEGMENTS, (int)std::ceil(n)));
+}
+
+int bezier_segments_quadratic(float x0, float y0, float x1, float y1, float x2, float y2)
+{
+    float dx = x0 - 2.0f * x1 + x2, dy = y0 - 2.0f * y1 + y2;
+    return segments_for(0.25f, std::sqrt(dx * dx + dy * dy));
+}
+
+int bezier_segments_cubic(float x0, float y0, float x1, float y1, float x2, float y2, float x3, float y3)
+{
+    float ax = x0 - 2.0f * x1 + x2, ay = y0 - 2.0f * y1 + y2;
+    float bx = x1 - 2.0f * x2 + x3, by = y1 - 2.0f * y2 + y3;
+    float dd = std::sqrt(std::max(ax * ax + ay * ay, bx * bx + by * by));
+    return segments_for(0.75f, dd);
+}
+
+void Path::Clear()
+{
+    verbs.clear();
+    coords.clear();
+}
+
+void Path::MoveTo(float x, float y)
+{
+    verbs.push_back(VerbMove);
+    coords.insert(coords.end(), { x, y });
+}
+
+void Path::LineTo(float x, float y)
+{
+    verbs.push_back(VerbLine);
+    coords.insert(coords.end(), { x, y });
+}
+
+void Path::QuadTo(float cx, float cy, float x, float y)
+{
+    verbs.push_back(VerbQuad);
+    coords.insert(coords.end(), { cx, cy, x, y });
+}
+
+void Path::CubicTo(float c0x, float c0y, float c1x, float c1y, float x, float y)
+{
+    verbs.push_back(VerbCubic);
+    coords.insert(coords.end(), { c0x, c0y, c1x, c1y, x, y });
+}
+
+void Path::Close()
+{
+    verbs.push_back(VerbClose);
+}
+
+void Path::Flatten(const Affine &matrix, float offset_x, float offset_y, Core::ArenaVector<float> &points, Core::ArenaVector<int> &contours) const
+{
+    points.clear();
+    contours.clear();
+
+    size_t contourStart = 0;
+    float px = 0.0f, py = 0.0f; // 当前点（设备坐标）
+    float sx = 0.0f, sy = 0.0f; // 轮廓起点
+    bool open = false;
+
+    auto map = [&](size_t i, float &x, float &y) {
+        x = coords[i];
+        y = coords[i + 1];
+        matrix.Apply(x, y);
+        x += offset_x;
+        y += offset_y;
+    };
+    auto endContour = [&]() {
+        int count = (int)((points.size() - contourStart) / 2);
+        if (count >= 3)
+        {
+            contours.push_back(count);
+        }
+        else
+        {
+            points.resize(contourStart);
+        }
+        contourStart = points.size();
+        open = false;
+    };
+    auto lineTo = [&](float x, float y) {
+        if (!open)
+        {
+            // 没有 MoveTo 时从上一个点开始
+            points.insert(points.end(), { px, py });
+            sx = px, sy = py;
+            open = true;
+        }
+        points.insert(points.end(), { x, y });
+        px = x, py = y;
+    };
+
+    size_t c = 0;
+    for (uint8_t verb : verbs)
+    {
+        switch (verb)
+        {
+        case VerbMove:
+        {
+            if (open) endContour();
+            map(c, px, py);
+            c += 2;
+            sx = px, sy = py;
+            points.insert(points.end(), { px, py });
+            open = true;
+            break;
+        }
+        case VerbLine:
+        {
+            float x, y;
+            map(c, x, y);
+            c += 2;
+            lineTo(x, y);
+            break;
+        }
+        case VerbQuad:
+        {
+            float x0 = px, y0 = py, x1, y1, x2, y2;
+            map(c, x1, y1);
+            map(c + 2, x2, y2);
+            c += 4;
+
+            int n = bezier_segments_quadratic(x0, y0, x1, y1, x2, y2);
+            for (int i = 1; i <= n; i++)
+            {
+                float t = i / (float)n, u = 1.0f - t;
+                lineTo(u * u * x0 + 2.0f * u * t * x1 + t * t * x2, u * u * y0 + 2.0f * u * t * y1 + t * t * y2);
+            }
+            break;
+        }
+        case VerbCubic:
+        {
+            float x0 = px, y0 = py, x1, y1, x2, y2, x3, y3;
+            map(c, x1, y1);
+            map(c + 2, x2, y2);
+            map(c + 4, x3, y3);
+            c += 6;
+
+            int n = bezier_segments_cubic(x0, y0, x1, y1, x2, y2, x3, y3);
+            for (int i = 1; i <= n; i++)
+            {
+                float t = i / (float)n, u = 1.0f - t;
+                float a = u * u * u, b = 3.0f * u * u * t, d = 3.0f * u * t * t, e = t * t * t;
+                lineTo(a * x0 + b * x1 + d * x2 + e * x3, a * y0 + b * y1 + d * y2 + e * y3);
+            }
+            break;
+        }
+        case VerbClose:
+        {
+            if (open) endContour();
+            px = sx, py = sy;
+            break;
+        }
+        }
+    }
+    if (open) endContour();
+}
+
+} // namespace Graphics
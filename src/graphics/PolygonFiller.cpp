@@ -0,0 +1,214 @@
+/*
+ * CPU-Draw - Polygon Filler Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 扫描线多边形填充
+ * 添加边时按裁剪区截取行范围，填充时计数排序分桶，
+ * 活动边表逐行插入排序（相邻两行交点次序几乎不变，接近线性）
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "graphics/PolygonFiller.h"
+#include "graphics/SpanKernels.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Graphics
+{
+
+PolygonFiller::PolygonFiller() : clip(IntRect::Empty()), minRow(0), maxRow(-1), startX(0), startY(0), lastX(0), lastY(0), hasPath(false)
+{
+}
+
+void PolygonFiller::Reset(const IntRect &rect)
+{
+    clip = rect;
+    edges.clear();
+    minRow = clip.y1 + 1;
+    maxRow = clip.y0 - 1;
+    hasPath = false;
+}
+
+void PolygonFiller::MoveTo(float x, float y)
+{
+    Close();
+    startX = lastX = x;
+    startY = lastY = y;
+    hasPath = true;
+}
+
+void PolygonFiller::LineTo(float x, float y)
+{
+    if (!hasPath)
+    {
+        MoveTo(x, y);
+        return;
+    }
+    AddEdge(lastX, lastY, x, y);
+    lastX = x;
+    lastY = y;
+}
+
+void PolygonFiller::Close()
+{
+    if (!hasPath) return;
+    AddEdge(lastX, lastY, startX, startY);
+    lastX = startX;
+    lastY = startY;
+    hasPath = false;
+}
+
+void PolygonFiller::AddPolygon(const float *points, int point_count)
+{
+    if (point_count < 3) return;
+
+    MoveTo(points[0], points[1]);
+    for (int i = 1; i < point_count; i++)
+    {
+        LineTo(points[i * 2], points[i * 2 + 1]);
+    }
+    Close();
+}
+
+void PolygonFiller::AddPolygon(const int *points, int point_count)
+{
+    if (point_count < 3) return;
+
+    MoveTo((float)points[0], (float)points[1]);
+    for (int i = 1; i < point_count; i++)
+    {
+        LineTo((float)points[i * 2], (float)points[i * 2 + 1]);
+    }
+    Close();
+}
+
+void PolygonFiller::AddEdge(float x0, float y0, float x1, float y1)
+{
+    int winding = 1;
+    if (y0 > y1)
+    {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+        winding = -1;
+    }
+
+    // 覆盖的扫描线：y0 <= row + 0.5 < y1（水平边为空）
+    int row0 = (int)std::ceil(y0 - 0.5f);
+    int row1 = (int)std::ceil(y1 - 0.5f) - 1;
+    row0 = std::max(row0, clip.y0);
+    row1 = std::min(row1, clip.y1);
+    if (row0 > row1) return;
+
+    // 整条边在裁剪区右侧，不影响区内任何像素的绕数
+    if (std::min(x0, x1) >= clip.x1 + 1) return;
+
+    Edge e;
+    e.x0 = x0;
+    e.y0 = y0;
+    e.dxdy = (x1 - x0) / (y1 - y0);
+    e.row0 = row0;
+    e.row1 = row1;
+    e.winding = winding;
+    e.x = x0;
+    edges.push_back(e);
+
+    minRow = std::min(minRow, row0);
+    maxRow = std::max(maxRow, row1);
+}
+
+// 像素中心在 [a, b) 内的像素
+static inline void fill_span(uint32_t *row, const IntRect &cr, float a, float b, uint32_t color)
+{
+    int x0 = std::max(cr.x0, (int)std::ceil(a - 0.5f));
+    int x1 = std::min(cr.x1, (int)std::ceil(b - 0.5f) - 1);
+    if (x0 <= x1) span_blend(row + x0, x1 - x0 + 1, color);
+}
+
+void PolygonFiller::Fill(uint32_t *pixels, int stride, uint32_t color, FillRule rule)
+{
+    Close();
+    if (edges.empty() || (color >> 24) == 0) return;
+
+    // 按起始行计数排序
+    int rows = maxRow - minRow + 1;
+    rowStart.assign(rows + 1, 0);
+    for (const Edge &e : edges)
+    {
+        rowStart[e.row0 - minRow + 1]++;
+    }
+    for (int r = 0; r < rows; r++)
+    {
+        rowStart[r + 1] += rowStart[r];
+    }
+    bucket.resize(edges.size());
+    for (size_t i = 0; i < edges.size(); i++)
+    {
+        bucket[rowStart[edges[i].row0 - minRow]++] = (int)i;
+    }
+
+    active.clear();
+    size_t next = 0;
+    const bool evenOdd = rule == FillRule::EvenOdd;
+
+    for (int y = minRow; y <= maxRow; y++)
+    {
+        // 移除已结束的边，加入从本行开始的边
+        size_t keep = 0;
+        for (size_t i = 0; i < active.size(); i++)
+        {
+            if (active[i]->row1 >= y) active[keep++] = active[i];
+        }
+        active.resize(keep);
+        while (next < bucket.size() && edges[bucket[next]].row0 == y)
+        {
+            active.push_back(&edges[bucket[next++]]);
+        }
+        if (active.empty()) continue;
+
+        // 交点按 x 插入排序
+        float sy = y + 0.5f;
+        for (size_t i = 0; i < active.size(); i++)
+        {
+            Edge *e = active[i];
+            e->x = e->x0 + (sy - e->y0) * e->dxdy;
+
+            size_t j = i;
+            while (j > 0 && active[j - 1]->x > e->x)
+            {
+                active[j] = active[j - 1];
+                j--;
+            }
+            active[j] = e;
+        }
+
+        // 从左到右累计绕数，进入 / 离开内部时输出区间
+        uint32_t *row = pixels + (size_t)y * stride;
+        int winding = 0;
+        float spanStart = 0.0f;
+        for (const Edge *e : active)
+        {
+            bool wasInside = evenOdd ? (winding & 1) != 0 : winding != 0;
+            winding += evenOdd ? 1 : e->winding;
+            bool inside = evenOdd ? (winding & 1) != 0 : winding != 0;
+
+            if (!wasInside && inside)
+            {
+                spanStart = e->x;
+            }
+            else if (wasInside && !inside)
+            {
+                fill_span(row, clip, spanStart, e->x, color);
+            }
+        }
+
+        // 离开内部的边在裁剪区右侧（已丢弃），区间延伸到右边界
+        if (evenOdd ? (winding & 1) != 0 : winding != 0)
+        {
+            fill_span(row, clip, spanStart, clip.x1 + 1.0f, color);
+        }
+    }
+}
+
+} // namespace Graphics
@@ -15,6 +15,10 @@
  */
 
 #include "graphics/Primitives.h"
+#include "graphics/Gradient.h"
+#include "graphics/Path.h"
+#include "graphics/PolygonFiller.h"
+#include "graphics/SpanKernels.h"
 #include <algorithm>
 #include <cmath>
 #include <cstring>
@@ -22,68 +26,116 @@
 namespace Graphics
 {
 
-// Alpha混合
-static inline uint32_t blend_alpha(uint32_t fg, uint32_t bg)
+// 有效裁剪区：缓冲区与 clip 的交集
+static inline IntRect clip_bounds(int width, int height, const IntRect *clip)
 {
-    uint8_t r = fg & 0xFF;
-    uint8_t g = (fg >> 8) & 0xFF;
-    uint8_t b = (fg >> 16) & 0xFF;
-    uint8_t a = (fg >> 24) & 0xFF;
+    IntRect r = { 0, 0, width - 1, height - 1 };
+    return clip ? r.Intersect(*clip) : r;
+}
 
-    if (a == 255) return fg;
-    if (a == 0) return bg;
+// 包围盒与裁剪区不相交
+static inline bool clip_reject(const IntRect &cr, int x0, int y0, int x1, int y1)
+{
+    return std::max(x0, x1) < cr.x0 || std::min(x0, x1) > cr.x1 || std::max(y0, y1) < cr.y0 || std::min(y0, y1) > cr.y1;
+}
 
-    uint8_t br = bg & 0xFF;
-    uint8_t bg_ = (bg >> 8) & 0xFF;
-    uint8_t bb = (bg >> 16) & 0xFF;
+static inline bool clip_contains(const IntRect &cr, int x, int y)
+{
+    return x >= cr.x0 && x <= cr.x1 && y >= cr.y0 && y <= cr.y1;
+}
 
-    uint8_t nr = (r * a + br * (255 - a)) / 255;
-    uint8_t ng = (g * a + bg_ * (255 - a)) / 255;
-    uint8_t nb = (b * a + bb * (255 - a)) / 255;
+// 单像素写入，调用方保证在裁剪区内
+static inline void plot(uint32_t *pixels, int stride, int x, int y, uint32_t color)
+{
+    uint32_t *dst = pixels + y * stride + x;
+    *dst = blend_color(*dst, color);
+}
 
-    return nr | (ng << 8) | (nb << 16) | (255 << 24);
+static inline void plot_clipped(uint32_t *pixels, int stride, const IntRect &cr, int x, int y, uint32_t color)
+{
+    if (clip_contains(cr, x, y)) plot(pixels, stride, x, y, color);
 }
 
-void put_pixel(uint32_t *pixels, int stride, int width, int height, int x, int y, uint32_t color)
+// 水平扫描线，裁剪后按 alpha 选择内核
+static inline void draw_hline(uint32_t *pixels, int stride, const IntRect &cr, int x0, int x1, int y, uint32_t color)
 {
-    if (x < 0 || x >= width || y < 0 || y >= height) return;
+    if (y < cr.y0 || y > cr.y1) return;
+    if (x0 > x1) std::swap(x0, x1);
 
-    uint32_t *dst = pixels + y * stride + x;
-    uint8_t a = (color >> 24) & 0xFF;
+    x0 = std::max(cr.x0, x0);
+    x1 = std::min(cr.x1, x1);
+    if (x0 > x1) return;
 
-    if (a == 255)
-    {
-        *dst = color;
-    }
-    else if (a > 0)
+    span_blend(pixels + y * stride + x0, x1 - x0 + 1, color);
+}
+
+// 竖直线
+static inline void draw_vline(uint32_t *pixels, int stride, const IntRect &cr, int x, int y0, int y1, uint32_t color)
+{
+    if (x < cr.x0 || x > cr.x1) return;
+    if (y0 > y1) std::swap(y0, y1);
+
+    y0 = std::max(cr.y0, y0);
+    y1 = std::min(cr.y1, y1);
+
+    for (int y = y0; y <= y1; y++)
     {
-        *dst = blend_alpha(color, *dst);
+        plot(pixels, stride, x, y, color);
     }
 }
 
-void put_pixel_fast(uint32_t *pixels, int stride, int width, int height, int x, int y, uint32_t color)
+void put_pixel(uint32_t *pixels, int stride, int width, int height, int x, int y, uint32_t color, const IntRect *clip)
+{
+    plot_clipped(pixels, stride, clip_bounds(width, height, clip), x, y, color);
+}
+
+void put_pixel_fast(uint32_t *pixels, int stride, int width, int height, int x, int y, uint32_t color, const IntRect *clip)
 {
-    if (x < 0 || x >= width || y < 0 || y >= height) return;
-    pixels[y * stride + x] = color;
+    if (!clip_contains(clip_bounds(width, height, clip), x, y)) return;
+    pixels[y * stride + x] = to_pixel(color);
 }
 
-void put_pixelF(uint32_t *pixels, int stride, int width, int height, float x, float y, uint32_t color)
+void put_pixelF(uint32_t *pixels, int stride, int width, int height, float x, float y, uint32_t color, const IntRect *clip)
 {
-    put_pixel(pixels, stride, width, height, (int)(x + 0.5f), (int)(y + 0.5f), color);
+    put_pixel(pixels, stride, width, height, (int)std::floor(x + 0.5f), (int)std::floor(y + 0.5f), color, clip);
 }
 
-void draw_line(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color)
+void draw_line(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color, const IntRect *clip)
 {
+    IntRect cr = clip_bounds(width, height, clip);
+    if (clip_reject(cr, x0, y0, x1, y1)) return;
+
+    if (y0 == y1)
+    {
+        draw_hline(pixels, stride, cr, x0, x1, y0, color);
+        return;
+    }
+    if (x0 == x1)
+    {
+        draw_vline(pixels, stride, cr, x0, y0, y1, color);
+        return;
+    }
+
     // Bresenham's line algorithm
     int dx = abs(x1 - x0);
     int dy = -abs(y1 - y0);
     int sx = (x0 < x1) ? 1 : -1;
     int sy = (y0 < y1) ? 1 : -1;
     int err = dx + dy;
+    bool entered = false;
 
     while (true)
     {
-        put_pixel(pixels, stride, width, height, x0, y0, color);
+        // 直线单调，离开裁剪区后不会再进入
+        if (clip_contains(cr, x0, y0))
+        {
+            plot(pixels, stride, x0, y0, color);
+            entered = true;
+        }
+        else if (entered)
+        {
+            break;
+        }
         if (x0 == x1 && y0 == y1) break;
 
         int e2 = 2 * err;
@@ -100,15 +152,18 @@ void draw_line(uint32_t *pixels, int stride, int width, int height, int x0, int
     }
 }
 
-void draw_lineF(uint32_t *pixels, int stride, int width, int height, float x0, float y0, float x1, float y1, uint32_t color)
+void draw_lineF(uint32_t *pixels, int stride, int width, int height, float x0, float y0, float x1, float y1, uint32_t color, const IntRect *clip)
 {
+    IntRect cr = clip_bounds(width, height, clip);
+    if (clip_reject(cr, (int)std::floor(std::min(x0, x1)), (int)std::floor(std::min(y0, y1)), (int)std::ceil(std::max(x0, x1)), (int)std::ceil(std::max(y0, y1)))) return;
+
     float dx = x1 - x0;
     float dy = y1 - y0;
     int steps = std::max(std::abs(dx), std::abs(dy));
 
     if (steps == 0)
     {
-        put_pixelF(pixels, stride, width, height, x0, y0, color);
+        put_pixelF(pixels, stride, width, height, x0, y0, color, &cr);
         return;
     }
 
@@ -116,26 +171,42 @@ void draw_lineF(uint32_t *pixels, int stride, int width, int height, float x0, f
     float sy = dy / steps;
     float x = x0;
     float y = y0;
+    bool entered = false;
 
     for (int i = 0; i <= steps; i++)
     {
-        put_pixelF(pixels, stride, width, height, x, y, color);
+        int px = (int)std::floor(x + 0.5f);
+        int py = (int)std::floor(y + 0.5f);
+        if (clip_contains(cr, px, py))
+        {
+            plot(pixels, stride, px, py, color);
+            entered = true;
+        }
+        else if (entered)
+        {
+            break;
+        }
         x += sx;
         y += sy;
     }
 }
 
-void draw_line_thick(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color, int thickness)
+void draw_line_thick(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color, int thickness, const IntRect *clip)
 {
     if (thickness <= 1)
     {
-        draw_line(pixels, stride, width, height, x0, y0, x1, y1, color);
+        draw_line(pixels, stride, width, height, x0, y0, x1, y1, color, clip);
         return;
     }
 
+    IntRect cr = clip_bounds(width, height, clip);
+    int pad = thickness / 2 + 1;
+    if (clip_reject(cr, std::min(x0, x1) - pad, std::min(y0, y1) - pad, std::max(x0, x1) + pad, std::max(y0, y1) + pad)) return;
+
     int dx = x1 - x0;
     int dy = y1 - y0;
-    float len = std::sqrt(dx * dx + dy * dy);
+    // 外部命令的端点差可达 2 * EXTERNAL_COORD_LIMIT，平方按浮点算，避免 int 溢出
+    float len = std::sqrt((float)dx * dx + (float)dy * dy);
     if (len == 0) return;
 
     float nx = -dy / len;
@@ -147,70 +218,79 @@ void draw_line_thick(uint32_t *pixels, int stride, int width, int height, int x0
         int sy0 = y0 + ny * t;
         int sx1 = x1 + nx * t;
         int sy1 = y1 + ny * t;
-        draw_line(pixels, stride, width, height, sx0, sy0, sx1, sy1, color);
+        draw_line(pixels, stride, width, height, sx0, sy0, sx1, sy1, color, &cr);
     }
 }
 
-void draw_rect(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color)
+void draw_rect(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color, const IntRect *clip)
 {
-    draw_line(pixels, stride, width, height, x0, y0, x1, y0, color);
-    draw_line(pixels, stride, width, height, x0, y1, x1, y1, color);
-    draw_line(pixels, stride, width, height, x0, y0, x0, y1, color);
-    draw_line(pixels, stride, width, height, x1, y0, x1, y1, color);
+    IntRect cr = clip_bounds(width, height, clip);
+    if (clip_reject(cr, x0, y0, x1, y1)) return;
+
+    draw_line(pixels, stride, width, height, x0, y0, x1, y0, color, &cr);
+    draw_line(pixels, stride, width, height, x0, y1, x1, y1, color, &cr);
+    draw_line(pixels, stride, width, height, x0, y0, x0, y1, color, &cr);
+    draw_line(pixels, stride, width, height, x1, y0, x1, y1, color, &cr);
 }
 
-void draw_rectF(uint32_t *pixels, int stride, int width, int height, float x0, float y0, float x1, float y1, uint32_t color)
+void draw_rectF(uint32_t *pixels, int stride, int width, int height, float x0, float y0, float x1, float y1, uint32_t color, const IntRect *clip)
 {
-    draw_lineF(pixels, stride, width, height, x0, y0, x1, y0, color);
-    draw_lineF(pixels, stride, width, height, x0, y1, x1, y1, color);
-    draw_lineF(pixels, stride, width, height, x0, y0, x0, y1, color);
-    draw_lineF(pixels, stride, width, height, x1, y0, x1, y1, color);
+    IntRect cr = clip_bounds(width, height, clip);
+
+    draw_lineF(pixels, stride, width, height, x0, y0, x1, y0, color, &cr);
+    draw_lineF(pixels, stride, width, height, x0, y1, x1, y1, color, &cr);
+    draw_lineF(pixels, stride, width, height, x0, y0, x0, y1, color, &cr);
+    draw_lineF(pixels, stride, width, height, x1, y0, x1, y1, color, &cr);
 }
 
-void draw_rect_filled(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color)
+void draw_rect_filled(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color, const IntRect *clip)
 {
     if (x0 > x1) std::swap(x0, x1);
     if (y0 > y1) std::swap(y0, y1);
 
-    x0 = std::max(0, x0);
-    y0 = std::max(0, y0);
-    x1 = std::min(width - 1, x1);
-    y1 = std::min(height - 1, y1);
+    IntRect cr = clip_bounds(width, height, clip);
+    x0 = std::max(cr.x0, x0);
+    y0 = std::max(cr.y0, y0);
+    x1 = std::min(cr.x1, x1);
+    y1 = std::min(cr.y1, y1);
+
+    if (x0 > x1 || (color >> 24) == 0) return;
 
+    int count = x1 - x0 + 1;
     for (int y = y0; y <= y1; y++)
     {
-        for (int x = x0; x <= x1; x++)
-        {
-            put_pixel(pixels, stride, width, height, x, y, color);
-        }
+        span_blend(pixels + y * stride + x0, count, color);
     }
 }
 
-void draw_rect_rounded(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, int radius, uint32_t color)
+void draw_rect_rounded(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, int radius, uint32_t color, const IntRect *clip)
 {
     if (x0 > x1) std::swap(x0, x1);
     if (y0 > y1) std::swap(y0, y1);
 
+    IntRect cr = clip_bounds(width, height, clip);
+    if (clip_reject(cr, x0, y0, x1, y1)) return;
+
     radius = std::min(radius, std::min((x1 - x0) / 2, (y1 - y0) / 2));
 
     // 直线部分
-    draw_line(pixels, stride, width, height, x0 + radius, y0, x1 - radius, y0, color);
-    draw_line(pixels, stride, width, height, x0 + radius, y1, x1 - radius, y1, color);
-    draw_line(pixels, stride, width, height, x0, y0 + radius, x0, y1 - radius, color);
-    draw_line(pixels, stride, width, height, x1, y0 + radius, x1, y1 - radius, color);
+    draw_line(pixels, stride, width, height, x0 + radius, y0, x1 - radius, y0, color, &cr);
+    draw_line(pixels, stride, width, height, x0 + radius, y1, x1 - radius, y1, color, &cr);
+    draw_line(pixels, stride, width, height, x0, y0 + radius, x0, y1 - radius, color, &cr);
+    draw_line(pixels, stride, width, height, x1, y0 + radius, x1, y1 - radius, color, &cr);
 
     // 圆角
     int x = radius, y = 0, err = 0;
     while (x >= y)
     {
-        put_pixel(pixels, stride, width, height, x1 - radius + x, y0 + radius - y, color);
-        put_pixel(pixels, stride, width, height, x1 - radius + y, y0 + radius - x, color);
-        put_pixel(pixels, stride, width, height, x0 + radius - y, y0 + radius - x, color);
-        put_pixel(pixels, stride, width, height, x0 + radius - x, y0 + radius - y, color);
-        put_pixel(pixels, stride, width, height, x0 + radius - x, y1 - radius + y, color);
-        put_pixel(pixels, stride, width, height, x0 + radius - y, y1 - radius + x, color);
-        put_pixel(pixels, stride, width, height, x1 - radius + y, y1 - radius + x, color);
-        put_pixel(pixels, stride, width, height, x1 - radius + x, y1 - radius + y, color);
+        plot_clipped(pixels, stride, cr, x1 - radius + x, y0 + radius - y, color);
+        plot_clipped(pixels, stride, cr, x1 - radius + y, y0 + radius - x, color);
+        plot_clipped(pixels, stride, cr, x0 + radius - y, y0 + radius - x, color);
+        plot_clipped(pixels, stride, cr, x0 + radius - x, y0 + radius - y, color);
+        plot_clipped(pixels, stride, cr, x0 + radius - x, y1 - radius + y, color);
+        plot_clipped(pixels, stride, cr, x0 + radius - y, y1 - radius + x, color);
+        plot_clipped(pixels, stride, cr, x1 - radius + y, y1 - radius + x, color);
+        plot_clipped(pixels, stride, cr, x1 - radius + x, y1 - radius + y, color);
 
         y++;
         if (err <= 0)
@@ -225,26 +305,29 @@ void draw_rect_rounded(uint32_t *pixels, int stride, int width, int height, int
     }
 }
 
-void draw_rect_rounded_filled(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, int radius, uint32_t color)
+void draw_rect_rounded_filled(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, int radius, uint32_t color, const IntRect *clip)
 {
     if (x0 > x1) std::swap(x0, x1);
     if (y0 > y1) std::swap(y0, y1);
 
+    IntRect cr = clip_bounds(width, height, clip);
+    if (clip_reject(cr, x0, y0, x1, y1)) return;
+
     radius = std::min(radius, std::min((x1 - x0) / 2, (y1 - y0) / 2));
 
     // 中间矩形部分
-    draw_rect_filled(pixels, stride, width, height, x0, y0 + radius, x1, y1 - radius, color);
-    draw_rect_filled(pixels, stride, width, height, x0 + radius, y0, x1 - radius, y0 + radius - 1, color);
-    draw_rect_filled(pixels, stride, width, height, x0 + radius, y1 - radius + 1, x1 - radius, y1, color);
+    draw_rect_filled(pixels, stride, width, height, x0, y0 + radius, x1, y1 - radius, color, &cr);
+    draw_rect_filled(pixels, stride, width, height, x0 + radius, y0, x1 - radius, y0 + radius - 1, color, &cr);
+    draw_rect_filled(pixels, stride, width, height, x0 + radius, y1 - radius + 1, x1 - radius, y1, color, &cr);
 
     // 四个圆角
     int x = radius, y = 0, err = 0;
     while (x >= y)
     {
-        draw_line(pixels, stride, width, height, x0 + radius - x, y0 + radius - y, x0 + radius - x, y0 + radius - y, color);
-        draw_line(pixels, stride, width, height, x1 - radius + x, y0 + radius - y, x1 - radius + x, y0 + radius - y, color);
-        draw_line(pixels, stride, width, height, x0 + radius - x, y1 - radius + y, x0 + radius - x, y1 - radius + y, color);
-        draw_line(pixels, stride, width, height, x1 - radius + x, y1 - radius + y, x1 - radius + x, y1 - radius + y, color);
+        plot_clipped(pixels, stride, cr, x0 + radius - x, y0 + radius - y, color);
+        plot_clipped(pixels, stride, cr, x1 - radius + x, y0 + radius - y, color);
+        plot_clipped(pixels, stride, cr, x0 + radius - x, y1 - radius + y, color);
+        plot_clipped(pixels, stride, cr, x1 - radius + x, y1 - radius + y, color);
 
         y++;
         if (err <= 0)
@@ -259,20 +342,23 @@ void draw_rect_rounded_filled(uint32_t *pixels, int stride, int width, int heigh
     }
 }
 
-void draw_circle(uint32_t *pixels, int stride, int width, int height, int cx, int cy, int radius, uint32_t color)
+void draw_circle(uint32_t *pixels, int stride, int width, int height, int cx, int cy, int radius, uint32_t color, const IntRect *clip)
 {
+    IntRect cr = clip_bounds(width, height, clip);
+    if (clip_reject(cr, cx - radius, cy - radius, cx + radius, cy + radius)) return;
+
     int x = radius, y = 0, err = 0;
 
     while (x >= y)
     {
-        put_pixel(pixels, stride, width, height, cx + x, cy + y, color);
-        put_pixel(pixels, stride, width, height, cx + y, cy + x, color);
-        put_pixel(pixels, stride, width, height, cx - y, cy + x, color);
-        put_pixel(pixels, stride, width, height, cx - x, cy + y, color);
-        put_pixel(pixels, stride, width, height, cx - x, cy - y, color);
-        put_pixel(pixels, stride, width, height, cx - y, cy - x, color);
-        put_pixel(pixels, stride, width, height, cx + y, cy - x, color);
-        put_pixel(pixels, stride, width, height, cx + x, cy - y, color);
+        plot_clipped(pixels, stride, cr, cx + x, cy + y, color);
+        plot_clipped(pixels, stride, cr, cx + y, cy + x, color);
+        plot_clipped(pixels, stride, cr, cx - y, cy + x, color);
+        plot_clipped(pixels, stride, cr, cx - x, cy + y, color);
+        plot_clipped(pixels, stride, cr, cx - x, cy - y, color);
+        plot_clipped(pixels, stride, cr, cx - y, cy - x, color);
+        plot_clipped(pixels, stride, cr, cx + y, cy - x, color);
+        plot_clipped(pixels, stride, cr, cx + x, cy - y, color);
 
         y++;
         if (err <= 0)
@@ -287,16 +373,19 @@ void draw_circle(uint32_t *pixels, int stride, int width, int height, int cx, in
     }
 }
 
-void draw_circle_filled(uint32_t *pixels, int stride, int width, int height, int cx, int cy, int radius, uint32_t color)
+void draw_circle_filled(uint32_t *pixels, int stride, int width, int height, int cx, int cy, int radius, uint32_t color, const IntRect *clip)
 {
+    IntRect cr = clip_bounds(width, height, clip);
+    if (clip_reject(cr, cx - radius, cy - radius, cx + radius, cy + radius)) return;
+
     int x = radius, y = 0, err = 0;
 
     while (x >= y)
     {
-        draw_line(pixels, stride, width, height, cx - x, cy + y, cx + x, cy + y, color);
-        draw_line(pixels, stride, width, height, cx - y, cy + x, cx + y, cy + x, color);
-        draw_line(pixels, stride, width, height, cx - x, cy - y, cx + x, cy - y, color);
-        draw_line(pixels, stride, width, height, cx - y, cy - x, cx + y, cy - x, color);
+        draw_hline(pixels, stride, cr, cx - x, cx + x, cy + y, color);
+        draw_hline(pixels, stride, cr, cx - y, cx + y, cy + x, color);
+        draw_hline(pixels, stride, cr, cx - x, cx + x, cy - y, color);
+        draw_hline(pixels, stride, cr, cx - y, cx + y, cy - x, color);
 
         y++;
         if (err <= 0)
@@ -311,20 +400,26 @@ void draw_circle_filled(uint32_t *pixels, int stride, int width, int height, int
     }
 }
 
-void draw_circleF(uint32_t *pixels, int stride, int width, int height, float cx, float cy, float radius, uint32_t color)
+void draw_circleF(uint32_t *pixels, int stride, int width, int height, float cx, float cy, float radius, uint32_t color, const IntRect *clip)
 {
-    draw_circle(pixels, stride, width, height, (int)cx, (int)cy, (int)radius, color);
+    draw_circle(pixels, stride, width, height, (int)std::floor(cx), (int)std::floor(cy), (int)radius, color, clip);
 }
 
-void draw_triangle(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, int x2, int y2, uint32_t color)
+void draw_triangle(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, int x2, int y2, uint32_t color, const IntRect *clip)
 {
-    draw_line(pixels, stride, width, height, x0, y0, x1, y1, color);
-    draw_line(pixels, stride, width, height, x1, y1, x2, y2, color);
-    draw_line(pixels, stride, width, height, x2, y2, x0, y0, color);
+    IntRect cr = clip_bounds(width, height, clip);
+    if (clip_reject(cr, std::min({ x0, x1, x2 }), std::min({ y0, y1, y2 }), std::max({ x0, x1, x2 }), std::max({ y0, y1, y2 }))) return;
+
+    draw_line(pixels, stride, width, height, x0, y0, x1, y1, color, &cr);
+    draw_line(pixels, stride, width, height, x1, y1, x2, y2, color, &cr);
+    draw_line(pixels, stride, width, height, x2, y2, x0, y0, color, &cr);
 }
 
-void draw_triangle_filled(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, int x2, int y2, uint32_t color)
+void draw_triangle_filled(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, int x2, int y2, uint32_t color, const IntRect *clip)
 {
+    IntRect cr = clip_bounds(width, height, clip);
+    if (clip_reject(cr, std::min({ x0, x1, x2 }), std::min({ y0, y1, y2 }), std::max({ x0, x1, x2 }), std::max({ y0, y1, y2 }))) return;
+
     // 排序顶点 y0 <= y1 <= y2
     if (y0 > y1)
     {
@@ -347,12 +442,12 @@ void draw_triangle_filled(uint32_t *pixels, int stride, int width, int height, i
         // 平底三角形
         int sx = (x1 < x2) ? x1 : x2;
         int ex = (x1 > x2) ? x1 : x2;
-        for (int y = y0; y <= y1; y++)
+        for (int y = std::max(y0, cr.y0); y <= std::min(y1, cr.y1); y++)
         {
             float t = (y - y0) / (float)(y1 - y0);
             int xl = x0 + t * (sx - x0);
             int xr = x0 + t * (ex - x0);
-            draw_line(pixels, stride, width, height, xl, y, xr, y, color);
+            draw_hline(pixels, stride, cr, xl, xr, y, color);
         }
     }
     else if (y0 == y1)
@@ -360,25 +455,90 @@ void draw_triangle_filled(uint32_t *pixels, int stride, int width, int height, i
         // 平顶三角形
         int sx = (x0 < x1) ? x0 : x1;
         int ex = (x0 > x1) ? x0 : x1;
-        for (int y = y0; y <= y2; y++)
+        for (int y = std::max(y0, cr.y0); y <= std::min(y2, cr.y1); y++)
         {
             float t = (y - y0) / (float)(y2 - y0);
             int xl = sx + t * (x2 - sx);
             int xr = ex + t * (x2 - ex);
-            draw_line(pixels, stride, width, height, xl, y, xr, y, color);
+            draw_hline(pixels, stride, cr, xl, xr, y, color);
         }
     }
     else
     {
         // 分割成两个三角形
         int x3 = x0 + ((y1 - y0) * (x2 - x0)) / (y2 - y0);
-        draw_triangle_filled(pixels, stride, width, height, x0, y0, x1, y1, x3, y1, color);
-        draw_triangle_filled(pixels, stride, width, height, x1, y1, x3, y1, x2, y2, color);
+        draw_triangle_filled(pixels, stride, width, height, x0, y0, x1, y1, x3, y1, color, &cr);
+        draw_triangle_filled(pixels, stride, width, height, x1, y1, x3, y1, x2, y2, color, &cr);
     }
 }
 
-void draw_bezier_cubic(uint32_t *pixels, int stride, int width, int height, float x0, float y0, float x1, float y1, float x2, float y2, float x3, float y3, uint32_t color, int segments)
+void draw_polygon(uint32_t *pixels, int stride, int width, int height, const int *points, int point_count, uint32_t color, const IntRect *clip)
 {
+    if (point_count < 2) return;
+
+    IntRect cr = clip_bounds(width, height, clip);
+    for (int i = 0; i < point_count; i++)
+    {
+        int j = (i + 1) % point_count;
+        draw_line(pixels, stride, width, height, points[i * 2], points[i * 2 + 1], points[j * 2], points[j * 2 + 1], color, &cr);
+    }
+}
+
+void draw_polygonF(uint32_t *pixels, int stride, int width, int height, const float *points, int point_count, uint32_t color, const IntRect *clip)
+{
+    if (point_count < 2) return;
+
+    IntRect cr = clip_bounds(width, height, clip);
+    for (int i = 0; i < point_count; i++)
+    {
+        int j = (i + 1) % point_count;
+        draw_lineF(pixels, stride, width, height, points[i * 2], points[i * 2 + 1], points[j * 2], points[j * 2 + 1], color, &cr);
+    }
+}
+
+// 每个线程一份，分块回放时可并行
+static PolygonFiller &local_filler()
+{
+    static thread_local PolygonFiller filler;
+    return filler;
+}
+
+void draw_polygon_filled(uint32_t *pixels, int stride, int width, int height, const int *points, int point_count, uint32_t color, const IntRect *clip)
+{
+    if (point_count < 3 || (color >> 24) == 0) return;
+
+    IntRect cr = clip_bounds(width, height, clip);
+    if (cr.IsEmpty()) return;
+
+    PolygonFiller &filler = local_filler();
+    filler.Reset(cr);
+    filler.AddPolygon(points, point_count);
+    filler.Fill(pixels, stride, color, FillRule::EvenOdd);
+}
+
+void draw_path_filled(uint32_t *pixels, int stride, int width, int height, const float *points, const int *contour_sizes, int contour_count, uint32_t color, FillRule rule, const IntRect *clip)
+{
+    if (contour_count <= 0 || (color >> 24) == 0) return;
+
+    IntRect cr = clip_bounds(width, height, clip);
+    if (cr.IsEmpty()) return;
+
+    PolygonFiller &filler = local_filler();
+    filler.Reset(cr);
+    for (int i = 0; i < contour_count; i++)
+    {
+        filler.AddPolygon(points, contour_sizes[i]);
+        points += contour_sizes[i] * 2;
+    }
+    filler.Fill(pixels, stride, color, rule);
+}
+
+void draw_bezier_cubic(uint32_t *pixels, int stride, int width, int height, float x0, float y0, float x1, float y1, float x2, float y2, float x3, float y3, uint32_t color, int segments, const IntRect *clip)
+{
+    IntRect cr = clip_bounds(width, height, clip);
+    if (clip_reject(cr, (int)std::floor(std::min({ x0, x1, x2, x3 })), (int)std::floor(std::min({ y0, y1, y2, y3 })), (int)std::ceil(std::max({ x0, x1, x2, x3 })), (int)std::ceil(std::max({ y0, y1, y2, y3 })))) return;
+
+    if (segments <= 0) segments = bezier_segments_cubic(x0, y0, x1, y1, x2, y2, x3, y3);
     float px = x0, py = y0;
 
     for (int i = 1; i <= segments; i++)
@@ -393,14 +553,18 @@ void draw_bezier_cubic(uint32_t *pixels, int stride, int width, int height, floa
         float x = uuu * x0 + 3 * uu * t * x1 + 3 * u * tt * x2 + ttt * x3;
         float y = uuu * y0 + 3 * uu * t * y1 + 3 * u * tt * y2 + ttt * y3;
 
-        draw_lineF(pixels, stride, width, height, px, py, x, y, color);
+        draw_lineF(pixels, stride, width, height, px, py, x, y, color, &cr);
         px = x;
         py = y;
     }
 }
 
-void draw_bezier_quadratic(uint32_t *pixels, int stride, int width, int height, float x0, float y0, float x1, float y1, float x2, float y2, uint32_t color, int segments)
+void draw_bezier_quadratic(uint32_t *pixels, int stride, int width, int height, float x0, float y0, float x1, float y1, float x2, float y2, uint32_t color, int segments, const IntRect *clip)
 {
+    IntRect cr = clip_bounds(width, height, clip);
+    if (clip_reject(cr, (int)std::floor(std::min({ x0, x1, x2 })), (int)std::floor(std::min({ y0, y1, y2 })), (int)std::ceil(std::max({ x0, x1, x2 })), (int)std::ceil(std::max({ y0, y1, y2 })))) return;
+
+    if (segments <= 0) segments = bezier_segments_quadratic(x0, y0, x1, y1, x2, y2);
     float px = x0, py = y0;
 
     for (int i = 1; i <= segments; i++)
@@ -413,71 +577,71 @@ void draw_bezier_quadratic(uint32_t *pixels, int stride, int width, int height,
         float x = uu * x0 + 2 * u * t * x1 + tt * x2;
         float y = uu * y0 + 2 * u * t * y1 + tt * y2;
 
-        draw_lineF(pixels, stride, width, height, px, py, x, y, color);
+        draw_lineF(pixels, stride, width, height, px, py, x, y, color, &cr);
         px = x;
         py = y;
     }
 }
 
-void fill_gradient_linear(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color_start, uint32_t color_end)
+// 两色渐变：色带在栈上烘焙（256 项，比逐像素插值便宜得多），不经过缓存，可在任意线程调用
+void fill_gradient_linear(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color_start, uint32_t color_end, const IntRect *clip)
 {
-    if (x0 > x1) std::swap(x0, x1);
     if (y0 > y1) std::swap(y0, y1);
 
-    uint8_t r0 = get_red(color_start), g0 = get_green(color_start), b0 = get_blue(color_start);
-    uint8_t r1 = get_red(color_end), g1 = get_green(color_end), b1 = get_blue(color_end);
-
-    for (int y = y0; y <= y1; y++)
-    {
-        float t = (y - y0) / (float)(y1 - y0 + 1);
-        uint8_t r = r0 + t * (r1 - r0);
-        uint8_t g = g0 + t * (g1 - g0);
-        uint8_t b = b0 + t * (b1 - b0);
-        uint32_t color = rgba(r, g, b);
+    GradientStop stops[2] = { { 0.0f, color_start }, { 1.0f, color_end } };
+    GradientRamp ramp;
+    bake_gradient_ramp(ramp, stops, 2);
+    fill_gradient_linear(pixels, stride, width, height, x0, y0, x1, y1, 0.0f, (float)y0, 0.0f, (float)(y1 + 1), ramp, clip);
+}
 
-        for (int x = x0; x <= x1; x++)
-        {
-            put_pixel_fast(pixels, stride, width, height, x, y, color);
-        }
-    }
+void fill_gradient_radial(uint32_t *pixels, int stride, int width, int height, int cx, int cy, int radius, uint32_t color_center, uint32_t color_edge, const IntRect *clip)
+{
+    GradientStop stops[2] = { { 0.0f, color_center }, { 1.0f, color_edge } };
+    GradientRamp ramp;
+    bake_gradient_ramp(ramp, stops, 2);
+    fill_gradient_radial(pixels, stride, width, height, cx, cy, radius, ramp, clip);
 }
 
-void fill_gradient_radial(uint32_t *pixels, int stride, int width, int height, int cx, int cy, int radius, uint32_t color_center, uint32_t color_edge)
+void clear_screen(uint32_t *pixels, int stride, int width, int height, uint32_t color, const IntRect *clip)
 {
-    uint8_t r0 = get_red(color_center), g0 = get_green(color_center), b0 = get_blue(color_center);
-    uint8_t r1 = get_red(color_edge), g1 = get_green(color_edge), b1 = get_blue(color_edge);
+    if (width <= 0) return;
 
-    for (int y = cy - radius; y <= cy + radius; y++)
+    if (clip)
     {
-        for (int x = cx - radius; x <= cx + radius; x++)
-        {
-            int dx = x - cx;
-            int dy = y - cy;
-            float dist = std::sqrt(dx * dx + dy * dy);
-
-            if (dist <= radius)
-            {
-                float t = dist / radius;
-                uint8_t r = r0 + t * (r1 - r0);
-                uint8_t g = g0 + t * (g1 - g0);
-                uint8_t b = b0 + t * (b1 - b0);
-                uint32_t color = rgba(r, g, b);
-
-                put_pixel(pixels, stride, width, height, x, y, color);
-            }
-        }
+        clear_rect(pixels, stride, width, height, 0, 0, width - 1, height - 1, color, clip);
+        return;
+    }
+
+    color = to_pixel(color);
+    if (stride == width)
+    {
+        span_fill(pixels, width * height, color);
+        return;
+    }
+
+    for (int y = 0; y < height; y++)
+    {
+        span_fill(pixels + y * stride, width, color);
     }
 }
 
-void clear_screen(uint32_t *pixels, int stride, int width, int height, uint32_t color)
+void clear_rect(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, uint32_t color, const IntRect *clip)
 {
-    for (int y = 0; y < height; y++)
+    if (x0 > x1) std::swap(x0, x1);
+    if (y0 > y1) std::swap(y0, y1);
+
+    IntRect cr = clip_bounds(width, height, clip);
+    x0 = std::max(cr.x0, x0);
+    y0 = std::max(cr.y0, y0);
+    x1 = std::min(cr.x1, x1);
+    y1 = std::min(cr.y1, y1);
+    if (x0 > x1) return;
+
+    color = to_pixel(color);
+    for (int y = y0; y <= y1; y++)
     {
-        for (int x = 0; x < width; x++)
-        {
-            pixels[y * stride + x] = color;
-        }
+        span_fill(pixels + y * stride + x0, x1 - x0 + 1, color);
     }
 }
 
-} // namespace Graphics
\ No newline at end of file
+} // namespace Graphics
@@ -0,0 +1,765 @@
+/*
+ * CPU-Draw - Rasterizer Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 抗锯齿覆盖率光栅化
+ * 路径按扫描线累积有向面积，输出水平覆盖率扫描线
+ *
+ * 特性：
+ * - 稀疏单元格（只记录边经过的像素），按行计数排序、行内按 x 排序后扫描
+ * - 非零 / 奇偶填充规则
+ * - 内部恒定覆盖率的区间整段交给 span_blend，边缘交给 span_blend_mask
+ * - 线段描边、圆、圆环、圆角矩形
+ * - 细线段、细圆环（线宽不超过 3）不建边表，逐像素按方框重叠求覆盖率
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "graphics/Rasterizer.h"
+#include "graphics/SpanKernels.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Graphics
+{
+
+// 圆弧展开的最大弦高误差（像素）
+static const float ARC_TOLERANCE = 0.125f;
+static const float PI = 3.14159265358979f;
+
+// 恒定覆盖率区间短于此值时并入遮罩
+static const int SHORT_SPAN = 8;
+
+// 不超过此线宽的线段、圆环直接逐像素求覆盖率
+static const float THIN_STROKE = 3.0f;
+static const int THIN_MASK_CHUNK = 256;
+
+// 单元格数不超过此值的行用插入排序
+static const size_t SHORT_ROW = 16;
+
+Rasterizer::Rasterizer() : clip(IntRect::Empty()), startX(0), startY(0), lastX(0), lastY(0), hasPath(false)
+{
+}
+
+void Rasterizer::Reset(const IntRect &rect)
+{
+    clip = rect;
+    cells.clear();
+    hasPath = false;
+
+    if (!clip.IsEmpty() && (int)rowMask.size() < clip.Width())
+    {
+        rowMask.resize(clip.Width());
+    }
+}
+
+void Rasterizer::MoveTo(float x, float y)
+{
+    Close();
+    startX = lastX = x;
+    startY = lastY = y;
+    hasPath = true;
+}
+
+void Rasterizer::LineTo(float x, float y)
+{
+    if (!hasPath)
+    {
+        MoveTo(x, y);
+        return;
+    }
+    AddEdge(lastX, lastY, x, y);
+    lastX = x;
+    lastY = y;
+}
+
+void Rasterizer::Close()
+{
+    if (!hasPath) return;
+    AddEdge(lastX, lastY, startX, startY);
+    lastX = startX;
+    lastY = startY;
+    hasPath = false;
+}
+
+void Rasterizer::AddPolygon(const float *points, int point_count)
+{
+    if (point_count < 3) return;
+
+    MoveTo(points[0], points[1]);
+    for (int i = 1; i < point_count; i++)
+    {
+        LineTo(points[i * 2], points[i * 2 + 1]);
+    }
+    Close();
+}
+
+// 弦高误差不超过 ARC_TOLERANCE 的整圆分段数
+static int arc_segments(float radius)
+{
+    if (radius <= ARC_TOLERANCE) return 8;
+    float step = std::acos(1.0f - ARC_TOLERANCE / radius);
+    int n = (int)std::ceil(PI / step);
+    return std::max(8, std::min(n, 1024));
+}
+
+void Rasterizer::AddArc(float cx, float cy, float radius, float a0, float a1, bool first)
+{
+    int n = std::max(1, (int)std::ceil(arc_segments(radius) * std::fabs(a1 - a0) / (2.0f * PI)));
+    float step = (a1 - a0) / n;
+
+    // 旋转递推，只在起点算一次三角函数
+    float c = std::cos(step), s = std::sin(step);
+    float dx = std::cos(a0) * radius, dy = std::sin(a0) * radius;
+
+    for (int i = 0; i <= n; i++)
+    {
+        if (i == 0 && first)
+        {
+            MoveTo(cx + dx, cy + dy);
+        }
+        else
+        {
+            LineTo(cx + dx, cy + dy);
+        }
+
+        float nx = dx * c - dy * s;
+        dy = dx * s + dy * c;
+        dx = nx;
+    }
+}
+
+void Rasterizer::AddCircle(float cx, float cy, float radius, bool reverse)
+{
+    if (radius <= 0.0f) return;
+
+    // 屏幕坐标下角度递增为顺时针
+    if (reverse)
+    {
+        AddArc(cx, cy, radius, 2.0f * PI, 0.0f, true);
+    }
+    else
+    {
+        AddArc(cx, cy, radius, 0.0f, 2.0f * PI, true);
+    }
+    Close();
+}
+
+void Rasterizer::AddRoundedRect(float x0, float y0, float x1, float y1, float radius, bool reverse)
+{
+    if (x0 > x1) std::swap(x0, x1);
+    if (y0 > y1) std::swap(y0, y1);
+    if (x1 - x0 <= 0.0f || y1 - y0 <= 0.0f) return;
+
+    radius = std::min(radius, std::min(x1 - x0, y1 - y0) * 0.5f);
+
+    if (radius <= 0.0f)
+    {
+        if (reverse)
+        {
+            MoveTo(x0, y0);
+            LineTo(x0, y1);
+            LineTo(x1, y1);
+            LineTo(x1, y0);
+        }
+        else
+        {
+            MoveTo(x0, y0);
+            LineTo(x1, y0);
+            LineTo(x1, y1);
+            LineTo(x0, y1);
+        }
+        Close();
+        return;
+    }
+
+    // 四个圆角之间的直边由 LineTo 自然连接
+    float l = x0 + radius, r = x1 - radius;
+    float t = y0 + radius, b = y1 - radius;
+    if (reverse)
+    {
+        AddArc(l, t, radius, 1.5f * PI, 1.0f * PI, true);
+        AddArc(l, b, radius, 1.0f * PI, 0.5f * PI, false);
+        AddArc(r, b, radius, 0.5f * PI, 0.0f, false);
+        AddArc(r, t, radius, 0.0f, -0.5f * PI, false);
+    }
+    else
+    {
+        AddArc(r, t, radius, -0.5f * PI, 0.0f, true);
+        AddArc(r, b, radius, 0.0f, 0.5f * PI, false);
+        AddArc(l, b, radius, 0.5f * PI, 1.0f * PI, false);
+        AddArc(l, t, radius, 1.0f * PI, 1.5f * PI, false);
+    }
+    Close();
+}
+
+void Rasterizer::AddStrokeLine(float x0, float y0, float x1, float y1, float width)
+{
+    float half = std::max(width, 0.0f) * 0.5f;
+    if (half <= 0.0f) return;
+
+    float dx = x1 - x0, dy = y1 - y0;
+    float len = std::sqrt(dx * dx + dy * dy);
+
+    // 两端各延长半个像素，与 Bresenham 包含端点一致
+    float ux = 1.0f, uy = 0.0f;
+    if (len >= 1e-6f)
+    {
+        ux = dx / len;
+        uy = dy / len;
+    }
+    float tx = ux * 0.5f, ty = uy * 0.5f;
+    float nx = -uy * half, ny = ux * half;
+
+    MoveTo(x0 - tx + nx, y0 - ty + ny);
+    LineTo(x1 + tx + nx, y1 + ty + ny);
+    LineTo(x1 + tx - nx, y1 + ty - ny);
+    LineTo(x0 - tx - nx, y0 - ty - ny);
+    Close();
+}
+
+void Rasterizer::AddEdge(float x0, float y0, float x1, float y1)
+{
+    if (y0 == y1 || clip.IsEmpty()) return;
+
+    // 向下的边覆盖为正
+    float dir = 1.0f;
+    if (y0 > y1)
+    {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+        dir = -1.0f;
+    }
+
+    // 只处理裁剪区内的扫描线
+    float top = std::max(y0, (float)clip.y0);
+    float bottom = std::min(y1, (float)(clip.y1 + 1));
+    if (top >= bottom) return;
+
+    float dxdy = (x1 - x0) / (y1 - y0);
+    int row0 = (int)std::floor(top);
+    int row1 = (int)std::ceil(bottom) - 1;
+
+    for (int row = row0; row <= row1; row++)
+    {
+        float ya = std::max(top, (float)row);
+        float yb = std::min(bottom, (float)(row + 1));
+        if (ya >= yb) continue;
+
+        float xa = x0 + (ya - y0) * dxdy;
+        float xb = x0 + (yb - y0) * dxdy;
+        AddRowSegment(row, xa, xb, (yb - ya) * dir);
+    }
+}
+
+void Rasterizer::AddRowSegment(int row, float xa, float xb, float dy)
+{
+    // 覆盖只与经过的 x 区间有关，统一从左往右拆分
+    if (xa > xb) std::swap(xa, xb);
+
+    int ca = (int)std::floor(xa);
+    int cb = (int)std::floor(xb);
+
+    // 像素内的覆盖 = dy * (1 - 平均 x 偏移)，右侧像素得到完整的 dy
+    if (ca == cb)
+    {
+        AddCell(ca, row, dy, dy * (1.0f - ((xa + xb) * 0.5f - ca)));
+        return;
+    }
+
+    float slope = dy / (xb - xa);
+    float x = xa;
+    for (int c = ca; c <= cb; c++)
+    {
+        float nx = std::min(xb, (float)(c + 1));
+        float d = (nx - x) * slope;
+        AddCell(c, row, d, d * (1.0f - ((x + nx) * 0.5f - c)));
+        x = nx;
+    }
+}
+
+void Rasterizer::AddCell(int x, int y, float cover, float area)
+{
+    // 裁剪区右侧的单元格不影响可见像素
+    if (x > clip.x1) return;
+
+    // 左侧的单元格只保留向右传递的覆盖
+    if (x < clip.x0)
+    {
+        x = clip.x0 - 1;
+        area = 0.0f;
+    }
+
+    if (!cells.empty())
+    {
+        Cell &last = cells.back();
+        if (last.x == x && last.y == y)
+        {
+            last.cover += cover;
+            last.area += area;
+            return;
+        }
+    }
+    cells.push_back({ x, y, cover, area });
+}
+
+void Rasterizer::SortCells()
+{
+    // 行号有界：先按行计数排序，再在每行内按 x 排序
+    int minY = cells[0].y, maxY = cells[0].y;
+    for (const Cell &c : cells)
+    {
+        minY = std::min(minY, c.y);
+        maxY = std::max(maxY, c.y);
+    }
+
+    int rows = maxY - minY + 1;
+    rowStart.assign(rows + 1, 0);
+    for (const Cell &c : cells)
+    {
+        rowStart[c.y - minY + 1]++;
+    }
+    for (int r = 0; r < rows; r++)
+    {
+        rowStart[r + 1] += rowStart[r];
+    }
+    sorted.resize(cells.size());
+    for (const Cell &c : cells)
+    {
+        sorted[rowStart[c.y - minY]++] = c;
+    }
+
+    // 每行单元格很少，短行插入排序
+    auto byX = [](const Cell &a, const Cell &b) { return a.x < b.x; };
+    size_t begin = 0;
+    for (int r = 0; r < rows; r++)
+    {
+        size_t end = rowStart[r];
+        if (end - begin > SHORT_ROW)
+        {
+            std::sort(sorted.begin() + begin, sorted.begin() + end, byX);
+        }
+        else
+        {
+            for (size_t i = begin + 1; i < end; i++)
+            {
+                Cell c = sorted[i];
+                size_t j = i;
+                while (j > begin && sorted[j - 1].x > c.x)
+                {
+                    sorted[j] = sorted[j - 1];
+                    j--;
+                }
+                sorted[j] = c;
+            }
+        }
+        begin = end;
+    }
+}
+
+// 累积值转为 0-255 覆盖率
+static inline uint8_t coverage(float v, FillRule rule)
+{
+    v = std::fabs(v);
+    if (rule == FillRule::EvenOdd)
+    {
+        v = std::fmod(v, 2.0f);
+        if (v > 1.0f) v = 2.0f - v;
+    }
+    if (v >= 1.0f) return 255;
+    return (uint8_t)(v * 255.0f + 0.5f);
+}
+
+// 颜色 alpha 乘以覆盖率
+static inline uint32_t scale_alpha(uint32_t color, uint8_t c)
+{
+    if (c == 255) return color;
+    return (color & 0x00FFFFFF) | (div255((color >> 24) * c) << 24);
+}
+
+void Rasterizer::Fill(uint32_t *pixels, int stride, uint32_t color, FillRule rule)
+{
+    if (cells.empty() || (color >> 24) == 0) return;
+
+    SortCells();
+
+    size_t i = 0, n = sorted.size();
+    while (i < n)
+    {
+        int y = sorted[i].y;
+        uint32_t *row = pixels + y * stride;
+        float acc = 0.0f;
+
+        // 边缘像素的覆盖率先攒成连续遮罩，再一次混合
+        int runStart = 0, runLen = 0;
+        auto flush = [&]() {
+            if (runLen > 0) span_blend_mask(row + runStart, rowMask.data(), runLen, color);
+            runLen = 0;
+        };
+        auto push = [&](int x, uint8_t c) {
+            if (runLen > 0 && runStart + runLen != x) flush();
+            if (runLen == 0) runStart = x;
+            rowMask[runLen++] = c;
+        };
+
+        while (i < n && sorted[i].y == y)
+        {
+            int x = sorted[i].x;
+            float cover = 0.0f, area = 0.0f;
+            while (i < n && sorted[i].y == y && sorted[i].x == x)
+            {
+                cover += sorted[i].cover;
+                area += sorted[i].area;
+                i++;
+            }
+
+            if (x >= clip.x0)
+            {
+                push(x, coverage(acc + area, rule));
+            }
+            acc += cover;
+
+            // 到下一个单元格之前覆盖率不变
+            int next = (i < n && sorted[i].y == y) ? sorted[i].x : clip.x1 + 1;
+            int sx = std::max(x + 1, clip.x0);
+            int ex = next - 1;
+            if (sx > ex) continue;
+
+            uint8_t c = coverage(acc, rule);
+            if (c == 0) continue;
+
+            if (ex - sx < SHORT_SPAN)
+            {
+                for (int px = sx; px <= ex; px++)
+                {
+                    push(px, c);
+                }
+            }
+            else
+            {
+                flush();
+                span_blend(row + sx, ex - sx + 1, scale_alpha(color, c));
+            }
+        }
+        flush();
+    }
+}
+
+// 每个线程一份，分块回放时可并行
+static Rasterizer &local_rasterizer()
+{
+    static thread_local Rasterizer rasterizer;
+    return rasterizer;
+}
+
+static inline IntRect clip_bounds(int width, int height, const IntRect *clip)
+{
+    IntRect r = { 0, 0, width - 1, height - 1 };
+    return clip ? r.Intersect(*clip) : r;
+}
+
+// 准备光栅化器，裁剪区为空时返回空指针
+static Rasterizer *begin_path(int width, int height, uint32_t color, const IntRect *clip)
+{
+    if ((color >> 24) == 0) return nullptr;
+
+    IntRect cr = clip_bounds(width, height, clip);
+    if (cr.IsEmpty()) return nullptr;
+
+    Rasterizer &r = local_rasterizer();
+    r.Reset(cr);
+    return &r;
+}
+
+// 先夹到 [lo - 1, hi + 1] 再取整：截断比 std::floor 快，夹紧后也不会溢出 int
+static inline int floor_clamped(float v, int lo, int hi)
+{
+    v = std::min(std::max(v, (float)(lo - 1)), (float)(hi + 1));
+    int i = (int)v;
+    return i - (v < (float)i);
+}
+
+static inline int ceil_clamped(float v, int lo, int hi)
+{
+    return -floor_clamped(-v, -hi, -lo);
+}
+
+// 单位像素投影到方向 (nx, ny) 上是梯形，中段斜率为 1 / max(|nx|, |ny|)：
+// 近似成宽 w = max(|nx|, |ny|) 的方框，中段与精确面积一致，墨量不变，只在两角略有偏差
+// 返回 [t - w / 2, t + w / 2] 与 [lo, hi] 的重叠占 w 的比例
+static inline float box_cover(float t, float lo, float hi, float w)
+{
+    float r = w * 0.5f;
+    return std::max(0.0f, std::min(t + r, hi) - std::max(t - r, lo)) / w;
+}
+
+// 把 [x0, x1] 缩小到 a + k * x 落在 (lo, hi) 内的像素，inv_k = 1 / k
+static inline void narrow_span(float a, float k, float inv_k, float lo, float hi, int &x0, int &x1)
+{
+    if (lo >= hi)
+    {
+        x1 = x0 - 1;
+        return;
+    }
+    if (std::fabs(k) < 1e-6f)
+    {
+        if (a <= lo || a >= hi) x1 = x0 - 1;
+        return;
+    }
+    float s = (lo - a) * inv_k, t = (hi - a) * inv_k;
+    if (s > t) std::swap(s, t);
+    int a0 = x0, a1 = x1;
+    x0 = std::max(a0, floor_clamped(s, a0, a1) + 1);
+    x1 = std::min(a1, ceil_clamped(t, a0, a1) - 1);
+}
+
+// 细描边直接逐像素求覆盖率：逐行求出覆盖率非零的区间，不建边表
+// 像素在法向、切向上分别与描边矩形求重叠比例，两端以外只看法向
+static void stroke_thin_line(uint32_t *pixels, int stride, const IntRect &cr, float x0, float y0, float x1, float y1, float half, uint32_t color)
+{
+    float dx = x1 - x0, dy = y1 - y0;
+    float len = std::sqrt(dx * dx + dy * dy);
+    float ux = 1.0f, uy = 0.0f;
+    if (len >= 1e-6f)
+    {
+        ux = dx / len;
+        uy = dy / len;
+    }
+
+    float inv_ux = ux != 0.0f ? 1.0f / ux : 0.0f;
+    float inv_uy = uy != 0.0f ? 1.0f / uy : 0.0f;
+    float w = std::max(std::fabs(ux), std::fabs(uy));
+    float r = w * 0.5f;
+
+    // 切向两端各延长半个像素，与 AddStrokeLine 一致
+    float ulo = -0.5f, uhi = len + 0.5f;
+
+    // 法向：min(w, 2 * half, half + r - |v|) / w，预乘 255
+    float scale = 255.0f / w;
+    float vfull = std::min(w, 2.0f * half) * scale;
+    float vedge = (half + r) * scale;
+
+    float reach = half + r + 1.0f;
+    int ry0 = std::max(cr.y0, floor_clamped(std::min(y0, y1) - reach, cr.y0, cr.y1));
+    int ry1 = std::min(cr.y1, ceil_clamped(std::max(y0, y1) + reach, cr.y0, cr.y1));
+
+    uint8_t mask[THIN_MASK_CHUNK];
+    for (int y = ry0; y <= ry1; y++)
+    {
+        // 像素 x 的中心：u = ua + ux * x，v = va - uy * x
+        float py = y + 0.5f - y0;
+        float ua = (0.5f - x0) * ux + py * uy;
+        float va = py * ux - (0.5f - x0) * uy;
+
+        int sx = cr.x0, ex = cr.x1;
+        narrow_span(va, -uy, -inv_uy, -half - r, half + r, sx, ex);
+        if (sx > ex) continue;
+
+        // 离两端足够远的部分切向完全覆盖；靠近两端的行才需要按切向再切分
+        int bx0 = sx, bx1 = ex;
+        float us = ua + ux * sx, ue = ua + ux * ex;
+        if (std::min(us, ue) <= ulo + r || std::max(us, ue) >= uhi - r)
+        {
+            narrow_span(ua, ux, inv_ux, ulo - r, uhi + r, sx, ex);
+            if (sx > ex) continue;
+
+            bx0 = sx;
+            bx1 = ex;
+            narrow_span(ua, ux, inv_ux, ulo + r, uhi - r, bx0, bx1);
+            if (bx0 > bx1)
+            {
+                bx0 = ex + 1;
+                bx1 = ex;
+            }
+        }
+
+        uint32_t *row = pixels + y * stride;
+        auto caps = [&](int from, int to) {
+            for (int x = from; x <= to; x += THIN_MASK_CHUNK)
+            {
+                int n = std::min(THIN_MASK_CHUNK, to - x + 1);
+                float u = ua + ux * x, v = va - uy * x;
+                for (int i = 0; i < n; i++)
+                {
+                    float c = box_cover(u + ux * i, ulo, uhi, w) * box_cover(v - uy * i, -half, half, w);
+                    mask[i] = (uint8_t)(int)(c * 255.0f + 0.5f);
+                }
+                span_blend_mask(row + x, mask, n, color);
+            }
+        };
+
+        caps(sx, bx0 - 1);
+        for (int x = bx0; x <= bx1; x += THIN_MASK_CHUNK)
+        {
+            int n = std::min(THIN_MASK_CHUNK, bx1 - x + 1);
+            float v = va - uy * x;
+            for (int i = 0; i < n; i++)
+            {
+                float c = std::min(vfull, vedge - scale * std::fabs(v - uy * i));
+                mask[i] = (uint8_t)(int)(std::max(c, 0.0f) + 0.5f);
+            }
+            span_blend_mask(row + x, mask, n, color);
+        }
+        caps(bx1 + 1, ex);
+    }
+}
+
+// 细圆环：像素中心到圆心的距离与 [radius - half, radius + half] 的重叠，投影宽度随径向变化
+static void stroke_thin_circle(uint32_t *pixels, int stride, const IntRect &cr, float cx, float cy, float radius, float half, uint32_t color)
+{
+    float lo = radius - half, hi = radius + half;
+    float outer = hi + 0.5f, inner = lo - 0.5f;
+    int ry0 = std::max(cr.y0, floor_clamped(cy - outer, cr.y0, cr.y1));
+    int ry1 = std::min(cr.y1, ceil_clamped(cy + outer, cr.y0, cr.y1));
+
+    uint8_t mask[THIN_MASK_CHUNK];
+    auto segment = [&](uint32_t *row, float py, float l, float r) {
+        // 中心落在 (l, r) 内的像素
+        int sx = std::max(cr.x0, floor_clamped(l - 0.5f, cr.x0, cr.x1) + 1);
+        int ex = std::min(cr.x1, ceil_clamped(r - 0.5f, cr.x0, cr.x1) - 1);
+        float ay = std::fabs(py);
+        for (int x = sx; x <= ex; x += THIN_MASK_CHUNK)
+        {
+            int n = std::min(THIN_MASK_CHUNK, ex - x + 1);
+            float px = x + 0.5f - cx;
+            for (int i = 0; i < n; i++, px += 1.0f)
+            {
+                // 径向 (px, py) / d 上的投影宽度 max(|px|, |py|) / d
+                float d = std::sqrt(px * px + py * py);
+                float m = std::max(std::fabs(px), ay);
+                float w = m > 1e-3f ? m / d : 1.0f;
+                mask[i] = (uint8_t)(int)(box_cover(d, lo, hi, w) * 255.0f + 0.5f);
+            }
+            span_blend_mask(row + x, mask, n, color);
+        }
+    };
+
+    for (int y = ry0; y <= ry1; y++)
+    {
+        float py = y + 0.5f - cy;
+        float qo = outer * outer - py * py;
+        if (qo <= 0.0f) continue;
+
+        uint32_t *row = pixels + y * stride;
+        float xo = std::sqrt(qo);
+        float qi = inner > 0.0f ? inner * inner - py * py : 0.0f;
+        if (qi <= 0.0f)
+        {
+            segment(row, py, cx - xo, cx + xo);
+            continue;
+        }
+
+        // 内圆以内覆盖率为 0，只画左右两段
+        float xi = std::sqrt(qi);
+        segment(row, py, cx - xo, cx - xi);
+        segment(row, py, cx + xi, cx + xo);
+    }
+}
+
+void draw_line_aa(uint32_t *pixels, int stride, int width, int height, float x0, float y0, float x1, float y1, uint32_t color, float thickness, const IntRect *clip)
+{
+    if (thickness <= THIN_STROKE && (color >> 24) != 0)
+    {
+        IntRect cr = clip_bounds(width, height, clip);
+        if (!cr.IsEmpty() && thickness > 0.0f)
+        {
+            stroke_thin_line(pixels, stride, cr, x0 + 0.5f, y0 + 0.5f, x1 + 0.5f, y1 + 0.5f, thickness * 0.5f, color);
+        }
+        return;
+    }
+
+    Rasterizer *r = begin_path(width, height, color, clip);
+    if (!r) return;
+
+    r->AddStrokeLine(x0 + 0.5f, y0 + 0.5f, x1 + 0.5f, y1 + 0.5f, thickness);
+    r->Fill(pixels, stride, color);
+}
+
+void draw_rectF_aa(uint32_t *pixels, int stride, int width, int height, float x0, float y0, float x1, float y1, uint32_t color, const IntRect *clip)
+{
+    Rasterizer *r = begin_path(width, height, color, clip);
+    if (!r) return;
+
+    if (x0 > x1) std::swap(x0, x1);
+    if (y0 > y1) std::swap(y0, y1);
+
+    // 以像素中心为边线的 1 像素描边：外框减去内框
+    r->AddRoundedRect(x0, y0, x1 + 1.0f, y1 + 1.0f, 0.0f);
+    r->AddRoundedRect(x0 + 1.0f, y0 + 1.0f, x1, y1, 0.0f, true);
+    r->Fill(pixels, stride, color);
+}
+
+void draw_circle_aa(uint32_t *pixels, int stride, int width, int height, float cx, float cy, float radius, uint32_t color, float thickness, const IntRect *clip)
+{
+    if (thickness <= THIN_STROKE && (color >> 24) != 0)
+    {
+        IntRect cr = clip_bounds(width, height, clip);
+        if (!cr.IsEmpty() && thickness > 0.0f && radius + thickness * 0.5f > 0.0f)
+        {
+            stroke_thin_circle(pixels, stride, cr, cx + 0.5f, cy + 0.5f, radius, thickness * 0.5f, color);
+        }
+        return;
+    }
+
+    Rasterizer *r = begin_path(width, height, color, clip);
+    if (!r) return;
+
+    float half = thickness * 0.5f;
+    r->AddCircle(cx + 0.5f, cy + 0.5f, radius + half);
+    r->AddCircle(cx + 0.5f, cy + 0.5f, radius - half, true);
+    r->Fill(pixels, stride, color);
+}
+
+void draw_circle_filled_aa(uint32_t *pixels, int stride, int width, int height, float cx, float cy, float radius, uint32_t color, const IntRect *clip)
+{
+    Rasterizer *r = begin_path(width, height, color, clip);
+    if (!r) return;
+
+    r->AddCircle(cx + 0.5f, cy + 0.5f, radius + 0.5f);
+    r->Fill(pixels, stride, color);
+}
+
+void draw_rect_rounded_aa(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, int radius, uint32_t color, const IntRect *clip)
+{
+    Rasterizer *r = begin_path(width, height, color, clip);
+    if (!r) return;
+
+    if (x0 > x1) std::swap(x0, x1);
+    if (y0 > y1) std::swap(y0, y1);
+    radius = std::max(0, std::min(radius, std::min((x1 - x0) / 2, (y1 - y0) / 2)));
+
+    // 圆角圆心与非抗锯齿版本相同，外缘半径 radius + 0.5，内缘 radius - 0.5
+    float rad = (float)radius;
+    r->AddRoundedRect((float)x0, (float)y0, (float)(x1 + 1), (float)(y1 + 1), rad + 0.5f);
+    r->AddRoundedRect((float)(x0 + 1), (float)(y0 + 1), (float)x1, (float)y1, std::max(0.0f, rad - 0.5f), true);
+    r->Fill(pixels, stride, color);
+}
+
+void draw_rect_rounded_filled_aa(uint32_t *pixels, int stride, int width, int height, int x0, int y0, int x1, int y1, int radius, uint32_t color, const IntRect *clip)
+{
+    Rasterizer *r = begin_path(width, height, color, clip);
+    if (!r) return;
+
+    if (x0 > x1) std::swap(x0, x1);
+    if (y0 > y1) std::swap(y0, y1);
+    radius = std::max(0, std::min(radius, std::min((x1 - x0) / 2, (y1 - y0) / 2)));
+
+    r->AddRoundedRect((float)x0, (float)y0, (float)(x1 + 1), (float)(y1 + 1), radius + 0.5f);
+    r->Fill(pixels, stride, color);
+}
+
+void draw_path_filled_aa(uint32_t *pixels, int stride, int width, int height, const float *points, const int *contour_sizes, int contour_count, uint32_t color, FillRule rule, const IntRect *clip)
+{
+    Rasterizer *r = begin_path(width, height, color, clip);
+    if (!r) return;
+
+    for (int i = 0; i < contour_count; i++)
+    {
+        r->AddPolygon(points, contour_sizes[i]);
+        points += contour_sizes[i] * 2;
+    }
+    r->Fill(pixels, stride, color, rule);
+}
+
+} // namespace Graphics
@@ -0,0 +1,98 @@
+/*
+ * CPU-Draw - Render Scale Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 双线性放大
+ * 屏幕像素中心反算到源像素坐标：s = (x + 0.5) * src / dst - 0.5，16.16 定点步进
+ * 两端超出范围的采样取边缘像素；先横向采样源行（缓存两行），再纵向插值
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "graphics/RenderScale.h"
+#include "graphics/SpanKernels.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace Graphics
+{
+
+IntRect upscale_bounds(const IntRect &rect, int src_w, int src_h, int dst_w, int dst_h)
+{
+    if (rect.IsEmpty()) return rect;
+
+    // 采样点 s 落在 [x0 - 1, x1 + 1) 内的屏幕像素会读到 rect 中的源像素
+    double kx = (double)dst_w / src_w, ky = (double)dst_h / src_h;
+    IntRect r;
+    r.x0 = (int)std::floor((rect.x0 - 0.5) * kx - 0.5);
+    r.y0 = (int)std::floor((rect.y0 - 0.5) * ky - 0.5);
+    r.x1 = (int)std::ceil((rect.x1 + 1.5) * kx - 0.5);
+    r.y1 = (int)std::ceil((rect.y1 + 1.5) * ky - 0.5);
+    return r.Intersect(IntRect{ 0, 0, dst_w - 1, dst_h - 1 });
+}
+
+void upscale_bilinear(uint32_t *dst, int dst_stride, int dst_w, int dst_h, const uint32_t *src, int src_stride, int src_w, int src_h, const IntRect &rect)
+{
+    IntRect r = rect.Intersect(IntRect{ 0, 0, dst_w - 1, dst_h - 1 });
+    if (r.IsEmpty() || src_w <= 0 || src_h <= 0) return;
+
+    double stepX = (double)src_w / dst_w, stepY = (double)src_h / dst_h;
+    int32_t du = (int32_t)std::llround(stepX * 65536.0);
+    int32_t dv = (int32_t)std::llround(stepY * 65536.0);
+    // 起点按第 0 列 / 行推算，分区域放大时采样位置与整屏一致
+    int32_t u0 = (int32_t)std::llround((0.5 * stepX - 0.5) * 65536.0) + r.x0 * du;
+    int32_t v0 = (int32_t)std::llround((0.5 * stepY - 0.5) * 65536.0);
+    int n = r.Width();
+
+    // 先横向：每个用到的源行只采样一次（放大时相邻几行屏幕像素共用），再纵向插值（NEON）
+    thread_local std::vector<uint32_t> rows;
+    if ((int)rows.size() < n * 2) rows.resize((size_t)n * 2);
+    uint32_t *cached[2] = { rows.data(), rows.data() + n };
+    int cachedRow[2] = { -1, -1 };
+
+    auto sampled = [&](int ty) -> const uint32_t * {
+        for (int k = 0; k < 2; k++)
+        {
+            if (cachedRow[k] == ty) return cached[k];
+        }
+        // 源行递增使用：保留 ty - 1，替换另一行
+        int k = cachedRow[0] == ty - 1 ? 1 : 0;
+        span_image_sample_bilinear(cached[k], src + (size_t)ty * src_stride, src_w, u0, du, n);
+        cachedRow[k] = ty;
+        return cached[k];
+    };
+
+    for (int y = r.y0; y <= r.y1; y++)
+    {
+        int32_t v = v0 + y * dv;
+        int ty = v >> 16;
+        int fy = ((uint32_t)v >> 8) & 0xFF;
+        if (ty < 0)
+        {
+            ty = 0;
+            fy = 0;
+        }
+        else if (ty >= src_h - 1)
+        {
+            ty = src_h - 1;
+            fy = 0;
+        }
+
+        uint32_t *out = dst + (size_t)y * dst_stride + r.x0;
+        const uint32_t *row0 = sampled(ty);
+        if (fy == 0)
+        {
+            memcpy(out, row0, (size_t)n * sizeof(uint32_t));
+        }
+        else
+        {
+            // 取 ty + 1 时保留 ty 所在的那一行
+            const uint32_t *row1 = sampled(ty + 1);
+            span_image_lerp_rows(out, row0, row1, n, fy);
+        }
+    }
+}
+
+} // namespace Graphics
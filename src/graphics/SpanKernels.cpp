@@ -0,0 +1,563 @@
+/*
+ * CPU-Draw - Span Kernels Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 水平扫描线内核
+ * 填充图形的底层像素写入
+ *
+ * 特性：
+ * - 不透明填充 / 常量颜色混合
+ * - 逐像素颜色混合（渐变、贴图）
+ * - 覆盖率遮罩混合（字形、抗锯齿）
+ * - 预乘 alpha 源混合（离屏缓存贴回）
+ * - ARM NEON 加速，除法改为乘法+移位
+ * - 预乘管线：常量颜色只预乘一次，每像素只剩 dst * (255 - a) 一次乘法
+ * - SDF：纵向插值、距离转覆盖率整行处理，横向采样为定点步进
+ * - 纹理：纵向插值、着色整行处理，横向两两通道合并插值
+ * - RGB565 输出：有序抖动后截断，NEON 一次 8 像素
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "graphics/SpanKernels.h"
+#include <algorithm>
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CPUDRAW_NEON 1
+#endif
+
+namespace Graphics
+{
+
+#if CPUDRAW_NEON
+
+// 16 字节逐通道插值：(s * a + d * (255 - a)) / 255
+static inline uint8x16_t neon_lerp(uint8x16_t s, uint8x16_t d, uint8x16_t a)
+{
+    uint8x16_t ia = vmvnq_u8(a);
+
+    uint16x8_t lo = vmull_u8(vget_low_u8(s), vget_low_u8(a));
+    uint16x8_t hi = vmull_u8(vget_high_u8(s), vget_high_u8(a));
+    lo = vmlal_u8(lo, vget_low_u8(d), vget_low_u8(ia));
+    hi = vmlal_u8(hi, vget_high_u8(d), vget_high_u8(ia));
+
+    lo = vrsraq_n_u16(lo, lo, 8);
+    hi = vrsraq_n_u16(hi, hi, 8);
+    return vcombine_u8(vrshrn_n_u16(lo, 8), vrshrn_n_u16(hi, 8));
+}
+
+// 16 字节逐通道缩放：(v * s) / 255
+static inline uint8x16_t neon_scale(uint8x16_t v, uint8x16_t s)
+{
+    uint16x8_t lo = vmull_u8(vget_low_u8(v), vget_low_u8(s));
+    uint16x8_t hi = vmull_u8(vget_high_u8(v), vget_high_u8(s));
+    lo = vrsraq_n_u16(lo, lo, 8);
+    hi = vrsraq_n_u16(hi, hi, 8);
+    return vcombine_u8(vrshrn_n_u16(lo, 8), vrshrn_n_u16(hi, 8));
+}
+
+// 4 像素直通混合，a 为逐字节展开的 alpha；a > 0 的像素结果 alpha 置 255
+static inline uint8x16_t neon_blend(uint8x16_t s, uint8x16_t d, uint8x16_t a)
+{
+    uint8x16_t opaque = vreinterpretq_u8_u32(vdupq_n_u32(0xFF000000));
+    return vorrq_u8(neon_lerp(s, d, a), vandq_u8(vtstq_u8(a, a), opaque));
+}
+
+// 4 像素预乘混合：s + d * (255 - a) / 255
+static inline uint8x16_t neon_blend_premul(uint8x16_t s, uint8x16_t d, uint8x16_t a)
+{
+    uint8x16_t r = vqaddq_u8(s, neon_scale(d, vmvnq_u8(a)));
+#if CPUDRAW_PREMULTIPLIED
+    return r;
+#else
+    uint8x16_t opaque = vreinterpretq_u8_u32(vdupq_n_u32(0xFF000000));
+    return vorrq_u8(r, opaque);
+#endif
+}
+
+static const uint8_t kAlphaIndex[16] = { 3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15 };
+static const uint8_t kMaskIndexLo[16] = { 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3 };
+static const uint8_t kMaskIndexHi[16] = { 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7 };
+
+#endif
+
+void span_fill(uint32_t *dst, int count, uint32_t color)
+{
+    int i = 0;
+
+#if CPUDRAW_NEON
+    uint32x4_t c = vdupq_n_u32(color);
+    for (; i + 16 <= count; i += 16)
+    {
+        vst1q_u32(dst + i, c);
+        vst1q_u32(dst + i + 4, c);
+        vst1q_u32(dst + i + 8, c);
+        vst1q_u32(dst + i + 12, c);
+    }
+    for (; i + 4 <= count; i += 4)
+    {
+        vst1q_u32(dst + i, c);
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        dst[i] = color;
+    }
+}
+
+void span_blend(uint32_t *dst, int count, uint32_t color)
+{
+    uint32_t a = color >> 24;
+    if (a == 0) return;
+    if (a == 255)
+    {
+        span_fill(dst, count, color);
+        return;
+    }
+
+    int i = 0;
+
+#if CPUDRAW_PREMULTIPLIED
+    // 颜色只预乘一次
+    uint32_t src = premultiply(color);
+    uint32_t ia = 255 - a;
+
+#if CPUDRAW_NEON
+    uint8x16_t s = vreinterpretq_u8_u32(vdupq_n_u32(src));
+    uint8x16_t av = vdupq_n_u8((uint8_t)a);
+    for (; i + 8 <= count; i += 8)
+    {
+        uint8x16_t d0 = vreinterpretq_u8_u32(vld1q_u32(dst + i));
+        uint8x16_t d1 = vreinterpretq_u8_u32(vld1q_u32(dst + i + 4));
+        d0 = neon_blend_premul(s, d0, av);
+        d1 = neon_blend_premul(s, d1, av);
+        vst1q_u32(dst + i, vreinterpretq_u32_u8(d0));
+        vst1q_u32(dst + i + 4, vreinterpretq_u32_u8(d1));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        dst[i] = blend_pixel_premul(dst[i], src, ia);
+    }
+#else
+
+#if CPUDRAW_NEON
+    uint8x16_t s = vreinterpretq_u8_u32(vdupq_n_u32(color));
+    uint8x16_t av = vdupq_n_u8((uint8_t)a);
+    for (; i + 8 <= count; i += 8)
+    {
+        uint8x16_t d0 = vreinterpretq_u8_u32(vld1q_u32(dst + i));
+        uint8x16_t d1 = vreinterpretq_u8_u32(vld1q_u32(dst + i + 4));
+        d0 = neon_blend(s, d0, av);
+        d1 = neon_blend(s, d1, av);
+        vst1q_u32(dst + i, vreinterpretq_u32_u8(d0));
+        vst1q_u32(dst + i + 4, vreinterpretq_u32_u8(d1));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        dst[i] = blend_pixel_straight(dst[i], color, a);
+    }
+#endif
+}
+
+void span_blend_colors(uint32_t *dst, const uint32_t *src, int count)
+{
+#if CPUDRAW_PREMULTIPLIED
+    span_blend_premul(dst, src, count);
+#else
+    int i = 0;
+
+#if CPUDRAW_NEON
+    uint8x16_t index = vld1q_u8(kAlphaIndex);
+    for (; i + 8 <= count; i += 8)
+    {
+        uint8x16_t s0 = vreinterpretq_u8_u32(vld1q_u32(src + i));
+        uint8x16_t s1 = vreinterpretq_u8_u32(vld1q_u32(src + i + 4));
+        uint8x16_t d0 = vreinterpretq_u8_u32(vld1q_u32(dst + i));
+        uint8x16_t d1 = vreinterpretq_u8_u32(vld1q_u32(dst + i + 4));
+        d0 = neon_blend(s0, d0, vqtbl1q_u8(s0, index));
+        d1 = neon_blend(s1, d1, vqtbl1q_u8(s1, index));
+        vst1q_u32(dst + i, vreinterpretq_u32_u8(d0));
+        vst1q_u32(dst + i + 4, vreinterpretq_u32_u8(d1));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        uint32_t c = src[i];
+        uint32_t a = c >> 24;
+        if (a == 255)
+        {
+            dst[i] = c;
+        }
+        else if (a > 0)
+        {
+            dst[i] = blend_pixel_straight(dst[i], c, a);
+        }
+    }
+#endif
+}
+
+void span_blend_mask(uint32_t *dst, const uint8_t *mask, int count, uint32_t color)
+{
+    uint32_t a = color >> 24;
+    if (a == 0) return;
+
+    int i = 0;
+
+#if CPUDRAW_PREMULTIPLIED
+#if CPUDRAW_NEON
+    // 预乘颜色按覆盖率整体缩放即为本像素的源
+    uint32_t src = premultiply(color);
+    uint8x16_t s = vreinterpretq_u8_u32(vdupq_n_u32(src));
+    uint8x16_t alphaIndex = vld1q_u8(kAlphaIndex);
+    uint8x16_t indexLo = vld1q_u8(kMaskIndexLo);
+    uint8x16_t indexHi = vld1q_u8(kMaskIndexHi);
+    for (; i + 8 <= count; i += 8)
+    {
+        uint8x8_t m = vld1_u8(mask + i);
+        if (vget_lane_u64(vreinterpret_u64_u8(m), 0) == 0) continue;
+
+        uint8x16_t mq = vcombine_u8(m, m);
+        uint8x16_t s0 = neon_scale(s, vqtbl1q_u8(mq, indexLo));
+        uint8x16_t s1 = neon_scale(s, vqtbl1q_u8(mq, indexHi));
+
+        uint8x16_t d0 = vreinterpretq_u8_u32(vld1q_u32(dst + i));
+        uint8x16_t d1 = vreinterpretq_u8_u32(vld1q_u32(dst + i + 4));
+        d0 = neon_blend_premul(s0, d0, vqtbl1q_u8(s0, alphaIndex));
+        d1 = neon_blend_premul(s1, d1, vqtbl1q_u8(s1, alphaIndex));
+        vst1q_u32(dst + i, vreinterpretq_u32_u8(d0));
+        vst1q_u32(dst + i + 4, vreinterpretq_u32_u8(d1));
+    }
+#endif
+
+    // 标量：src * m + dst * (255 - ma) 等价于把不透明颜色按 ma 插值到 dst
+    uint32_t opaque = color | 0xFF000000;
+    for (; i < count; i++)
+    {
+        uint32_t m = mask[i];
+        if (m == 0) continue;
+
+        uint32_t ma = (a == 255) ? m : div255(m * a);
+        if (ma == 255)
+        {
+            dst[i] = opaque;
+        }
+        else if (ma > 0)
+        {
+            dst[i] = lerp_pixel(dst[i], opaque, ma);
+        }
+    }
+#else
+
+#if CPUDRAW_NEON
+    uint8x16_t s = vreinterpretq_u8_u32(vdupq_n_u32(color));
+    uint8x8_t av = vdup_n_u8((uint8_t)a);
+    uint8x16_t indexLo = vld1q_u8(kMaskIndexLo);
+    uint8x16_t indexHi = vld1q_u8(kMaskIndexHi);
+    for (; i + 8 <= count; i += 8)
+    {
+        uint8x8_t m = vld1_u8(mask + i);
+        if (vget_lane_u64(vreinterpret_u64_u8(m), 0) == 0) continue;
+
+        // 覆盖率乘以颜色 alpha
+        uint16x8_t t = vmull_u8(m, av);
+        t = vrsraq_n_u16(t, t, 8);
+        uint8x8_t m8 = vrshrn_n_u16(t, 8);
+        uint8x16_t mq = vcombine_u8(m8, m8);
+
+        uint8x16_t d0 = vreinterpretq_u8_u32(vld1q_u32(dst + i));
+        uint8x16_t d1 = vreinterpretq_u8_u32(vld1q_u32(dst + i + 4));
+        d0 = neon_blend(s, d0, vqtbl1q_u8(mq, indexLo));
+        d1 = neon_blend(s, d1, vqtbl1q_u8(mq, indexHi));
+        vst1q_u32(dst + i, vreinterpretq_u32_u8(d0));
+        vst1q_u32(dst + i + 4, vreinterpretq_u32_u8(d1));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        uint32_t m = mask[i];
+        if (m == 0) continue;
+
+        uint32_t ma = (a == 255) ? m : div255(m * a);
+        if (ma == 255)
+        {
+            dst[i] = color | 0xFF000000;
+        }
+        else if (ma > 0)
+        {
+            dst[i] = blend_pixel_straight(dst[i], color, ma);
+        }
+    }
+#endif
+}
+
+void span_blend_premul(uint32_t *dst, const uint32_t *src, int count)
+{
+    int i = 0;
+
+#if CPUDRAW_NEON
+    uint8x16_t index = vld1q_u8(kAlphaIndex);
+    for (; i + 8 <= count; i += 8)
+    {
+        uint8x16_t s0 = vreinterpretq_u8_u32(vld1q_u32(src + i));
+        uint8x16_t s1 = vreinterpretq_u8_u32(vld1q_u32(src + i + 4));
+
+        // 整段透明时跳过（缓存里大部分是圆角外和阴影外的空白）
+        if ((vgetq_lane_u64(vreinterpretq_u64_u8(vorrq_u8(s0, s1)), 0) | vgetq_lane_u64(vreinterpretq_u64_u8(vorrq_u8(s0, s1)), 1)) == 0) continue;
+
+        uint8x16_t d0 = vreinterpretq_u8_u32(vld1q_u32(dst + i));
+        uint8x16_t d1 = vreinterpretq_u8_u32(vld1q_u32(dst + i + 4));
+        d0 = neon_blend_premul(s0, d0, vqtbl1q_u8(s0, index));
+        d1 = neon_blend_premul(s1, d1, vqtbl1q_u8(s1, index));
+        vst1q_u32(dst + i, vreinterpretq_u32_u8(d0));
+        vst1q_u32(dst + i + 4, vreinterpretq_u32_u8(d1));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        uint32_t c = src[i];
+        uint32_t a = c >> 24;
+        if (a == 255)
+        {
+            dst[i] = c;
+        }
+        else if (a > 0)
+        {
+            dst[i] = blend_pixel_premul(dst[i], c, 255 - a);
+        }
+    }
+}
+
+void span_modulate(uint32_t *dst, const uint32_t *src, int count, uint32_t color)
+{
+    int i = 0;
+
+#if CPUDRAW_NEON
+    uint8x16_t c = vreinterpretq_u8_u32(vdupq_n_u32(color));
+    for (; i + 4 <= count; i += 4)
+    {
+        vst1q_u32(dst + i, vreinterpretq_u32_u8(neon_scale(vreinterpretq_u8_u32(vld1q_u32(src + i)), c)));
+    }
+#endif
+
+    uint32_t c0 = color & 0xFF, c1 = (color >> 8) & 0xFF, c2 = (color >> 16) & 0xFF, c3 = color >> 24;
+    for (; i < count; i++)
+    {
+        uint32_t s = src[i];
+        dst[i] = div255((s & 0xFF) * c0) | (div255(((s >> 8) & 0xFF) * c1) << 8) | (div255(((s >> 16) & 0xFF) * c2) << 16) | (div255((s >> 24) * c3) << 24);
+    }
+}
+
+// 两像素按 8 位权重插值，两两通道合并计算：(a * (256 - f) + b * f + 128) / 256
+static inline uint32_t lerp_texel(uint32_t a, uint32_t b, uint32_t f)
+{
+    uint32_t w = 256 - f;
+    uint32_t rb = ((a & 0x00FF00FF) * w + (b & 0x00FF00FF) * f + 0x00800080) >> 8;
+    uint32_t ag = ((a >> 8) & 0x00FF00FF) * w + ((b >> 8) & 0x00FF00FF) * f + 0x00800080;
+    return (rb & 0x00FF00FF) | (ag & 0xFF00FF00);
+}
+
+void span_image_lerp_rows(uint32_t *dst, const uint32_t *row0, const uint32_t *row1, int count, int fy)
+{
+    if (fy == 0)
+    {
+        std::copy(row0, row0 + count, dst);
+        return;
+    }
+
+    int i = 0;
+
+#if CPUDRAW_NEON
+    // fy > 0 时 256 - fy 放得进 8 位
+    uint8x8_t w0 = vdup_n_u8((uint8_t)(256 - fy));
+    uint8x8_t w1 = vdup_n_u8((uint8_t)fy);
+    for (; i + 4 <= count; i += 4)
+    {
+        uint8x16_t r0 = vreinterpretq_u8_u32(vld1q_u32(row0 + i));
+        uint8x16_t r1 = vreinterpretq_u8_u32(vld1q_u32(row1 + i));
+        uint16x8_t lo = vmlal_u8(vmull_u8(vget_low_u8(r0), w0), vget_low_u8(r1), w1);
+        uint16x8_t hi = vmlal_u8(vmull_u8(vget_high_u8(r0), w0), vget_high_u8(r1), w1);
+        vst1q_u32(dst + i, vreinterpretq_u32_u8(vcombine_u8(vrshrn_n_u16(lo, 8), vrshrn_n_u16(hi, 8))));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        dst[i] = lerp_texel(row0[i], row1[i], (uint32_t)fy);
+    }
+}
+
+void span_image_sample_nearest(uint32_t *dst, const uint32_t *row, int width, int32_t u, int32_t du, int count)
+{
+    int last = width - 1;
+    for (int i = 0; i < count; i++, u += du)
+    {
+        int x = u >> 16;
+        dst[i] = row[x < 0 ? 0 : (x > last ? last : x)];
+    }
+}
+
+void span_image_sample_bilinear(uint32_t *dst, const uint32_t *row, int width, int32_t u, int32_t du, int count)
+{
+    // 与 span_sdf_sample 相同：两端超出范围的部分取边缘纹素，中间段不做判断
+    int last = width - 1;
+    int i = 0;
+    for (; i < count && u <= 0; i++, u += du)
+    {
+        dst[i] = row[0];
+    }
+
+    int end = count;
+    if (du > 0)
+    {
+        int64_t span = ((int64_t)last << 16) - u;
+        int64_t n = span > 0 ? (span + du - 1) / du : 0;
+        end = (int)std::min<int64_t>(count, i + n);
+    }
+
+    for (; i < end; i++, u += du)
+    {
+        int x = u >> 16;
+        dst[i] = lerp_texel(row[x], row[x + 1], ((uint32_t)u >> 8) & 0xFF);
+    }
+
+    for (; i < count; i++)
+    {
+        dst[i] = row[last];
+    }
+}
+
+// 4x4 Bayer 阈值（0..15）
+static const uint8_t kBayer4[4][4] = { { 0, 8, 2, 10 }, { 12, 4, 14, 6 }, { 3, 11, 1, 9 }, { 15, 7, 13, 5 } };
+
+void span_convert_rgb565(uint16_t *dst, const uint32_t *src, int count, int x, int y)
+{
+    // 5 位通道一级为 8，6 位为 4：截断前加上阈值比例的偏移
+    const uint8_t *bayer = kBayer4[y & 3];
+    uint8_t d5[8], d6[8];
+    for (int i = 0; i < 8; i++)
+    {
+        d5[i] = bayer[(x + i) & 3] >> 1;
+        d6[i] = bayer[(x + i) & 3] >> 2;
+    }
+
+    int i = 0;
+
+#if CPUDRAW_NEON
+    // 阈值每 4 像素重复，8 像素一组时每组相同
+    uint8x8_t dr = vld1_u8(d5);
+    uint8x8_t dg = vld1_u8(d6);
+    for (; i + 8 <= count; i += 8)
+    {
+        uint8x8x4_t p = vld4_u8(reinterpret_cast<const uint8_t *>(src + i));
+        uint16x8_t r = vshll_n_u8(vqadd_u8(p.val[0], dr), 8);
+        uint16x8_t g = vshll_n_u8(vqadd_u8(p.val[1], dg), 8);
+        uint16x8_t b = vshll_n_u8(vqadd_u8(p.val[2], dr), 8);
+        r = vsriq_n_u16(r, g, 5);
+        r = vsriq_n_u16(r, b, 11);
+        vst1q_u16(dst + i, r);
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        uint32_t c = src[i];
+        uint32_t r = std::min(255u, (c & 0xFF) + d5[i & 7]);
+        uint32_t g = std::min(255u, ((c >> 8) & 0xFF) + d6[i & 7]);
+        uint32_t b = std::min(255u, ((c >> 16) & 0xFF) + d5[i & 7]);
+        dst[i] = (uint16_t)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+    }
+}
+
+void span_sdf_lerp_rows(uint16_t *dst, const uint8_t *row0, const uint8_t *row1, int count, int fy)
+{
+    int i = 0;
+    int w0 = 128 - fy;
+
+#if CPUDRAW_NEON
+    uint8x8_t a0 = vdup_n_u8((uint8_t)w0);
+    uint8x8_t a1 = vdup_n_u8((uint8_t)fy);
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16_t r0 = vld1q_u8(row0 + i);
+        uint8x16_t r1 = vld1q_u8(row1 + i);
+        vst1q_u16(dst + i, vmlal_u8(vmull_u8(vget_low_u8(r0), a0), vget_low_u8(r1), a1));
+        vst1q_u16(dst + i + 8, vmlal_u8(vmull_u8(vget_high_u8(r0), a0), vget_high_u8(r1), a1));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        dst[i] = (uint16_t)(row0[i] * w0 + row1[i] * fy);
+    }
+}
+
+void span_sdf_sample(uint16_t *dst, const uint16_t *row, int width, int32_t u, int32_t du, int count)
+{
+    // 纹素随机访问，逐像素定点步进；两端超出范围的部分取边缘纹素，中间段不做判断
+    int last = width - 1;
+    int i = 0;
+    for (; i < count && u <= 0; i++, u += du)
+    {
+        dst[i] = row[0];
+    }
+
+    int end = count;
+    if (du > 0)
+    {
+        // (u + k * du) >> 16 < last 的像素数
+        int64_t span = ((int64_t)last << 16) - u;
+        int64_t n = span > 0 ? (span + du - 1) / du : 0;
+        end = (int)std::min<int64_t>(count, i + n);
+    }
+
+    for (; i < end; i++, u += du)
+    {
+        int x = u >> 16;
+        uint32_t fx = ((uint32_t)u >> 9) & 127;
+        dst[i] = (uint16_t)((row[x] * (128 - fx) + row[x + 1] * fx) >> 7);
+    }
+
+    for (; i < count; i++)
+    {
+        dst[i] = row[last];
+    }
+}
+
+void span_sdf_coverage(uint8_t *mask, const uint16_t *dist, int count, int edge, int gain)
+{
+    int i = 0;
+    const int32_t bias = (127 << 12) + 2048;
+
+#if CPUDRAW_NEON
+    int32x4_t e = vdupq_n_s32(edge);
+    int32x4_t b = vdupq_n_s32(bias);
+    for (; i + 8 <= count; i += 8)
+    {
+        uint16x8_t d = vld1q_u16(dist + i);
+        int32x4_t lo = vsubq_s32(vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(d))), e);
+        int32x4_t hi = vsubq_s32(vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(d))), e);
+        lo = vmlaq_n_s32(b, lo, gain);
+        hi = vmlaq_n_s32(b, hi, gain);
+        // 负数饱和为 0，超过 255 饱和为 255
+        vst1_u8(mask + i, vqmovn_u16(vcombine_u16(vqshrun_n_s32(lo, 12), vqshrun_n_s32(hi, 12))));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        int32_t v = ((int32_t)dist[i] - edge) * gain + bias;
+        mask[i] = v <= 0 ? 0 : (v >= (255 << 12) ? 255 : (uint8_t)(v >> 12));
+    }
+}
+
+} // namespace Graphics
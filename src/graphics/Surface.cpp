@@ -0,0 +1,86 @@
+/*
+ * CPU-Draw - Surface Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 离屏像素缓冲
+ * 缓存静态内容，之后每帧只需一次贴图
+ *
+ * 特性：
+ * - 像素为预乘 alpha（透明区域为 0）
+ * - 版本号随内容更新递增，用于帧签名
+ * - 黑白两次绘制提取 alpha（直通 alpha 管线也能得到正确的半透明缓存）
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "graphics/Surface.h"
+#include "graphics/SpanKernels.h"
+#include <algorithm>
+
+namespace Graphics
+{
+
+Surface::Surface() : width(0), height(0), version(0)
+{
+}
+
+bool Surface::Resize(int w, int h)
+{
+    w = std::max(0, w);
+    h = std::max(0, h);
+    if (w == width && h == height) return false;
+
+    width = w;
+    height = h;
+    pixels.assign((size_t)w * h, 0);
+    version++;
+    return true;
+}
+
+void Surface::ResolveBlackWhite(const uint32_t *on_black, const uint32_t *on_white)
+{
+    // 黑底结果 B = C * a，白底结果 W = C * a + 255 * (1 - a)
+    // 所以 a = 255 - (W - B)，B 本身就是预乘颜色
+    size_t count = (size_t)width * height;
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t b = on_black[i];
+        uint32_t w = on_white[i];
+
+        int dr = (int)(w & 0xFF) - (int)(b & 0xFF);
+        int dg = (int)((w >> 8) & 0xFF) - (int)((b >> 8) & 0xFF);
+        int db = (int)((w >> 16) & 0xFF) - (int)((b >> 16) & 0xFF);
+        int a = 255 - (std::max(0, dr + dg + db) + 1) / 3;
+
+        if (a <= 0)
+        {
+            pixels[i] = 0;
+            continue;
+        }
+
+        // 两次舍入可能让分量略大于 alpha
+        uint32_t r = std::min<uint32_t>(b & 0xFF, a);
+        uint32_t g = std::min<uint32_t>((b >> 8) & 0xFF, a);
+        uint32_t bl = std::min<uint32_t>((b >> 16) & 0xFF, a);
+        pixels[i] = r | (g << 8) | (bl << 16) | ((uint32_t)a << 24);
+    }
+}
+
+void draw_surface(uint32_t *pixels, int stride, int width, int height, const Surface &surface, int x, int y, const IntRect *clip)
+{
+    IntRect cr = { 0, 0, width - 1, height - 1 };
+    if (clip) cr = cr.Intersect(*clip);
+
+    IntRect r = IntRect{ x, y, x + surface.GetWidth() - 1, y + surface.GetHeight() - 1 }.Intersect(cr);
+    if (r.IsEmpty()) return;
+
+    const uint32_t *src = surface.GetPixels();
+    int srcStride = surface.GetStride();
+    for (int py = r.y0; py <= r.y1; py++)
+    {
+        span_blend_premul(pixels + py * stride + r.x0, src + (py - y) * srcStride + (r.x0 - x), r.Width());
+    }
+}
+
+} // namespace Graphics
@@ -0,0 +1,339 @@
+/*
+ * CPU-Draw - Texture Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 纹理载入、mipmap 与贴图
+ * 缩放映射为 16.16 定点：目标像素中心反算到纹素坐标，起点由目标矩形左上角推算，
+ * 分块回放时各块的采样位置与整屏一致
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "graphics/Texture.h"
+#include "graphics/SpanKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Graphics
+{
+
+// 纹理尺寸上限（每边）
+static const int TEXTURE_MAX_SIZE = 8192;
+
+static inline IntRect clip_bounds(int width, int height, const IntRect *clip)
+{
+    IntRect r = { 0, 0, width - 1, height - 1 };
+    return clip ? r.Intersect(*clip) : r;
+}
+
+// 横向采样的临时行（每个光栅化线程一份）
+static std::vector<uint32_t> &local_rows()
+{
+    thread_local std::vector<uint32_t> rows;
+    return rows;
+}
+
+Texture::Texture() : version(0)
+{
+}
+
+bool Texture::Allocate(int width, int height)
+{
+    if (width <= 0 || height <= 0 || width > TEXTURE_MAX_SIZE || height > TEXTURE_MAX_SIZE) return false;
+
+    levels.clear();
+    levels.push_back(Level{ width, height, 0 });
+    pixels.resize((size_t)width * height);
+    version++;
+    return true;
+}
+
+bool Texture::Load(const uint8_t *rgba, int width, int height, int stride, bool mipmaps)
+{
+    if (!rgba || !Allocate(width, height)) return false;
+    if (stride <= 0) stride = width * 4;
+
+    // 字节序 R, G, B, A 与 rgba() 的打包一致，逐行拷贝后预乘
+    for (int y = 0; y < height; y++)
+    {
+        uint32_t *dst = pixels.data() + (size_t)y * width;
+        memcpy(dst, rgba + (size_t)y * stride, (size_t)width * 4);
+        for (int x = 0; x < width; x++)
+        {
+            dst[x] = premultiply(dst[x]);
+        }
+    }
+
+    if (mipmaps) GenerateMipmaps();
+    return true;
+}
+
+bool Texture::LoadPremultiplied(const uint32_t *src, int width, int height, int stride, bool mipmaps)
+{
+    if (!src || !Allocate(width, height)) return false;
+    if (stride <= 0) stride = width;
+
+    for (int y = 0; y < height; y++)
+    {
+        memcpy(pixels.data() + (size_t)y * width, src + (size_t)y * stride, (size_t)width * sizeof(uint32_t));
+    }
+
+    if (mipmaps) GenerateMipmaps();
+    return true;
+}
+
+// 四个预乘像素的平均（四舍五入），两两通道合并
+static inline uint32_t average4(uint32_t a, uint32_t b, uint32_t c, uint32_t d)
+{
+    uint32_t rb = (a & 0x00FF00FF) + (b & 0x00FF00FF) + (c & 0x00FF00FF) + (d & 0x00FF00FF) + 0x00020002;
+    uint32_t ag = ((a >> 8) & 0x00FF00FF) + ((b >> 8) & 0x00FF00FF) + ((c >> 8) & 0x00FF00FF) + ((d >> 8) & 0x00FF00FF) + 0x00020002;
+    return ((rb >> 2) & 0x00FF00FF) | ((ag << 6) & 0xFF00FF00);
+}
+
+void Texture::GenerateMipmaps()
+{
+    if (levels.empty()) return;
+    levels.resize(1);
+
+    // 先算出各层大小，一次分配
+    size_t total = (size_t)levels[0].width * levels[0].height;
+    int w = levels[0].width, h = levels[0].height;
+    while (w > 1 || h > 1)
+    {
+        w = std::max(1, w / 2);
+        h = std::max(1, h / 2);
+        levels.push_back(Level{ w, h, total });
+        total += (size_t)w * h;
+    }
+    pixels.resize(total);
+
+    for (size_t l = 1; l < levels.size(); l++)
+    {
+        const Level &src = levels[l - 1];
+        const Level &dst = levels[l];
+        const uint32_t *sp = pixels.data() + src.offset;
+        uint32_t *dp = pixels.data() + dst.offset;
+
+        // 奇数边长时最后一行 / 列重复使用
+        for (int y = 0; y < dst.height; y++)
+        {
+            const uint32_t *r0 = sp + (size_t)std::min(y * 2, src.height - 1) * src.width;
+            const uint32_t *r1 = sp + (size_t)std::min(y * 2 + 1, src.height - 1) * src.width;
+            for (int x = 0; x < dst.width; x++)
+            {
+                int x0 = std::min(x * 2, src.width - 1);
+                int x1 = std::min(x * 2 + 1, src.width - 1);
+                dp[(size_t)y * dst.width + x] = average4(r0[x0], r0[x1], r1[x0], r1[x1]);
+            }
+        }
+    }
+    version++;
+}
+
+int Texture::SelectLevel(float src_w, float src_h, int dst_w, int dst_h) const
+{
+    if (levels.size() <= 1 || dst_w <= 0 || dst_h <= 0) return 0;
+
+    // 取缩小较少的方向，下降到比例落在 [1, 2) 的那一层
+    float ratio = std::min(src_w / dst_w, src_h / dst_h);
+    int level = 0;
+    while (ratio >= 2.0f && level + 1 < (int)levels.size())
+    {
+        ratio *= 0.5f;
+        level++;
+    }
+    return level;
+}
+
+const Texture *TextureCache::Load(const std::string &name, const uint8_t *rgba, int width, int height, int stride, bool mipmaps)
+{
+    std::unique_ptr<Texture> &slot = textures[name];
+    if (!slot) slot.reset(new Texture());
+    if (!slot->Load(rgba, width, height, stride, mipmaps))
+    {
+        textures.erase(name);
+        return nullptr;
+    }
+    return slot.get();
+}
+
+const Texture *TextureCache::Find(const std::string &name) const
+{
+    auto it = textures.find(name);
+    return it == textures.end() ? nullptr : it->second.get();
+}
+
+void TextureCache::Remove(const std::string &name)
+{
+    textures.erase(name);
+}
+
+void TextureCache::Clear()
+{
+    textures.clear();
+}
+
+size_t TextureCache::GetMemoryUsage() const
+{
+    size_t total = 0;
+    for (const auto &it : textures)
+    {
+        total += it.second->GetMemoryUsage();
+    }
+    return total;
+}
+
+// 1:1 贴图：纹理中 (sx, sy) 起的 w x h 区域贴到 (x, y)
+static void blit_texture(uint32_t *pixels, int stride, const IntRect &cr, const Texture &texture, int sx, int sy, int w, int h, int x, int y, uint32_t tint)
+{
+    IntRect r = IntRect{ x, y, x + w - 1, y + h - 1 }.Intersect(cr);
+    if (r.IsEmpty()) return;
+
+    int srcStride = texture.GetWidth();
+    const uint32_t *src = texture.GetPixels() + (size_t)sy * srcStride + sx;
+    int n = r.Width();
+
+    // 不着色时直接整行混合
+    if (tint == 0xFFFFFFFF)
+    {
+        for (int py = r.y0; py <= r.y1; py++)
+        {
+            span_blend_premul(pixels + (size_t)py * stride + r.x0, src + (size_t)(py - y) * srcStride + (r.x0 - x), n);
+        }
+        return;
+    }
+
+    uint32_t color = premultiply(tint);
+    if ((color >> 24) == 0) return;
+
+    uint32_t row[256];
+    for (int py = r.y0; py <= r.y1; py++)
+    {
+        const uint32_t *sp = src + (size_t)(py - y) * srcStride + (r.x0 - x);
+        uint32_t *dst = pixels + (size_t)py * stride + r.x0;
+        for (int i = 0; i < n; i += 256)
+        {
+            int count = std::min(256, n - i);
+            span_modulate(row, sp + i, count, color);
+            span_blend_premul(dst + i, row, count);
+        }
+    }
+}
+
+void draw_texture(uint32_t *pixels, int stride, int width, int height, const Texture &texture, int x, int y, uint32_t tint, const IntRect *clip)
+{
+    if (texture.IsEmpty()) return;
+    blit_texture(pixels, stride, clip_bounds(width, height, clip), texture, 0, 0, texture.GetWidth(), texture.GetHeight(), x, y, tint);
+}
+
+void draw_texture_scaled(uint32_t *pixels, int stride, int width, int height, const Texture &texture, int x0, int y0, int x1, int y1, const IntRect *source, TextureFilter filter, uint32_t tint, const IntRect *clip)
+{
+    if (texture.IsEmpty()) return;
+    if (x0 > x1) std::swap(x0, x1);
+    if (y0 > y1) std::swap(y0, y1);
+
+    IntRect src = { 0, 0, texture.GetWidth() - 1, texture.GetHeight() - 1 };
+    if (source) src = src.Intersect(*source);
+    if (src.IsEmpty()) return;
+
+    int dstW = x1 - x0 + 1, dstH = y1 - y0 + 1;
+
+    // 1:1（含图集子图）直接整行混合
+    if (src.Width() == dstW && src.Height() == dstH)
+    {
+        blit_texture(pixels, stride, clip_bounds(width, height, clip), texture, src.x0, src.y0, dstW, dstH, x0, y0, tint);
+        return;
+    }
+
+    IntRect r = IntRect{ x0, y0, x1, y1 }.Intersect(clip_bounds(width, height, clip));
+    if (r.IsEmpty()) return;
+
+    uint32_t color = premultiply(tint);
+    if ((color >> 24) == 0) return;
+    bool tinted = tint != 0xFFFFFFFF;
+
+    // 选 mip 层，源区域换算到该层的纹素坐标
+    int level = texture.SelectLevel((float)src.Width(), (float)src.Height(), dstW, dstH);
+    int lw = texture.GetLevelWidth(level), lh = texture.GetLevelHeight(level);
+    const uint32_t *lp = texture.GetLevelPixels(level);
+    double sx = (double)lw / texture.GetWidth(), sy = (double)lh / texture.GetHeight();
+    double srcX = src.x0 * sx, srcY = src.y0 * sy;
+    double stepX = src.Width() * sx / dstW, stepY = src.Height() * sy / dstH;
+
+    // 目标像素中心对应的纹素坐标，双线性再减半个纹素（采样点在纹素中心之间）
+    bool bilinear = filter == TextureFilter::Bilinear;
+    double bias = bilinear ? 0.5 : 0.0;
+    int32_t du = (int32_t)std::llround(stepX * 65536.0);
+    int32_t dv = (int32_t)std::llround(stepY * 65536.0);
+    int32_t u0 = (int32_t)std::llround((srcX + 0.5 * stepX - bias) * 65536.0) + (r.x0 - x0) * du;
+    int32_t v0 = (int32_t)std::llround((srcY + 0.5 * stepY - bias) * 65536.0);
+    int n = r.Width();
+
+    // 纵向插值结果（只做本块用到的纹理列）
+    std::vector<uint32_t> &rows = local_rows();
+    uint32_t out[256];
+
+    for (int py = r.y0; py <= r.y1; py++)
+    {
+        int32_t v = v0 + (py - y0) * dv;
+        uint32_t *dst = pixels + (size_t)py * stride + r.x0;
+        int32_t u = u0;
+
+        const uint32_t *row0, *row1 = nullptr;
+        int fy = 0;
+        if (bilinear)
+        {
+            int ty = v >> 16;
+            fy = ((uint32_t)v >> 8) & 0xFF;
+            if (ty < 0)
+            {
+                ty = 0;
+                fy = 0;
+            }
+            else if (ty >= lh - 1)
+            {
+                ty = lh - 1;
+                fy = 0;
+            }
+            row0 = lp + (size_t)ty * lw;
+            row1 = row0 + (fy ? lw : 0);
+        }
+        else
+        {
+            int ty = std::min(lh - 1, std::max(0, v >> 16));
+            row0 = lp + (size_t)ty * lw;
+        }
+
+        for (int i = 0; i < n; i += 256)
+        {
+            int count = std::min(256, n - i);
+
+            if (!bilinear)
+            {
+                span_image_sample_nearest(out, row0, lw, u, du, count);
+            }
+            else if (fy == 0)
+            {
+                span_image_sample_bilinear(out, row0, lw, u, du, count);
+            }
+            else
+            {
+                // 本块用到的纹理列 [c0, c1]
+                int c0 = std::min(lw - 1, std::max(0, u >> 16));
+                int c1 = std::min(lw - 1, std::max(0, (int)(((int64_t)u + (int64_t)(count - 1) * du) >> 16) + 1));
+                int cols = c1 - c0 + 1;
+                if ((int)rows.size() < cols) rows.resize(cols);
+                span_image_lerp_rows(rows.data(), row0 + c0, row1 + c0, cols, fy);
+                span_image_sample_bilinear(out, rows.data(), cols, u - (c0 << 16), du, count);
+            }
+
+            if (tinted) span_modulate(out, out, count, color);
+            span_blend_premul(dst + i, out, count);
+            u += count * du;
+        }
+    }
+}
+
+} // namespace Graphics
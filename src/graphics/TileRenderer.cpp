@@ -0,0 +1,218 @@
+/*
+ * CPU-Draw - Tile Renderer Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 分块多线程光栅化
+ * 回放 CommandBuffer，按 64x64 分块并行绘制
+ *
+ * 特性：
+ * - 命令按范围分箱到分块
+ * - 固定线程池，原子计数领取分块
+ * - 每个分块以自身为裁剪区，只写自己的像素，帧缓冲无需加锁
+ * - 并行前预热字形缓存（缓存只允许单线程写）
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "graphics/TileRenderer.h"
+#include "graphics/EntityBatch.h"
+#include "text/GlyphCache.h"
+#include "text/SdfText.h"
+#include "text/TextLayout.h"
+#include "text/TextRenderer.h"
+#include <algorithm>
+
+namespace Graphics
+{
+
+TileRenderer::TileRenderer(int thread_count)
+    : tilesX(0), tilesY(0), job(nullptr), jobPixels(nullptr), jobStride(0), jobWidth(0), jobHeight(0), nextTile(0), jobId(0), pending(0), quit(false)
+{
+    if (thread_count <= 0)
+    {
+        thread_count = (int)std::thread::hardware_concurrency();
+    }
+    thread_count = std::max(1, thread_count);
+
+    // 调用线程也参与光栅化
+    scratches.resize(thread_count);
+    for (int i = 1; i < thread_count; i++)
+    {
+        workers.emplace_back(&TileRenderer::WorkerLoop, this, i);
+    }
+}
+
+TileRenderer::~TileRenderer()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    startCond.notify_all();
+
+    for (auto &t : workers)
+    {
+        t.join();
+    }
+}
+
+void TileRenderer::Render(CommandBuffer &commands, uint32_t *pixels, int stride, int width, int height)
+{
+    commands.Prepare(width, height);
+    const std::vector<DrawCommand> &prepared = commands.GetPrepared();
+
+    // 命令太少或字形缓存不稳定时单线程回放
+    if (workers.empty() || (int)prepared.size() < PARALLEL_MIN_COMMANDS || !PrewarmText(commands))
+    {
+        for (const DrawCommand &cmd : prepared)
+        {
+            commands.Execute(cmd, pixels, stride, width, height, nullptr, scratches[0]);
+        }
+        return;
+    }
+
+    Bin(commands, width, height);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &commands;
+        jobPixels = pixels;
+        jobStride = stride;
+        jobWidth = width;
+        jobHeight = height;
+        nextTile.store(0, std::memory_order_relaxed);
+        pending = (int)workers.size();
+        jobId++;
+    }
+    startCond.notify_all();
+
+    RunTiles(scratches[0]);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCond.wait(lock, [this] { return pending == 0; });
+    job = nullptr;
+}
+
+void TileRenderer::Bin(const CommandBuffer &commands, int width, int height)
+{
+    tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+
+    // 保留每个分箱的容量，避免每帧分配
+    size_t count = (size_t)tilesX * tilesY;
+    if (bins.size() < count) bins.resize(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        bins[i].clear();
+    }
+
+    // 范围先限制在屏幕内：录制的命令已裁剪，外部命令（Attach）不一定
+    const IntRect screen = { 0, 0, width - 1, height - 1 };
+    const std::vector<DrawCommand> &prepared = commands.GetPrepared();
+    for (size_t i = 0; i < prepared.size(); i++)
+    {
+        IntRect b = prepared[i].bounds.Intersect(screen);
+        if (b.IsEmpty()) continue;
+
+        int tx0 = std::max(0, std::min(b.x0 / TILE_SIZE, tilesX - 1));
+        int ty0 = std::max(0, std::min(b.y0 / TILE_SIZE, tilesY - 1));
+        int tx1 = std::max(0, std::min(b.x1 / TILE_SIZE, tilesX - 1));
+        int ty1 = std::max(0, std::min(b.y1 / TILE_SIZE, tilesY - 1));
+
+        for (int ty = ty0; ty <= ty1; ty++)
+        {
+            for (int tx = tx0; tx <= tx1; tx++)
+            {
+                bins[ty * tilesX + tx].push_back((uint32_t)i);
+            }
+        }
+    }
+}
+
+bool TileRenderer::PrewarmText(const CommandBuffer &commands)
+{
+    // 并行阶段只读缓存：先把所有字形光栅化进图集、排版放进当前代
+    // 预热过程中图集被清空（一帧的字形装不下）或排版缓存换代，退回单线程
+    Text::GlyphCache &cache = Text::GlyphCache::Instance();
+    Text::TextLayoutCache &layouts = Text::TextLayoutCache::Instance();
+    uint32_t generation = cache.GetGeneration();
+    uint32_t layoutGeneration = layouts.GetGeneration();
+    RasterScratch &scratch = scratches[0];
+
+    for (const DrawCommand &cmd : commands.GetPrepared())
+    {
+        if (cmd.op == DrawOp::EntityBatch)
+        {
+            prewarm_entity_batch(commands.GetData() + cmd.args[0].u);
+            continue;
+        }
+        if (cmd.op != DrawOp::Text && cmd.op != DrawOp::TextSdf) continue;
+
+        scratch.text.assign(reinterpret_cast<const char *>(commands.GetData() + cmd.args[2].u), cmd.args[3].u);
+        if (cmd.op == DrawOp::Text)
+        {
+            Text::CalcTextBounds(0, 0, scratch.text, cmd.args[4].i);
+        }
+        else
+        {
+            Text::CalcTextSizeSdf(scratch.text, cmd.args[4].f);
+        }
+    }
+
+    return cache.GetGeneration() == generation && layouts.GetGeneration() == layoutGeneration;
+}
+
+void TileRenderer::RunTiles(RasterScratch &scratch)
+{
+    int count = tilesX * tilesY;
+    while (true)
+    {
+        int tile = nextTile.fetch_add(1, std::memory_order_relaxed);
+        if (tile >= count) break;
+        RenderTile(tile, scratch);
+    }
+}
+
+void TileRenderer::RenderTile(int tile, RasterScratch &scratch)
+{
+    const std::vector<uint32_t> &bin = bins[tile];
+    if (bin.empty()) return;
+
+    int ox = (tile % tilesX) * TILE_SIZE;
+    int oy = (tile / tilesX) * TILE_SIZE;
+    IntRect rect = { ox, oy, std::min(ox + TILE_SIZE, jobWidth) - 1, std::min(oy + TILE_SIZE, jobHeight) - 1 };
+
+    // 以分块为裁剪区，坐标不变，结果与整屏回放逐像素一致
+    const std::vector<DrawCommand> &prepared = job->GetPrepared();
+    for (uint32_t index : bin)
+    {
+        job->Execute(prepared[index], jobPixels, jobStride, jobWidth, jobHeight, &rect, scratch);
+    }
+}
+
+void TileRenderer::WorkerLoop(int index)
+{
+    uint64_t seen = 0;
+    RasterScratch &scratch = scratches[index];
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            startCond.wait(lock, [this, seen] { return quit || jobId != seen; });
+            if (quit) return;
+            seen = jobId;
+        }
+
+        RunTiles(scratch);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending--;
+        }
+        doneCond.notify_one();
+    }
+}
+
+} // namespace Graphics
@@ -10,24 +10,34 @@
  * - 最多 10 点触摸
  * - 手势识别
  * - 屏幕旋转适配
+ * - 单个 epoll 读取线程监听全部设备，eventfd 通知退出
+ * - 同一次唤醒内的多次上报合并为最新状态，按下/抬起不合并
+ * - 读取线程经无锁队列投递快照，回调只在渲染线程执行
  * 
  * 仅供学习和研究使用
  */
 
 #include "input/TouchHelper.h"
+#include "core/SpscRing.h"
 #include "core/Utils.h"
 #include "core/spinlock.h"
+#include <atomic>
+#include <cerrno>
 #include <cmath>
 #include <cstring>
 #include <dirent.h>
 #include <fcntl.h>
 #include <linux/uinput.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/time.h>
 #include <thread>
 #include <unistd.h>
 
 #define MAX_EVENTS 5
 #define MAX_FINGERS 10
+#define SNAPSHOT_QUEUE_SIZE 128
+#define WAKE_TOKEN 0xFFFFFFFFu
 #define UNGRAB 0
 #define GRAB 1
 
@@ -43,17 +53,43 @@ static struct
 
 static My_Vector2 g_touchScale;
 static My_Vector2 g_screenSize;
-static std::vector<TouchDevice> g_devices;
+// 触摸快照（一次或多次合并的 SYN_REPORT 后的完整状态）
+struct TouchSnapshot
+{
+    long long timestamp; // 事件时间（微秒）
+    int device;          // 设备索引
+    TouchPoint fingers[MAX_FINGERS];
+};
+
+// 读取线程中每个设备的解析状态
+struct TouchReader
+{
+    int fd;
+    float scaleX, scaleY;
+    int currentSlot;
+    bool pending;     // 有已上报但未投递的状态
+    bool transition;  // 本次上报中有按下/抬起
+    TouchSnapshot state;
+};
+
+static std::vector<TouchDevice> g_devices;       // 渲染线程视图
+static std::vector<TouchDevice> g_uploadDevices; // 转发视图，受 g_lock 保护
+static std::vector<TouchReader> g_readers;       // 仅读取线程访问
+static SpscRing<TouchSnapshot, SNAPSHOT_QUEUE_SIZE> g_snapshots;
+static std::thread g_readThread;
+static int g_epollFd = -1;
+static int g_wakeFd = -1;
 static int g_outputFd = -1;
 static int g_orientation = 0;
-static bool g_initialized = false;
+static std::atomic<bool> g_initialized(false);
 static bool g_readOnly = false;
 static bool g_gestureEnabled = false;
 
 static TouchCallback g_touchCallback;
 static GestureCallback g_gestureCallback;
+static EventNotifyCallback g_eventNotify;
 static GestureConfig g_gestureConfig;
-static spinlock g_lock;
+static spinlock g_lock; // 只保护 uinput 转发与注入
 
 // 手势识别状态
 static struct
@@ -109,12 +145,11 @@ static bool CheckDeviceIsTouch(int fd)
 }
 
 // 识别手势
-static void RecognizeGesture(const TouchDevice &device)
+static void RecognizeGesture(const TouchDevice &device, long long currentTime)
 {
     if (!g_gestureEnabled || !g_gestureCallback) return;
 
     GestureData gesture;
-    long long currentTime = GetCurrentTimeMs();
     int activeCount = 0;
     My_Vector2 avgPos;
 
@@ -217,130 +252,251 @@ static void RecognizeGesture(const TouchDevice &device)
     }
 }
 
-// 触摸事件读取线程
-static void *TouchReadThread(void *arg)
+// 写出触摸事件到虚拟设备
+static void WriteTouchEvents(const std::vector<TouchDevice> &devices)
 {
-    int deviceIndex = (int)(long)arg;
-    TouchDevice &device = g_devices[deviceIndex];
+    static bool isFirstDown = true;
+    int eventCount = 0;
+    int fingerCount = 0;
 
-    int currentSlot = 0;
-    input_event events[64]{ 0 };
+    for (auto &device : devices)
+    {
+        for (auto &finger : device.fingers)
+        {
+            if (finger.isDown)
+            {
+                if (fingerCount++ > 20) goto finish;
 
-    static long long lastCallbackTime = 0;
-    const int MIN_CALLBACK_INTERVAL = 4; // 最多60fps
+                g_input.event[eventCount++] = { .type = EV_ABS, .code = ABS_X, .value = (int)finger.pos.x };
+                g_input.event[eventCount++] = { .type = EV_ABS, .code = ABS_Y, .value = (int)finger.pos.y };
+                g_input.event[eventCount++] = { .type = EV_ABS, .code = ABS_MT_POSITION_X, .value = (int)finger.pos.x };
+                g_input.event[eventCount++] = { .type = EV_ABS, .code = ABS_MT_POSITION_Y, .value = (int)finger.pos.y };
+                g_input.event[eventCount++] = { .type = EV_ABS, .code = ABS_MT_TRACKING_ID, .value = finger.id };
+                g_input.event[eventCount++] = { .type = EV_SYN, .code = SYN_MT_REPORT, .value = 0 };
+            }
+        }
+    }
 
-    while (g_initialized)
+finish:
+    bool hasTouch = false;
+    if (eventCount == 0)
     {
-        ssize_t readSize = read(device.fd, events, sizeof(events));
-        if (readSize <= 0 || (readSize % sizeof(input_event)) != 0)
+        g_input.event[eventCount++] = { .type = EV_SYN, .code = SYN_MT_REPORT, .value = 0 };
+        if (!isFirstDown)
         {
-            continue;
+            isFirstDown = true;
+            g_input.event[eventCount++] = { .type = EV_KEY, .code = BTN_TOUCH, .value = 0 };
+            g_input.event[eventCount++] = { .type = EV_KEY, .code = BTN_TOOL_FINGER, .value = 0 };
         }
+    }
+    else
+    {
+        hasTouch = true;
+    }
 
-        size_t count = readSize / sizeof(input_event);
+    g_input.event[eventCount++] = { .type = EV_SYN, .code = SYN_REPORT, .value = 0 };
 
-        g_lock.lock();
+    if (hasTouch && isFirstDown)
+    {
+        isFirstDown = false;
+        write(g_outputFd, &g_input, sizeof(input_event) * (eventCount + 2));
+    }
+    else
+    {
+        write(g_outputFd, g_input.event, sizeof(input_event) * eventCount);
+    }
+}
 
-        for (size_t i = 0; i < count; i++)
-        {
-            input_event &ie = events[i];
+// 按下状态位掩码
+static uint32_t GetDownMask(const TouchPoint *fingers)
+{
+    uint32_t mask = 0;
+    for (int i = 0; i < MAX_FINGERS; i++)
+    {
+        if (fingers[i].isDown) mask |= 1u << i;
+    }
+    return mask;
+}
+
+// 投递设备的待发状态
+static void FlushReader(TouchReader &reader)
+{
+    if (!reader.pending) return;
+    reader.pending = false;
 
-            if (ie.type == EV_ABS)
+    // 计算速度
+    for (int j = 0; j < MAX_FINGERS; j++)
+    {
+        TouchPoint &finger = reader.state.fingers[j];
+        if (finger.isDown)
+        {
+            long long dt = GetCurrentTimeMs() - finger.timestamp;
+            if (dt > 0)
             {
-                if (ie.code == ABS_MT_SLOT)
-                {
-                    currentSlot = ie.value;
-                    if (currentSlot < 0 || currentSlot >= MAX_FINGERS)
-                    {
-                        currentSlot = 0;
-                    }
-                    continue;
-                }
+                // 简单的速度估算
+                finger.velocity = finger.pos - finger.startPos;
+            }
+        }
+    }
 
-                if (ie.code == ABS_MT_TRACKING_ID)
-                {
-                    TouchPoint &finger = device.fingers[currentSlot];
-                    if (ie.value == -1)
-                    {
-                        finger.isDown = false;
-                    }
-                    else
-                    {
-                        finger.id = (deviceIndex * 2 + 1) * MAX_FINGERS + currentSlot;
-                        finger.isDown = true;
-                        finger.startPos = finger.pos;
-                        finger.timestamp = GetCurrentTimeMs();
-                    }
-                    continue;
-                }
+    // 队列满时丢弃本次快照，快照是完整状态，下一次会带上最新位置
+    g_snapshots.Push(reader.state);
 
-                if (ie.code == ABS_MT_POSITION_X)
-                {
-                    device.fingers[currentSlot].pos.x = (float)ie.value * device.scaleX;
-                    continue;
-                }
+    // 无回调的非只读模式：直接转发到虚拟设备
+    if (!g_readOnly && !g_touchCallback)
+    {
+        g_lock.lock();
+        if (reader.state.device < (int)g_uploadDevices.size())
+        {
+            std::copy(reader.state.fingers, reader.state.fingers + MAX_FINGERS, g_uploadDevices[reader.state.device].fingers);
+            WriteTouchEvents(g_uploadDevices);
+        }
+        g_lock.unlock();
+    }
+}
 
-                if (ie.code == ABS_MT_POSITION_Y)
-                {
-                    device.fingers[currentSlot].pos.y = (float)ie.value * device.scaleY;
-                    continue;
-                }
+// 解析一个输入事件
+static void ProcessEvent(TouchReader &reader, const input_event &ie)
+{
+    TouchSnapshot &state = reader.state;
 
-                if (ie.code == ABS_MT_PRESSURE)
-                {
-                    device.fingers[currentSlot].pressure = (float)ie.value / 255.0f;
-                    continue;
-                }
+    if (ie.type == EV_ABS)
+    {
+        if (ie.code == ABS_MT_SLOT)
+        {
+            reader.currentSlot = ie.value;
+            if (reader.currentSlot < 0 || reader.currentSlot >= MAX_FINGERS)
+            {
+                reader.currentSlot = 0;
             }
+            return;
+        }
+
+        if (ie.code == ABS_MT_TRACKING_ID)
+        {
+            // 按下/抬起不与之前的移动合并，先投递之前的状态
+            FlushReader(reader);
+            reader.transition = true;
 
-            if (ie.type == EV_SYN && ie.code == SYN_REPORT)
+            TouchPoint &finger = state.fingers[reader.currentSlot];
+            if (ie.value == -1)
             {
-                // 计算速度
-                for (int j = 0; j < MAX_FINGERS; j++)
-                {
-                    TouchPoint &finger = device.fingers[j];
-                    if (finger.isDown)
-                    {
-                        long long dt = GetCurrentTimeMs() - finger.timestamp;
-                        if (dt > 0)
-                        {
-                            // 简单的速度估算
-                            finger.velocity = finger.pos - finger.startPos;
-                        }
-                    }
-                }
+                finger.isDown = false;
+            }
+            else
+            {
+                finger.id = (state.device * 2 + 1) * MAX_FINGERS + reader.currentSlot;
+                finger.isDown = true;
+                finger.startPos = finger.pos;
+                finger.timestamp = GetCurrentTimeMs();
+            }
+            return;
+        }
 
-                // 手势识别
-                if (g_gestureEnabled)
-                {
-                    RecognizeGesture(device);
-                }
+        if (ie.code == ABS_MT_POSITION_X)
+        {
+            state.fingers[reader.currentSlot].pos.x = (float)ie.value * reader.scaleX;
+            return;
+        }
 
-                long long currentTime = GetCurrentTimeMs();
-                if (currentTime - lastCallbackTime < MIN_CALLBACK_INTERVAL)
-                {
-                    continue; // 跳过，不触发回调
-                }
-                lastCallbackTime = currentTime;
+        if (ie.code == ABS_MT_POSITION_Y)
+        {
+            state.fingers[reader.currentSlot].pos.y = (float)ie.value * reader.scaleY;
+            return;
+        }
 
-                // 触摸回调 - 修复：无论 readOnly 是否为 true 都应该调用回调
-                if (g_touchCallback)
-                {
-                    g_touchCallback(&g_devices);
-                }
-                else if (!g_readOnly)
-                {
-                    // 只有在非只读模式下才上传触摸事件
-                    Upload();
-                }
+        if (ie.code == ABS_MT_PRESSURE)
+        {
+            state.fingers[reader.currentSlot].pressure = (float)ie.value / 255.0f;
+            return;
+        }
+    }
+
+    if (ie.type == EV_SYN && ie.code == SYN_REPORT)
+    {
+        state.timestamp = ie.time.tv_sec * 1000000LL + ie.time.tv_usec;
+        reader.pending = true;
+
+        // 含按下/抬起的上报立即投递，纯移动留到本次唤醒结束合并
+        if (reader.transition)
+        {
+            reader.transition = false;
+            FlushReader(reader);
+        }
+    }
+}
+
+// 读空设备（非阻塞），返回 false 表示设备已失效
+static bool DrainReader(TouchReader &reader)
+{
+    input_event events[64];
+
+    while (true)
+    {
+        ssize_t readSize = read(reader.fd, events, sizeof(events));
+        if (readSize < 0)
+        {
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        if (readSize == 0) return false;
+
+        size_t count = readSize / sizeof(input_event);
+        for (size_t i = 0; i < count; i++)
+        {
+            ProcessEvent(reader, events[i]);
+        }
+
+        if ((size_t)readSize < sizeof(events)) return true;
+    }
+}
+
+// 触摸事件读取线程
+// 一个线程经 epoll 监听全部设备，不持锁、不调用回调
+static void TouchReadThread()
+{
+    epoll_event ready[MAX_EVENTS];
+
+    while (g_initialized)
+    {
+        int n = epoll_wait(g_epollFd, ready, MAX_EVENTS, -1);
+        if (n < 0)
+        {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        bool wake = false;
+        for (int i = 0; i < n; i++)
+        {
+            uint32_t token = ready[i].data.u32;
+            if (token == WAKE_TOKEN)
+            {
+                wake = true;
                 continue;
             }
+
+            TouchReader &reader = g_readers[token];
+            if (!DrainReader(reader) || (ready[i].events & (EPOLLERR | EPOLLHUP)))
+            {
+                // 设备被移除，停止监听
+                epoll_ctl(g_epollFd, EPOLL_CTL_DEL, reader.fd, nullptr);
+            }
         }
 
-        g_lock.unlock();
-    }
+        // 本次唤醒内的纯移动上报合并为一份快照
+        for (auto &reader : g_readers)
+        {
+            FlushReader(reader);
+        }
 
-    return nullptr;
+        if (g_eventNotify && !g_snapshots.Empty())
+        {
+            g_eventNotify();
+        }
+
+        if (wake) break;
+    }
 }
 
 bool Init(const My_Vector2 &screenSize, bool readOnly)
@@ -350,15 +506,6 @@ bool Init(const My_Vector2 &screenSize, bool readOnly)
     g_devices.clear();
     g_readOnly = readOnly;
 
-    if (screenSize.x > screenSize.y)
-    {
-        g_screenSize = screenSize;
-    }
-    else
-    {
-        g_screenSize = My_Vector2(screenSize.y, screenSize.x);
-    }
-
     DIR *dir = opendir("/dev/input/");
     if (!dir) return false;
 
@@ -378,7 +525,7 @@ bool Init(const My_Vector2 &screenSize, bool readOnly)
         char path[128];
         sprintf(path, "/dev/input/event%d", i);
 
-        int fd = open(path, O_RDWR);
+        int fd = open(path, O_RDWR | O_NONBLOCK);
         if (fd < 0) continue;
 
         if (CheckDeviceIsTouch(fd))
@@ -470,33 +617,76 @@ bool Init(const My_Vector2 &screenSize, bool readOnly)
         device.scaleY = (float)touchHeight / (float)device.absY.maximum;
     }
 
-    My_Vector2 actualSize = screenSize;
-    if (actualSize.x > actualSize.y)
+    SetScreenSize(screenSize);
+
+    g_uploadDevices = g_devices;
+
+    // 丢弃上一次会话残留的快照
+    while (g_snapshots.Front())
     {
-        std::swap(actualSize.x, actualSize.y);
+        g_snapshots.Discard();
     }
 
-    g_touchScale.x = (float)touchWidth / actualSize.x;
-    g_touchScale.y = (float)touchHeight / actualSize.y;
+    g_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    g_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (g_epollFd < 0 || g_wakeFd < 0)
+    {
+        return false;
+    }
 
-    g_initialized = true;
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.u32 = WAKE_TOKEN;
+    epoll_ctl(g_epollFd, EPOLL_CTL_ADD, g_wakeFd, &ev);
 
+    g_readers.resize(g_devices.size());
     for (size_t i = 0; i < g_devices.size(); i++)
     {
-        pthread_t thread;
-        pthread_create(&thread, nullptr, TouchReadThread, (void *)(long)i);
-        pthread_detach(thread);
+        TouchReader &reader = g_readers[i];
+        reader.fd = g_devices[i].fd;
+        reader.scaleX = g_devices[i].scaleX;
+        reader.scaleY = g_devices[i].scaleY;
+        reader.currentSlot = 0;
+        reader.pending = false;
+        reader.transition = false;
+        reader.state = TouchSnapshot();
+        reader.state.device = (int)i;
+
+        ev.events = EPOLLIN;
+        ev.data.u32 = (uint32_t)i;
+        epoll_ctl(g_epollFd, EPOLL_CTL_ADD, reader.fd, &ev);
     }
 
+    g_initialized = true;
+    g_readThread = std::thread(TouchReadThread);
+
     return true;
 }
 
 void Close()
 {
-    if (g_initialized)
+    // 唤醒并等待读取线程退出，之后才能关闭设备
+    g_initialized = false;
+    if (g_readThread.joinable())
+    {
+        uint64_t one = 1;
+        write(g_wakeFd, &one, sizeof(one));
+        g_readThread.join();
+    }
+
+    if (g_epollFd >= 0)
+    {
+        close(g_epollFd);
+        g_epollFd = -1;
+    }
+    if (g_wakeFd >= 0)
     {
-        g_initialized = false;
+        close(g_wakeFd);
+        g_wakeFd = -1;
+    }
 
+    if (!g_devices.empty())
+    {
         for (auto &device : g_devices)
         {
             if (!g_readOnly)
@@ -513,8 +703,13 @@ void Close()
             g_outputFd = -1;
         }
 
-        g_devices.clear();
+        g_lock.lock();
+        g_uploadDevices.clear();
         memset(g_input.event, 0, sizeof(g_input.event));
+        g_lock.unlock();
+
+        g_readers.clear();
+        g_devices.clear();
     }
 }
 
@@ -525,64 +720,59 @@ bool IsInitialized()
 
 void Upload()
 {
-    static bool isFirstDown = true;
-    int eventCount = 0;
-    int fingerCount = 0;
+    WriteTouchEvents(g_uploadDevices);
+}
 
-    for (auto &device : g_devices)
+void DispatchEvents()
+{
+    const TouchSnapshot *snapshot;
+    while ((snapshot = g_snapshots.Front()) != nullptr)
     {
-        for (auto &finger : device.fingers)
+        int index = snapshot->device;
+        long long timestamp = snapshot->timestamp;
+        if (index >= (int)g_devices.size())
         {
-            if (finger.isDown)
-            {
-                if (fingerCount++ > 20) goto finish;
-
-                g_input.event[eventCount++] = { .type = EV_ABS, .code = ABS_X, .value = (int)finger.pos.x };
-                g_input.event[eventCount++] = { .type = EV_ABS, .code = ABS_Y, .value = (int)finger.pos.y };
-                g_input.event[eventCount++] = { .type = EV_ABS, .code = ABS_MT_POSITION_X, .value = (int)finger.pos.x };
-                g_input.event[eventCount++] = { .type = EV_ABS, .code = ABS_MT_POSITION_Y, .value = (int)finger.pos.y };
-                g_input.event[eventCount++] = { .type = EV_ABS, .code = ABS_MT_TRACKING_ID, .value = finger.id };
-                g_input.event[eventCount++] = { .type = EV_SYN, .code = SYN_MT_REPORT, .value = 0 };
-            }
+            g_snapshots.Discard();
+            continue;
         }
-    }
 
-finish:
-    bool hasTouch = false;
-    if (eventCount == 0)
-    {
-        g_input.event[eventCount++] = { .type = EV_SYN, .code = SYN_MT_REPORT, .value = 0 };
-        if (!isFirstDown)
+        TouchDevice &device = g_devices[index];
+        uint32_t lastMask = GetDownMask(device.fingers);
+        uint32_t mask = GetDownMask(snapshot->fingers);
+        std::copy(snapshot->fingers, snapshot->fingers + MAX_FINGERS, device.fingers);
+        g_snapshots.Discard();
+
+        // 纯移动快照且同一设备后面还有纯移动快照时，合并到最新状态再派发
+        const TouchSnapshot *next = g_snapshots.Front();
+        if (mask == lastMask && next && next->device == index && GetDownMask(next->fingers) == mask)
         {
-            isFirstDown = true;
-            g_input.event[eventCount++] = { .type = EV_KEY, .code = BTN_TOUCH, .value = 0 };
-            g_input.event[eventCount++] = { .type = EV_KEY, .code = BTN_TOOL_FINGER, .value = 0 };
+            continue;
         }
-    }
-    else
-    {
-        hasTouch = true;
-    }
 
-    g_input.event[eventCount++] = { .type = EV_SYN, .code = SYN_REPORT, .value = 0 };
+        // 手势识别
+        if (g_gestureEnabled)
+        {
+            RecognizeGesture(device, timestamp / 1000);
+        }
 
-    if (hasTouch && isFirstDown)
-    {
-        isFirstDown = false;
-        write(g_outputFd, &g_input, sizeof(input_event) * (eventCount + 2));
-    }
-    else
-    {
-        write(g_outputFd, g_input.event, sizeof(input_event) * eventCount);
+        // 触摸回调 - 无论 readOnly 是否为 true 都调用
+        if (g_touchCallback)
+        {
+            g_touchCallback(&g_devices);
+        }
     }
 }
 
 void Down(float x, float y, int touchId)
 {
-    if (g_devices.empty()) return;
-
     g_lock.lock();
-    TouchPoint &touch = g_devices[0].fingers[9];
+    if (g_uploadDevices.empty())
+    {
+        g_lock.unlock();
+        return;
+    }
+
+    TouchPoint &touch = g_uploadDevices[0].fingers[9];
     touch.id = touchId >= 0 ? touchId : 19;
     touch.pos = My_Vector2(x, y) * g_touchScale;
     touch.startPos = touch.pos;
@@ -594,10 +784,14 @@ void Down(float x, float y, int touchId)
 
 void Move(float x, float y, int touchId)
 {
-    if (g_devices.empty()) return;
-
     g_lock.lock();
-    TouchPoint &touch = g_devices[0].fingers[9];
+    if (g_uploadDevices.empty())
+    {
+        g_lock.unlock();
+        return;
+    }
+
+    TouchPoint &touch = g_uploadDevices[0].fingers[9];
     touch.pos = My_Vector2(x, y) * g_touchScale;
     Upload();
     g_lock.unlock();
@@ -605,10 +799,14 @@ void Move(float x, float y, int touchId)
 
 void Up(int touchId)
 {
-    if (g_devices.empty()) return;
-
     g_lock.lock();
-    TouchPoint &touch = g_devices[0].fingers[9];
+    if (g_uploadDevices.empty())
+    {
+        g_lock.unlock();
+        return;
+    }
+
+    TouchPoint &touch = g_uploadDevices[0].fingers[9];
     touch.isDown = false;
     Upload();
     g_lock.unlock();
@@ -656,6 +854,11 @@ void SetGestureCallback(const GestureCallback &callback)
     g_gestureCallback = callback;
 }
 
+void SetEventNotify(const EventNotifyCallback &callback)
+{
+    g_eventNotify = callback;
+}
+
 My_Vector2 TouchToScreen(const My_Vector2 &touchCoord)
 {
     float x = touchCoord.x, y = touchCoord.y;
@@ -695,6 +898,25 @@ My_Vector2 GetScale()
     return g_touchScale;
 }
 
+void SetScreenSize(const My_Vector2 &screenSize)
+{
+    if (screenSize.x > screenSize.y)
+    {
+        g_screenSize = screenSize;
+    }
+    else
+    {
+        g_screenSize = My_Vector2(screenSize.y, screenSize.x);
+    }
+
+    // 触摸坐标按竖屏方向的屏幕尺寸换算
+    if (g_devices.empty()) return;
+    int touchWidth = g_devices[0].absX.maximum;
+    int touchHeight = g_devices[0].absY.maximum;
+    g_touchScale.x = (float)touchWidth / g_screenSize.y;
+    g_touchScale.y = (float)touchHeight / g_screenSize.x;
+}
+
 void SetOrientation(int orientation)
 {
     g_orientation = orientation % 4;
@@ -723,6 +945,21 @@ std::vector<TouchPoint> GetActiveTouches()
     return activeTouches;
 }
 
+void GetActiveTouches(Core::ArenaVector<TouchPoint> &out)
+{
+    out.clear();
+    for (const auto &device : g_devices)
+    {
+        for (const auto &finger : device.fingers)
+        {
+            if (finger.isDown)
+            {
+                out.push_back(finger);
+            }
+        }
+    }
+}
+
 int GetTouchCount()
 {
     int count = 0;
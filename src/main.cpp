@@ -14,11 +14,22 @@
  */
 
 
+#include "core/Profiler.h"
 #include "graphics/DrawList.h"
+#include "graphics/RenderScale.h"
+#include "graphics/TileRenderer.h"
 #include "input/TouchHelper.h"
 #include "platform/ANativeWindowCreator.h"
+#include "platform/CommandFeed.h"
+#include "platform/DisplayMonitor.h"
+#include "platform/FrameScheduler.h"
+#include "platform/Presenter.h"
+#include "platform/QualityGovernor.h"
+#include "platform/ThermalMonitor.h"
 #include "ui/FloatingMenu.h"
-#include <chrono>
+#include "ui/ProfilerHud.h"
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
 #include <thread>
 
@@ -26,12 +37,31 @@
 ANativeWindow *g_nativeWindow = nullptr;
 UI::FloatingMenu *g_mainMenu = nullptr;
 UI::FloatingMenu *g_miniMenu = nullptr;
+UI::Label *g_fpsLabel = nullptr;
+UI::ProfilerHud *g_profilerHud = nullptr;
 
 // 配置变量
-int g_targetFps = 120;
 bool g_showDemo = true;
 bool g_showMainMenu = true;
 bool g_showMiniMenu = false;
+bool g_showProfiler = false;
+bool g_pipelinedPresent = true; // 提交线程与渲染线程并行
+// 窗口像素格式：RGB565 窗口带宽减半（提交时抖动转换），但窗口不透明，只适合全屏界面
+Graphics::PixelFormat g_windowFormat = Graphics::PixelFormat::RGBA8888;
+// 渲染缩放（如 0.5 / 0.75）：几何按比例在缩小的缓冲中绘制，像素量按平方减少
+float g_renderScale = 1.0f;
+// 缩放时文字另起一遍、按屏幕分辨率绘制并叠在几何之上（几何由 CPU 放大），菜单整层按屏幕分辨率绘制；关闭时缩小的缓冲直接交给合成器放大
+bool g_nativeResolutionText = true;
+// 外部进程通过共享内存提交绘制命令（CommandFeedClient 连接此名字），叠在 Demo / ESP 之上、菜单之下（两条渲染路径一致）
+bool g_commandFeed = true;
+const char *g_commandFeedName = "cpudraw_feed";
+// 目标帧率（菜单按钮修改），自适应画质降帧率时在此基础上打折
+int g_targetFps = 120;
+// 自适应画质：按渲染耗时与温控逐档降级，每帧渲染耗时不超过帧间隔的 g_cpuBudget
+bool g_adaptiveQuality = true;
+float g_cpuBudget = 0.6f;
+// 当前生效的画质设置（由 QualityGovernor 给出，关闭自适应时为最高档）
+Platform::QualitySettings g_quality = Platform::QualityGovernor::SettingsFor(Platform::QualityLevel::Full);
 
 // ESP配置
 struct ESPConfig
@@ -133,6 +163,14 @@ void InitMainMenu() {
         g_showDemo = v;
     });
     
+    UI::Checkbox *profilerCheck = g_mainMenu->AddCheckbox("性能面板", false);
+    profilerCheck->SetChecked(g_showProfiler);
+    profilerCheck->SetOnValueChange([](bool v) {
+        g_showProfiler = v;
+        Core::Profiler::Instance().SetEnabled(v);
+        if (!v) Core::Profiler::Instance().LogSummary();
+    });
+    
     g_mainMenu->AddSeparator();
     
     // FPS控制
@@ -145,6 +183,12 @@ void InitMainMenu() {
     
     UI::Button *fps120 = g_mainMenu->AddButton("FPS: 120");
     fps120->SetOnClick([]() { g_targetFps = 120; });
+
+    UI::Checkbox *adaptiveCheck = g_mainMenu->AddCheckbox("自适应画质", false);
+    adaptiveCheck->SetChecked(g_adaptiveQuality);
+    adaptiveCheck->SetOnValueChange([](bool v) {
+        g_adaptiveQuality = v;
+    });
     
     g_mainMenu->AddSeparator();
     
@@ -193,9 +237,9 @@ void InitMiniMenu()
             g_showMiniMenu = false;
         });
 
-    UI::Label *fpsLabel = g_miniMenu->AddLabel("FPS: --");
-    fpsLabel->SetTextColor(Graphics::rgba(100, 100, 100, 255));
-    fpsLabel->SetFontSize(18);
+    g_fpsLabel = g_miniMenu->AddLabel("FPS: --");
+    g_fpsLabel->SetTextColor(Graphics::rgba(100, 100, 100, 255));
+    g_fpsLabel->SetFontSize(18);
 }
 
 // Demo演示 (从别的地方扣过来的，不知道叫啥)
@@ -213,6 +257,10 @@ void DrawDemoContent(Graphics::DrawList &dl, int width, int height)
     dl.AddText((int)(width / 2 - textSize.x / 2), height - 100, "Hello CPU Render!", 32, Graphics::rgba(255, 255, 255, 255));
     dl.AddRectRoundedFilled(650, 50, 800, 150, 10, Graphics::rgba(255, 128, 0, 200));
     dl.AddGradientLinear(50, 300, 250, 400, Graphics::rgba(255, 0, 0, 200), Graphics::rgba(0, 0, 255, 200));
+
+    // 多色标渐变：色带只烘焙一次，之后每帧查缓存
+    static const Graphics::Gradient rainbow = Graphics::Gradient().AddStop(0.0f, Graphics::rgba(255, 0, 0, 255)).AddStop(0.5f, Graphics::rgba(0, 255, 0, 255)).AddStop(1.0f, Graphics::rgba(0, 0, 255, 255));
+    dl.AddGradientLinear(50, 420, 250, 440, rainbow, true);
 }
 
 // 绘制ESP演示
@@ -229,51 +277,35 @@ void DrawESPDemo(Graphics::DrawList &dl, int width, int height)
 
     uint32_t nameColor = Graphics::rgba(g_colorConfig.nameColor[0] * 255, g_colorConfig.nameColor[1] * 255, g_colorConfig.nameColor[2] * 255, g_colorConfig.nameColor[3] * 255);
 
-    // 方框
-    if (g_espConfig.showBox)
-    {
-        dl.AddRect(centerX - boxW / 2, centerY - boxH / 2, centerX + boxW / 2, centerY + boxH / 2, boxColor);
-    }
-
-    // 射线
-    if (g_espConfig.showLine)
-    {
-        dl.AddLine(width / 2, height, centerX, centerY + boxH / 2, lineColor);
-    }
-
-    // 名字
-    if (g_espConfig.showName)
-    {
-        dl.AddText(centerX - 30, centerY - boxH / 2 - 25, "蔡徐坤", (int)g_fontConfig.actorSize, nameColor);
-    }
-
-    // 距离
-    if (g_espConfig.showDistance)
-    {
-        dl.AddText(centerX - 20, centerY + boxH / 2 + 5, "120m", (int)g_fontConfig.itemSize, Graphics::rgba(255, 255, 0, 255));
-    }
-
-    // 血量条
-    if (g_espConfig.showHealth)
-    {
-        int healthBarW = boxW;
-        int healthBarH = 6;
-        int healthX = centerX - boxW / 2;
-        int healthY = centerY + boxH / 2 + 25;
-
-        // 背景
-        dl.AddRectFilled(healthX, healthY, healthX + healthBarW, healthY + healthBarH, Graphics::rgba(60, 60, 60, 200));
-        // 当前血量
-        dl.AddRectFilled(healthX, healthY, healthX + healthBarW * 0.75f, healthY + healthBarH, Graphics::rgba(0, 255, 0, 220));
-    }
+    // 所有实体一批提交：方框、射线、名字、距离、血条
+    static Graphics::EntityBatch batch;
+    batch.Clear();
+    int name = batch.AddLabel("蔡徐坤");
+    int distance = batch.AddLabel("120m");
+    batch.Add(centerX - boxW / 2, centerY - boxH / 2, centerX + boxW / 2, centerY + boxH / 2, boxColor, 0.75f, name, distance);
+
+    Graphics::EntityStyle style;
+    style.flags = 0;
+    if (g_espConfig.showBox) style.flags |= Graphics::ENTITY_BOX;
+    if (g_espConfig.showLine) style.flags |= Graphics::ENTITY_TRACER;
+    if (g_espConfig.showName) style.flags |= Graphics::ENTITY_NAME;
+    if (g_espConfig.showDistance) style.flags |= Graphics::ENTITY_INFO;
+    if (g_espConfig.showHealth) style.flags |= Graphics::ENTITY_HEALTH;
+    style.tracerX = width / 2;
+    style.tracerY = height;
+    style.tracerColor = lineColor;
+    style.nameSize = (int)g_fontConfig.actorSize;
+    style.nameColor = nameColor;
+    style.infoSize = (int)g_fontConfig.itemSize;
+
+    dl.AddEntityBatch(batch, style);
 }
 
-// 主绘制函数
-void DrawFrame(uint32_t *pixels, int stride, int width, int height) {
-    memset(pixels, 0x00, stride * height * 4);
-    
-    Graphics::DrawList dl(pixels, stride, width, height);
-    
+// 场景层：演示与 ESP，外部帧叠在这一层之上
+void DrawScene(Graphics::DrawList &dl, int width, int height) {
+    // 线条、圆、圆角面板走覆盖率抗锯齿（自适应画质可能关闭）
+    dl.SetAntiAliasing(g_quality.antiAliasing);
+
     // 演示
     if (g_showDemo) {
         DrawDemoContent(dl, width, height);
@@ -281,7 +313,12 @@ void DrawFrame(uint32_t *pixels, int stride, int width, int height) {
     
     // ESP
     DrawESPDemo(dl, width, height);
-    
+}
+
+// 界面层：菜单与性能面板，始终在最上面
+void DrawOverlay(Graphics::DrawList &dl) {
+    dl.SetAntiAliasing(g_quality.antiAliasing);
+
     // 绘制主菜单
     if (g_showMainMenu && g_mainMenu) {
         g_mainMenu->Draw(dl);
@@ -292,6 +329,55 @@ void DrawFrame(uint32_t *pixels, int stride, int width, int height) {
         g_miniMenu->SetVisible(true);
         g_miniMenu->Draw(dl);
     }
+
+    // 性能面板
+    if (g_showProfiler && g_profilerHud) {
+        g_profilerHud->Draw(dl);
+    }
+}
+
+// 迷你窗帧率：按画质档位每 250ms / 1s 刷新一次，避免每帧让菜单缓存失效
+void UpdateFpsLabel(int64_t nowNs)
+{
+    static int64_t windowStartNs = 0;
+    static int frames = 0;
+
+    frames++;
+    if (windowStartNs == 0)
+    {
+        windowStartNs = nowNs;
+        return;
+    }
+
+    int64_t elapsed = nowNs - windowStartNs;
+    if (elapsed < g_quality.labelRefreshMs * 1000000LL) return;
+
+    if (g_fpsLabel)
+    {
+        char text[32];
+        snprintf(text, sizeof(text), "FPS: %.0f", frames * 1e9 / (double)elapsed);
+        g_fpsLabel->SetText(text);
+    }
+    windowStartNs = nowNs;
+    frames = 0;
+}
+
+// 应用画质档位：菜单阴影需要重建菜单缓存，其余设置在录制 / 渲染时读取 g_quality
+void ApplyQuality(const Platform::QualitySettings &quality)
+{
+    g_quality = quality;
+
+    UI::FloatingMenu *menus[] = { g_mainMenu, g_miniMenu };
+    for (UI::FloatingMenu *menu : menus)
+    {
+        if (!menu || menu->GetStyle().showShadow == quality.shadows) continue;
+        UI::FloatingMenu::Style style = menu->GetStyle();
+        style.showShadow = quality.shadows;
+        menu->SetStyle(style);
+    }
+
+    // 画面会变，立即重画一帧
+    Platform::FrameScheduler::Instance().Wake();
 }
 
 // 触摸回调
@@ -329,6 +415,14 @@ void RenderThread()
 
     My_Vector2 screenSize(actualWidth, actualHeight);
 
+    // 帧调度：跟随垂直同步，无触摸、无动画时挂起
+    Platform::FrameScheduler &scheduler = Platform::FrameScheduler::Instance();
+    scheduler.Init();
+    scheduler.SetTargetFps(g_targetFps);
+
+    // 新触摸到达时唤醒渲染循环（在读取线程调用）
+    Input::SetEventNotify([]() { Platform::FrameScheduler::Instance().Wake(); });
+
     if (!Input::Init(screenSize, true))
     {
         return;
@@ -349,73 +443,293 @@ void RenderThread()
     // 初始化UI
     InitMainMenu();
     InitMiniMenu();
+    g_profilerHud = new UI::ProfilerHud(20, 20);
+
+
+    // 屏幕状态：后台线程低频查询（binder 调用不进渲染循环），变化时唤醒渲染循环
+    Platform::DisplayMonitor &displayMonitor = Platform::DisplayMonitor::Instance();
+    displayMonitor.SetChangeNotify([]() { Platform::FrameScheduler::Instance().Wake(); });
+    displayMonitor.Start([](Platform::DisplayState &state) {
+        android::ANativeWindowCreator::DisplayInfo info = android::ANativeWindowCreator::GetDisplayInfo();
+        state.width = info.width;
+        state.height = info.height;
+        state.orientation = info.orientation;
+        return info.width > 0 && info.height > 0;
+    });
+    Platform::DisplayState display = { displayInfo.width, displayInfo.height, displayInfo.orientation, 0 };
+    displayMonitor.Poll(display);
+
+    int lastOrientation = display.IsLandscape() ? 1 : 0;
+
+    // 自适应画质：温控状态由后台线程低频查询，变化时唤醒渲染循环
+    Platform::GovernorConfig governorConfig;
+    governorConfig.cpuBudget = g_cpuBudget;
+    Platform::QualityGovernor governor(governorConfig);
+    Platform::ThermalMonitor &thermalMonitor = Platform::ThermalMonitor::Instance();
+    thermalMonitor.SetChangeNotify([]() { Platform::FrameScheduler::Instance().Wake(); });
+    thermalMonitor.Start();
+    bool governorActive = g_adaptiveQuality;
+
+    // 外部绘制命令：新帧到达或生产者断开时唤醒渲染循环
+    Platform::CommandFeedServer feed;
+    Graphics::CommandBuffer feedCommands;
+    // 创建失败时 Acquire 始终为空，只显示本进程内容
+    if (g_commandFeed)
+    {
+        feed.SetChangeNotify([]() { Platform::FrameScheduler::Instance().Wake(); });
+        feed.Start(g_commandFeedName);
+    }
 
+    // 录制的绘制命令与分块光栅化线程池
+    Graphics::CommandBuffer commands;
+    Graphics::CommandBuffer textCommands;
+    Graphics::CommandBuffer overlayCommands;
+    // 帧内临时内存（DrawList 的栈与顶点），每帧开始整体回收
+    Core::FrameArena frameArena;
+    Graphics::TileRenderer tileRenderer;
+
+    // 渲染缩放且保留原分辨率文字时，几何先画进低分辨率缓冲
+    Graphics::Surface lowBuffer;
+    Graphics::IntRect lowContent = Graphics::IntRect::Empty();
+
+    // 后台缓冲与窗口提交（几何只在尺寸变化时重设）
+    Platform::NativeWindowTarget windowTarget(g_nativeWindow, g_windowFormat);
+    Platform::Presenter presenter;
+    presenter.Start(&windowTarget, g_pipelinedPresent);
+
+    // 上一帧的签名与尺寸
+    uint64_t lastSignature = 0;
+    int lastWidth = 0;
+    int lastHeight = 0;
+    int lastRenderWidth = 0;
 
-    int lastOrientation = displayInfo.width > displayInfo.height ? 1 : 0;
     // 主循环
     while (true)
     {
-        auto frameStart = std::chrono::steady_clock::now();
+        float deltaTime = scheduler.WaitFrame();
+        int64_t workStartNs = Platform::FrameScheduler::NowNs();
 
-        android::ANativeWindowCreator::DisplayInfo currentInfo = android::ANativeWindowCreator::GetDisplayInfo();
+        Core::Profiler &profiler = Core::Profiler::Instance();
+        profiler.BeginFrame();
+        frameArena.Reset();
+        UpdateFpsLabel(scheduler.GetFrameTimeNs());
 
-        int currentOrientation = currentInfo.width > currentInfo.height ? 1 : 0;
+        // 屏幕尺寸 / 方向变化：触摸换算参数原地更新，不重新打开设备
+        if (displayMonitor.Poll(display))
+        {
+            int currentOrientation = display.IsLandscape() ? 1 : 0;
+            Input::SetScreenSize(My_Vector2(display.width, display.height));
+            if (currentOrientation != lastOrientation)
+            {
+                Input::SetOrientation(currentOrientation);
+                lastOrientation = currentOrientation;
+            }
+        }
 
-        if (currentOrientation != lastOrientation)
+        // 自适应画质开关切换时回到最高档；发热时直接降到温控对应的档位
+        if (g_adaptiveQuality != governorActive)
         {
-            // 重新初始化触摸
-            Input::Close();
-            My_Vector2 newSize(currentInfo.width, currentInfo.height);
-            Input::Init(newSize, true);
-            Input::SetOrientation(currentOrientation);
-            Input::SetTouchCallback(HandleTouchCallback);
-
-            lastOrientation = currentOrientation;
+            governorActive = g_adaptiveQuality;
+            governor.Reset();
+            ApplyQuality(governor.GetSettings());
+        }
+        if (governorActive && governor.SetThermal(thermalMonitor.GetStatus(), thermalMonitor.GetHeadroom()))
+        {
+            ApplyQuality(governor.GetSettings());
         }
 
-        int width = ANativeWindow_getWidth(g_nativeWindow);
-        int height = ANativeWindow_getHeight(g_nativeWindow);
-        ANativeWindow_setBuffersGeometry(g_nativeWindow, width, height, WINDOW_FORMAT_RGBA_8888);
+        // 目标帧率：菜单设定值按画质档位打折
+        int targetFps = g_quality.fpsScale < 1.0f ? std::max(15, (int)(g_targetFps * g_quality.fpsScale + 0.5f)) : g_targetFps;
+        if (scheduler.GetTargetFps() != targetFps)
+        {
+            scheduler.SetTargetFps(targetFps);
+        }
 
-        // 锁定缓冲区
-        ANativeWindow_Buffer buffer;
-        if (ANativeWindow_lock(g_nativeWindow, &buffer, nullptr) != 0)
+        // 派发本帧之前到达的触摸，UI 状态只在渲染线程修改
         {
-            break;
+            CPUDRAW_PROFILE_SCOPE(Input);
+            Input::DispatchEvents();
         }
 
-        uint32_t *pixels = static_cast<uint32_t *>(buffer.bits);
+        // 更新菜单动画
+        {
+            CPUDRAW_PROFILE_SCOPE(Update);
+            if (g_showMainMenu && g_mainMenu) {
+                g_mainMenu->Update(deltaTime);
+            }
+            if (g_showMiniMenu && g_miniMenu) {
+                g_miniMenu->Update(deltaTime);
+            }
+        }
 
-        // 清空缓冲区
-        memset(pixels, 0x00, buffer.stride * buffer.height * 4);
+        // 渲染缩放：缓冲几何缩小后，窗口尺寸报告的是缓冲尺寸，逻辑尺寸改用屏幕尺寸
+        // UI 与触摸仍按屏幕坐标，录制时压入缩放变换，触摸不需要换算
+        // 实际缩放取配置值与画质档位上限中较小的一个
+        float renderScale = g_renderScale > 0.0f ? std::min(g_renderScale, g_quality.renderScale) : g_quality.renderScale;
+        bool scaled = renderScale < 1.0f;
+        bool upscale = scaled && g_nativeResolutionText;
+        int width = scaled ? display.width : ANativeWindow_getWidth(g_nativeWindow);
+        int height = scaled ? display.height : ANativeWindow_getHeight(g_nativeWindow);
+        int renderWidth = scaled ? Graphics::scaled_size(width, renderScale) : width;
+        int renderHeight = scaled ? Graphics::scaled_size(height, renderScale) : height;
+
+        // 录制：同时得到绘制范围与签名，不写像素
+        if (g_showProfiler && g_profilerHud)
+        {
+            g_profilerHud->SetFrameBudget(1000.0f / (targetFps > 0 ? targetFps : scheduler.GetRefreshRate()));
+        }
 
-        DrawFrame(pixels, buffer.stride, width, height);
+        // 外部帧按后台缓冲尺寸录制（合成器放大时为缩小后的尺寸），尺寸对不上的帧（如刚转屏）先不画
+        int feedWidth = scaled && !upscale ? renderWidth : width;
+        int feedHeight = scaled && !upscale ? renderHeight : height;
+        feed.SetTargetSize(feedWidth, feedHeight);
+        const Platform::FeedFrame *feedFrame = feed.Acquire();
+        if (feedFrame && (feedFrame->width != feedWidth || feedFrame->height != feedHeight))
+        {
+            feedFrame = nullptr;
+        }
 
-        ANativeWindow_unlockAndPost(g_nativeWindow);
+        // 场景与界面分开录制，外部帧回放在两者之间
+        // CPU 放大时界面层按屏幕分辨率录制（菜单本身有屏幕分辨率的缓存），否则与场景同在后台缓冲尺寸上
+        commands.Reset();
+        textCommands.Reset();
+        overlayCommands.Reset();
+        Graphics::DrawList recorder(&commands, renderWidth, renderHeight, &frameArena);
+        Graphics::DrawList textRecorder(&textCommands, width, height, &frameArena);
+        Graphics::DrawList overlayRecorder(&overlayCommands, upscale ? width : renderWidth, upscale ? height : renderHeight, &frameArena);
+        {
+            CPUDRAW_PROFILE_SCOPE(Record);
+            if (scaled)
+            {
+                recorder.PushTransform(0.0f, 0.0f, (float)renderWidth / width);
+                if (!upscale) overlayRecorder.PushTransform(0.0f, 0.0f, (float)renderWidth / width);
+            }
+            if (upscale)
+            {
+                // 文字层按屏幕分辨率单独录制，叠在放大后的几何之上
+                recorder.SetLayer(Graphics::DrawLayer::Geometry);
+                textRecorder.SetLayer(Graphics::DrawLayer::Text);
+                DrawScene(textRecorder, width, height);
+            }
+            DrawScene(recorder, width, height);
+            DrawOverlay(overlayRecorder);
+        }
 
-        // 更新菜单动画
-        float deltaTime = 0.008f;
-        if (g_showMainMenu && g_mainMenu) {
-            g_mainMenu->Update(deltaTime);
+        // 内容未变化时跳过提交
+        uint64_t signature = recorder.GetSignature() ^ (textRecorder.GetSignature() * 0x9E3779B97F4A7C15ULL) ^ (overlayRecorder.GetSignature() * 0xFF51AFD7ED558CCDULL);
+        if (feedFrame)
+        {
+            signature ^= ((uint64_t)feedFrame->sequence + 1) * 0xC2B2AE3D27D4EB4FULL;
         }
-        if (g_showMiniMenu && g_miniMenu) {
-            g_miniMenu->Update(deltaTime);
+        bool resized = width != lastWidth || height != lastHeight || renderWidth != lastRenderWidth;
+        if (resized || signature != lastSignature)
+        {
+            // 空闲后台缓冲：两个缓冲都在排队/提交时才会等待
+            // 合成器放大时后台缓冲（窗口缓冲几何）就是缩小后的尺寸
+            int backWidth = scaled && !upscale ? renderWidth : width;
+            int backHeight = scaled && !upscale ? renderHeight : height;
+            Platform::BackBuffer *back = presenter.Acquire(backWidth, backHeight);
+            if (!back)
+            {
+                break;
+            }
+
+            Graphics::IntRect drawn = recorder.GetDrawnBounds();
+            if (upscale)
+            {
+                // 低分辨率缓冲同样只保留上一帧的范围：清空其与本帧范围的并集
+                if (lowBuffer.Resize(renderWidth, renderHeight)) lowContent = Graphics::IntRect::Empty();
+                Graphics::IntRect lowRepair = drawn.Union(lowContent);
+                if (!lowRepair.IsEmpty())
+                {
+                    CPUDRAW_PROFILE_SCOPE(Clear);
+                    Graphics::clear_rect(lowBuffer.GetPixels(), lowBuffer.GetStride(), renderWidth, renderHeight, lowRepair.x0, lowRepair.y0, lowRepair.x1, lowRepair.y1, 0x00000000);
+                }
+                lowContent = drawn;
+
+                // 放大后的几何范围 ∪ 文字与界面范围为本帧范围，后台缓冲旧内容所在区域一并重新放大（覆盖写入）
+                drawn = Graphics::upscale_bounds(drawn, renderWidth, renderHeight, width, height).Union(textRecorder.GetDrawnBounds()).Union(overlayRecorder.GetDrawnBounds());
+                if (feedFrame) drawn = drawn.Union(feedFrame->bounds);
+                Graphics::IntRect repair = drawn.Union(back->content);
+                {
+                    CPUDRAW_PROFILE_SCOPE(Render);
+                    tileRenderer.Render(commands, lowBuffer.GetPixels(), lowBuffer.GetStride(), renderWidth, renderHeight);
+                    if (!repair.IsEmpty())
+                    {
+                        Graphics::upscale_bilinear(back->pixels, back->stride, width, height, lowBuffer.GetPixels(), lowBuffer.GetStride(), renderWidth, renderHeight, repair);
+                    }
+                    // 放大会覆盖写入，场景文字、外部帧、界面依次叠在放大后的几何之上
+                    tileRenderer.Render(textCommands, back->pixels, back->stride, width, height);
+                    if (feedFrame)
+                    {
+                        feedCommands.Attach(feedFrame->GetCommands(), feedFrame->commandCount, feedFrame->GetData(), feedFrame->dataSize);
+                        tileRenderer.Render(feedCommands, back->pixels, back->stride, width, height);
+                    }
+                    tileRenderer.Render(overlayCommands, back->pixels, back->stride, width, height);
+                }
+            }
+            else
+            {
+                // 后台缓冲保存的是它上次那一帧：清空其旧内容与本帧范围的并集
+                drawn = drawn.Union(overlayRecorder.GetDrawnBounds());
+                if (feedFrame) drawn = drawn.Union(feedFrame->bounds);
+                Graphics::IntRect repair = drawn.Union(back->content);
+                if (!repair.IsEmpty())
+                {
+                    CPUDRAW_PROFILE_SCOPE(Clear);
+                    Graphics::clear_rect(back->pixels, back->stride, backWidth, backHeight, repair.x0, repair.y0, repair.x1, repair.y1, 0x00000000);
+                }
+
+                {
+                    CPUDRAW_PROFILE_SCOPE(Render);
+                    // 场景、外部帧（直接从共享内存回放）、界面依次叠加
+                    tileRenderer.Render(commands, back->pixels, back->stride, backWidth, backHeight);
+                    if (feedFrame)
+                    {
+                        feedCommands.Attach(feedFrame->GetCommands(), feedFrame->commandCount, feedFrame->GetData(), feedFrame->dataSize);
+                        tileRenderer.Render(feedCommands, back->pixels, back->stride, backWidth, backHeight);
+                    }
+                    tileRenderer.Render(overlayCommands, back->pixels, back->stride, backWidth, backHeight);
+                }
+            }
+
+            // 变化区域拷进窗口缓冲并投递，流水线模式下在提交线程完成
+            presenter.Submit(back, drawn);
+
+            lastSignature = signature;
+            lastWidth = width;
+            lastHeight = height;
+            lastRenderWidth = renderWidth;
+
+            // 只统计真正渲染了的帧（跳过提交的帧几乎不耗时，会拉低平均）
+            if (governorActive)
+            {
+                float baseFps = g_targetFps > 0 ? (float)g_targetFps : scheduler.GetRefreshRate();
+                if (governor.Update(Platform::FrameScheduler::NowNs() - workStartNs, baseFps))
+                {
+                    ApplyQuality(governor.GetSettings());
+                }
+            }
         }
 
-        // 帧率控制
-        auto frameEnd = std::chrono::steady_clock::now();
-        auto frameDuration = std::chrono::duration_cast<std::chrono::milliseconds>(frameEnd - frameStart).count();
-
-        int targetFrameTime = 1000 / g_targetFps;
-        if (frameDuration < targetFrameTime)
+        // 动画未结束时继续请求下一帧
+        if ((g_showMainMenu && g_mainMenu && g_mainMenu->IsAnimating()) || (g_showMiniMenu && g_miniMenu && g_miniMenu->IsAnimating()))
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(targetFrameTime - frameDuration));
+            scheduler.Wake();
         }
+
+        profiler.EndFrame();
     }
 
+    presenter.Stop();
+    feed.Stop();
+    thermalMonitor.Stop();
+    displayMonitor.Stop();
     Input::Close();
+    scheduler.Shutdown();
     delete g_mainMenu;
     delete g_miniMenu;
+    delete g_profilerHud;
 }
 
 int main()
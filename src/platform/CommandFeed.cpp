@@ -0,0 +1,454 @@
+/*
+ * CPU-Draw - Command Feed Module
+ * Created: 2026-10-15
+ * By: MaySnowL
+ *
+ * 跨进程绘制命令输入
+ * 共享内存：FeedHeader | 槽 0 | 槽 1 | 槽 2，每个槽为 FeedFrame | DrawCommand[] | 数据区
+ * 三缓冲状态放在一个原子字里：最新槽、渲染端正在读的槽、是否有新帧；剩下的一个槽归生产者
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "platform/CommandFeed.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+
+namespace Platform
+{
+
+static const uint32_t FEED_MAGIC = 0x44464443; // "CDFD"
+static const int FEED_SLOTS = 3;
+
+// 三缓冲状态位
+static const uint32_t STATE_READY_MASK = 0x3;  // 最新发布的槽
+static const int STATE_FRONT_SHIFT = 2;        // 渲染端正在读的槽
+static const uint32_t STATE_FRESH = 1u << 4;   // 最新槽还没被取走
+
+// 共享内存头（按页对齐，槽紧随其后）
+struct FeedHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t commandSize; // sizeof(DrawCommand)
+    uint32_t opCount;     // DRAW_OP_COUNT
+    uint32_t slotSize;
+    std::atomic<int32_t> targetWidth;
+    std::atomic<int32_t> targetHeight;
+    std::atomic<uint32_t> state;
+};
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "feed state must be lock-free to live in shared memory");
+static_assert(sizeof(FeedFrame) % alignof(Graphics::DrawCommand) == 0, "commands follow the frame header");
+
+static size_t HeaderSize()
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    return (sizeof(FeedHeader) + page - 1) / page * page;
+}
+
+static FeedFrame *SlotAt(FeedHeader *header, uint32_t slot)
+{
+    return reinterpret_cast<FeedFrame *>(reinterpret_cast<uint8_t *>(header) + HeaderSize() + (size_t)slot * header->slotSize);
+}
+
+static uint32_t MakeState(uint32_t ready, uint32_t front, bool fresh)
+{
+    return ready | (front << STATE_FRONT_SHIFT) | (fresh ? STATE_FRESH : 0);
+}
+
+static void FillAddress(sockaddr_un &addr, socklen_t &length, const char *name)
+{
+    // 抽象命名空间：sun_path 以 '\0' 开头，不在文件系统中留下节点
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    size_t n = strnlen(name, sizeof(addr.sun_path) - 2);
+    memcpy(addr.sun_path + 1, name, n);
+    length = (socklen_t)(offsetof(sockaddr_un, sun_path) + 1 + n);
+}
+
+static void CloseFd(int &fd)
+{
+    if (fd >= 0) close(fd);
+    fd = -1;
+}
+
+// ---------------------------------------------------------------------------
+// 渲染端
+// ---------------------------------------------------------------------------
+
+CommandFeedServer::CommandFeedServer() : header(nullptr), mapSize(0), memFd(-1), eventFd(-1), listenFd(-1), stopFd(-1), connected(false), generation(0), current(nullptr), acquiredGeneration(0)
+{
+}
+
+CommandFeedServer::~CommandFeedServer()
+{
+    Stop();
+}
+
+bool CommandFeedServer::Start(const char *name, size_t slotSize)
+{
+    Stop();
+
+    slotSize = (slotSize + 4095) & ~(size_t)4095;
+    if (slotSize <= sizeof(FeedFrame) || slotSize > 0x40000000) return false;
+    mapSize = HeaderSize() + slotSize * FEED_SLOTS;
+
+    // 老版本 NDK 没有 memfd_create 的声明，直接走系统调用
+    memFd = (int)syscall(__NR_memfd_create, "cpudraw_feed", MFD_CLOEXEC);
+    if (memFd < 0 || ftruncate(memFd, (off_t)mapSize) != 0)
+    {
+        Stop();
+        return false;
+    }
+
+    void *memory = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, memFd, 0);
+    if (memory == MAP_FAILED)
+    {
+        Stop();
+        return false;
+    }
+
+    header = static_cast<FeedHeader *>(memory);
+    header->magic = FEED_MAGIC;
+    header->version = COMMAND_FEED_VERSION;
+    header->commandSize = sizeof(Graphics::DrawCommand);
+    header->opCount = Graphics::DRAW_OP_COUNT;
+    header->slotSize = (uint32_t)slotSize;
+    header->targetWidth.store(0, std::memory_order_relaxed);
+    header->targetHeight.store(0, std::memory_order_relaxed);
+    // 初始：槽 0 归生产者，槽 1 为（空的）最新槽，槽 2 归渲染端
+    header->state.store(MakeState(1, 2, false), std::memory_order_release);
+
+    eventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    stopFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    sockaddr_un addr;
+    socklen_t length;
+    FillAddress(addr, length, name);
+    if (eventFd < 0 || stopFd < 0 || listenFd < 0 || bind(listenFd, reinterpret_cast<sockaddr *>(&addr), length) != 0 || listen(listenFd, 1) != 0)
+    {
+        Stop();
+        return false;
+    }
+
+    current = nullptr;
+    thread = std::thread(&CommandFeedServer::ListenThread, this);
+    return true;
+}
+
+void CommandFeedServer::Stop()
+{
+    if (thread.joinable())
+    {
+        uint64_t one = 1;
+        ssize_t written = write(stopFd, &one, sizeof(one));
+        (void)written;
+        thread.join();
+    }
+
+    CloseFd(listenFd);
+    CloseFd(stopFd);
+    CloseFd(eventFd);
+    if (header) munmap(header, mapSize);
+    header = nullptr;
+    CloseFd(memFd);
+
+    connected.store(false, std::memory_order_release);
+    current = nullptr;
+}
+
+void CommandFeedServer::SetChangeNotify(const ChangeCallback &callback)
+{
+    std::lock_guard<std::mutex> lock(notifyMutex);
+    notify = callback;
+}
+
+void CommandFeedServer::SetTargetSize(int width, int height)
+{
+    if (!header) return;
+    header->targetWidth.store(width, std::memory_order_relaxed);
+    header->targetHeight.store(height, std::memory_order_relaxed);
+}
+
+bool CommandFeedServer::SendHandles(int client)
+{
+    // 一个字节的正文 + SCM_RIGHTS 附带 memfd 与 eventfd
+    int fds[2] = { memFd, eventFd };
+    char payload = 'F';
+    iovec iov = { &payload, 1 };
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(fds))];
+    memset(control, 0, sizeof(control));
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    return sendmsg(client, &msg, MSG_NOSIGNAL) == 1;
+}
+
+void CommandFeedServer::ListenThread()
+{
+    int client = -1;
+
+    while (true)
+    {
+        pollfd fds[4] = { { stopFd, POLLIN, 0 }, { listenFd, POLLIN, 0 }, { eventFd, POLLIN, 0 }, { client, POLLIN, 0 } };
+        int n = poll(fds, client >= 0 ? 4 : 3, -1);
+        if (n < 0)
+        {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[0].revents) break;
+
+        bool changed = false;
+
+        if (fds[1].revents & POLLIN)
+        {
+            int accepted = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (accepted >= 0)
+            {
+                // 只接受同一用户或 root 的进程，且同一时间只有一个生产者
+                ucred cred;
+                socklen_t credLength = sizeof(cred);
+                bool allowed = getsockopt(accepted, SOL_SOCKET, SO_PEERCRED, &cred, &credLength) == 0 && (cred.uid == getuid() || cred.uid == 0);
+                if (allowed && client < 0 && SendHandles(accepted))
+                {
+                    client = accepted;
+                    generation.fetch_add(1, std::memory_order_release);
+                    connected.store(true, std::memory_order_release);
+                }
+                else
+                {
+                    close(accepted);
+                }
+            }
+        }
+
+        if (fds[2].revents & POLLIN)
+        {
+            uint64_t count;
+            ssize_t got = read(eventFd, &count, sizeof(count));
+            (void)got;
+            changed = true;
+        }
+
+        // 生产者不会再写 socket，可读即断开
+        if (client >= 0 && fds[3].revents)
+        {
+            char byte;
+            if (recv(client, &byte, 1, MSG_DONTWAIT) <= 0)
+            {
+                CloseFd(client);
+                connected.store(false, std::memory_order_release);
+                changed = true;
+            }
+        }
+
+        if (changed)
+        {
+            std::lock_guard<std::mutex> lock(notifyMutex);
+            if (notify) notify();
+        }
+    }
+
+    CloseFd(client);
+}
+
+const FeedFrame *CommandFeedServer::Acquire()
+{
+    if (!header || !connected.load(std::memory_order_acquire))
+    {
+        current = nullptr;
+        return nullptr;
+    }
+
+    // 换了生产者：旧帧作废，等新生产者的第一帧
+    uint32_t gen = generation.load(std::memory_order_acquire);
+    if (gen != acquiredGeneration)
+    {
+        acquiredGeneration = gen;
+        current = nullptr;
+    }
+
+    uint32_t state = header->state.load(std::memory_order_acquire);
+    while (state & STATE_FRESH)
+    {
+        // 交换最新槽与正在读的槽
+        uint32_t ready = state & STATE_READY_MASK;
+        uint32_t front = (state >> STATE_FRONT_SHIFT) & STATE_READY_MASK;
+        if (!header->state.compare_exchange_weak(state, MakeState(front, ready, false), std::memory_order_acq_rel, std::memory_order_acquire)) continue;
+
+        // 新帧只检查一次
+        FeedFrame *frame = SlotAt(header, ready);
+        uint64_t bytes = sizeof(FeedFrame) + (uint64_t)frame->commandCount * sizeof(Graphics::DrawCommand) + frame->dataSize;
+        bool valid = bytes <= header->slotSize && frame->width > 0 && frame->height > 0 && Graphics::CommandBuffer::Validate(frame->GetCommands(), frame->commandCount, frame->GetData(), frame->dataSize);
+        if (valid)
+        {
+            // 读槽归渲染端所有：范围就地限制在帧尺寸内，分块与脏区都不会越界
+            Graphics::CommandBuffer::ClampBounds(const_cast<Graphics::DrawCommand *>(frame->GetCommands()), frame->commandCount, frame->width, frame->height);
+            frame->bounds = frame->bounds.Intersect({ 0, 0, frame->width - 1, frame->height - 1 });
+        }
+        current = valid ? frame : nullptr;
+        break;
+    }
+
+    return current;
+}
+
+// ---------------------------------------------------------------------------
+// 生产者
+// ---------------------------------------------------------------------------
+
+CommandFeedClient::CommandFeedClient() : header(nullptr), mapSize(0), socketFd(-1), eventFd(-1), sequence(0)
+{
+}
+
+CommandFeedClient::~CommandFeedClient()
+{
+    Disconnect();
+}
+
+bool CommandFeedClient::Connect(const char *name)
+{
+    Disconnect();
+
+    socketFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_un addr;
+    socklen_t length;
+    FillAddress(addr, length, name);
+    if (socketFd < 0 || connect(socketFd, reinterpret_cast<sockaddr *>(&addr), length) != 0)
+    {
+        Disconnect();
+        return false;
+    }
+
+    // 渲染端拒绝时直接关闭连接，这里读到 0 字节
+    int fds[2] = { -1, -1 };
+    char payload;
+    iovec iov = { &payload, 1 };
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(fds))];
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t got;
+    do
+    {
+        got = recvmsg(socketFd, &msg, MSG_CMSG_CLOEXEC);
+    } while (got < 0 && errno == EINTR);
+
+    cmsghdr *cmsg = got == 1 ? CMSG_FIRSTHDR(&msg) : nullptr;
+    if (!cmsg || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS || cmsg->cmsg_len != CMSG_LEN(sizeof(fds)))
+    {
+        Disconnect();
+        return false;
+    }
+    memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+    eventFd = fds[1];
+
+    struct stat st;
+    void *memory = fstat(fds[0], &st) == 0 && (size_t)st.st_size > HeaderSize() ? mmap(nullptr, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fds[0], 0) : MAP_FAILED;
+    close(fds[0]);
+    if (memory == MAP_FAILED)
+    {
+        Disconnect();
+        return false;
+    }
+    header = static_cast<FeedHeader *>(memory);
+    mapSize = (size_t)st.st_size;
+
+    // 布局不一致（不同版本编译）时不发布
+    if (header->magic != FEED_MAGIC || header->version != COMMAND_FEED_VERSION || header->commandSize != sizeof(Graphics::DrawCommand) || header->opCount != (uint32_t)Graphics::DRAW_OP_COUNT || HeaderSize() + (size_t)header->slotSize * FEED_SLOTS > mapSize)
+    {
+        Disconnect();
+        return false;
+    }
+    return true;
+}
+
+void CommandFeedClient::Disconnect()
+{
+    if (header) munmap(header, mapSize);
+    header = nullptr;
+    mapSize = 0;
+    CloseFd(eventFd);
+    CloseFd(socketFd);
+}
+
+void CommandFeedClient::GetTargetSize(int &width, int &height) const
+{
+    width = header ? header->targetWidth.load(std::memory_order_relaxed) : 0;
+    height = header ? header->targetHeight.load(std::memory_order_relaxed) : 0;
+}
+
+bool CommandFeedClient::Publish(const Graphics::CommandBuffer &buffer, int width, int height)
+{
+    if (!header) return false;
+
+    const Graphics::DrawCommand *commands = buffer.GetCommands();
+    size_t count = buffer.GetCommandCount();
+    size_t dataSize = buffer.GetDataSize();
+    if (sizeof(FeedFrame) + count * sizeof(Graphics::DrawCommand) + dataSize > header->slotSize) return false;
+    if (!Graphics::CommandBuffer::Validate(commands, count, buffer.GetData(), dataSize)) return false;
+
+    // 既不是最新槽也不是渲染端正在读的槽，渲染端交换这两个槽时不会动它
+    uint32_t state = header->state.load(std::memory_order_acquire);
+    uint32_t ready = state & STATE_READY_MASK;
+    uint32_t front = (state >> STATE_FRONT_SHIFT) & STATE_READY_MASK;
+    uint32_t back = 3 - ready - front;
+
+    FeedFrame *frame = SlotAt(header, back);
+    frame->sequence = ++sequence;
+    frame->width = width;
+    frame->height = height;
+    frame->commandCount = (uint32_t)count;
+    frame->dataSize = (uint32_t)dataSize;
+    frame->reserved = 0;
+    frame->bounds = Graphics::IntRect::Empty();
+    for (size_t i = 0; i < count; i++)
+    {
+        frame->bounds = frame->bounds.Union(commands[i].bounds.Intersect(commands[i].clip));
+    }
+    if (count > 0) memcpy(const_cast<Graphics::DrawCommand *>(frame->GetCommands()), commands, count * sizeof(Graphics::DrawCommand));
+    if (dataSize > 0) memcpy(const_cast<uint8_t *>(frame->GetData()), buffer.GetData(), dataSize);
+
+    // 发布：back 成为最新槽，渲染端正在读的槽保持不变
+    while (!header->state.compare_exchange_weak(state, MakeState(back, (state >> STATE_FRONT_SHIFT) & STATE_READY_MASK, true), std::memory_order_acq_rel, std::memory_order_acquire))
+    {
+    }
+
+    uint64_t one = 1;
+    ssize_t written = write(eventFd, &one, sizeof(one));
+    (void)written;
+    return true;
+}
+
+} // namespace Platform
@@ -0,0 +1,122 @@
+/*
+ * CPU-Draw - Display Monitor Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 屏幕状态监视
+ * 轮询线程按周期（或 Refresh() 唤醒）查询，结果与缓存不同时才更新版本号
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "platform/DisplayMonitor.h"
+#include <chrono>
+
+namespace Platform
+{
+
+DisplayMonitor &DisplayMonitor::Instance()
+{
+    static DisplayMonitor instance;
+    return instance;
+}
+
+DisplayMonitor::DisplayMonitor() : intervalMs(500), running(false), refreshRequested(false), state{ 0, 0, 0, 0 }, version(0), polledVersion(0)
+{
+}
+
+bool DisplayMonitor::Start(const QueryFunction &queryFunction, int interval)
+{
+    Stop();
+
+    query = queryFunction;
+    intervalMs = interval > 0 ? interval : 500;
+
+    DisplayState queried = {};
+    if (!query || !query(queried) || queried.width <= 0 || queried.height <= 0) return false;
+    Update(queried);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    running = true;
+    refreshRequested = false;
+    thread = std::thread(&DisplayMonitor::PollThread, this);
+    return true;
+}
+
+void DisplayMonitor::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    cv.notify_all();
+    if (thread.joinable()) thread.join();
+}
+
+void DisplayMonitor::SetChangeNotify(const ChangeCallback &callback)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    notify = callback;
+}
+
+void DisplayMonitor::Refresh()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        refreshRequested = true;
+    }
+    cv.notify_all();
+}
+
+DisplayState DisplayMonitor::Get() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return state;
+}
+
+bool DisplayMonitor::Poll(DisplayState &out)
+{
+    // 版本号未变时不加锁
+    if (version.load(std::memory_order_acquire) == polledVersion) return false;
+
+    out = Get();
+    polledVersion = out.version;
+    return true;
+}
+
+void DisplayMonitor::Update(const DisplayState &queried)
+{
+    ChangeCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (state.version != 0 && queried.width == state.width && queried.height == state.height && queried.orientation == state.orientation) return;
+
+        state.width = queried.width;
+        state.height = queried.height;
+        state.orientation = queried.orientation;
+        state.version++;
+        version.store(state.version, std::memory_order_release);
+        callback = notify;
+    }
+    if (callback) callback();
+}
+
+void DisplayMonitor::PollThread()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (running)
+    {
+        cv.wait_for(lock, std::chrono::milliseconds(intervalMs), [this]() { return !running || refreshRequested; });
+        if (!running) break;
+        refreshRequested = false;
+
+        // 查询不持锁（binder 调用可能较慢）
+        lock.unlock();
+        DisplayState queried = {};
+        bool ok = query(queried);
+        if (ok && queried.width > 0 && queried.height > 0) Update(queried);
+        lock.lock();
+    }
+}
+
+} // namespace Platform
@@ -0,0 +1,314 @@
+/*
+ * CPU-Draw - Frame Scheduler Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 帧调度器
+ * 垂直同步驱动，CLOCK_MONOTONIC 绝对时间休眠兜底
+ *
+ * 特性：
+ * - Choreographer 回调在渲染线程的 Looper 上派发
+ * - 连续回调的间隔用于估计刷新率
+ * - 空闲等待用条件变量，Wake() 可从任意线程调用
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "platform/FrameScheduler.h"
+#include <cerrno>
+#include <chrono>
+#include <time.h>
+
+#ifdef __ANDROID__
+#include <android/looper.h>
+#include <dlfcn.h>
+#endif
+
+namespace Platform
+{
+
+#ifdef __ANDROID__
+// Choreographer 接口按系统版本运行时解析（postFrameCallback64 需要 API 29）
+typedef void (*FrameCallback64)(int64_t frameTimeNanos, void *data);
+typedef void (*FrameCallbackLong)(long frameTimeNanos, void *data);
+
+static struct
+{
+    bool resolved;
+    void *(*getInstance)();
+    void (*postFrameCallback64)(void *choreographer, FrameCallback64 callback, void *data);
+    void (*postFrameCallback)(void *choreographer, FrameCallbackLong callback, void *data);
+} g_choreographerApi = { false, nullptr, nullptr, nullptr };
+
+static void ResolveChoreographerApi()
+{
+    if (g_choreographerApi.resolved) return;
+    g_choreographerApi.resolved = true;
+
+    void *handle = dlopen("libandroid.so", RTLD_NOW);
+    if (!handle) return;
+
+    g_choreographerApi.getInstance = reinterpret_cast<void *(*)()>(dlsym(handle, "AChoreographer_getInstance"));
+    g_choreographerApi.postFrameCallback64 = reinterpret_cast<void (*)(void *, FrameCallback64, void *)>(dlsym(handle, "AChoreographer_postFrameCallback64"));
+    g_choreographerApi.postFrameCallback = reinterpret_cast<void (*)(void *, FrameCallbackLong, void *)>(dlsym(handle, "AChoreographer_postFrameCallback"));
+}
+
+static void OnVsyncLong(long frameTimeNanos, void *data)
+{
+    FrameScheduler::OnVsync((int64_t)frameTimeNanos, data);
+}
+#endif
+
+FrameScheduler &FrameScheduler::Instance()
+{
+    static FrameScheduler instance;
+    return instance;
+}
+
+FrameScheduler::FrameScheduler() : looper(nullptr), choreographer(nullptr), vsyncPosted(false), vsyncTimeNs(0), vsyncCount(0), vsyncPeriodNs(DEFAULT_PERIOD_NS), periodMeasured(false), nextDeadlineNs(0), wakeRequested(true), frameTimeNs(0), deltaTime(0), requestedFrame(true), resumed(true)
+{
+}
+
+int64_t FrameScheduler::NowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+void FrameScheduler::Init()
+{
+#ifdef __ANDROID__
+    ResolveChoreographerApi();
+
+    looper = ALooper_prepare(0);
+    if (looper && g_choreographerApi.getInstance && (g_choreographerApi.postFrameCallback64 || g_choreographerApi.postFrameCallback))
+    {
+        choreographer = g_choreographerApi.getInstance();
+    }
+#endif
+
+    vsyncPosted = false;
+    nextDeadlineNs = 0;
+
+    // 每帧只等一个回调时测不到周期，先连续等几个垂直同步完成测量
+    if (choreographer)
+    {
+        resumed = true;
+        frameTimeNs = WaitVsync(1);
+        resumed = false;
+        if (choreographer) WaitVsync(3);
+    }
+
+    frameTimeNs = 0;
+    resumed = true;
+    Wake();
+}
+
+void FrameScheduler::Shutdown()
+{
+    DisableVsync();
+    looper = nullptr;
+    Wake();
+}
+
+void FrameScheduler::SetPolicy(const PacingPolicy &policy)
+{
+    this->policy = policy;
+    Wake();
+}
+
+void FrameScheduler::SetTargetFps(int fps)
+{
+    policy.targetFps = fps < 0 ? 0 : fps;
+    Wake();
+}
+
+float FrameScheduler::GetRefreshRate() const
+{
+    return 1e9f / (float)vsyncPeriodNs;
+}
+
+void FrameScheduler::Wake()
+{
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        wakeRequested = true;
+    }
+    wakeCond.notify_one();
+}
+
+// 等待 Wake() 请求，返回是否被请求唤醒（false 为超时）
+bool FrameScheduler::WaitWake(int timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    if (!wakeRequested)
+    {
+        resumed = true;
+        if (timeoutMs > 0)
+        {
+            wakeCond.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]() { return wakeRequested.load(); });
+        }
+        else
+        {
+            wakeCond.wait(lock, [this]() { return wakeRequested.load(); });
+        }
+    }
+    return wakeRequested.exchange(false);
+}
+
+float FrameScheduler::WaitFrame()
+{
+    if (policy.idleSkip)
+    {
+        requestedFrame = WaitWake(policy.idleTimeoutMs);
+    }
+    else
+    {
+        wakeRequested = false;
+        requestedFrame = true;
+    }
+
+    int64_t periodNs;
+    int64_t frameTime;
+    if (choreographer)
+    {
+        // 按刷新率取整到垂直同步的整数倍
+        int interval = 1;
+        if (policy.targetFps > 0)
+        {
+            float refresh = GetRefreshRate();
+            interval = (int)(refresh / (float)policy.targetFps + 0.5f);
+            if (interval < 1) interval = 1;
+        }
+        frameTime = WaitVsync(interval);
+        periodNs = vsyncPeriodNs * interval;
+    }
+    else
+    {
+        periodNs = policy.targetFps > 0 ? 1000000000LL / policy.targetFps : vsyncPeriodNs;
+        frameTime = WaitDeadline(periodNs);
+    }
+
+    // 空闲恢复后的第一帧按一帧间隔计算，避免动画跳变
+    int64_t deltaNs = (resumed || frameTimeNs == 0) ? periodNs : frameTime - frameTimeNs;
+    if (deltaNs < 0) deltaNs = 0;
+    if (deltaNs > MAX_DELTA_NS) deltaNs = MAX_DELTA_NS;
+
+    frameTimeNs = frameTime;
+    deltaTime = (float)deltaNs * 1e-9f;
+    resumed = false;
+    return deltaTime;
+}
+
+void FrameScheduler::OnVsync(int64_t frameTimeNanos, void *data)
+{
+    FrameScheduler *self = static_cast<FrameScheduler *>(data);
+    self->vsyncPosted = false;
+    self->vsyncTimeNs = frameTimeNanos;
+    self->vsyncCount++;
+}
+
+void FrameScheduler::PostVsync()
+{
+#ifdef __ANDROID__
+    if (vsyncPosted || !choreographer) return;
+    vsyncPosted = true;
+
+    if (g_choreographerApi.postFrameCallback64)
+    {
+        g_choreographerApi.postFrameCallback64(choreographer, OnVsync, this);
+    }
+    else
+    {
+        g_choreographerApi.postFrameCallback(choreographer, OnVsyncLong, this);
+    }
+#endif
+}
+
+// 等待距上一帧 interval 个周期的垂直同步，返回其时间戳
+int64_t FrameScheduler::WaitVsync(int interval)
+{
+#ifdef __ANDROID__
+    // 留半个周期余量，抵消时间戳抖动
+    int64_t minTime = (resumed || frameTimeNs == 0) ? 0 : frameTimeNs + interval * vsyncPeriodNs - vsyncPeriodNs / 2;
+    int64_t prevTime = -1;
+
+    while (true)
+    {
+        PostVsync();
+
+        uint64_t count = vsyncCount;
+        int result = ALooper_pollOnce(VSYNC_TIMEOUT_MS, nullptr, nullptr, nullptr);
+        if (result == ALOOPER_POLL_TIMEOUT && vsyncCount == count)
+        {
+            // 收不到回调（无显示连接等），降级为定时休眠
+            DisableVsync();
+            return WaitDeadline(vsyncPeriodNs * interval);
+        }
+        if (vsyncCount == count) continue;
+
+        // 连续两次回调之间正好一个周期，用来估计刷新率
+        if (prevTime >= 0)
+        {
+            int64_t d = vsyncTimeNs - prevTime;
+            if (d > 3000000 && d < 50000000)
+            {
+                if (!periodMeasured)
+                {
+                    vsyncPeriodNs = d;
+                    periodMeasured = true;
+                }
+                else if (d < vsyncPeriodNs * 3 / 2)
+                {
+                    vsyncPeriodNs += (d - vsyncPeriodNs) / 8;
+                }
+            }
+        }
+        prevTime = vsyncTimeNs;
+
+        if (vsyncTimeNs >= minTime && vsyncTimeNs > frameTimeNs)
+        {
+            return vsyncTimeNs;
+        }
+    }
+#else
+    return WaitDeadline(vsyncPeriodNs * interval);
+#endif
+}
+
+// 绝对时间休眠到下一帧，返回该帧的理想开始时间
+int64_t FrameScheduler::WaitDeadline(int64_t periodNs)
+{
+    int64_t now = NowNs();
+    int64_t target = nextDeadlineNs + periodNs;
+
+    // 首帧、空闲恢复或落后超过一帧时重新对齐到当前时间
+    if (resumed || nextDeadlineNs == 0 || now > target + periodNs)
+    {
+        nextDeadlineNs = now;
+        return now;
+    }
+
+    if (target > now)
+    {
+        struct timespec ts;
+        ts.tv_sec = target / 1000000000LL;
+        ts.tv_nsec = target % 1000000000LL;
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+        {
+        }
+    }
+
+    nextDeadlineNs = target;
+    return target;
+}
+
+void FrameScheduler::DisableVsync()
+{
+    choreographer = nullptr;
+    vsyncPosted = false;
+    nextDeadlineNs = 0;
+}
+
+} // namespace Platform
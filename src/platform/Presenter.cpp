@@ -0,0 +1,273 @@
+/*
+ * CPU-Draw - Presenter Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 帧提交
+ * 后台缓冲状态：Free -> Rendering -> Queued -> Presenting -> Free
+ * 同一时刻最多一帧排队，提交顺序即投递顺序
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "platform/Presenter.h"
+#include "core/Profiler.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace Platform
+{
+
+static const int BUFFER_ALIGNMENT = 64;
+static const int STRIDE_ALIGNMENT = BUFFER_ALIGNMENT / sizeof(uint32_t);
+
+#ifdef __ANDROID__
+bool NativeWindowTarget::SetGeometry(int width, int height)
+{
+    int32_t windowFormat = format == Graphics::PixelFormat::RGB565 ? WINDOW_FORMAT_RGB_565 : WINDOW_FORMAT_RGBA_8888;
+    return ANativeWindow_setBuffersGeometry(window, width, height, windowFormat) == 0;
+}
+
+bool NativeWindowTarget::Lock(LockedBuffer &buffer)
+{
+    ANativeWindow_Buffer locked;
+    ARect dirty = { buffer.dirty.x0, buffer.dirty.y0, buffer.dirty.x1 + 1, buffer.dirty.y1 + 1 };
+    if (ANativeWindow_lock(window, &locked, &dirty) != 0) return false;
+
+    // 以系统实际分配的格式为准
+    switch (locked.format)
+    {
+    case WINDOW_FORMAT_RGBA_8888:
+    case WINDOW_FORMAT_RGBX_8888: buffer.format = Graphics::PixelFormat::RGBA8888; break;
+    case WINDOW_FORMAT_RGB_565: buffer.format = Graphics::PixelFormat::RGB565; break;
+    default: ANativeWindow_unlockAndPost(window); return false;
+    }
+
+    buffer.bits = locked.bits;
+    buffer.stride = locked.stride;
+    buffer.width = locked.width;
+    buffer.height = locked.height;
+    // 系统按自身缓冲年龄扩大的范围，范围外保留上一帧内容
+    buffer.dirty = Graphics::IntRect{ dirty.left, dirty.top, dirty.right - 1, dirty.bottom - 1 };
+    return true;
+}
+
+void NativeWindowTarget::Post()
+{
+    ANativeWindow_unlockAndPost(window);
+}
+#endif
+
+Presenter::Presenter() : target(nullptr), pipelined(false), submitted(0), lastSubmittedBounds(Graphics::IntRect::Empty()), presentedWidth(0), presentedHeight(0), running(false), failed(false)
+{
+    for (Slot &slot : slots)
+    {
+        slot.buffer = BackBuffer{ nullptr, 0, 0, 0, Graphics::IntRect::Empty() };
+        slot.state = BufferState::Free;
+        slot.sequence = 0;
+        slot.damage = Graphics::IntRect::Empty();
+    }
+}
+
+Presenter::~Presenter()
+{
+    Stop();
+    for (Slot &slot : slots)
+    {
+        Release(slot.buffer);
+    }
+}
+
+void Presenter::Start(PresentTarget *presentTarget, bool enablePipeline)
+{
+    Stop();
+
+    target = presentTarget;
+    pipelined = enablePipeline;
+    failed = false;
+    presentedWidth = 0;
+    presentedHeight = 0;
+
+    if (pipelined)
+    {
+        running = true;
+        thread = std::thread(&Presenter::PresentThread, this);
+    }
+}
+
+void Presenter::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    cv.notify_all();
+    if (thread.joinable()) thread.join();
+}
+
+bool Presenter::HasFailed() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return failed;
+}
+
+bool Presenter::Allocate(BackBuffer &buffer, int width, int height)
+{
+    Release(buffer);
+
+    int stride = (width + STRIDE_ALIGNMENT - 1) & ~(STRIDE_ALIGNMENT - 1);
+    void *memory = nullptr;
+    if (posix_memalign(&memory, BUFFER_ALIGNMENT, (size_t)stride * height * sizeof(uint32_t)) != 0) return false;
+    memset(memory, 0, (size_t)stride * height * sizeof(uint32_t));
+
+    buffer.pixels = static_cast<uint32_t *>(memory);
+    buffer.stride = stride;
+    buffer.width = width;
+    buffer.height = height;
+    buffer.content = Graphics::IntRect::Empty();
+    return true;
+}
+
+void Presenter::Release(BackBuffer &buffer)
+{
+    free(buffer.pixels);
+    buffer = BackBuffer{ nullptr, 0, 0, 0, Graphics::IntRect::Empty() };
+}
+
+BackBuffer *Presenter::Acquire(int width, int height)
+{
+    if (width <= 0 || height <= 0) return nullptr;
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // 优先取最近提交的空闲缓冲，需要修补的范围最小
+    Slot *slot = nullptr;
+    cv.wait(lock, [&]() {
+        if (failed) return true;
+        for (Slot &s : slots)
+        {
+            if (s.state == BufferState::Free && (!slot || s.sequence > slot->sequence)) slot = &s;
+        }
+        return slot != nullptr;
+    });
+    if (failed) return nullptr;
+
+    slot->state = BufferState::Rendering;
+    lock.unlock();
+
+    BackBuffer &buffer = slot->buffer;
+    if (buffer.width != width || buffer.height != height)
+    {
+        if (!Allocate(buffer, width, height))
+        {
+            lock.lock();
+            slot->state = BufferState::Free;
+            return nullptr;
+        }
+    }
+    return &buffer;
+}
+
+void Presenter::Submit(BackBuffer *buffer, const Graphics::IntRect &drawn)
+{
+    Slot *slot = nullptr;
+    for (Slot &s : slots)
+    {
+        if (&s.buffer == buffer) slot = &s;
+    }
+    if (!slot) return;
+
+    buffer->content = drawn;
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // 相对上一帧的变化：本帧范围 ∪ 上一帧范围（上一帧的内容要被擦掉）
+    slot->damage = drawn.Union(lastSubmittedBounds).Intersect(Graphics::IntRect{ 0, 0, buffer->width - 1, buffer->height - 1 });
+    slot->sequence = ++submitted;
+    lastSubmittedBounds = drawn;
+
+    if (!pipelined)
+    {
+        slot->state = BufferState::Presenting;
+        lock.unlock();
+        bool ok = PresentSlot(*slot);
+        lock.lock();
+        slot->state = BufferState::Free;
+        if (!ok) failed = true;
+        return;
+    }
+
+    slot->state = BufferState::Queued;
+    lock.unlock();
+    cv.notify_all();
+}
+
+bool Presenter::PresentSlot(Slot &slot)
+{
+    CPUDRAW_PROFILE_SCOPE(Present);
+
+    const BackBuffer &buffer = slot.buffer;
+    Graphics::IntRect damage = slot.damage;
+
+    // 只在尺寸真正变化时重设几何，新缓冲没有旧内容，整屏提交
+    if (buffer.width != presentedWidth || buffer.height != presentedHeight)
+    {
+        if (!target->SetGeometry(buffer.width, buffer.height)) return false;
+        presentedWidth = buffer.width;
+        presentedHeight = buffer.height;
+        damage = Graphics::IntRect{ 0, 0, buffer.width - 1, buffer.height - 1 };
+    }
+    if (damage.IsEmpty()) return true;
+
+    LockedBuffer locked;
+    locked.dirty = damage;
+    bool ok;
+    {
+        CPUDRAW_PROFILE_SCOPE(Lock);
+        ok = target->Lock(locked);
+    }
+    if (!ok) return false;
+
+    // 后台缓冲保存的是完整一帧，系统扩大后的范围同样可以直接拷贝
+    Graphics::IntRect copy = locked.dirty.Intersect(Graphics::IntRect{ 0, 0, std::min(buffer.width, locked.width) - 1, std::min(buffer.height, locked.height) - 1 });
+    if (!copy.IsEmpty())
+    {
+        Graphics::convert_rect(locked.format, locked.bits, locked.stride, buffer.pixels, buffer.stride, copy);
+    }
+
+    target->Post();
+    return true;
+}
+
+void Presenter::PresentThread()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        Slot *slot = nullptr;
+        cv.wait(lock, [&]() {
+            // 醒得晚时可能有多帧排队：按提交顺序先送最早的，最后显示的总是最新帧
+            slot = nullptr;
+            for (Slot &s : slots)
+            {
+                if (s.state == BufferState::Queued && (!slot || s.sequence < slot->sequence)) slot = &s;
+            }
+            return slot != nullptr || !running;
+        });
+        // 退出前把已排队的帧提交完
+        if (!slot) break;
+
+        slot->state = BufferState::Presenting;
+        lock.unlock();
+        bool ok = PresentSlot(*slot);
+        lock.lock();
+
+        slot->state = BufferState::Free;
+        if (!ok) failed = true;
+        cv.notify_all();
+        if (failed) break;
+    }
+}
+
+} // namespace Platform
@@ -0,0 +1,162 @@
+/*
+ * CPU-Draw - Quality Governor Module
+ * Created: 2026-10-15
+ * By: MaySnowL
+ *
+ * 自适应画质
+ * 渲染耗时取指数平均后与当前档位的预算比较，温控状态只抬高最低档位
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "platform/QualityGovernor.h"
+#include <algorithm>
+
+namespace Platform
+{
+
+static const float AVERAGE_WEIGHT = 0.1f; // 新样本在指数平均中的权重
+
+static const QualitySettings LEVEL_SETTINGS[(int)QualityLevel::Count] = {
+    { true, true, 250, 1.0f, 1.0f },    // Full
+    { false, true, 250, 1.0f, 1.0f },   // NoShadow
+    { false, false, 250, 1.0f, 1.0f },  // NoAntiAliasing
+    { false, false, 1000, 1.0f, 1.0f }, // SlowRefresh
+    { false, false, 1000, 0.75f, 1.0f }, // Scale75
+    { false, false, 1000, 0.5f, 1.0f }, // Scale50
+    { false, false, 1000, 0.5f, 0.5f }, // ReducedFps
+};
+
+static const char *const LEVEL_NAMES[(int)QualityLevel::Count] = { "Full", "NoShadow", "NoAA", "SlowRefresh", "Scale75", "Scale50", "HalfFps" };
+
+// 温控状态对应的最低档位
+static QualityLevel ThermalFloor(ThermalStatus status, float headroom)
+{
+    QualityLevel floor;
+    switch (status)
+    {
+    case ThermalStatus::None: floor = QualityLevel::Full; break;
+    case ThermalStatus::Light: floor = QualityLevel::NoShadow; break;
+    case ThermalStatus::Moderate: floor = QualityLevel::SlowRefresh; break;
+    case ThermalStatus::Severe: floor = QualityLevel::Scale50; break;
+    default: floor = QualityLevel::ReducedFps; break;
+    }
+
+    // 余量接近 1 说明很快会重度降频，提前降档
+    if (headroom >= 0.95f) floor = std::max(floor, QualityLevel::Scale75);
+    else if (headroom >= 0.85f) floor = std::max(floor, QualityLevel::SlowRefresh);
+    return floor;
+}
+
+QualityGovernor::QualityGovernor(const GovernorConfig &governorConfig) : config(governorConfig), level(QualityLevel::Full), thermalFloor(QualityLevel::Full)
+{
+    Reset();
+}
+
+void QualityGovernor::SetConfig(const GovernorConfig &governorConfig)
+{
+    config = governorConfig;
+    if (level > config.maxLevel) SetLevel(config.maxLevel);
+}
+
+void QualityGovernor::Reset()
+{
+    level = QualityLevel::Full;
+    thermalFloor = QualityLevel::Full;
+    averageNs = 0.0f;
+    cooldown = 0;
+    overFrames = 0;
+    underFrames = 0;
+    upgradedFrom = -1;
+    framesSinceUpgrade = 0;
+    std::fill(holdShift, holdShift + LEVEL_COUNT, 0);
+}
+
+QualitySettings QualityGovernor::SettingsFor(QualityLevel quality)
+{
+    return LEVEL_SETTINGS[std::min((int)quality, LEVEL_COUNT - 1)];
+}
+
+const char *QualityGovernor::GetLevelName(QualityLevel quality)
+{
+    return LEVEL_NAMES[std::min((int)quality, LEVEL_COUNT - 1)];
+}
+
+int64_t QualityGovernor::GetBudgetNs(QualityLevel quality, float baseFps) const
+{
+    float fps = std::max(1.0f, baseFps * SettingsFor(quality).fpsScale);
+    return (int64_t)(config.cpuBudget * 1e9f / fps);
+}
+
+void QualityGovernor::SetLevel(QualityLevel next)
+{
+    level = next;
+    // 切档后的几帧还带着旧档位的开销（缓存重建、缓冲重设），不计入
+    averageNs = 0.0f;
+    cooldown = config.cooldownFrames;
+    overFrames = 0;
+    underFrames = 0;
+}
+
+bool QualityGovernor::SetThermal(ThermalStatus status, float headroom)
+{
+    thermalFloor = std::min(ThermalFloor(status, headroom), config.maxLevel);
+    if (level >= thermalFloor) return false;
+
+    // 发热导致的降档不算振荡
+    upgradedFrom = -1;
+    SetLevel(thermalFloor);
+    return true;
+}
+
+bool QualityGovernor::Update(int64_t workNs, float baseFps)
+{
+    framesSinceUpgrade++;
+    if (cooldown > 0)
+    {
+        cooldown--;
+        return false;
+    }
+
+    averageNs = averageNs == 0.0f ? (float)workNs : averageNs + ((float)workNs - averageNs) * AVERAGE_WEIGHT;
+
+    int current = (int)level;
+    bool canDowngrade = level < config.maxLevel;
+    bool canUpgrade = level > thermalFloor;
+
+    if (averageNs > (float)GetBudgetNs(level, baseFps))
+    {
+        underFrames = 0;
+        if (canDowngrade && ++overFrames >= config.downgradeFrames)
+        {
+            // 刚升上来又撑不住：下次要在原档位等更久才升
+            if (upgradedFrom == current + 1 && framesSinceUpgrade < config.upgradeFrames << holdShift[current + 1])
+            {
+                holdShift[current + 1] = std::min(holdShift[current + 1] + 1, MAX_HOLD_SHIFT);
+            }
+            upgradedFrom = -1;
+            SetLevel((QualityLevel)(current + 1));
+            return true;
+        }
+    }
+    else if (canUpgrade && averageNs < config.upgradeRatio * (float)GetBudgetNs((QualityLevel)(current - 1), baseFps))
+    {
+        overFrames = 0;
+        if (++underFrames >= config.upgradeFrames << holdShift[current])
+        {
+            upgradedFrom = current;
+            framesSinceUpgrade = 0;
+            SetLevel((QualityLevel)(current - 1));
+            return true;
+        }
+    }
+    else
+    {
+        // 介于两个阈值之间：保持当前档位
+        overFrames = 0;
+        underFrames = 0;
+    }
+    return false;
+}
+
+} // namespace Platform
@@ -0,0 +1,209 @@
+/*
+ * CPU-Draw - Thermal Monitor Module
+ * Created: 2026-10-15
+ * By: MaySnowL
+ *
+ * 温控状态监视
+ * AThermal 接口按系统版本运行时解析，不可用时退回 sysfs 温区温度
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "platform/ThermalMonitor.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+
+#ifdef __ANDROID__
+#include <dlfcn.h>
+#endif
+
+namespace Platform
+{
+
+#ifdef __ANDROID__
+// AThermal_getCurrentThermalStatus 需要 API 30，AThermal_getThermalHeadroom 需要 API 31
+static struct
+{
+    bool resolved;
+    void *(*acquireManager)();
+    void (*releaseManager)(void *manager);
+    int (*getCurrentStatus)(void *manager);
+    float (*getHeadroom)(void *manager, int forecastSeconds);
+} g_thermalApi = { false, nullptr, nullptr, nullptr, nullptr };
+
+static void ResolveThermalApi()
+{
+    if (g_thermalApi.resolved) return;
+    g_thermalApi.resolved = true;
+
+    void *handle = dlopen("libandroid.so", RTLD_NOW);
+    if (!handle) return;
+
+    g_thermalApi.acquireManager = reinterpret_cast<void *(*)()>(dlsym(handle, "AThermal_acquireManager"));
+    g_thermalApi.releaseManager = reinterpret_cast<void (*)(void *)>(dlsym(handle, "AThermal_releaseManager"));
+    g_thermalApi.getCurrentStatus = reinterpret_cast<int (*)(void *)>(dlsym(handle, "AThermal_getCurrentThermalStatus"));
+    g_thermalApi.getHeadroom = reinterpret_cast<float (*)(void *, int)>(dlsym(handle, "AThermal_getThermalHeadroom"));
+}
+#endif
+
+// sysfs 温区的最高温度（摄氏度），读不到返回 NaN
+static float ReadMaxZoneTemperature()
+{
+    DIR *dir = opendir("/sys/class/thermal");
+    if (!dir) return NAN;
+
+    float maxTemp = NAN;
+    while (dirent *entry = readdir(dir))
+    {
+        if (strncmp(entry->d_name, "thermal_zone", 12) != 0) continue;
+
+        char path[300];
+        snprintf(path, sizeof(path), "/sys/class/thermal/%s/temp", entry->d_name);
+        FILE *file = fopen(path, "r");
+        if (!file) continue;
+
+        long value = 0;
+        if (fscanf(file, "%ld", &value) == 1)
+        {
+            // 多数温区单位为毫摄氏度，少数直接是摄氏度；离谱的读数（未接传感器）忽略
+            float temp = value > 1000 ? value / 1000.0f : (float)value;
+            if (temp > 0.0f && temp < 150.0f && !(temp <= maxTemp)) maxTemp = temp;
+        }
+        fclose(file);
+    }
+    closedir(dir);
+    return maxTemp;
+}
+
+// 按最高温区温度粗略估算（不同机型的降频温度不同，只作兜底）
+static ThermalStatus StatusFromTemperature(float temp)
+{
+    if (temp >= 65.0f) return ThermalStatus::Emergency;
+    if (temp >= 55.0f) return ThermalStatus::Critical;
+    if (temp >= 50.0f) return ThermalStatus::Severe;
+    if (temp >= 46.0f) return ThermalStatus::Moderate;
+    if (temp >= 42.0f) return ThermalStatus::Light;
+    return ThermalStatus::None;
+}
+
+ThermalMonitor &ThermalMonitor::Instance()
+{
+    static ThermalMonitor instance;
+    return instance;
+}
+
+ThermalMonitor::ThermalMonitor() : intervalMs(2000), manager(nullptr), running(false), status((int)ThermalStatus::None), headroom(-1.0f)
+{
+}
+
+ThermalMonitor::~ThermalMonitor()
+{
+    Stop();
+}
+
+bool ThermalMonitor::Start(int interval)
+{
+    Stop();
+    intervalMs = interval > 0 ? interval : 2000;
+
+#ifdef __ANDROID__
+    ResolveThermalApi();
+    if (!manager && g_thermalApi.acquireManager && g_thermalApi.getCurrentStatus)
+    {
+        manager = g_thermalApi.acquireManager();
+    }
+#endif
+
+    ThermalStatus queried;
+    float queriedHeadroom;
+    if (!Query(queried, queriedHeadroom)) return false;
+    status.store((int)queried, std::memory_order_relaxed);
+    headroom.store(queriedHeadroom, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    running = true;
+    thread = std::thread(&ThermalMonitor::PollThread, this);
+    return true;
+}
+
+void ThermalMonitor::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    cv.notify_all();
+    if (thread.joinable()) thread.join();
+
+#ifdef __ANDROID__
+    if (manager && g_thermalApi.releaseManager) g_thermalApi.releaseManager(manager);
+#endif
+    manager = nullptr;
+}
+
+void ThermalMonitor::SetChangeNotify(const ChangeCallback &callback)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    notify = callback;
+}
+
+bool ThermalMonitor::Query(ThermalStatus &queried, float &queriedHeadroom)
+{
+    queriedHeadroom = -1.0f;
+
+#ifdef __ANDROID__
+    if (manager)
+    {
+        int value = g_thermalApi.getCurrentStatus(manager);
+        if (value >= 0)
+        {
+            queried = (ThermalStatus)std::min(value, (int)ThermalStatus::Shutdown);
+            // 余量预测 10 秒后的状态，不支持时返回 NaN
+            if (g_thermalApi.getHeadroom)
+            {
+                float h = g_thermalApi.getHeadroom(manager, 10);
+                if (!std::isnan(h)) queriedHeadroom = h;
+            }
+            return true;
+        }
+    }
+#endif
+
+    float temp = ReadMaxZoneTemperature();
+    if (std::isnan(temp)) return false;
+    queried = StatusFromTemperature(temp);
+    return true;
+}
+
+void ThermalMonitor::PollThread()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (running)
+    {
+        cv.wait_for(lock, std::chrono::milliseconds(intervalMs), [this]() { return !running; });
+        if (!running) break;
+
+        // 查询不持锁（binder 调用可能较慢）
+        lock.unlock();
+        ThermalStatus queried;
+        float queriedHeadroom;
+        bool ok = Query(queried, queriedHeadroom);
+        lock.lock();
+        if (!ok) continue;
+
+        headroom.store(queriedHeadroom, std::memory_order_relaxed);
+        if ((int)queried != status.exchange((int)queried, std::memory_order_relaxed) && notify)
+        {
+            ChangeCallback callback = notify;
+            lock.unlock();
+            callback();
+            lock.lock();
+        }
+    }
+}
+
+} // namespace Platform
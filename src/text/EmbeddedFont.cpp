@@ -0,0 +1,31 @@
+/*
+ * CPU-Draw - Embedded Font Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 内嵌字体（可选）
+ * 只在 CPUDRAW_EMBED_FONT 打开时参与编译
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "text/EmbeddedFont.h"
+
+// 子集构建时使用生成的头文件，符号名与 Font.h 相同
+#if CPUDRAW_FONT_SUBSET
+#include "FontSubset.h"
+#else
+#include "text/Font.h"
+#endif
+
+namespace Text
+{
+
+bool GetEmbeddedFont(const unsigned char *&data, size_t &size)
+{
+    data = reinterpret_cast<const unsigned char *>(OPPOSans_H);
+    size = OPPOSans_H_size;
+    return true;
+}
+
+} // namespace Text
@@ -0,0 +1,248 @@
+/*
+ * CPU-Draw - Font Manager Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 字体管理模块
+ * 字体文件只读映射后直接交给 stb，不复制、不解压
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "core/FrameArena.h"
+#include <cstddef>
+
+namespace Text
+{
+void *StbScratchAlloc(size_t size);
+void StbScratchFree(void *pointer);
+}
+
+// stb 的临时分配（轮廓、边表、扫描线）走线程内 arena
+#define STBTT_malloc(x, u) ((void)(u), Text::StbScratchAlloc(x))
+#define STBTT_free(x, u) ((void)(u), Text::StbScratchFree(x))
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "text/FontManager.h"
+#include "text/EmbeddedFont.h"
+#include "text/GlyphCache.h"
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Text
+{
+
+// stb 的分配总是成对释放：本线程未释放的分配归零时整体回收，字形光栅化不再逐次 malloc
+struct StbScratch
+{
+    Core::FrameArena arena;
+    int live = 0;
+};
+
+static StbScratch &stb_scratch()
+{
+    thread_local StbScratch scratch;
+    return scratch;
+}
+
+void *StbScratchAlloc(size_t size)
+{
+    StbScratch &scratch = stb_scratch();
+    scratch.live++;
+    return scratch.arena.Allocate(size);
+}
+
+void StbScratchFree(void *pointer)
+{
+    if (!pointer) return;
+    StbScratch &scratch = stb_scratch();
+    if (--scratch.live == 0) scratch.arena.Reset();
+}
+
+// 程序目录下随包部署的字体
+static const char *const BUNDLED_FONTS[] = {
+    "fonts/OPPOSans-H.ttf",
+};
+
+// 系统回退字体（按优先级，只加载第一个存在的）
+static const char *const SYSTEM_FONTS[] = {
+    // Android
+    "/system/fonts/NotoSansCJK-Regular.ttc",
+    "/system/fonts/NotoSansSC-Regular.otf",
+    "/system/fonts/DroidSansFallback.ttf",
+    "/system/fonts/Roboto-Regular.ttf",
+    // Linux 主机
+    "/usr/share/fonts/opentype/noto/NotoSansCJK-Regular.ttc",
+    "/usr/share/fonts/truetype/wqy/wqy-microhei.ttc",
+    "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+};
+
+FontManager::~FontManager()
+{
+    // 退出阶段 GlyphCache 可能已析构，这里只解除映射
+    Unload();
+}
+
+int FontManager::AddFace(const unsigned char *data, size_t size, int index, bool mapped, const char *name)
+{
+    int offset = stbtt_GetFontOffsetForIndex(data, index);
+    if (offset < 0 || (size_t)offset >= size) return -1;
+
+    std::unique_ptr<FontFace> face(new FontFace());
+    if (!stbtt_InitFont(&face->info, data, offset)) return -1;
+
+    face->data = data;
+    face->size = size;
+    face->mapped = mapped;
+    face->name = name;
+
+    faces.push_back(std::move(face));
+    chain.push_back((int)faces.size() - 1);
+
+    // 主字体变化后缓存的度量与字形都可能失效
+    if (chain.size() == 1) GlyphCache::Instance().Clear();
+    return (int)faces.size() - 1;
+}
+
+int FontManager::LoadFile(const char *path, int index)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void *memory = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // 映射建立后即可关闭描述符
+    close(fd);
+    if (memory == MAP_FAILED) return -1;
+
+    // 字形按需随机访问，不做预读
+    madvise(memory, size, MADV_RANDOM);
+
+    int id = AddFace(static_cast<const unsigned char *>(memory), size, index, true, path);
+    if (id < 0) munmap(memory, size);
+    return id;
+}
+
+int FontManager::LoadMemory(const unsigned char *data, size_t size, int index, const char *name)
+{
+    if (!data || size == 0) return -1;
+    return AddFace(data, size, index, false, name);
+}
+
+bool FontManager::LoadFirstExisting(const char *const *paths, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (LoadFile(paths[i]) >= 0) return true;
+    }
+    return false;
+}
+
+bool FontManager::LoadDefaults()
+{
+    // CPUDRAW_FONT：冒号分隔的字体路径，按顺序组成回退链
+    const char *env = getenv("CPUDRAW_FONT");
+    if (env && *env)
+    {
+        std::string list(env);
+        size_t start = 0;
+        while (start <= list.size())
+        {
+            size_t end = list.find(':', start);
+            if (end == std::string::npos) end = list.size();
+            if (end > start) LoadFile(list.substr(start, end - start).c_str());
+            start = end + 1;
+        }
+    }
+
+    // 程序目录下的 fonts/
+    if (chain.empty())
+    {
+        char exe[4096];
+        ssize_t n = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+        if (n > 0)
+        {
+            exe[n] = '\0';
+            char *slash = strrchr(exe, '/');
+            if (slash) slash[1] = '\0';
+
+            for (const char *bundled : BUNDLED_FONTS)
+            {
+                std::string path = std::string(exe) + bundled;
+                if (LoadFile(path.c_str()) >= 0) break;
+            }
+        }
+    }
+
+    // 内嵌字体
+    if (chain.empty())
+    {
+        const unsigned char *data;
+        size_t size;
+        if (GetEmbeddedFont(data, size)) LoadMemory(data, size, 0, "embedded");
+    }
+
+    // 系统字体作为回退（主字体可能是子集）
+    LoadFirstExisting(SYSTEM_FONTS, (int)(sizeof(SYSTEM_FONTS) / sizeof(SYSTEM_FONTS[0])));
+
+    return !chain.empty();
+}
+
+void FontManager::SetFallbackChain(const std::vector<int> &order)
+{
+    std::vector<int> next;
+    for (int id : order)
+    {
+        if (GetFace(id)) next.push_back(id);
+    }
+    if (next == chain) return;
+
+    // 回退顺序变化会改变字形来源
+    chain = next;
+    GlyphCache::Instance().Clear();
+}
+
+const FontFace *FontManager::FindGlyph(int codepoint, int &glyph) const
+{
+    for (int id : chain)
+    {
+        const FontFace *face = faces[id].get();
+        int index = stbtt_FindGlyphIndex(&face->info, codepoint);
+        if (index != 0)
+        {
+            glyph = index;
+            return face;
+        }
+    }
+
+    glyph = 0;
+    return GetPrimary();
+}
+
+void FontManager::Clear()
+{
+    GlyphCache::Instance().Clear();
+    Unload();
+}
+
+void FontManager::Unload()
+{
+    for (auto &face : faces)
+    {
+        if (face->mapped) munmap(const_cast<unsigned char *>(face->data), face->size);
+    }
+    faces.clear();
+    chain.clear();
+}
+
+} // namespace Text
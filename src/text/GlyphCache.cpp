@@ -0,0 +1,208 @@
+/*
+ * CPU-Draw - Glyph Cache Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 字形缓存模块
+ * 按 (codepoint, font_size) 缓存光栅化结果
+ *
+ * 特性：
+ * - 8 位覆盖率图集（货架式打包）
+ * - 缓存步进与偏移量
+ * - 缓存命中后不再调用 stb
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "text/GlyphCache.h"
+#include "core/Profiler.h"
+#include "text/FontManager.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Text
+{
+
+void GlyphCache::Clear()
+{
+    glyphs.clear();
+    metrics.clear();
+    pages.clear();
+    generation++;
+}
+
+const SizeMetrics &GlyphCache::GetMetrics(int font_size)
+{
+    auto it = metrics.find(font_size);
+    if (it != metrics.end()) return it->second;
+
+    SizeMetrics m = {};
+    const FontFace *primary = FontManager::Instance().GetPrimary();
+    if (primary)
+    {
+        const stbtt_fontinfo *font = &primary->info;
+        m.font.scale = stbtt_ScaleForPixelHeight(font, font_size);
+        stbtt_GetFontVMetrics(font, &m.font.ascent, &m.font.descent, &m.font.lineGap);
+        m.lineHeight = (m.font.ascent - m.font.descent + m.font.lineGap) * m.font.scale;
+    }
+
+    return metrics.emplace(font_size, m).first->second;
+}
+
+const GlyphInfo *GlyphCache::GetGlyph(int codepoint, int font_size)
+{
+    uint64_t key = MakeKey(codepoint, font_size);
+    auto it = glyphs.find(key);
+    if (it != glyphs.end()) return &it->second;
+
+    int glyph;
+    const FontFace *face = FontManager::Instance().FindGlyph(codepoint, glyph);
+    if (!face) return nullptr;
+    CPUDRAW_PROFILE_COUNT(GlyphsRasterized, 1);
+
+    // 回退字体按自身单位换算到同一像素高度
+    const stbtt_fontinfo *font = &face->info;
+    float scale = stbtt_ScaleForPixelHeight(font, font_size);
+
+    GlyphInfo info = {};
+
+    int advance, lsb;
+    stbtt_GetGlyphHMetrics(font, glyph, &advance, &lsb);
+    info.advance = advance * scale;
+
+    int x0, y0, x1, y1;
+    stbtt_GetGlyphBitmapBox(font, glyph, scale, scale, &x0, &y0, &x1, &y1);
+    info.offsetX = x0;
+    info.offsetY = y0;
+    info.width = x1 - x0;
+    info.height = y1 - y0;
+
+    if (info.width > 0 && info.height > 0)
+    {
+        if (!AllocateOrReset(info.width, info.height, info.page, info.atlasX, info.atlasY))
+        {
+            return nullptr;
+        }
+
+        uint8_t *dst = pages[info.page].pixels.data() + info.atlasY * PAGE_SIZE + info.atlasX;
+        stbtt_MakeGlyphBitmap(font, dst, info.width, info.height, PAGE_SIZE, scale, scale, glyph);
+    }
+    else
+    {
+        info.width = 0;
+        info.height = 0;
+    }
+
+    return &glyphs.emplace(key, info).first->second;
+}
+
+const GlyphInfo *GlyphCache::GetSdfGlyph(int codepoint)
+{
+    uint64_t key = MakeKey(codepoint, SDF_KEY_SIZE);
+    auto it = glyphs.find(key);
+    if (it != glyphs.end()) return &it->second;
+
+    int glyph;
+    const FontFace *face = FontManager::Instance().FindGlyph(codepoint, glyph);
+    if (!face) return nullptr;
+    CPUDRAW_PROFILE_COUNT(GlyphsRasterized, 1);
+
+    const stbtt_fontinfo *font = &face->info;
+    float scale = stbtt_ScaleForPixelHeight(font, SDF_BASE_SIZE);
+
+    GlyphInfo info = {};
+
+    int advance, lsb;
+    stbtt_GetGlyphHMetrics(font, glyph, &advance, &lsb);
+    info.advance = advance * scale;
+
+    int w = 0, h = 0, xoff = 0, yoff = 0;
+    unsigned char *sdf = stbtt_GetGlyphSDF(font, scale, glyph, SDF_PADDING, SDF_ONEDGE, (float)SDF_DIST_SCALE, &w, &h, &xoff, &yoff);
+
+    if (sdf && w > 0 && h > 0)
+    {
+        info.offsetX = xoff;
+        info.offsetY = yoff;
+        info.width = w;
+        info.height = h;
+
+        if (!AllocateOrReset(w, h, info.page, info.atlasX, info.atlasY))
+        {
+            stbtt_FreeSDF(sdf, nullptr);
+            return nullptr;
+        }
+
+        uint8_t *dst = pages[info.page].pixels.data() + info.atlasY * PAGE_SIZE + info.atlasX;
+        for (int y = 0; y < h; y++)
+        {
+            memcpy(dst + y * PAGE_SIZE, sdf + y * w, w);
+        }
+    }
+    if (sdf) stbtt_FreeSDF(sdf, nullptr);
+
+    return &glyphs.emplace(key, info).first->second;
+}
+
+bool GlyphCache::AllocateOrReset(int w, int h, int &page, int &x, int &y)
+{
+    // 比整页还大的字形永远放不下：不开新页，也不清空图集（否则每次绘制都让所有缓存失效）
+    if (w + GLYPH_PADDING > PAGE_SIZE || h + GLYPH_PADDING > PAGE_SIZE) return false;
+
+    if (Allocate(w, h, page, x, y)) return true;
+
+    // 图集已满：整体清空后重新打包
+    Clear();
+    return Allocate(w, h, page, x, y);
+}
+
+bool GlyphCache::AllocateInPage(Page &p, int w, int h, int &x, int &y)
+{
+    int pw = w + GLYPH_PADDING;
+    int ph = h + GLYPH_PADDING;
+
+    // 优先放进高度接近的货架，避免浪费
+    for (auto &shelf : p.shelves)
+    {
+        if (ph <= shelf.height && ph * 4 >= shelf.height * 3 && shelf.x + pw <= PAGE_SIZE)
+        {
+            x = shelf.x;
+            y = shelf.y;
+            shelf.x += pw;
+            return true;
+        }
+    }
+
+    // 新开一个货架
+    if (p.nextY + ph > PAGE_SIZE || pw > PAGE_SIZE) return false;
+
+    p.shelves.push_back({ p.nextY, ph, pw });
+    x = 0;
+    y = p.nextY;
+    p.nextY += ph;
+    return true;
+}
+
+bool GlyphCache::Allocate(int w, int h, int &page, int &x, int &y)
+{
+    for (size_t i = 0; i < pages.size(); i++)
+    {
+        if (AllocateInPage(pages[i], w, h, x, y))
+        {
+            page = (int)i;
+            return true;
+        }
+    }
+
+    if ((int)pages.size() >= MAX_PAGES) return false;
+
+    pages.emplace_back();
+    Page &p = pages.back();
+    p.pixels.assign(PAGE_SIZE * PAGE_SIZE, 0);
+    p.nextY = 0;
+
+    if (!AllocateInPage(p, w, h, x, y)) return false;
+    page = (int)pages.size() - 1;
+    return true;
+}
+
+} // namespace Text
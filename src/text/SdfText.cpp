@@ -0,0 +1,254 @@
+/*
+ * CPU-Draw - SDF Text Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 有向距离场文字
+ * 每行：两行纹素纵向插值 -> 定点横向采样 -> 阈值转覆盖率 -> span_blend_mask
+ * 绘制顺序：全部阴影 -> 全部描边 -> 全部填充，相邻字形的描边不会盖住前一个字
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "text/SdfText.h"
+#include "core/Profiler.h"
+#include "graphics/SpanKernels.h"
+#include "text/GlyphCache.h"
+#include "text/TextLayout.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Text
+{
+
+static const int SDF_MAX_WIDTH = 512; // 纹素行缓冲上限
+static const int SDF_CHUNK = 256;     // 目标行分段处理的像素数
+
+// 一遍绘制的参数
+struct SdfPass
+{
+    float dx, dy; // 偏移
+    int edge;     // 阈值（距离 × 128）
+    int gain;     // 覆盖率斜率（见 span_sdf_coverage）
+    float inset;  // 四周填充区中覆盖率恒为 0 的宽度（像素），不采样
+    uint32_t color;
+};
+
+// 距离阈值：向外扩 expand 像素
+static int SdfEdge(float expand, float scale)
+{
+    const int onedge = GlyphCache::SDF_ONEDGE * 128;
+    return onedge - (int)std::lround(expand * 128.0f * GlyphCache::SDF_DIST_SCALE / scale);
+}
+
+// 覆盖率斜率：边缘过渡宽度 ramp 像素
+static int SdfGain(float ramp, float scale)
+{
+    float gain = 4096.0f * 255.0f * scale / (128.0f * GlyphCache::SDF_DIST_SCALE * std::max(ramp, 1.0f));
+    return std::max(1, std::min(65535, (int)std::lround(gain)));
+}
+
+// 外扩 expand、过渡宽度 ramp 时，填充区里墨迹到不了的宽度
+static float SdfInset(float expand, float ramp, float scale)
+{
+    return std::max(0.0f, GlyphCache::SDF_PADDING * scale - expand - std::max(ramp, 1.0f) * 0.5f - 1.0f);
+}
+
+static SdfPass MakePass(float dx, float dy, float expand, float ramp, float scale, uint32_t color)
+{
+    SdfPass pass = { dx, dy, SdfEdge(expand, scale), SdfGain(ramp, scale), SdfInset(expand, ramp, scale), color };
+    return pass;
+}
+
+static void DrawSdfGlyph(uint32_t *pixels, int stride, const GlyphInfo &glyph, float pen_x, float pen_y, float scale, const SdfPass &pass, const Graphics::IntRect &cr)
+{
+    if (glyph.width == 0 || glyph.width > SDF_MAX_WIDTH) return;
+
+    float gx0 = pen_x + pass.dx + glyph.offsetX * scale;
+    float gy0 = pen_y + pass.dy + glyph.offsetY * scale;
+
+    int x0 = std::max(cr.x0, (int)std::floor(gx0 + pass.inset));
+    int y0 = std::max(cr.y0, (int)std::floor(gy0 + pass.inset));
+    int x1 = std::min(cr.x1, (int)std::ceil(gx0 + glyph.width * scale - pass.inset) - 1);
+    int y1 = std::min(cr.y1, (int)std::ceil(gy0 + glyph.height * scale - pass.inset) - 1);
+    if (x0 > x1 || y0 > y1) return;
+
+    GlyphCache &cache = GlyphCache::Instance();
+    const int atlasStride = cache.GetPageSize();
+    const uint8_t *src = cache.GetPagePixels(glyph.page) + glyph.atlasY * atlasStride + glyph.atlasX;
+
+    float inv = 1.0f / scale;
+    int32_t du = (int32_t)std::lround(65536.0f * inv);
+    int32_t u0 = (int32_t)std::lround(((x0 + 0.5f - gx0) * inv - 0.5f) * 65536.0f);
+
+    uint16_t row[SDF_MAX_WIDTH];
+    uint16_t dist[SDF_CHUNK];
+    uint8_t mask[SDF_CHUNK];
+
+    // 纵向同样按 16.16 定点步进
+    int32_t v = (int32_t)std::lround(((y0 + 0.5f - gy0) * inv - 0.5f) * 65536.0f);
+
+    for (int y = y0; y <= y1; y++, v += du)
+    {
+        // 纹素中心对齐，超出范围取边缘行
+        int iy = v >> 16;
+        int fy = (v >> 9) & 127;
+        if (iy < 0)
+        {
+            iy = 0;
+            fy = 0;
+        }
+        else if (iy >= glyph.height - 1)
+        {
+            iy = glyph.height - 1;
+            fy = 0;
+        }
+        int iy1 = std::min(iy + 1, glyph.height - 1);
+
+        Graphics::span_sdf_lerp_rows(row, src + iy * atlasStride, src + iy1 * atlasStride, glyph.width, fy);
+
+        uint32_t *dst = pixels + (size_t)y * stride;
+        for (int x = x0; x <= x1; x += SDF_CHUNK)
+        {
+            int count = std::min(SDF_CHUNK, x1 - x + 1);
+            Graphics::span_sdf_sample(dist, row, glyph.width, u0 + (x - x0) * du, du, count);
+            Graphics::span_sdf_coverage(mask, dist, count, pass.edge, pass.gain);
+            Graphics::span_blend_mask(dst + x, mask, count, pass.color);
+        }
+    }
+}
+
+// 按文本逐字形执行 fn(glyph, pen_x, pen_y)
+template <typename Fn>
+static void ForEachSdfGlyph(const std::string &text, float x, float y, float scale, Fn fn)
+{
+    GlyphCache &cache = GlyphCache::Instance();
+    float line_height = cache.GetMetrics(GlyphCache::SDF_BASE_SIZE).lineHeight * scale;
+    float pen_x = x;
+    float pen_y = y;
+
+    size_t i = 0;
+    while (i < text.size())
+    {
+        if (text[i] == '\n')
+        {
+            pen_x = x;
+            pen_y += line_height;
+            i++;
+            continue;
+        }
+
+        int codepoint = 0;
+        int bytes = DecodeUTF8(text, i, codepoint);
+        if (bytes == 0)
+        {
+            i++;
+            continue;
+        }
+
+        const GlyphInfo *glyph = cache.GetSdfGlyph(codepoint);
+        if (glyph)
+        {
+            fn(*glyph, pen_x, pen_y);
+            pen_x += glyph->advance * scale;
+        }
+
+        i += bytes;
+    }
+}
+
+void RenderTextSdf(uint32_t *pixels, int stride, int width, int height, float x, float y, const std::string &text, float font_size, uint32_t color, const SdfEffect &effect, const Graphics::IntRect *clip)
+{
+    if (!InitFont() || font_size <= 0.0f) return;
+    CPUDRAW_PROFILE_SCOPE(Text);
+
+    Graphics::IntRect cr = { 0, 0, width - 1, height - 1 };
+    if (clip) cr = cr.Intersect(*clip);
+    if (cr.IsEmpty()) return;
+
+    float scale = font_size / GlyphCache::SDF_BASE_SIZE;
+    float outline = effect.HasOutline() ? effect.outlineWidth : 0.0f;
+
+    SdfPass passes[3];
+    int passCount = 0;
+    if (effect.HasShadow())
+    {
+        // 阴影取文字加描边的外形
+        passes[passCount++] = MakePass(effect.shadowX, effect.shadowY, outline, 1.0f + effect.shadowSoftness * 2.0f, scale, effect.shadowColor);
+    }
+    if (outline > 0.0f)
+    {
+        passes[passCount++] = MakePass(0.0f, 0.0f, outline, 1.0f, scale, effect.outlineColor);
+    }
+    passes[passCount++] = MakePass(0.0f, 0.0f, 0.0f, 1.0f, scale, color);
+
+    for (int p = 0; p < passCount; p++)
+    {
+        const SdfPass &pass = passes[p];
+        ForEachSdfGlyph(text, x, y, scale, [&](const GlyphInfo &glyph, float pen_x, float pen_y) {
+            if (p == passCount - 1) CPUDRAW_PROFILE_COUNT(GlyphsDrawn, 1);
+            DrawSdfGlyph(pixels, stride, glyph, pen_x, pen_y, scale, pass, cr);
+        });
+    }
+}
+
+My_Vector2 CalcTextSizeSdf(const std::string &text, float font_size)
+{
+    if (!InitFont() || font_size <= 0.0f) return My_Vector2(0, 0);
+
+    float scale = font_size / GlyphCache::SDF_BASE_SIZE;
+    float line_height = GlyphCache::Instance().GetMetrics(GlyphCache::SDF_BASE_SIZE).lineHeight * scale;
+
+    // 每行从 x = 0 开始，最宽一行即最大的行尾位置
+    float max_width = 0.0f;
+    ForEachSdfGlyph(text, 0.0f, 0.0f, scale, [&](const GlyphInfo &glyph, float pen_x, float) { max_width = std::max(max_width, pen_x + glyph.advance * scale); });
+
+    int line_count = (int)std::count(text.begin(), text.end(), '\n') + 1;
+    return My_Vector2(max_width, line_height * line_count);
+}
+
+TextBounds CalcTextBoundsSdf(float x, float y, const std::string &text, float font_size, const SdfEffect &effect)
+{
+    TextBounds bounds = { 0, 0, -1, -1 };
+    if (!InitFont() || font_size <= 0.0f) return bounds;
+
+    float scale = font_size / GlyphCache::SDF_BASE_SIZE;
+    float outline = effect.HasOutline() ? effect.outlineWidth : 0.0f;
+    float softness = effect.HasShadow() ? effect.shadowSoftness : 0.0f;
+
+    // SDF 四周的填充区不会有墨迹，向内收缩到描边 / 柔化能到达的位置（与绘制时的最大范围一致）
+    float inset = SdfInset(outline, 1.0f + softness * 2.0f, scale);
+
+    float fx0 = 0, fy0 = 0, fx1 = -1, fy1 = -1;
+    bool empty = true;
+    ForEachSdfGlyph(text, x, y, scale, [&](const GlyphInfo &glyph, float pen_x, float pen_y) {
+        if (glyph.width == 0) return;
+
+        float gx0 = pen_x + glyph.offsetX * scale + inset;
+        float gy0 = pen_y + glyph.offsetY * scale + inset;
+        float gx1 = pen_x + (glyph.offsetX + glyph.width) * scale - inset;
+        float gy1 = pen_y + (glyph.offsetY + glyph.height) * scale - inset;
+        if (empty)
+        {
+            fx0 = gx0, fy0 = gy0, fx1 = gx1, fy1 = gy1;
+            empty = false;
+        }
+        else
+        {
+            fx0 = std::min(fx0, gx0), fy0 = std::min(fy0, gy0);
+            fx1 = std::max(fx1, gx1), fy1 = std::max(fy1, gy1);
+        }
+    });
+    if (empty) return bounds;
+
+    if (effect.HasShadow())
+    {
+        fx0 = std::min(fx0, fx0 + effect.shadowX), fx1 = std::max(fx1, fx1 + effect.shadowX);
+        fy0 = std::min(fy0, fy0 + effect.shadowY), fy1 = std::max(fy1, fy1 + effect.shadowY);
+    }
+
+    bounds = { (int)std::floor(fx0), (int)std::floor(fy0), (int)std::ceil(fx1), (int)std::ceil(fy1) };
+    return bounds;
+}
+
+} // namespace Text
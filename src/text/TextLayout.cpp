@@ -0,0 +1,337 @@
+/*
+ * CPU-Draw - Text Layout Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 文本排版缓存
+ * 落笔位置与 RenderText 原有规则一致：每个字形步进取整后累加，行高按行累加后取整
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "text/TextLayout.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Text
+{
+
+// 中日韩字符（前后都可以断行）
+static bool IsBreakableCJK(int cp)
+{
+    return (cp >= 0x2E80 && cp <= 0x9FFF) || (cp >= 0xAC00 && cp <= 0xD7AF) || (cp >= 0xF900 && cp <= 0xFAFF) || (cp >= 0xFF00 && cp <= 0xFFEF) || (cp >= 0x20000 && cp <= 0x2FFFF);
+}
+
+// 不能出现在行首的标点
+static bool IsNoBreakBefore(int cp)
+{
+    switch (cp)
+    {
+    case 0x3001: // 、
+    case 0x3002: // 。
+    case 0xFF0C: // ，
+    case 0xFF1A: // ：
+    case 0xFF1B: // ；
+    case 0xFF01: // ！
+    case 0xFF1F: // ？
+    case 0xFF09: // ）
+    case 0x3011: // 】
+    case 0x300B: // 》
+    case 0x300D: // 」
+    case 0x201D: // ”
+    case 0x2019: // ’
+    case 0x2026: // …
+    case ',':
+    case '.':
+    case ')':
+    case '!':
+    case '?':
+    case ':':
+    case ';':
+        return true;
+    default: return false;
+    }
+}
+
+static bool IsSpace(int cp)
+{
+    return cp == ' ' || cp == '\t' || cp == 0x3000;
+}
+
+// 解码后的字符
+struct ShapedChar
+{
+    const GlyphInfo *glyph;
+    int codepoint;
+    uint32_t offset;
+    float advance; // 含字距
+};
+
+static float SumAdvance(const std::vector<ShapedChar> &chars, int first, int last)
+{
+    float width = 0.0f;
+    for (int i = first; i < last; i++) width += chars[i].advance;
+    return width;
+}
+
+static void EmitLine(TextLayout &layout, const std::vector<ShapedChar> &chars, int first, int last, int cursor_y)
+{
+    LayoutLine line;
+    line.first = (int)layout.glyphs.size();
+    line.width = 0.0f;
+
+    int cursor_x = 0;
+    for (int i = first; i < last; i++)
+    {
+        const ShapedChar &c = chars[i];
+        layout.glyphs.push_back({ c.glyph, c.codepoint, cursor_x, cursor_y, c.offset });
+        line.width += c.advance;
+        cursor_x += static_cast<int>(c.advance);
+    }
+
+    line.count = (int)layout.glyphs.size() - line.first;
+    layout.lines.push_back(line);
+}
+
+void TextLayoutCache::Build(TextLayout &layout, const std::string &text, int font_size, float letter_spacing, float line_spacing, int wrap_width)
+{
+    GlyphCache &cache = GlyphCache::Instance();
+
+    layout.glyphs.clear();
+    layout.lines.clear();
+    layout.fontSize = font_size;
+
+    float line_height = cache.GetMetrics(font_size).lineHeight * line_spacing;
+
+    // 解码，'\n' 保留为硬换行标记
+    // 光栅化新字形可能让图集整体清空，之前取得的字形指针失效，此时重新解码一次
+    std::vector<ShapedChar> chars;
+    chars.reserve(text.size());
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        chars.clear();
+        layout.glyphGeneration = cache.GetGeneration();
+
+        size_t i = 0;
+        while (i < text.size())
+        {
+            if (text[i] == '\n')
+            {
+                chars.push_back({ nullptr, '\n', (uint32_t)i, 0.0f });
+                i++;
+                continue;
+            }
+
+            int codepoint = 0;
+            int bytes = DecodeUTF8(text, i, codepoint);
+            if (bytes == 0)
+            {
+                // 无效字符，跳过
+                i++;
+                continue;
+            }
+
+            const GlyphInfo *glyph = cache.GetGlyph(codepoint, font_size);
+            if (glyph) chars.push_back({ glyph, codepoint, (uint32_t)i, glyph->advance + letter_spacing });
+            i += bytes;
+        }
+
+        if (layout.IsGlyphCacheValid()) break;
+    }
+
+    int count = (int)chars.size();
+    int cursor_y = 0;
+
+    if (wrap_width <= 0)
+    {
+        int start = 0;
+        for (int k = 0; k <= count; k++)
+        {
+            if (k < count && chars[k].codepoint != '\n') continue;
+            EmitLine(layout, chars, start, k, cursor_y);
+            cursor_y += line_height;
+            start = k + 1;
+        }
+    }
+    else
+    {
+        // 贪心断行：越界时回到最近的断点，行首行尾的空白丢弃
+        int start = 0;
+        int breakEnd = -1, breakAt = -1; // 最近断点：本行到 breakEnd 为止，下一行从 breakAt 开始
+        float width = 0.0f;
+
+        auto finish = [&](int end, int next) {
+            while (end > start && IsSpace(chars[end - 1].codepoint)) end--;
+            EmitLine(layout, chars, start, end, cursor_y);
+            cursor_y += line_height;
+            start = next;
+            while (start < count && IsSpace(chars[start].codepoint)) start++;
+            breakEnd = breakAt = -1;
+        };
+
+        for (int k = 0; k < count; k++)
+        {
+            const ShapedChar &c = chars[k];
+            if (c.codepoint == '\n')
+            {
+                finish(k, k + 1);
+                width = 0.0f;
+                k = start - 1;
+                continue;
+            }
+
+            // 记录断点
+            if (k > start && !IsSpace(c.codepoint) && !IsNoBreakBefore(c.codepoint))
+            {
+                int prev = chars[k - 1].codepoint;
+                if (IsSpace(prev))
+                {
+                    int end = k;
+                    while (end > start && IsSpace(chars[end - 1].codepoint)) end--;
+                    breakEnd = end;
+                    breakAt = k;
+                }
+                else if (IsBreakableCJK(c.codepoint) || IsBreakableCJK(prev))
+                {
+                    breakEnd = breakAt = k;
+                }
+            }
+
+            width += c.advance;
+
+            // 行尾空白悬挂，不触发断行；单词本身超宽时独占一行
+            if (width > wrap_width && !IsSpace(c.codepoint) && breakAt > start)
+            {
+                finish(breakEnd, breakAt);
+                width = SumAdvance(chars, start, k + 1);
+            }
+        }
+
+        if (start < count) finish(count, count);
+    }
+
+    // 尺寸与墨迹范围
+    float max_width = 0.0f;
+    for (const LayoutLine &line : layout.lines)
+    {
+        max_width = std::max(max_width, line.width);
+    }
+    layout.size = My_Vector2(max_width, line_height * layout.lines.size());
+
+    // 一段文字的字形多到图集装不下时指针已失效，逐个重新查找
+    bool valid = layout.IsGlyphCacheValid();
+    layout.ink = { 0, 0, -1, -1 };
+    bool empty = true;
+    for (const LayoutGlyph &g : layout.glyphs)
+    {
+        const GlyphInfo *glyph = valid ? g.glyph : cache.GetGlyph(g.codepoint, font_size);
+        if (!glyph || glyph->width == 0) continue;
+
+        int gx0 = g.x + glyph->offsetX;
+        int gy0 = g.y + glyph->offsetY;
+        int gx1 = gx0 + glyph->width - 1;
+        int gy1 = gy0 + glyph->height - 1;
+
+        if (empty)
+        {
+            layout.ink = { gx0, gy0, gx1, gy1 };
+            empty = false;
+        }
+        else
+        {
+            layout.ink.x0 = std::min(layout.ink.x0, gx0);
+            layout.ink.y0 = std::min(layout.ink.y0, gy0);
+            layout.ink.x1 = std::max(layout.ink.x1, gx1);
+            layout.ink.y1 = std::max(layout.ink.y1, gy1);
+        }
+    }
+}
+
+uint64_t TextLayoutCache::MakeKey(const std::string &text, int font_size, float letter_spacing, float line_spacing, int wrap_width)
+{
+    // FNV-1a
+    uint64_t h = 1469598103934665603ULL;
+    for (unsigned char c : text)
+    {
+        h = (h ^ c) * 1099511628211ULL;
+    }
+
+    uint32_t ls, lsp;
+    memcpy(&ls, &letter_spacing, sizeof(ls));
+    memcpy(&lsp, &line_spacing, sizeof(lsp));
+
+    uint64_t params[4] = { (uint64_t)(uint32_t)font_size, ls, lsp, (uint64_t)(uint32_t)wrap_width };
+    for (uint64_t p : params)
+    {
+        h = (h ^ p) * 1099511628211ULL;
+        h ^= h >> 29;
+    }
+    return h;
+}
+
+bool TextLayoutCache::Matches(const Entry &entry, const std::string &text, int font_size, float letter_spacing, float line_spacing, int wrap_width)
+{
+    return entry.layout.fontSize == font_size && entry.letterSpacing == letter_spacing && entry.lineSpacing == line_spacing && entry.wrapWidth == wrap_width && entry.text == text;
+}
+
+const TextLayout &TextLayoutCache::Get(const std::string &text, int font_size, float letter_spacing, float line_spacing, int wrap_width)
+{
+    if (wrap_width <= 0) wrap_width = -1;
+    uint64_t key = MakeKey(text, font_size, letter_spacing, line_spacing, wrap_width);
+
+    // 当前代命中
+    auto it = current.find(key);
+    if (it != current.end())
+    {
+        Entry &entry = it->second;
+        if (Matches(entry, text, font_size, letter_spacing, line_spacing, wrap_width))
+        {
+            if (!entry.layout.IsGlyphCacheValid()) Build(entry.layout, text, font_size, letter_spacing, line_spacing, wrap_width);
+            return entry.layout;
+        }
+
+        // 哈希冲突：覆盖旧条目
+        entry.text = text;
+        entry.letterSpacing = letter_spacing;
+        entry.lineSpacing = line_spacing;
+        entry.wrapWidth = wrap_width;
+        Build(entry.layout, text, font_size, letter_spacing, line_spacing, wrap_width);
+        return entry.layout;
+    }
+
+    // 上一代命中的条目提回当前代，否则新建
+    Entry entry;
+    auto old = previous.find(key);
+    if (old != previous.end() && Matches(old->second, text, font_size, letter_spacing, line_spacing, wrap_width))
+    {
+        entry = std::move(old->second);
+        previous.erase(old);
+        if (!entry.layout.IsGlyphCacheValid()) Build(entry.layout, text, font_size, letter_spacing, line_spacing, wrap_width);
+    }
+    else
+    {
+        entry.text = text;
+        entry.letterSpacing = letter_spacing;
+        entry.lineSpacing = line_spacing;
+        entry.wrapWidth = wrap_width;
+        Build(entry.layout, text, font_size, letter_spacing, line_spacing, wrap_width);
+    }
+
+    if (current.size() >= GENERATION_CAPACITY)
+    {
+        previous = std::move(current);
+        current.clear();
+        generation++;
+    }
+
+    return current.emplace(key, std::move(entry)).first->second.layout;
+}
+
+void TextLayoutCache::Clear()
+{
+    current.clear();
+    previous.clear();
+    generation++;
+}
+
+} // namespace Text
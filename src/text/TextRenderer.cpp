@@ -16,28 +16,28 @@
 
  
 #include "text/TextRenderer.h"
+#include "core/Profiler.h"
 #include "graphics/Primitives.h"
-#include "text/Font.h"
+#include "graphics/SpanKernels.h"
+#include "text/FontManager.h"
+#include "text/GlyphCache.h"
+#include "text/TextLayout.h"
 #include <algorithm>
 #include <cstring>
-#include <sstream>
 #include <vector>
 
-#define STB_TRUETYPE_IMPLEMENTATION
-#include "stb/stb_truetype.h"
-
 namespace Text
 {
 
-static stbtt_fontinfo g_font;
 static bool g_font_initialized = false;
 
 bool InitFont()
 {
     if (g_font_initialized) return true;
 
-    const unsigned char *ttf_buffer = reinterpret_cast<const unsigned char *>(OPPOSans_H);
-    if (!stbtt_InitFont(&g_font, ttf_buffer, 0))
+    // 调用方已经自行加载过字体时直接使用
+    FontManager &fonts = FontManager::Instance();
+    if (!fonts.GetPrimary() && !fonts.LoadDefaults())
     {
         return false;
     }
@@ -48,6 +48,7 @@ bool InitFont()
 
 void ShutdownFont()
 {
+    FontManager::Instance().Clear();
     g_font_initialized = false;
 }
 
@@ -56,171 +57,102 @@ bool IsFontInitialized()
     return g_font_initialized;
 }
 
-void RenderChar(uint32_t *pixels, int stride, int width, int height,
-                int codepoint, int x, int y, int font_size, uint32_t color) {  // 改为 int codepoint
-    if (!InitFont()) return;
-    
-    float scale = stbtt_ScaleForPixelHeight(&g_font, font_size);
-    
-    int x0, y0, x1, y1;
-    stbtt_GetCodepointBitmapBox(&g_font, codepoint, scale, scale, &x0, &y0, &x1, &y1);
-    
-    int w = x1 - x0;
-    int h = y1 - y0;
-    
-    unsigned char *bitmap = stbtt_GetCodepointBitmap(&g_font, 0, scale, codepoint, &w, &h, 0, 0);
-    if (!bitmap) return;
-    
-    for (int j = 0; j < h; j++) {
-        for (int i = 0; i < w; i++) {
-            uint8_t alpha = bitmap[j * w + i];
-            if (alpha > 0) {
-                uint8_t r = color & 0xFF;
-                uint8_t g = (color >> 8) & 0xFF;
-                uint8_t b = (color >> 16) & 0xFF;
-                uint32_t blended = Graphics::rgba(r, g, b, alpha);
-                Graphics::put_pixel(pixels, stride, width, height, 
-                                   x + i + x0, y + j + y0, blended);
-            }
-        }
-    }
-    
-    stbtt_FreeBitmap(bitmap, nullptr);
-}
-
-void RenderText(uint32_t *pixels, int stride, int width, int height, int x, int y, const std::string &text, int font_size, uint32_t color)
+// 从图集绘制已缓存的字形
+static void BlitGlyph(uint32_t *pixels, int stride, int width, int height, const GlyphInfo &glyph, int x, int y, uint32_t color, const Graphics::IntRect *clip)
 {
-    if (!InitFont()) return;
+    if (glyph.width == 0) return;
 
-    float scale = stbtt_ScaleForPixelHeight(&g_font, font_size);
-    int cursor_x = x;
-    int cursor_y = y;
+    int gx = x + glyph.offsetX;
+    int gy = y + glyph.offsetY;
 
-    int ascent, descent, lineGap;
-    stbtt_GetFontVMetrics(&g_font, &ascent, &descent, &lineGap);
-    float line_height = (ascent - descent + lineGap) * scale;
+    // 整体裁剪（缓冲区与 clip 的交集）
+    Graphics::IntRect cr = { 0, 0, width - 1, height - 1 };
+    if (clip) cr = cr.Intersect(*clip);
 
-    size_t i = 0;
-    while (i < text.size())
+    int i0 = std::max(0, cr.x0 - gx);
+    int j0 = std::max(0, cr.y0 - gy);
+    int i1 = std::min(glyph.width, cr.x1 + 1 - gx);
+    int j1 = std::min(glyph.height, cr.y1 + 1 - gy);
+    if (i0 >= i1 || j0 >= j1) return;
+
+    GlyphCache &cache = GlyphCache::Instance();
+    const int atlasStride = cache.GetPageSize();
+    const uint8_t *src = cache.GetPagePixels(glyph.page) + glyph.atlasY * atlasStride + glyph.atlasX;
+
+    for (int j = j0; j < j1; j++)
     {
-        unsigned char c = text[i];
+        Graphics::span_blend_mask(pixels + (gy + j) * stride + gx + i0, src + j * atlasStride + i0, i1 - i0, color);
+    }
+}
 
-        // 处理换行
-        if (c == '\n')
-        {
-            cursor_x = x;
-            cursor_y += line_height;
-            i++;
-            continue;
-        }
+void RenderChar(uint32_t *pixels, int stride, int width, int height,
+                int codepoint, int x, int y, int font_size, uint32_t color, const Graphics::IntRect *clip) {  // 改为 int codepoint
+    if (!InitFont()) return;
 
-        // 解码 UTF-8
-        int codepoint = 0;
-        int bytes = 0;
+    const GlyphInfo *glyph = GlyphCache::Instance().GetGlyph(codepoint, font_size);
+    if (!glyph) return;
 
-        if (c < 0x80)
-        {
-            // ASCII (1 byte)
-            codepoint = c;
-            bytes = 1;
-        }
-        else if ((c & 0xE0) == 0xC0)
-        {
-            // 2 bytes
-            codepoint = ((c & 0x1F) << 6) | (text[i + 1] & 0x3F);
-            bytes = 2;
-        }
-        else if ((c & 0xF0) == 0xE0)
-        {
-            // 3 bytes (中文通常在这里)
-            codepoint = ((c & 0x0F) << 12) | ((text[i + 1] & 0x3F) << 6) | (text[i + 2] & 0x3F);
-            bytes = 3;
-        }
-        else if ((c & 0xF8) == 0xF0)
-        {
-            // 4 bytes
-            codepoint = ((c & 0x07) << 18) | ((text[i + 1] & 0x3F) << 12) | ((text[i + 2] & 0x3F) << 6) | (text[i + 3] & 0x3F);
-            bytes = 4;
-        }
-        else
+    BlitGlyph(pixels, stride, width, height, *glyph, x, y, color, clip);
+}
+
+void RenderTextLayout(uint32_t *pixels, int stride, int width, int height, int x, int y, const TextLayout &layout, uint32_t color, const Graphics::IntRect *clip)
+{
+    CPUDRAW_PROFILE_SCOPE(Text);
+    CPUDRAW_PROFILE_COUNT(GlyphsDrawn, layout.glyphs.size());
+
+    // 字形缓存清空过时按字符重新查找
+    if (layout.IsGlyphCacheValid())
+    {
+        for (const LayoutGlyph &g : layout.glyphs)
         {
-            // 无效字符，跳过
-            i++;
-            continue;
+            BlitGlyph(pixels, stride, width, height, *g.glyph, x + g.x, y + g.y, color, clip);
         }
+        return;
+    }
 
-        // 渲染字符（使用 codepoint 而不是 c）
-        RenderChar(pixels, stride, width, height, codepoint, cursor_x, cursor_y, font_size, color);
+    GlyphCache &cache = GlyphCache::Instance();
+    for (const LayoutGlyph &g : layout.glyphs)
+    {
+        const GlyphInfo *glyph = cache.GetGlyph(g.codepoint, layout.fontSize);
+        if (glyph) BlitGlyph(pixels, stride, width, height, *glyph, x + g.x, y + g.y, color, clip);
+    }
+}
 
-        int advance, lsb;
-        stbtt_GetCodepointHMetrics(&g_font, codepoint, &advance, &lsb);
-        cursor_x += static_cast<int>(advance * scale);
+void RenderText(uint32_t *pixels, int stride, int width, int height, int x, int y, const std::string &text, int font_size, uint32_t color, const Graphics::IntRect *clip)
+{
+    if (!InitFont()) return;
 
-        i += bytes;
-    }
+    RenderTextLayout(pixels, stride, width, height, x, y, TextLayoutCache::Instance().Get(text, font_size), color, clip);
 }
 
-void RenderTextF(uint32_t *pixels, int stride, int width, int height, float x, float y, const std::string &text, int font_size, uint32_t color)
+void RenderTextF(uint32_t *pixels, int stride, int width, int height, float x, float y, const std::string &text, int font_size, uint32_t color, const Graphics::IntRect *clip)
 {
-    RenderText(pixels, stride, width, height, (int)x, (int)y, text, font_size, color);
+    RenderText(pixels, stride, width, height, (int)x, (int)y, text, font_size, color, clip);
 }
 
-void RenderTextStyled(uint32_t *pixels, int stride, int width, int height, int x, int y, const std::string &text, const TextStyle &style)
+void RenderTextStyled(uint32_t *pixels, int stride, int width, int height, int x, int y, const std::string &text, const TextStyle &style, const Graphics::IntRect *clip)
 {
     if (!InitFont()) return;
 
-    float scale = stbtt_ScaleForPixelHeight(&g_font, style.fontSize);
-    int cursor_x = x;
-    int cursor_y = y;
-
-    int ascent, descent, lineGap;
-    stbtt_GetFontVMetrics(&g_font, &ascent, &descent, &lineGap);
-    float line_height = (ascent - descent + lineGap) * scale * style.lineSpacing;
-
-    for (size_t i = 0; i < text.size(); ++i)
-    {
-        unsigned char c = text[i];
-
-        if (c == '\n')
-        {
-            cursor_x = x;
-            cursor_y += line_height;
-            continue;
-        }
-
-        RenderChar(pixels, stride, width, height, c, cursor_x, cursor_y, style.fontSize, style.color);
-
-        int advance, lsb;
-        stbtt_GetCodepointHMetrics(&g_font, c, &advance, &lsb);
-        cursor_x += static_cast<int>((advance * scale) + style.letterSpacing);
-    }
+    const TextLayout &layout = TextLayoutCache::Instance().Get(text, style.fontSize, style.letterSpacing, style.lineSpacing);
+    RenderTextLayout(pixels, stride, width, height, x, y, layout, style.color, clip);
 }
 
-void RenderTextMultiline(uint32_t *pixels, int stride, int width, int height, int x, int y, const std::string &text, int font_size, uint32_t color, int maxWidth)
+void RenderTextMultiline(uint32_t *pixels, int stride, int width, int height, int x, int y, const std::string &text, int font_size, uint32_t color, int maxWidth, const Graphics::IntRect *clip)
 {
-    if (maxWidth > 0)
-    {
-        std::vector<std::string> lines = WrapText(text, font_size, maxWidth);
-        int cursor_y = y;
-
-        FontMetrics metrics = GetFontMetrics(font_size);
-        float line_height = (metrics.ascent - metrics.descent + metrics.lineGap) * metrics.scale;
+    if (!InitFont()) return;
 
-        for (const auto &line : lines)
-        {
-            RenderText(pixels, stride, width, height, x, cursor_y, line, font_size, color);
-            cursor_y += line_height;
-        }
-    }
-    else
-    {
-        RenderText(pixels, stride, width, height, x, y, text, font_size, color);
-    }
+    const TextLayout &layout = TextLayoutCache::Instance().Get(text, font_size, 0.0f, 1.0f, maxWidth);
+    RenderTextLayout(pixels, stride, width, height, x, y, layout, color, clip);
 }
 
-void RenderTextAligned(uint32_t *pixels, int stride, int width, int height, int x, int y, int box_width, const std::string &text, int font_size, uint32_t color, Alignment align)
+void RenderTextAligned(uint32_t *pixels, int stride, int width, int height, int x, int y, int box_width, const std::string &text, int font_size, uint32_t color, Alignment align, const Graphics::IntRect *clip)
 {
-    My_Vector2 text_size = CalcTextSize(text, font_size);
+    if (!InitFont()) return;
+
+    // 测量与绘制共用一份排版
+    const TextLayout &layout = TextLayoutCache::Instance().Get(text, font_size);
+    const My_Vector2 &text_size = layout.size;
 
     int offset_x = 0;
     switch (align)
@@ -231,153 +163,95 @@ void RenderTextAligned(uint32_t *pixels, int stride, int width, int height, int
     default: offset_x = 0; break;
     }
 
-    RenderText(pixels, stride, width, height, x + offset_x, y, text, font_size, color);
+    RenderTextLayout(pixels, stride, width, height, x + offset_x, y, layout, color, clip);
 }
 
 My_Vector2 CalcTextSize(const std::string &text, int font_size)
 {
     if (!InitFont()) return My_Vector2(0, 0);
 
-    float scale = stbtt_ScaleForPixelHeight(&g_font, font_size);
-
-    float width = 0.0f;
-    float max_width = 0.0f;
-    int line_count = 1;
-
-    int ascent, descent, lineGap;
-    stbtt_GetFontVMetrics(&g_font, &ascent, &descent, &lineGap);
-    float line_height = (ascent - descent + lineGap) * scale;
-
-    for (size_t i = 0; i < text.size(); ++i)
-    {
-        unsigned char c = text[i];
-
-        if (c == '\n')
-        {
-            max_width = std::max(max_width, width);
-            width = 0.0f;
-            line_count++;
-            continue;
-        }
-
-        int advance, lsb;
-        stbtt_GetCodepointHMetrics(&g_font, c, &advance, &lsb);
-        width += advance * scale;
-    }
-
-    max_width = std::max(max_width, width);
-    return My_Vector2(max_width, line_height * line_count);
+    return TextLayoutCache::Instance().Get(text, font_size).size;
 }
 
 My_Vector2 CalcTextSizeStyled(const std::string &text, const TextStyle &style)
 {
     if (!InitFont()) return My_Vector2(0, 0);
 
-    float scale = stbtt_ScaleForPixelHeight(&g_font, style.fontSize);
-
-    float width = 0.0f;
-    float max_width = 0.0f;
-    int line_count = 1;
-
-    int ascent, descent, lineGap;
-    stbtt_GetFontVMetrics(&g_font, &ascent, &descent, &lineGap);
-    float line_height = (ascent - descent + lineGap) * scale * style.lineSpacing;
-
-    for (size_t i = 0; i < text.size(); ++i)
-    {
-        unsigned char c = text[i];
-
-        if (c == '\n')
-        {
-            max_width = std::max(max_width, width);
-            width = 0.0f;
-            line_count++;
-            continue;
-        }
-
-        int advance, lsb;
-        stbtt_GetCodepointHMetrics(&g_font, c, &advance, &lsb);
-        width += (advance * scale) + style.letterSpacing;
-    }
-
-    max_width = std::max(max_width, width);
-    return My_Vector2(max_width, line_height * line_count);
+    return TextLayoutCache::Instance().Get(text, style.fontSize, style.letterSpacing, style.lineSpacing).size;
 }
 
 My_Vector2 CalcTextSizeMultiline(const std::string &text, int font_size, int maxWidth)
 {
-    if (maxWidth <= 0)
-    {
-        return CalcTextSize(text, font_size);
-    }
+    if (!InitFont()) return My_Vector2(0, 0);
 
-    std::vector<std::string> lines = WrapText(text, font_size, maxWidth);
+    return TextLayoutCache::Instance().Get(text, font_size, 0.0f, 1.0f, maxWidth).size;
+}
 
-    float max_width = 0.0f;
-    for (const auto &line : lines)
-    {
-        My_Vector2 line_size = CalcTextSize(line, font_size);
-        max_width = std::max(max_width, line_size.x);
-    }
+TextBounds CalcTextBounds(int x, int y, const std::string &text, int font_size)
+{
+    TextBounds bounds = { 0, 0, -1, -1 };
+    if (!InitFont()) return bounds;
 
-    FontMetrics metrics = GetFontMetrics(font_size);
-    float line_height = (metrics.ascent - metrics.descent + metrics.lineGap) * metrics.scale;
+    bounds = TextLayoutCache::Instance().Get(text, font_size).ink;
+    if (bounds.x0 > bounds.x1) return bounds;
 
-    return My_Vector2(max_width, line_height * lines.size());
+    return { bounds.x0 + x, bounds.y0 + y, bounds.x1 + x, bounds.y1 + y };
 }
 
-My_Vector2 CalcCharSize(unsigned char c, int font_size)
+My_Vector2 CalcCharSize(int codepoint, int font_size)
 {
     if (!InitFont()) return My_Vector2(0, 0);
 
-    float scale = stbtt_ScaleForPixelHeight(&g_font, font_size);
-
-    int x0, y0, x1, y1;
-    stbtt_GetCodepointBitmapBox(&g_font, c, scale, scale, &x0, &y0, &x1, &y1);
+    const GlyphInfo *glyph = GlyphCache::Instance().GetGlyph(codepoint, font_size);
+    if (!glyph) return My_Vector2(0, 0);
 
-    return My_Vector2(x1 - x0, y1 - y0);
+    return My_Vector2(glyph->width, glyph->height);
 }
 
-float GetCharAdvance(unsigned char c, int font_size)
+float GetCharAdvance(int codepoint, int font_size)
 {
     if (!InitFont()) return 0.0f;
 
-    float scale = stbtt_ScaleForPixelHeight(&g_font, font_size);
-
-    int advance, lsb;
-    stbtt_GetCodepointHMetrics(&g_font, c, &advance, &lsb);
-
-    return advance * scale;
+    const GlyphInfo *glyph = GlyphCache::Instance().GetGlyph(codepoint, font_size);
+    return glyph ? glyph->advance : 0.0f;
 }
 
 std::vector<std::string> WrapText(const std::string &text, int font_size, int maxWidth)
 {
-    std::vector<std::string> lines;
-    std::istringstream stream(text);
-    std::string word, line;
+    Core::ArenaVector<TextLine> ranges;
+    WrapText(text, font_size, maxWidth, ranges);
 
-    while (stream >> word)
+    std::vector<std::string> lines;
+    lines.reserve(ranges.size());
+    for (const TextLine &line : ranges)
     {
-        std::string test_line = line.empty() ? word : line + " " + word;
-        My_Vector2 size = CalcTextSize(test_line, font_size);
+        lines.push_back(text.substr(line.offset, line.length));
+    }
+    return lines;
+}
 
-        if (size.x > maxWidth && !line.empty())
-        {
-            lines.push_back(line);
-            line = word;
-        }
-        else
+void WrapText(const std::string &text, int font_size, int maxWidth, Core::ArenaVector<TextLine> &lines)
+{
+    lines.clear();
+    if (!InitFont()) return;
+
+    // 行内容取原文中首尾字形之间的字节
+    const TextLayout &layout = TextLayoutCache::Instance().Get(text, font_size, 0.0f, 1.0f, maxWidth);
+    lines.reserve(layout.lines.size());
+    for (const LayoutLine &line : layout.lines)
+    {
+        if (line.count == 0)
         {
-            line = test_line;
+            lines.push_back(TextLine{ 0, 0 });
+            continue;
         }
-    }
 
-    if (!line.empty())
-    {
-        lines.push_back(line);
+        const LayoutGlyph &first = layout.glyphs[line.first];
+        const LayoutGlyph &last = layout.glyphs[line.first + line.count - 1];
+        int codepoint;
+        int last_bytes = DecodeUTF8(text, last.offset, codepoint);
+        lines.push_back(TextLine{ (int)first.offset, (int)(last.offset + last_bytes - first.offset) });
     }
-
-    return lines;
 }
 
 FontMetrics GetFontMetrics(int font_size)
@@ -386,55 +260,52 @@ FontMetrics GetFontMetrics(int font_size)
 
     if (!InitFont()) return metrics;
 
-    metrics.scale = stbtt_ScaleForPixelHeight(&g_font, font_size);
-    stbtt_GetFontVMetrics(&g_font, &metrics.ascent, &metrics.descent, &metrics.lineGap);
-
-    return metrics;
+    return GlyphCache::Instance().GetMetrics(font_size).font;
 }
 
 std::string TruncateText(const std::string &text, int font_size, int maxWidth)
 {
+    if (!InitFont()) return text;
+
     const std::string ellipsis = "...";
-    My_Vector2 full_size = CalcTextSize(text, font_size);
+    float available_width = maxWidth - CalcTextSize(ellipsis, font_size).x;
 
-    if (full_size.x <= maxWidth)
+    const TextLayout &layout = TextLayoutCache::Instance().Get(text, font_size);
+    if (layout.size.x <= maxWidth)
     {
         return text;
     }
 
-    My_Vector2 ellipsis_size = CalcTextSize(ellipsis, font_size);
-    int available_width = maxWidth - ellipsis_size.x;
-
-    std::string result;
+    // 按字符截断，不会切开多字节字符
+    size_t end = text.size();
     float current_width = 0.0f;
-
-    for (size_t i = 0; i < text.size(); ++i)
+    for (const LayoutGlyph &g : layout.glyphs)
     {
-        float char_width = GetCharAdvance(text[i], font_size);
-
+        float char_width = GetCharAdvance(g.codepoint, font_size);
         if (current_width + char_width > available_width)
         {
+            end = g.offset;
             break;
         }
-
-        result += text[i];
         current_width += char_width;
     }
 
-    return result + ellipsis;
+    return text.substr(0, end) + ellipsis;
 }
 
 int GetCharIndexFromPos(const std::string &text, int font_size, int pixel_x)
 {
-    float current_x = 0.0f;
+    if (!InitFont()) return 0;
 
-    for (size_t i = 0; i < text.size(); ++i)
+    // 返回字节偏移，总落在字符边界上
+    float current_x = 0.0f;
+    for (const LayoutGlyph &g : TextLayoutCache::Instance().Get(text, font_size).glyphs)
     {
-        float char_width = GetCharAdvance(text[i], font_size);
+        float char_width = GetCharAdvance(g.codepoint, font_size);
 
         if (current_x + char_width / 2 > pixel_x)
         {
-            return i;
+            return g.offset;
         }
 
         current_x += char_width;
@@ -445,14 +316,14 @@ int GetCharIndexFromPos(const std::string &text, int font_size, int pixel_x)
 
 int GetPosFromCharIndex(const std::string &text, int font_size, int char_index)
 {
-    if (char_index < 0) return 0;
-    if (char_index > (int)text.size()) char_index = text.size();
+    if (char_index <= 0 || !InitFont()) return 0;
 
+    // char_index 为字节偏移，累加它之前的字符
     float pos = 0.0f;
-
-    for (int i = 0; i < char_index && i < (int)text.size(); ++i)
+    for (const LayoutGlyph &g : TextLayoutCache::Instance().Get(text, font_size).glyphs)
     {
-        pos += GetCharAdvance(text[i], font_size);
+        if ((int)g.offset >= char_index) break;
+        pos += GetCharAdvance(g.codepoint, font_size);
     }
 
     return (int)pos;
@@ -1,4 +1,5 @@
 #include "ui/FloatingMenu.h"
+#include "core/Profiler.h"
 #include "graphics/Primitives.h"
 #include <algorithm>
 #include <cstring>
@@ -8,7 +9,7 @@ namespace UI
 
 // ==================== FloatingMenu ====================
 
-FloatingMenu::FloatingMenu(float x, float y, float width, float height) : menuPos(x, y), menuSize(width, height), minimizedSize(width, 50), title("Menu"), isVisible(true), isMinimized(false), isDraggable(true), isResizable(false), autoLayout(true), animationEnabled(true), nextWidgetId(1), isDragging(false), isResizing(false), activeTouchId(-1), animationProgress(0), targetHeight(height), currentHeight(height)
+FloatingMenu::FloatingMenu(float x, float y, float width, float height) : menuPos(x, y), menuSize(width, height), minimizedSize(width, 50), title("Menu"), isVisible(true), isMinimized(false), isDraggable(true), isResizable(false), autoLayout(true), animationEnabled(true), nextWidgetId(1), isDragging(false), isResizing(false), activeTouchId(-1), animationProgress(0), targetHeight(height), currentHeight(height), cacheEnabled(true), cacheDirty(true), cacheAntiAliasing(false), cacheMenuSize(0, 0), cacheMenuHeight(0), cacheX(0), cacheY(0)
 {
 }
 
@@ -24,7 +25,105 @@ FloatingMenu::~FloatingMenu()
 void FloatingMenu::Draw(Graphics::DrawList &dl)
 {
     if (!isVisible) return;
+    CPUDRAW_PROFILE_SCOPE(Menu);
 
+    // 高度动画期间每帧都在变，直接绘制
+    bool animating = std::abs(currentHeight - targetHeight) > 1.0f && animationEnabled;
+    // 贴图只跟随平移且含文字：缩放变换或分层绘制时也直接绘制
+    bool direct = dl.GetTransform().GetKind() != Graphics::AffineKind::Translate || dl.GetLayer() != Graphics::DrawLayer::All;
+    if (!cacheEnabled || animating || direct)
+    {
+        DrawMenu(dl);
+        return;
+    }
+
+    if (!CacheValid(dl.GetAntiAliasing()))
+    {
+        RebuildCache(dl.GetAntiAliasing());
+    }
+
+    // 拖拽只改变贴图位置
+    dl.AddSurface(cache, (int)menuPos.x + cacheX, (int)menuPos.y + cacheY);
+}
+
+bool FloatingMenu::CacheValid(bool antiAliasing) const
+{
+    if (cacheDirty || antiAliasing != cacheAntiAliasing) return false;
+    if (menuSize.x != cacheMenuSize.x || menuSize.y != cacheMenuSize.y || currentHeight != cacheMenuHeight) return false;
+
+    for (auto widget : widgets)
+    {
+        if (widget->IsDirty()) return false;
+    }
+    return true;
+}
+
+void FloatingMenu::RebuildCache(bool antiAliasing)
+{
+    cacheAntiAliasing = antiAliasing;
+    cacheMenuSize = menuSize;
+    cacheMenuHeight = currentHeight;
+    cacheDirty = false;
+
+    for (auto widget : widgets)
+    {
+        widget->ClearDirty();
+    }
+
+    // 先只统计范围：文字、阴影、抗锯齿边缘都可能超出菜单矩形
+    int baseX = (int)menuPos.x;
+    int baseY = (int)menuPos.y;
+    Graphics::DrawList probe((int)menuSize.x + CACHE_SLACK * 2, (int)std::max(menuSize.y, currentHeight) + CACHE_SLACK * 2);
+    probe.SetAntiAliasing(antiAliasing);
+    probe.SetOrigin(CACHE_SLACK - baseX, CACHE_SLACK - baseY);
+    DrawMenu(probe);
+
+    Graphics::IntRect bounds = probe.GetDrawnBounds();
+    if (bounds.IsEmpty())
+    {
+        cache.Resize(0, 0);
+        return;
+    }
+    cacheX = bounds.x0 - CACHE_SLACK;
+    cacheY = bounds.y0 - CACHE_SLACK;
+
+    int w = bounds.Width();
+    int h = bounds.Height();
+    cache.Resize(w, h);
+    size_t count = (size_t)w * h;
+
+#if CPUDRAW_PREMULTIPLIED
+    // 预乘管线：直接画在透明底上，结果就是预乘缓存
+    std::fill(cache.GetPixels(), cache.GetPixels() + count, 0u);
+
+    Graphics::DrawList target(cache.GetPixels(), w, w, h);
+    target.SetAntiAliasing(antiAliasing);
+    target.SetOrigin(-baseX - cacheX, -baseY - cacheY);
+    DrawMenu(target);
+#else
+    cacheWhite.resize(count);
+
+    // 直通 alpha 混合结果的 alpha 恒为 255，分别画在黑底、白底上反推覆盖率
+    std::fill(cache.GetPixels(), cache.GetPixels() + count, Graphics::rgba(0, 0, 0, 255));
+    std::fill(cacheWhite.begin(), cacheWhite.end(), Graphics::rgba(255, 255, 255, 255));
+
+    Graphics::DrawList black(cache.GetPixels(), w, w, h);
+    black.SetAntiAliasing(antiAliasing);
+    black.SetOrigin(-baseX - cacheX, -baseY - cacheY);
+    DrawMenu(black);
+
+    Graphics::DrawList white(cacheWhite.data(), w, w, h);
+    white.SetAntiAliasing(antiAliasing);
+    white.SetOrigin(-baseX - cacheX, -baseY - cacheY);
+    DrawMenu(white);
+
+    cache.ResolveBlackWhite(cache.GetPixels(), cacheWhite.data());
+#endif
+    cache.MarkUpdated();
+}
+
+void FloatingMenu::DrawMenu(Graphics::DrawList &dl)
+{
     // 绘制阴影
     if (style.showShadow && !isMinimized)
     {
@@ -91,7 +190,7 @@ void FloatingMenu::DrawContent(Graphics::DrawList &dl)
     My_Vector2 contentOffset = GetContentOffset();
 
     // 设置裁剪区域
-    //dl.PushClipRect(menuPos.x, menuPos.y + style.titleBarHeight, menuPos.x + menuSize.x, menuPos.y + currentHeight);
+    dl.PushClipRect(menuPos.x, menuPos.y + style.titleBarHeight, menuPos.x + menuSize.x, menuPos.y + currentHeight);
 
     // 绘制所有组件
     for (auto widget : widgets)
@@ -102,13 +201,13 @@ void FloatingMenu::DrawContent(Graphics::DrawList &dl)
         }
     }
 
-    //dl.PopClipRect();
+    dl.PopClipRect();
 }
 
 void FloatingMenu::DrawShadow(Graphics::DrawList &dl)
 {
     // 简单的阴影效果
-    int shadowOffset = 4;
+    int shadowOffset = SHADOW_OFFSET;
     uint32_t shadowColor = Graphics::rgba(0, 0, 0, 60);
 
     dl.AddRectRoundedFilled(menuPos.x + shadowOffset, menuPos.y + shadowOffset, menuPos.x + menuSize.x + shadowOffset, menuPos.y + currentHeight + shadowOffset, style.cornerRadius, shadowColor);
@@ -326,6 +425,7 @@ void FloatingMenu::RemoveWidget(int id)
         {
             delete *it;
             widgets.erase(it);
+            Invalidate();
             if (autoLayout) UpdateLayout();
             return;
         }
@@ -339,6 +439,7 @@ void FloatingMenu::ClearWidgets()
         delete widget;
     }
     widgets.clear();
+    Invalidate();
     if (autoLayout) UpdateLayout();
 }
 
@@ -347,6 +448,7 @@ void FloatingMenu::SetMinimized(bool minimized)
     if (isMinimized != minimized)
     {
         isMinimized = minimized;
+        Invalidate();
         if (animationEnabled)
         {
             targetHeight = isMinimized ? style.titleBarHeight : GetContentHeight();
@@ -0,0 +1,114 @@
+/*
+ * CPU-Draw - Profiler HUD Module
+ * Created: 2026-10-14
+ * By: MaySnowL
+ *
+ * 性能面板
+ * 数据来自 Core::Profiler 的环形缓冲，只在渲染线程绘制
+ *
+ * 仅供学习和研究使用
+ */
+
+#include "ui/ProfilerHud.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace UI
+{
+
+static const int HUD_PADDING = 12;
+static const int HUD_BAR_WIDTH = 3;
+static const int HUD_GRAPH_HEIGHT = 80;
+static const int HUD_FONT_SIZE = 16;
+static const int HUD_LINE_HEIGHT = 20;
+static const int HUD_STAT_ROWS = 2 + (Core::PROFILE_ZONE_COUNT + 1) / 2 + (Core::PROFILE_COUNTER_COUNT + 1) / 2;
+
+static const uint32_t HUD_BACKGROUND = Graphics::rgba(16, 18, 24, 200);
+static const uint32_t HUD_TEXT = Graphics::rgba(230, 230, 235, 255);
+static const uint32_t HUD_TEXT_DIM = Graphics::rgba(150, 155, 165, 255);
+static const uint32_t HUD_GOOD = Graphics::rgba(80, 200, 120, 255);
+static const uint32_t HUD_WARN = Graphics::rgba(230, 190, 60, 255);
+static const uint32_t HUD_BAD = Graphics::rgba(230, 80, 70, 255);
+static const uint32_t HUD_GUIDE = Graphics::rgba(255, 255, 255, 90);
+
+ProfilerHud::ProfilerHud(int x, int y) : posX(x), posY(y), budgetMs(16.6667f)
+{
+}
+
+void ProfilerHud::Draw(Graphics::DrawList &dl)
+{
+    Core::Profiler &profiler = Core::Profiler::Instance();
+    int count = profiler.CopyFrames(frames, GRAPH_FRAMES);
+    Core::ProfileSummary summary = profiler.Summarize(GRAPH_FRAMES);
+
+    int panelW = GRAPH_FRAMES * HUD_BAR_WIDTH + HUD_PADDING * 2;
+    int panelH = HUD_PADDING * 3 + HUD_GRAPH_HEIGHT + HUD_STAT_ROWS * HUD_LINE_HEIGHT;
+
+    // 面板不需要抗锯齿，柱子都是轴对齐矩形
+    bool aa = dl.GetAntiAliasing();
+    dl.SetAntiAliasing(false);
+
+    dl.AddRectFilled(posX, posY, posX + panelW - 1, posY + panelH - 1, HUD_BACKGROUND);
+    DrawGraph(dl, posX + HUD_PADDING, posY + HUD_PADDING, count);
+    DrawStats(dl, posX + HUD_PADDING, posY + HUD_PADDING * 2 + HUD_GRAPH_HEIGHT, summary);
+
+    dl.SetAntiAliasing(aa);
+}
+
+void ProfilerHud::DrawGraph(Graphics::DrawList &dl, int x, int y, int count)
+{
+    // 纵轴为两倍帧预算，超出的柱子顶满
+    float scaleMs = budgetMs * 2.0f;
+    int bottom = y + HUD_GRAPH_HEIGHT - 1;
+
+    // 右对齐：最新一帧在最右侧
+    int start = x + (GRAPH_FRAMES - count) * HUD_BAR_WIDTH;
+    for (int i = 0; i < count; i++)
+    {
+        float ms = frames[i].frameNs * 1e-6f;
+        int h = std::max(1, (int)(std::min(ms / scaleMs, 1.0f) * HUD_GRAPH_HEIGHT));
+        uint32_t color = ms <= budgetMs ? HUD_GOOD : (ms <= scaleMs ? HUD_WARN : HUD_BAD);
+
+        int bx = start + i * HUD_BAR_WIDTH;
+        dl.AddRectFilled(bx, bottom - h + 1, bx + HUD_BAR_WIDTH - 2, bottom, color);
+    }
+
+    // 帧预算参考线
+    int guideY = bottom - HUD_GRAPH_HEIGHT / 2;
+    dl.AddLine(x, guideY, x + GRAPH_FRAMES * HUD_BAR_WIDTH - 1, guideY, HUD_GUIDE);
+}
+
+void ProfilerHud::DrawStats(Graphics::DrawList &dl, int x, int y, const Core::ProfileSummary &summary)
+{
+    char line[96];
+    int columnW = GRAPH_FRAMES * HUD_BAR_WIDTH / 2;
+
+    snprintf(line, sizeof(line), "FPS %.1f   预算 %.2f ms", summary.fps, budgetMs);
+    dl.AddText(x, y, line, HUD_FONT_SIZE, HUD_TEXT);
+    y += HUD_LINE_HEIGHT;
+
+    snprintf(line, sizeof(line), "p50 %.2f  p95 %.2f  p99 %.2f  max %.2f", summary.frameMs[0], summary.frameMs[1], summary.frameMs[2], summary.frameMs[3]);
+    dl.AddText(x, y, line, HUD_FONT_SIZE, summary.frameMs[2] <= budgetMs ? HUD_TEXT : HUD_WARN);
+    y += HUD_LINE_HEIGHT;
+
+    // 分段平均耗时，两列
+    for (int z = 0; z < Core::PROFILE_ZONE_COUNT; z++)
+    {
+        snprintf(line, sizeof(line), "%-8s %.2f", Core::Profiler::GetZoneName((Core::ProfileZone)z), summary.zoneMs[z]);
+        dl.AddText(x + (z & 1) * columnW, y + (z / 2) * HUD_LINE_HEIGHT, line, HUD_FONT_SIZE, HUD_TEXT_DIM);
+    }
+    y += (Core::PROFILE_ZONE_COUNT + 1) / 2 * HUD_LINE_HEIGHT;
+
+    // 每帧平均计数
+    for (int c = 0; c < Core::PROFILE_COUNTER_COUNT; c++)
+    {
+        float value = summary.counters[c];
+        if (value >= 1e6f)
+            snprintf(line, sizeof(line), "%-10s %.2fM", Core::Profiler::GetCounterName((Core::ProfileCounter)c), value * 1e-6f);
+        else
+            snprintf(line, sizeof(line), "%-10s %.0f", Core::Profiler::GetCounterName((Core::ProfileCounter)c), value);
+        dl.AddText(x + (c & 1) * columnW, y + (c / 2) * HUD_LINE_HEIGHT, line, HUD_FONT_SIZE, HUD_TEXT_DIM);
+    }
+}
+
+} // namespace UI
@@ -18,6 +18,7 @@
 #include "graphics/Primitives.h"
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 
 namespace UI
 {
@@ -85,8 +86,8 @@ bool Button::HandleTouch(const Input::TouchPoint &touch)
             {
                 onClick();
             }
-            isPressed = false;
-            isHovered = false;
+            SetState(isPressed, false);
+            SetState(isHovered, false);
             activeTouchId = -1;
         }
         return false;
@@ -97,26 +98,123 @@ bool Button::HandleTouch(const Input::TouchPoint &touch)
         if (activeTouchId == -1)
         {
             activeTouchId = touch.id;
-            isHovered = true;
-            isPressed = true;
+            SetState(isHovered, true);
+            SetState(isPressed, true);
             return true;
         }
         else if (activeTouchId == touch.id)
         {
-            isHovered = true;
-            isPressed = true;
+            SetState(isHovered, true);
+            SetState(isPressed, true);
             return true;
         }
     }
     else if (activeTouchId == touch.id)
     {
-        isHovered = false;
-        isPressed = false;
+        SetState(isHovered, false);
+        SetState(isPressed, false);
     }
 
     return activeTouchId == touch.id;
 }
 
+// ==================== Slider ====================
+
+Slider::Slider(float minValue, float maxValue) : value(minValue), minValue(minValue), maxValue(maxValue), isDragging(false), showValue(true)
+{
+    size = My_Vector2(300, 70);
+}
+
+void Slider::SetValue(float v)
+{
+    v = std::max(minValue, std::min(maxValue, v));
+    if (value != v)
+    {
+        value = v;
+        dirty = true;
+        if (onValueChange)
+        {
+            onValueChange(value);
+        }
+    }
+}
+
+void Slider::SetFromX(float x)
+{
+    if (size.x <= 0) return;
+
+    float percentage = std::max(0.0f, std::min(1.0f, (x - pos.x) / size.x));
+    SetValue(minValue + percentage * (maxValue - minValue));
+}
+
+void Slider::Draw(Graphics::DrawList &dl)
+{
+    if (!visible) return;
+
+    int fontSize = 24;
+    if (!label.empty())
+    {
+        dl.AddText((int)pos.x, (int)pos.y, label, fontSize, Graphics::rgba(38, 51, 71, 255));
+    }
+
+    if (showValue)
+    {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%.1f", value);
+        My_Vector2 textSize = dl.CalcTextSize(buf, fontSize);
+        dl.AddText((int)(pos.x + size.x - textSize.x), (int)pos.y, buf, fontSize, Graphics::rgba(90, 110, 140, 255));
+    }
+
+    // 滑轨
+    int trackH = 8;
+    int trackY = pos.y + size.y - 20;
+    int trackX0 = pos.x;
+    int trackX1 = pos.x + size.x;
+    float percentage = maxValue > minValue ? GetPercentage() : 0.0f;
+    int knobX = trackX0 + (int)(percentage * (trackX1 - trackX0));
+
+    dl.AddRectRoundedFilled(trackX0, trackY - trackH / 2, trackX1, trackY + trackH / 2, trackH / 2, Graphics::rgba(209, 224, 237, 255));
+    if (knobX > trackX0)
+    {
+        dl.AddRectRoundedFilled(trackX0, trackY - trackH / 2, knobX, trackY + trackH / 2, trackH / 2, Graphics::rgba(100, 150, 220, 255));
+    }
+
+    // 滑块
+    int knobR = isDragging ? 16 : 14;
+    dl.AddCircleFilled(knobX, trackY, knobR, enabled ? Graphics::rgba(255, 255, 255, 255) : Graphics::rgba(200, 200, 200, 255));
+    dl.AddCircle(knobX, trackY, knobR, Graphics::rgba(140, 179, 217, 255));
+}
+
+bool Slider::HandleTouch(const Input::TouchPoint &touch)
+{
+    if (!visible || !enabled) return false;
+
+    if (!touch.isDown)
+    {
+        if (activeTouchId == touch.id)
+        {
+            SetState(isDragging, false);
+            activeTouchId = -1;
+        }
+        return false;
+    }
+
+    if (activeTouchId == -1 && Contains(touch.pos))
+    {
+        activeTouchId = touch.id;
+        SetState(isDragging, true);
+    }
+
+    // 拖动中即使移出控件也继续跟随
+    if (activeTouchId == touch.id)
+    {
+        SetFromX(touch.pos.x);
+        return true;
+    }
+
+    return false;
+}
+
 // ==================== Checkbox ====================
 
 Checkbox::Checkbox(const std::string &label) : label(label), isChecked(false), isHovered(false)
@@ -129,6 +227,7 @@ void Checkbox::SetChecked(bool checked)
     if (isChecked != checked)
     {
         isChecked = checked;
+        dirty = true;
         if (onValueChange)
         {
             onValueChange(isChecked);
@@ -176,7 +275,7 @@ bool Checkbox::HandleTouch(const Input::TouchPoint &touch)
             {
                 SetChecked(!isChecked);
             }
-            isHovered = false;
+            SetState(isHovered, false);
             activeTouchId = -1;
         }
         return false;
@@ -187,18 +286,18 @@ bool Checkbox::HandleTouch(const Input::TouchPoint &touch)
         if (activeTouchId == -1)
         {
             activeTouchId = touch.id;
-            isHovered = true;
+            SetState(isHovered, true);
             return true;
         }
         else if (activeTouchId == touch.id)
         {
-            isHovered = true;
+            SetState(isHovered, true);
             return true;
         }
     }
     else if (activeTouchId == touch.id)
     {
-        isHovered = false;
+        SetState(isHovered, false);
     }
 
     return activeTouchId == touch.id;
@@ -291,12 +390,12 @@ bool TextInput::HandleTouch(const Input::TouchPoint &touch)
     {
         if (contains)
         {
-            isFocused = true;
+            SetState(isFocused, true);
             return true;
         }
         else
         {
-            isFocused = false;
+            SetState(isFocused, false);
         }
     }
 
@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+# CPU-Draw - Font Tool
+# Created: 2026-10-14
+# By: MaySnowL
+#
+# 构建时字体处理
+#   extract <Font.h> <out.ttf>                      从内嵌数组还原字体文件
+#   subset  <in.ttf> <out.ttf> <源码...> [--text S] 裁剪为源码字符串里用到的字符（需要 fontTools）
+#   header  <in.ttf> <out.h>                        生成与 Font.h 同格式的内嵌头文件
+#
+# 仅供学习和研究使用
+
+import re
+import struct
+import sys
+
+SYMBOL = "OPPOSans_H"
+
+# 源码之外运行时可能出现的字符：ASCII 可打印字符、常用中文标点
+EXTRA_TEXT = "".join(chr(c) for c in range(0x20, 0x7F)) + "，。、：；！？（）【】《》“”‘’…—·￥％℃°"
+
+
+def extract(header_path, out_path):
+    with open(header_path, "r", encoding="utf-8", errors="ignore") as f:
+        text = f.read()
+
+    size = int(re.search(r"_size\s*=\s*(\d+)", text).group(1))
+    body = text[text.index("{") + 1:text.rindex("}")]
+    words = [int(w, 16) for w in re.findall(r"0x([0-9a-fA-F]+)", body)]
+
+    data = struct.pack("<%dI" % len(words), *words)[:size]
+    with open(out_path, "wb") as f:
+        f.write(data)
+
+
+STRING_LITERAL = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+
+
+def collect_text(sources):
+    chars = set(EXTRA_TEXT)
+    for path in sources:
+        with open(path, "r", encoding="utf-8", errors="ignore") as f:
+            for literal in STRING_LITERAL.findall(f.read()):
+                chars.update(c for c in literal if ord(c) >= 0x20)
+    return "".join(sorted(chars))
+
+
+def subset(in_path, out_path, sources, text):
+    from fontTools import subset as ft_subset
+
+    options = ft_subset.Options()
+    options.layout_features = ["*"]
+    options.name_IDs = ["*"]
+    options.notdef_outline = True
+    options.hinting = False  # stb 不使用 hinting
+
+    font = ft_subset.load_font(in_path, options)
+    subsetter = ft_subset.Subsetter(options)
+    subsetter.populate(text=collect_text(sources) + text)
+    subsetter.subset(font)
+    ft_subset.save_font(font, out_path, options)
+
+
+def header(in_path, out_path):
+    with open(in_path, "rb") as f:
+        data = f.read()
+
+    size = len(data)
+    data += b"\0" * (-size % 4)
+    words = struct.unpack("<%dI" % (len(data) // 4), data)
+
+    with open(out_path, "w") as f:
+        f.write("static const unsigned int %s_size = %d;\n" % (SYMBOL, size))
+        f.write("static const unsigned int %s[%d] =\n{" % (SYMBOL, len(words)))
+        for i in range(0, len(words), 12):
+            f.write("    " + ", ".join("0x%08x" % w for w in words[i:i + 12]) + ",\n")
+        f.write("};\n")
+
+
+def main(argv):
+    if len(argv) >= 3 and argv[0] == "extract":
+        extract(argv[1], argv[2])
+    elif len(argv) >= 3 and argv[0] == "subset":
+        sources = []
+        text = ""
+        args = argv[3:]
+        i = 0
+        while i < len(args):
+            if args[i] == "--text" and i + 1 < len(args):
+                text += args[i + 1]
+                i += 2
+            else:
+                sources.append(args[i])
+                i += 1
+        subset(argv[1], argv[2], sources, text)
+    elif len(argv) >= 3 and argv[0] == "header":
+        header(argv[1], argv[2])
+    else:
+        sys.stderr.write(__doc__ or "usage: font_tool.py extract|subset|header ...\n")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))